@@ -41,10 +41,11 @@
 
 /* Scheduler Related */
 #define configUSE_PREEMPTION                    1
-#define configUSE_TICKLESS_IDLE                 0
-#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICKLESS_IDLE                 0   /* not supported by the RP2040 SMP port */
+#define configUSE_IDLE_HOOK                     1   /* power_idle(): WFI between ticks */
 #define configUSE_TICK_HOOK                     0
 #define configTICK_RATE_HZ                      ( ( TickType_t ) 1000 )
+#define configSYSTICK_CLOCK_HZ                  1000000   /* 1 us reference tick, independent of clk_sys */
 #define configMAX_PRIORITIES                    32
 #define configMINIMAL_STACK_SIZE                ( configSTACK_DEPTH_TYPE ) 256
 #define configUSE_16_BIT_TICKS                  0
@@ -68,9 +69,18 @@
 #define configMESSAGE_BUFFER_LENGTH_TYPE        size_t
 
 /* Memory allocation related definitions. */
-#define configSUPPORT_STATIC_ALLOCATION         0
+/* All application objects are static; RTOS_STATIC_ONLY=1 (CMake option) also drops the heap */
+#ifndef RTOS_STATIC_ONLY
+#define RTOS_STATIC_ONLY                        0
+#endif
+#define configSUPPORT_STATIC_ALLOCATION         1
+#define configKERNEL_PROVIDED_STATIC_MEMORY     1   /* idle and timer task buffers */
+#if RTOS_STATIC_ONLY
+#define configSUPPORT_DYNAMIC_ALLOCATION        0
+#else
 #define configSUPPORT_DYNAMIC_ALLOCATION        1
-#define configTOTAL_HEAP_SIZE                   (128*1024)
+#endif
+#define configTOTAL_HEAP_SIZE                   (16*1024)
 #define configAPPLICATION_ALLOCATED_HEAP        0
 
 /* Hook function related definitions. */
@@ -79,7 +89,14 @@
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
 /* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS           0
+#ifndef __ASSEMBLER__
+#include <stdint.h>
+extern uint64_t time_us_64(void);
+#endif
+#define configGENERATE_RUN_TIME_STATS           1   /* microseconds from the 64-bit timer */
+#define configRUN_TIME_COUNTER_TYPE             uint64_t
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()        time_us_64()
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
@@ -132,7 +149,7 @@ to exclude the API function. */
 /* A header file that defines trace macro can be included here. */
 
 /* SMP Related config. */
-#define configUSE_PASSIVE_IDLE_HOOK             0
+#define configUSE_PASSIVE_IDLE_HOOK             1
 #define portSUPPORT_SMP                         1
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,118 @@
+/**
+ * @file      clock_gov.h
+ * @brief     System clock governor, lowers clk_sys during long waits
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CLOCK_GOV_H
+#define CLOCK_GOV_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Low clk_sys in kHz, PLL_USB (48 MHz) divided by an integer */
+#ifndef CLOCK_GOV_LOW_KHZ
+#define CLOCK_GOV_LOW_KHZ       48000
+#endif
+
+/** Shortest wait worth two clock switches */
+#ifndef CLOCK_GOV_MIN_WAIT_MS
+#define CLOCK_GOV_MIN_WAIT_MS   50
+#endif
+
+/** 1 to check clk_sys with the frequency counter after every switch */
+#ifndef CLOCK_GOV_MEASURE
+#define CLOCK_GOV_MEASURE       0
+#endif
+
+/** Accepted frequency counter deviation in permille */
+#define CLOCK_GOV_TOLERANCE     10
+
+/**
+ * @brief clock governor level enumeration definition
+ */
+typedef enum
+{
+    CLOCK_GOV_FULL = 0,        /**< clk_sys from PLL_SYS, as set up at boot */
+    CLOCK_GOV_LOW  = 1,        /**< clk_sys from PLL_USB */
+    CLOCK_GOV_LEVELS = 2,
+} clock_gov_level_t;
+
+/**
+ * @brief Governor counters
+ */
+typedef struct clock_gov_stats_s
+{
+    uint64_t level_us[CLOCK_GOV_LEVELS];   /**< time spent at each level */
+    uint32_t transitions;                  /**< level changes */
+    uint32_t errors;                       /**< clock_configure failures */
+    uint32_t max_switch_us;                /**< longest switch */
+    uint32_t checks;                       /**< frequency counter checks, measurement mode */
+    uint32_t check_errors;                 /**< checks off by more than CLOCK_GOV_TOLERANCE */
+    uint32_t last_khz;                     /**< last measured clk_sys */
+} clock_gov_stats_t;
+
+/**
+ * @brief  Record the boot clk_sys as the full level and move clk_peri to PLL_USB
+ * @return status code
+ *         - 0 success
+ *         - 1 clk_peri reconfiguration failed
+ * @note   Call before any SPI or UART is initialised: their baud dividers are
+ *         computed from clk_peri, which no longer follows clk_sys afterwards.
+ *         The FreeRTOS tick and busy_wait_us run from the 1 us reference tick
+ *         and are unaffected by the level.
+ */
+uint8_t clock_gov_init(void);
+
+/**
+ * @brief     Switch clk_sys to a level
+ * @param[in] level Level
+ * @return    status code
+ *            - 0 success
+ *            - 1 not initialised or clock_configure failed, level unchanged
+ * @note      Only the 1-Wire sampling path switches levels; bit-banged slots
+ *            must run at CLOCK_GOV_FULL.
+ */
+uint8_t clock_gov_set(clock_gov_level_t level);
+
+/**
+ * @brief  Current level
+ * @return Level
+ */
+clock_gov_level_t clock_gov_level(void);
+
+/**
+ * @brief      Take a snapshot of the counters, level_us includes the running level
+ * @param[out] stats Snapshot
+ */
+void clock_gov_get_stats(clock_gov_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,158 @@
+/**
+ * @file      dlog.h
+ * @brief     Deferred binary logging: call sites store a message id and arguments, a task formats them later
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DLOG_H
+#define DLOG_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief dlog level enumeration definition
+ */
+typedef enum
+{
+    DLOG_LEVEL_NONE  = 0,
+    DLOG_LEVEL_ERROR = 1,
+    DLOG_LEVEL_WARN  = 2,
+    DLOG_LEVEL_INFO  = 3,
+    DLOG_LEVEL_DEBUG = 4,
+} dlog_level_t;
+
+/** Messages above this level are compiled out */
+#ifndef DLOG_LEVEL
+#define DLOG_LEVEL         DLOG_LEVEL_WARN
+#endif
+
+/** Records per core ring, a power of two */
+#ifndef DLOG_SIZE
+#define DLOG_SIZE          64
+#endif
+
+/** Number of per-core rings */
+#define DLOG_CORES         2
+
+#if (DLOG_SIZE & (DLOG_SIZE - 1)) != 0
+#error "DLOG_SIZE must be a power of two"
+#endif
+
+#include "dlog_msgs.h"
+
+#define DLOG_X_ID(name, level, text)       DLOG_##name,
+#define DLOG_X_LEVEL(name, level, text)    DLOG_LEVEL_OF_##name = (level),
+
+/**
+ * @brief dlog message id enumeration definition, one per dlog_msgs.h entry
+ */
+typedef enum
+{
+    DLOG_MESSAGES(DLOG_X_ID)
+    DLOG_COUNT
+} dlog_id_t;
+
+enum { DLOG_MESSAGES(DLOG_X_LEVEL) };
+
+/**
+ * @brief One deferred message, 16 bytes
+ */
+typedef struct dlog_record_s
+{
+    uint32_t time_us;          /**< low 32 bits of the 1 MHz timer */
+    uint16_t id;               /**< dlog_id_t */
+    uint8_t core;              /**< core that logged it */
+    uint8_t reserved;          /**< 0 */
+    uint32_t arg[2];           /**< format arguments */
+} dlog_record_t;
+
+/**
+ * @brief     Store one record in the calling core's ring
+ * @param[in] id   dlog_id_t
+ * @param[in] arg0 First argument
+ * @param[in] arg1 Second argument
+ * @note      Safe from tasks, ISRs and interrupt-disabled sections; never
+ *            blocks. A full ring drops the record and counts it.
+ */
+void dlog_write(uint16_t id, uint32_t arg0, uint32_t arg1);
+
+/**
+ * @brief Log a message from dlog_msgs.h with up to two arguments
+ *
+ * The level test is a compile-time constant, so a message above DLOG_LEVEL
+ * leaves no code behind.
+ */
+#define DLOG2(name, arg0, arg1)                                                     \
+    do {                                                                            \
+        if ((int)DLOG_LEVEL_OF_##name <= (int)DLOG_LEVEL) {                         \
+            dlog_write(DLOG_##name, (uint32_t)(arg0), (uint32_t)(arg1));            \
+        }                                                                           \
+    } while (0)
+#define DLOG1(name, arg0)    DLOG2(name, (arg0), 0)
+#define DLOG(name)           DLOG2(name, 0, 0)
+
+/**
+ * @brief      Take records out of one core's ring, oldest first
+ * @param[in]  core Ring
+ * @param[out] out  Destination
+ * @param[in]  max  Capacity of out
+ * @return     Number of records taken
+ * @note       Single consumer per ring
+ */
+uint16_t dlog_read(uint8_t core, dlog_record_t *out, uint16_t max);
+
+/**
+ * @brief     Records one core's ring dropped because it was full
+ * @param[in] core Ring
+ * @return    Dropped count
+ */
+uint32_t dlog_dropped(uint8_t core);
+
+/**
+ * @brief      Format a record as one text line without line end
+ * @param[in]  rec Record
+ * @param[out] buf Text
+ * @param[in]  len Size of buf
+ * @return     Length of the text, truncated to len - 1
+ */
+uint16_t dlog_format(const dlog_record_t *rec, char *buf, uint16_t len);
+
+/**
+ * @brief     Start the task that prints the rings on stdio
+ * @param[in] priority FreeRTOS priority, normally just above idle
+ * @return    status code
+ *            - 0 success
+ *            - 1 task creation failed
+ */
+uint8_t dlog_task_create(uint32_t priority);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,67 @@
+/**
+ * @file      dlog_msgs.h
+ * @brief     Deferred log message table: id, level and format of every message
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * X-macro list, no include guard: dlog.h expands it into the id and level
+ * enums, dlog.c into the format table. Arguments are uint32_t; a format
+ * uses at most two %lu/%lx conversions. Append new messages at the end so
+ * ids stay stable for anything that stored raw records.
+ */
+#define DLOG_MESSAGES(X) \
+    X(DS18B20_BUS_INIT_NULL,       DLOG_LEVEL_ERROR, "ds18b20: bus_init is null.") \
+    X(DS18B20_BUS_DEINIT_NULL,     DLOG_LEVEL_ERROR, "ds18b20: bus_deinit is null.") \
+    X(DS18B20_BUS_READ_NULL,       DLOG_LEVEL_ERROR, "ds18b20: bus_read is null.") \
+    X(DS18B20_BUS_WRITE_NULL,      DLOG_LEVEL_ERROR, "ds18b20: bus_write is null.") \
+    X(DS18B20_DELAY_MS_NULL,       DLOG_LEVEL_ERROR, "ds18b20: delay_ms is null.") \
+    X(DS18B20_DELAY_US_NULL,       DLOG_LEVEL_ERROR, "ds18b20: delay_us is null.") \
+    X(DS18B20_ENABLE_IRQ_NULL,     DLOG_LEVEL_ERROR, "ds18b20: enable_irq is null.") \
+    X(DS18B20_DISABLE_IRQ_NULL,    DLOG_LEVEL_ERROR, "ds18b20: disable_irq is null.") \
+    X(DS18B20_BUS_INIT_FAILED,     DLOG_LEVEL_ERROR, "ds18b20[%02lx]: bus init failed.") \
+    X(DS18B20_DEINIT_FAILED,       DLOG_LEVEL_ERROR, "ds18b20[%02lx]: deinit failed.") \
+    X(DS18B20_RESET_FAILED,        DLOG_LEVEL_WARN,  "ds18b20[%02lx]: reset failed.") \
+    X(DS18B20_BUS_RESET_FAILED,    DLOG_LEVEL_WARN,  "ds18b20[%02lx]: bus reset failed.") \
+    X(DS18B20_NO_RESPONSE,         DLOG_LEVEL_WARN,  "ds18b20[%02lx]: bus read no response.") \
+    X(DS18B20_BUS_READ_FAILED,     DLOG_LEVEL_ERROR, "ds18b20[%02lx]: bus read failed.") \
+    X(DS18B20_BUS_WRITE_FAILED,    DLOG_LEVEL_ERROR, "ds18b20[%02lx]: bus write failed.") \
+    X(DS18B20_READ_BIT_FAILED,     DLOG_LEVEL_ERROR, "ds18b20[%02lx]: read bit failed.") \
+    X(DS18B20_READ_2BIT_FAILED,    DLOG_LEVEL_ERROR, "ds18b20[%02lx]: read 2bit failed.") \
+    X(DS18B20_WRITE_BIT_FAILED,    DLOG_LEVEL_ERROR, "ds18b20[%02lx]: write bit failed.") \
+    X(DS18B20_READ_BYTE_FAILED,    DLOG_LEVEL_ERROR, "ds18b20[%02lx]: read byte failed.") \
+    X(DS18B20_BUS_READ_BYTE_FAILED, DLOG_LEVEL_ERROR, "ds18b20[%02lx]: bus read byte failed.") \
+    X(DS18B20_READ_DATA_FAILED,    DLOG_LEVEL_ERROR, "ds18b20[%02lx]: read data failed.") \
+    X(DS18B20_WRITE_CMD_FAILED,    DLOG_LEVEL_ERROR, "ds18b20[%02lx]: write command failed.") \
+    X(DS18B20_READ_ROM_FAILED,     DLOG_LEVEL_ERROR, "ds18b20[%02lx]: read rom failed.") \
+    X(DS18B20_CRC_ERROR,           DLOG_LEVEL_WARN,  "ds18b20[%02lx]: crc check error.") \
+    X(DS18B20_CONVERT_TIMEOUT,     DLOG_LEVEL_WARN,  "ds18b20[%02lx]: bus read timeout.") \
+    X(DS18B20_MODE_INVALID,        DLOG_LEVEL_ERROR, "ds18b20[%02lx]: mode invalid.") \
+    X(DS18B20_RESOLUTION_INVALID,  DLOG_LEVEL_ERROR, "ds18b20[%02lx]: resolution invalid.") \
+    X(DS18B20_SEARCH_OVERFLOW,     DLOG_LEVEL_ERROR, "ds18b20: number is over DS18B20_MAX_SEARCH_SIZE.") \
+    X(DS18B20_TIMING_NULL,         DLOG_LEVEL_ERROR, "ds18b20: timing is null.") \
+    X(OW_TUNE_PROFILE,             DLOG_LEVEL_INFO,  "ow_tune: profile %lu, rise %lu ns.") \
+    X(OW_TUNE_FALLBACK,            DLOG_LEVEL_WARN,  "ow_tune: profile %lu had %lu crc errors, back to standard timing.") \
+    X(DS18B20_DUAL_QUARANTINE,     DLOG_LEVEL_WARN,  "ds18b20_dual: sensor %lu quarantined after %lu failures.") \
+    X(DS18B20_DUAL_RECOVERED,      DLOG_LEVEL_INFO,  "ds18b20_dual: sensor %lu back after %lu failures.")
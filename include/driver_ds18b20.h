@@ -103,9 +103,41 @@ typedef enum
 } ds18b20_resolution_t;
 
 /**
- * @brief ds18b20 handle structure definition
+ * @brief ds18b20 slot timing structure definition
+ * @note  all times in us; one per bus, so a tuned profile follows the wiring
  */
-typedef struct ds18b20_handle_s
+typedef struct ds18b20_timing_s
+{
+    uint16_t reset_low_us;          /**< reset pulse, spec min 480 */
+    uint8_t presence_wait_us;       /**< release to first presence sample, spec 15..60 */
+    uint8_t presence_max_us;        /**< presence must start within this after the wait */
+    uint8_t presence_end_us;        /**< presence must end within this after it started */
+    uint8_t write1_low_us;          /**< write 1 low time, spec 1..15 */
+    uint8_t write1_high_us;         /**< write 1 rest of slot and recovery */
+    uint8_t write0_low_us;          /**< write 0 low time, spec 60..120 */
+    uint8_t write0_high_us;         /**< write 0 recovery, spec min 1 */
+    uint8_t read_low_us;            /**< read slot start, spec min 1 */
+    uint8_t read_sample_us;         /**< release to sample, low plus this below 15 */
+    uint8_t read_high_us;           /**< read rest of slot and recovery */
+    uint32_t frames;                /**< scratchpad reads with this timing */
+    uint32_t crc_errors;            /**< of which failed the crc */
+} ds18b20_timing_t;
+
+/**
+ * @brief ds18b20 timing initializer matching the datasheet defaults this driver always used
+ */
+#define DS18B20_TIMING_STANDARD    { 750, 15, 200, 240, 2, 60, 60, 2, 2, 12, 50, 0, 0 }
+
+/**
+ * @brief ds18b20 bus operations structure definition
+ * @note  one table per bus, shared by the handles of every sensor on it;
+ *        bus_touch runs a block of time slots, bit n of tx (lsb first) is
+ *        written in slot n and 1 bits double as read slots whose samples are
+ *        packed the same way into rx, which may be NULL; bus_triplet reads a
+ *        rom bit and its complement and writes the bit, or direction when
+ *        they are both 0, as one search step
+ */
+typedef struct ds18b20_bus_s
 {
     uint8_t (*bus_init)(void);                              /**< point to a bus_init function address */
     uint8_t (*bus_deinit)(void);                            /**< point to a bus_deinit function address */
@@ -116,9 +148,23 @@ typedef struct ds18b20_handle_s
     void (*enable_irq)(void);                               /**< point to an enable_irq function address */
     void (*disable_irq)(void);                              /**< point to a disable_irq function address */
     void (*debug_print)(const char *const fmt, ...);        /**< point to a debug_print function address */
+    ds18b20_timing_t *timing;                               /**< point to the bus slot timing */
+    uint8_t (*bus_reset)(uint8_t *presence_us, uint8_t *width_us);  /**< optional reset with presence capture, NULL to poll */
+    uint8_t (*bus_touch)(const uint8_t *tx, uint8_t *rx, uint16_t slots);   /**< optional slot transfer, NULL to bit-bang */
+    uint8_t (*bus_triplet)(uint8_t direction, uint8_t *id_bit, uint8_t *cmp_bit, uint8_t *taken); /**< optional search step, NULL for single slots */
+} ds18b20_bus_t;
+
+/**
+ * @brief ds18b20 handle structure definition
+ */
+typedef struct ds18b20_handle_s
+{
+    const ds18b20_bus_t *bus;                               /**< point to the bus operations */
+    uint8_t rom[8];                                         /**< chip rom */
     uint8_t inited;                                         /**< inited flag */
     uint8_t mode;                                           /**< chip mode */
-    uint8_t rom[8];                                         /**< chip mode */
+    uint8_t resolution;                                     /**< last known resolution */
+    uint8_t presence_width;                                 /**< presence pulse width of the last reset in us */
 } ds18b20_handle_t;
 
 /**
@@ -157,76 +203,12 @@ typedef struct ds18b20_info_s
 #define DRIVER_DS18B20_LINK_INIT(HANDLE, STRUCTURE)   memset(HANDLE, 0, sizeof(STRUCTURE))
 
 /**
- * @brief     link bus_init function
- * @param[in] HANDLE pointer to a ds18b20 handle structure
- * @param[in] FUC pointer to a bus_init function address
- * @note      none
- */
-#define DRIVER_DS18B20_LINK_BUS_INIT(HANDLE, FUC)    (HANDLE)->bus_init = FUC
-
-/**
- * @brief     link bus_deinit function
- * @param[in] HANDLE pointer to a ds18b20 handle structure
- * @param[in] FUC pointer to a bus_deinit function address
- * @note      none
- */
-#define DRIVER_DS18B20_LINK_BUS_DEINIT(HANDLE, FUC)  (HANDLE)->bus_deinit = FUC
-
-/**
- * @brief     link bus_read function
+ * @brief     link the bus operations
  * @param[in] HANDLE pointer to a ds18b20 handle structure
- * @param[in] FUC pointer to a bus_read function address
- * @note      none
+ * @param[in] BUS pointer to a ds18b20 bus operations structure
+ * @note      the table must outlive the handle, normally it is a const global
  */
-#define DRIVER_DS18B20_LINK_BUS_READ(HANDLE, FUC)    (HANDLE)->bus_read = FUC
-
-/**
- * @brief     link bus_write function
- * @param[in] HANDLE pointer to a ds18b20 handle structure
- * @param[in] FUC pointer to a bus_write function address
- * @note      none
- */
-#define DRIVER_DS18B20_LINK_BUS_WRITE(HANDLE, FUC)   (HANDLE)->bus_write = FUC
-
-/**
- * @brief     link delay_ms function
- * @param[in] HANDLE pointer to a ds18b20 handle structure
- * @param[in] FUC pointer to a delay_ms function address
- * @note      none
- */
-#define DRIVER_DS18B20_LINK_DELAY_MS(HANDLE, FUC)    (HANDLE)->delay_ms = FUC
-
-/**
- * @brief     link delay_us function
- * @param[in] HANDLE pointer to a ds18b20 handle structure
- * @param[in] FUC pointer to a delay_us function address
- * @note      none
- */
-#define DRIVER_DS18B20_LINK_DELAY_US(HANDLE, FUC)    (HANDLE)->delay_us = FUC
-
-/**
- * @brief     link enable_irq function
- * @param[in] HANDLE pointer to a ds18b20 handle structure
- * @param[in] FUC pointer to an enable_irq function address
- * @note      none
- */
-#define DRIVER_DS18B20_LINK_ENABLE_IRQ(HANDLE, FUC)  (HANDLE)->enable_irq = FUC
-
-/**
- * @brief     link disable_irq function
- * @param[in] HANDLE pointer to a ds18b20 handle structure
- * @param[in] FUC pointer to a disable_irq function address
- * @note      none
- */
-#define DRIVER_DS18B20_LINK_DISABLE_IRQ(HANDLE, FUC) (HANDLE)->disable_irq = FUC
-
-/**
- * @brief     link debug_print function
- * @param[in] HANDLE pointer to a ds18b20 handle structure
- * @param[in] FUC pointer to a debug_print function address
- * @note      none
- */
-#define DRIVER_DS18B20_LINK_DEBUG_PRINT(HANDLE, FUC) (HANDLE)->debug_print = FUC
+#define DRIVER_DS18B20_LINK_BUS(HANDLE, BUS)         (HANDLE)->bus = BUS
 
 /**
  * @}
@@ -288,6 +270,45 @@ uint8_t ds18b20_deinit(ds18b20_handle_t *handle);
  */
 uint8_t ds18b20_read(ds18b20_handle_t *handle, int16_t *raw, float *temp);
 
+/**
+ * @brief     start a temperature conversion without waiting for it
+ * @param[in] *handle pointer to a ds18b20 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      in skip rom mode every chip on the bus converts at once
+ */
+uint8_t ds18b20_start_conversion(ds18b20_handle_t *handle);
+
+/**
+ * @brief     wait for the conversions running on the handle's bus
+ * @param[in] *handle pointer to a ds18b20 handle structure
+ * @param[in] sleep_ms time to sleep before polling, 0 to poll at once
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed or timed out
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      polls for up to 1 s in total
+ */
+uint8_t ds18b20_wait_conversion(ds18b20_handle_t *handle, uint32_t sleep_ms);
+
+/**
+ * @brief      read the result of a finished conversion
+ * @param[in]  *handle pointer to a ds18b20 handle structure
+ * @param[out] *raw pointer to a raw adc buffer
+ * @param[out] *temp pointer to a converted temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the handle must be in match rom mode when the bus has several chips
+ */
+uint8_t ds18b20_read_converted(ds18b20_handle_t *handle, int16_t *raw, float *temp);
+
 /**
  * @brief     set the chip mode
  * @param[in] *handle pointer to a ds18b20 handle structure
@@ -312,6 +333,19 @@ uint8_t ds18b20_set_mode(ds18b20_handle_t *handle, ds18b20_mode_t mode);
  */
 uint8_t ds18b20_get_mode(ds18b20_handle_t *handle, ds18b20_mode_t *mode);
 
+/**
+ * @brief      get the presence pulse width of the last reset
+ * @param[in]  *handle pointer to a ds18b20 handle structure
+ * @param[out] *width_us pointer to a width buffer in us
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       exact with a bus_reset op, counted in poll iterations otherwise;
+ *             several chips on a bus answer with one combined pulse
+ */
+uint8_t ds18b20_get_presence_width(ds18b20_handle_t *handle, uint8_t *width_us);
+
 /**
  * @brief     set the handle rom
  * @param[in] *handle pointer to a ds18b20 handle structure
@@ -475,6 +509,19 @@ uint8_t ds18b20_search_rom(ds18b20_handle_t *handle, uint8_t (*rom)[8], uint8_t
  */
 uint8_t ds18b20_search_alarm(ds18b20_handle_t *handle, uint8_t (*rom)[8], uint8_t *num);
 
+/**
+ * @brief      verify that the chip in the handle's rom is on the bus
+ * @param[in]  *handle pointer to a ds18b20 handle structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 chip not found
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       one search pass steered along the rom: 64 search steps and no
+ *             conversion, a cheap probe for a chip that stopped answering
+ */
+uint8_t ds18b20_verify_rom(ds18b20_handle_t *handle);
+
 /**
  * @brief      get the power mode
  * @param[in]  *handle pointer to a ds18b20 handle structure
@@ -23,7 +23,7 @@
  * SOFTWARE.
  *
  * @file      driver_ds18b20_dual.h
- * @brief     DS18B20 dual-sensor driver (hard-coded ROMs)
+ * @brief     DS18B20 driver for the fixed sensor set in topology.h
  * @version   2.1.0
  * @date      2025-07-29
  * @author    Wiktor Stojek
@@ -38,25 +38,122 @@
 extern "C" {
 #endif
 
-/** Number of sensors on shared bus */
-#define DS18B20_DUAL_MAX_SENSORS 2
+/** Number of sensors, over all buses */
+#define DS18B20_DUAL_MAX_SENSORS TOPOLOGY_SENSOR_COUNT
+
+/** Consecutive failed reads that put a sensor, or failed conversions that put a bus, in quarantine */
+#ifndef DS18B20_DUAL_QUARANTINE_FAILS
+#define DS18B20_DUAL_QUARANTINE_FAILS   3
+#endif
+
+/** Longest quarantine: 2^shift read cycles sat out between probes, at most 7 */
+#ifndef DS18B20_DUAL_BACKOFF_MAX_SHIFT
+#define DS18B20_DUAL_BACKOFF_MAX_SHIFT  6
+#endif
+
+/**
+ * Cores the bus work is spread over. With 2, every core runs a pinned bus owner
+ * task for its group of buses, so two buses are bit-banged at once; needs
+ * OW_TRACE_ENABLE 0, the trace ring has a single producer
+ */
+#ifndef DS18B20_DUAL_CORES
+#define DS18B20_DUAL_CORES              1
+#endif
+
+/** Core whose bus owner drives topology bus b */
+#ifndef DS18B20_DUAL_BUS_CORE
+#define DS18B20_DUAL_BUS_CORE(b)        ((b) % DS18B20_DUAL_CORES)
+#endif
 
 /**
- * @brief  Initialize both sensors with hard-coded ROMs
- * @return 0 on success, 1 on failure
+ * Bus owner priority; with configRUN_MULTIPLE_PRIORITIES 0 both owners only run
+ * together when no task of a higher priority is ready
+ */
+#ifndef DS18B20_DUAL_OWNER_PRIO
+#define DS18B20_DUAL_OWNER_PRIO         (tskIDLE_PRIORITY + 1)
+#endif
+
+/** Bus owner stack, in words */
+#ifndef DS18B20_DUAL_OWNER_STACK
+#define DS18B20_DUAL_OWNER_STACK        1024
+#endif
+
+/**
+ * @brief Per-sensor result of ds18b20_dual_read_status()
+ */
+typedef enum {
+    DS18B20_DUAL_OK          = 0,   /**< fresh reading */
+    DS18B20_DUAL_FAILED      = 1,   /**< read or probe failed this cycle */
+    DS18B20_DUAL_QUARANTINED = 2,   /**< sat out, waiting for its next probe */
+    DS18B20_DUAL_BUS_FAILED  = 3,   /**< its bus did not convert or is quarantined */
+} ds18b20_dual_status_t;
+
+/**
+ * @brief     Share the buses with another user, such as flash erase and program
+ * @param[in] lock   Called before each bus phase and before the init's bus traffic, NULL for none
+ * @param[in] unlock Called after it
+ * @note      a read cycle holds the lock over the conversion start and over
+ *            the poll and reads, not over the conversion sleep between them;
+ *            set it before ds18b20_dual_init()
+ */
+void ds18b20_dual_set_bus_lock(void (*lock)(void), void (*unlock)(void));
+
+/**
+ * @brief  Initialize every bus and sensor listed in topology.h
+ * @note   with DS18B20_DUAL_CORES 2 this also starts the bus owner tasks,
+ *         so the scheduler must be running
+ * @note   a bus or sensor that fails here starts out quarantined and gets
+ *         its init retried each time its quarantine is up
+ * @return 0 on success, 1 if no bus came up
  */
 uint8_t ds18b20_dual_init(void);
 
 /**
- * @brief      Read temperatures from both sensors
+ * @brief      Read temperatures from all sensors
  * @param[out] temps Array of length DS18B20_DUAL_MAX_SENSORS for °C values
- * @return     0 on success, 1 on failure
+ * @return     0 on success, 1 when any sensor has no fresh reading
  */
 uint8_t ds18b20_dual_read(float temps[DS18B20_DUAL_MAX_SENSORS]);
 
 /**
- * @brief  Deinitialize sensors and release bus
- * @return 0 on success, 1 on failure
+ * @brief      Read raw register values and temperatures from all sensors
+ * @note       every bus converts at once, then each sensor is read by rom
+ * @param[out] raw   Array of length DS18B20_DUAL_MAX_SENSORS for raw readings
+ * @param[out] temps Array of length DS18B20_DUAL_MAX_SENSORS for °C values
+ * @return     0 on success, 1 when any sensor has no fresh reading
+ */
+uint8_t ds18b20_dual_read_raw(int16_t raw[DS18B20_DUAL_MAX_SENSORS],
+                              float temps[DS18B20_DUAL_MAX_SENSORS]);
+
+/**
+ * @brief      Read every sensor, keeping the readings of the ones that answered
+ * @note       a sensor or bus failing DS18B20_DUAL_QUARANTINE_FAILS times in a
+ *             row sits out 1, 2, 4... cycles; a quarantined sensor is then
+ *             probed with ds18b20_verify_rom() and read only if it answers,
+ *             a quarantined bus just tries its conversion again
+ * @param[out] raw    Array of length DS18B20_DUAL_MAX_SENSORS, written for DS18B20_DUAL_OK sensors
+ * @param[out] temps  Array of length DS18B20_DUAL_MAX_SENSORS, written for DS18B20_DUAL_OK sensors
+ * @param[out] status Array of length DS18B20_DUAL_MAX_SENSORS for ds18b20_dual_status_t
+ * @return     0 when every sensor has a fresh reading, 1 otherwise
+ */
+uint8_t ds18b20_dual_read_status(int16_t raw[DS18B20_DUAL_MAX_SENSORS],
+                                 float temps[DS18B20_DUAL_MAX_SENSORS],
+                                 uint8_t status[DS18B20_DUAL_MAX_SENSORS]);
+
+/**
+ * @brief Print the failure count and quarantine state of every sensor and bus
+ */
+void ds18b20_dual_print_health(void);
+
+/**
+ * @brief Print the slot timing profile, CRC error rate, last presence pulse and critical
+ *        section times of every bus, then the sensor reads and bus time of every core
+ */
+void ds18b20_dual_print_timing(void);
+
+/**
+ * @brief  Deinitialize sensors and release every bus once
+ * @return 0 on success, 1 when a bus failed to release
  */
 uint8_t ds18b20_dual_deinit(void);
 
@@ -39,6 +39,7 @@
 #define DRIVER_DS18B20_INTERFACE_H
 
 #include "driver_ds18b20.h"
+#include "topology.h"
 
 #ifdef __cplusplus
 extern "C"{
@@ -51,44 +52,6 @@ extern "C"{
  * @{
  */
 
-/**
- * @brief  interface bus init
- * @return status code
- *         - 0 success
- *         - 1 bus init failed
- * @note   none
- */
-uint8_t ds18b20_interface_init(void);
-
-/**
- * @brief  interface bus deinit
- * @return status code
- *         - 0 success
- *         - 1 bus deinit failed
- * @note   none
- */
-uint8_t ds18b20_interface_deinit(void);
-
-/**
- * @brief      interface bus read
- * @param[out] *value pointer to a value buffer
- * @return     status code
- *             - 0 success
- *             - 1 read failed
- * @note       none
- */
-uint8_t ds18b20_interface_read(uint8_t *value);
-
-/**
- * @brief     interface bus write
- * @param[in] value written value
- * @return    status code
- *            - 0 success
- *            - 1 write failed
- * @note      none
- */
-uint8_t ds18b20_interface_write(uint8_t value);
-
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -104,16 +67,24 @@ void ds18b20_interface_delay_ms(uint32_t ms);
 void ds18b20_interface_delay_us(uint32_t us);
 
 /**
- * @brief interface enable the interrupt
- * @note  none
+ * @brief interface bus critical section statistics structure definition
  */
-void ds18b20_interface_enable_irq(void);
+typedef struct ds18b20_interface_lock_stats_s
+{
+    uint32_t sections;        /**< critical sections entered */
+    uint32_t max_us;          /**< longest time with interrupts off */
+    uint32_t total_us;        /**< time with interrupts off, wraps after 71 minutes */
+} ds18b20_interface_lock_stats_t;
 
 /**
- * @brief interface disable the interrupt
- * @note  none
+ * @brief      interface get the critical section statistics of one bus
+ * @param[in]  bus topology_bus_t
+ * @param[out] *stats pointer to a statistics buffer
+ * @note       a bus critical section masks interrupts on the calling core only
+ *             and takes the bus's hardware spinlock, the other core runs on;
+ *             all zero for a bus timed by the UART or a bridge
  */
-void ds18b20_interface_disable_irq(void);
+void ds18b20_interface_lock_stats(uint8_t bus, ds18b20_interface_lock_stats_t *stats);
 
 /**
  * @brief     interface print format data
@@ -122,6 +93,28 @@ void ds18b20_interface_disable_irq(void);
  */
 void ds18b20_interface_debug_print(const char *const fmt, ...);
 
+/**
+ * @brief      interface measure rise time and presence timing of one bus
+ * @param[in]  bus topology_bus_t
+ * @param[out] *rise_ns release to logic high
+ * @param[out] *presence_delay_us release after a reset pulse to presence start
+ * @param[out] *presence_width_us presence pulse width
+ * @return     status code
+ *             - 0 success
+ *             - 1 no presence or no GPIO slots on this bus
+ * @note       the caller must own the bus
+ */
+uint8_t ds18b20_interface_measure(uint8_t bus, uint32_t *rise_ns,
+                                  uint32_t *presence_delay_us, uint32_t *presence_width_us);
+
+/**
+ * @brief bus operations tables, indexed by topology_bus_t
+ * @note  each bus has its own init, deinit, read, write and critical section
+ *        on the GPIO from topology.h and shares the delay and print functions
+ *        above; link a table to every handle on its bus with DRIVER_DS18B20_LINK_BUS
+ */
+extern const ds18b20_bus_t gc_ds18b20_interface_buses[TOPOLOGY_BUS_COUNT];
+
 /**
  * @}
  */
@@ -0,0 +1,418 @@
+/**
+ * @file      driver_nrf24l01.h
+ * @brief     nRF24L01+ register-level driver (handle + linked bus functions)
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DRIVER_NRF24L01_H
+#define DRIVER_NRF24L01_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup nrf24l01_driver nrf24l01 driver function
+ * @brief    nrf24l01 driver modules
+ * @{
+ */
+
+/**
+ * @brief nrf24l01 max payload size definition
+ */
+#define NRF24L01_MAX_PAYLOAD        32        /**< hardware payload limit in bytes */
+
+/**
+ * @brief nrf24l01 fifo depth definition
+ */
+#define NRF24L01_FIFO_DEPTH         3         /**< tx and rx fifo depth in payloads */
+
+/**
+ * @brief nrf24l01 address width definition
+ */
+#define NRF24L01_ADDR_WIDTH         5         /**< address width in bytes */
+
+/**
+ * @brief nrf24l01 status register bit definition
+ */
+#define NRF24L01_STATUS_RX_DR       (1 << 6)        /**< data ready rx fifo interrupt */
+#define NRF24L01_STATUS_TX_DS       (1 << 5)        /**< data sent tx fifo interrupt */
+#define NRF24L01_STATUS_MAX_RT      (1 << 4)        /**< maximum number of tx retransmits interrupt */
+#define NRF24L01_STATUS_TX_FULL     (1 << 0)        /**< tx fifo full flag */
+#define NRF24L01_STATUS_IRQ_MASK    (NRF24L01_STATUS_RX_DR | NRF24L01_STATUS_TX_DS | NRF24L01_STATUS_MAX_RT)
+
+/**
+ * @brief nrf24l01 fifo status register bit definition
+ */
+#define NRF24L01_FIFO_TX_FULL       (1 << 5)        /**< tx fifo full */
+#define NRF24L01_FIFO_TX_EMPTY      (1 << 4)        /**< tx fifo empty */
+#define NRF24L01_FIFO_RX_FULL       (1 << 1)        /**< rx fifo full */
+#define NRF24L01_FIFO_RX_EMPTY      (1 << 0)        /**< rx fifo empty */
+
+/**
+ * @brief nrf24l01 mode enumeration definition
+ */
+typedef enum
+{
+    NRF24L01_MODE_POWER_DOWN = 0x00,        /**< power down, registers retained */
+    NRF24L01_MODE_STANDBY    = 0x01,        /**< standby-I, ce low */
+    NRF24L01_MODE_TX         = 0x02,        /**< primary transmitter */
+    NRF24L01_MODE_RX         = 0x03,        /**< primary receiver, ce high */
+} nrf24l01_mode_t;
+
+/**
+ * @brief nrf24l01 air data rate enumeration definition
+ */
+typedef enum
+{
+    NRF24L01_DATA_RATE_1M   = 0x00,        /**< 1 Mbps */
+    NRF24L01_DATA_RATE_2M   = 0x08,        /**< 2 Mbps */
+    NRF24L01_DATA_RATE_250K = 0x20,        /**< 250 kbps */
+} nrf24l01_data_rate_t;
+
+/**
+ * @brief nrf24l01 rf output power enumeration definition
+ */
+typedef enum
+{
+    NRF24L01_POWER_MINUS_18_DBM = 0x00,        /**< -18 dBm */
+    NRF24L01_POWER_MINUS_12_DBM = 0x02,        /**< -12 dBm */
+    NRF24L01_POWER_MINUS_6_DBM  = 0x04,        /**< -6 dBm */
+    NRF24L01_POWER_0_DBM        = 0x06,        /**< 0 dBm */
+} nrf24l01_power_t;
+
+/**
+ * @brief nrf24l01 configuration structure definition
+ */
+typedef struct nrf24l01_config_s
+{
+    uint8_t channel;                        /**< rf channel 0 - 125 */
+    nrf24l01_data_rate_t data_rate;         /**< air data rate */
+    nrf24l01_power_t power;                 /**< rf output power */
+    uint8_t retransmit_delay;               /**< auto retransmit delay, (n + 1) * 250 us, 0 - 15 */
+    uint8_t retransmit_count;               /**< auto retransmit count, 0 - 15 */
+} nrf24l01_config_t;
+
+/**
+ * @brief nrf24l01 handle structure definition
+ */
+typedef struct nrf24l01_handle_s
+{
+    uint8_t (*spi_init)(void);                                              /**< point to a spi_init function address */
+    uint8_t (*spi_deinit)(void);                                            /**< point to a spi_deinit function address */
+    uint8_t (*spi_transfer)(const uint8_t *tx, uint8_t *rx, uint16_t len);  /**< point to a csn-framed spi_transfer function address */
+    uint8_t (*ce_write)(uint8_t level);                                     /**< point to a ce_write function address */
+    void (*delay_ms)(uint32_t ms);                                          /**< point to a delay_ms function address */
+    void (*delay_us)(uint32_t us);                                          /**< point to a delay_us function address */
+    void (*debug_print)(const char *const fmt, ...);                        /**< point to a debug_print function address */
+    uint8_t inited;                                                         /**< inited flag */
+    uint8_t config;                                                         /**< shadow of the config register */
+} nrf24l01_handle_t;
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup nrf24l01_link_driver nrf24l01 link driver function
+ * @brief    nrf24l01 link driver modules
+ * @ingroup  nrf24l01_driver
+ * @{
+ */
+
+/**
+ * @brief     initialize nrf24l01_handle_t structure
+ * @param[in] HANDLE pointer to an nrf24l01 handle structure
+ * @param[in] STRUCTURE nrf24l01_handle_t
+ * @note      none
+ */
+#define DRIVER_NRF24L01_LINK_INIT(HANDLE, STRUCTURE)      memset(HANDLE, 0, sizeof(STRUCTURE))
+
+/**
+ * @brief     link spi_init function
+ * @param[in] HANDLE pointer to an nrf24l01 handle structure
+ * @param[in] FUC pointer to a spi_init function address
+ * @note      none
+ */
+#define DRIVER_NRF24L01_LINK_SPI_INIT(HANDLE, FUC)        (HANDLE)->spi_init = FUC
+
+/**
+ * @brief     link spi_deinit function
+ * @param[in] HANDLE pointer to an nrf24l01 handle structure
+ * @param[in] FUC pointer to a spi_deinit function address
+ * @note      none
+ */
+#define DRIVER_NRF24L01_LINK_SPI_DEINIT(HANDLE, FUC)      (HANDLE)->spi_deinit = FUC
+
+/**
+ * @brief     link spi_transfer function
+ * @param[in] HANDLE pointer to an nrf24l01 handle structure
+ * @param[in] FUC pointer to a spi_transfer function address
+ * @note      none
+ */
+#define DRIVER_NRF24L01_LINK_SPI_TRANSFER(HANDLE, FUC)    (HANDLE)->spi_transfer = FUC
+
+/**
+ * @brief     link ce_write function
+ * @param[in] HANDLE pointer to an nrf24l01 handle structure
+ * @param[in] FUC pointer to a ce_write function address
+ * @note      none
+ */
+#define DRIVER_NRF24L01_LINK_CE_WRITE(HANDLE, FUC)        (HANDLE)->ce_write = FUC
+
+/**
+ * @brief     link delay_ms function
+ * @param[in] HANDLE pointer to an nrf24l01 handle structure
+ * @param[in] FUC pointer to a delay_ms function address
+ * @note      none
+ */
+#define DRIVER_NRF24L01_LINK_DELAY_MS(HANDLE, FUC)        (HANDLE)->delay_ms = FUC
+
+/**
+ * @brief     link delay_us function
+ * @param[in] HANDLE pointer to an nrf24l01 handle structure
+ * @param[in] FUC pointer to a delay_us function address
+ * @note      none
+ */
+#define DRIVER_NRF24L01_LINK_DELAY_US(HANDLE, FUC)        (HANDLE)->delay_us = FUC
+
+/**
+ * @brief     link debug_print function
+ * @param[in] HANDLE pointer to an nrf24l01 handle structure
+ * @param[in] FUC pointer to a debug_print function address
+ * @note      none
+ */
+#define DRIVER_NRF24L01_LINK_DEBUG_PRINT(HANDLE, FUC)     (HANDLE)->debug_print = FUC
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup nrf24l01_base_driver nrf24l01 base driver function
+ * @brief    nrf24l01 base driver modules
+ * @ingroup  nrf24l01_driver
+ * @{
+ */
+
+/**
+ * @brief     initialize the chip
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 chip not responding
+ * @note      leaves the chip powered down with both fifos flushed
+ */
+uint8_t nrf24l01_init(nrf24l01_handle_t *handle);
+
+/**
+ * @brief     close the chip
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t nrf24l01_deinit(nrf24l01_handle_t *handle);
+
+/**
+ * @brief     apply the rf configuration
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @param[in] *config pointer to a configuration structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 configure failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      enables 16 bit crc, dynamic payload length, payload with ack and no-ack transmit
+ */
+uint8_t nrf24l01_configure(nrf24l01_handle_t *handle, const nrf24l01_config_t *config);
+
+/**
+ * @brief     set the transmit address
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @param[in] *addr pointer to a NRF24L01_ADDR_WIDTH byte address
+ * @return    status code
+ *            - 0 success
+ *            - 1 set tx address failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      pipe 0 receive address is set to the same value so auto ack works
+ */
+uint8_t nrf24l01_set_tx_address(nrf24l01_handle_t *handle, const uint8_t addr[NRF24L01_ADDR_WIDTH]);
+
+/**
+ * @brief     set and enable a receive pipe address
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @param[in] pipe pipe number 0 - 5
+ * @param[in] *addr pointer to the address, pipes 2 - 5 only use addr[0]
+ * @return    status code
+ *            - 0 success
+ *            - 1 set rx address failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 pipe is invalid
+ * @note      pipes 2 - 5 share bytes 1 - 4 with pipe 1
+ */
+uint8_t nrf24l01_set_rx_address(nrf24l01_handle_t *handle, uint8_t pipe, const uint8_t addr[NRF24L01_ADDR_WIDTH]);
+
+/**
+ * @brief     set the chip mode
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @param[in] mode chip mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 set mode failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      waits the power up time when leaving power down
+ */
+uint8_t nrf24l01_set_mode(nrf24l01_handle_t *handle, nrf24l01_mode_t mode);
+
+/**
+ * @brief     drive the ce line
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @param[in] level 0 or 1
+ * @return    status code
+ *            - 0 success
+ *            - 1 ce write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      in tx mode the chip sends the whole tx fifo while ce is high
+ */
+uint8_t nrf24l01_set_ce(nrf24l01_handle_t *handle, uint8_t level);
+
+/**
+ * @brief     write one payload to the tx fifo
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @param[in] *buf pointer to a payload buffer
+ * @param[in] len payload length 1 - NRF24L01_MAX_PAYLOAD
+ * @param[in] ack 1 to request an ack, 0 for a no-ack payload
+ * @return    status code
+ *            - 0 success
+ *            - 1 write payload failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 length is invalid
+ * @note      none
+ */
+uint8_t nrf24l01_write_tx_payload(nrf24l01_handle_t *handle, const uint8_t *buf, uint8_t len, uint8_t ack);
+
+/**
+ * @brief      read the oldest payload from the rx fifo
+ * @param[in]  *handle pointer to an nrf24l01 handle structure
+ * @param[out] *buf pointer to a NRF24L01_MAX_PAYLOAD byte buffer
+ * @param[out] *len pointer to a payload length buffer
+ * @param[out] *pipe pointer to a pipe number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read payload failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 rx fifo is empty
+ * @note       corrupt payload widths flush the rx fifo and return 1
+ */
+uint8_t nrf24l01_read_rx_payload(nrf24l01_handle_t *handle, uint8_t *buf, uint8_t *len, uint8_t *pipe);
+
+/**
+ * @brief      get the status register
+ * @param[in]  *handle pointer to an nrf24l01 handle structure
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get status failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t nrf24l01_get_status(nrf24l01_handle_t *handle, uint8_t *status);
+
+/**
+ * @brief      get the fifo status register
+ * @param[in]  *handle pointer to an nrf24l01 handle structure
+ * @param[out] *fifo pointer to a fifo status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get fifo status failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t nrf24l01_get_fifo_status(nrf24l01_handle_t *handle, uint8_t *fifo);
+
+/**
+ * @brief     clear interrupt flags
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @param[in] mask NRF24L01_STATUS_* interrupt bits to clear
+ * @return    status code
+ *            - 0 success
+ *            - 1 clear irq failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t nrf24l01_clear_irq(nrf24l01_handle_t *handle, uint8_t mask);
+
+/**
+ * @brief     flush the tx fifo
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t nrf24l01_flush_tx(nrf24l01_handle_t *handle);
+
+/**
+ * @brief     flush the rx fifo
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t nrf24l01_flush_rx(nrf24l01_handle_t *handle);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,123 @@
+/**
+ * @file      driver_nrf24l01_interface.h
+ * @brief     nRF24L01+ interface for the Raspberry Pi Pico (SPI, CE, IRQ)
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DRIVER_NRF24L01_INTERFACE_H
+#define DRIVER_NRF24L01_INTERFACE_H
+
+#include "driver_nrf24l01.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup nrf24l01_interface_driver nrf24l01 interface driver function
+ * @brief    nrf24l01 interface driver modules
+ * @ingroup  nrf24l01_driver
+ * @{
+ */
+
+/**
+ * @brief  interface spi init
+ * @return status code
+ *         - 0 success
+ *         - 1 spi init failed
+ * @note   also configures the csn and ce lines
+ */
+uint8_t nrf24l01_interface_spi_init(void);
+
+/**
+ * @brief  interface spi deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 spi deinit failed
+ * @note   none
+ */
+uint8_t nrf24l01_interface_spi_deinit(void);
+
+/**
+ * @brief      interface spi transfer framed by csn
+ * @param[in]  *tx pointer to a transmit buffer
+ * @param[out] *rx pointer to a receive buffer
+ * @param[in]  len transfer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 transfer failed
+ * @note       none
+ */
+uint8_t nrf24l01_interface_spi_transfer(const uint8_t *tx, uint8_t *rx, uint16_t len);
+
+/**
+ * @brief     interface ce write
+ * @param[in] level ce level
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t nrf24l01_interface_ce_write(uint8_t level);
+
+/**
+ * @brief     interface delay ms
+ * @param[in] ms time
+ * @note      none
+ */
+void nrf24l01_interface_delay_ms(uint32_t ms);
+
+/**
+ * @brief     interface delay us
+ * @param[in] us time
+ * @note      none
+ */
+void nrf24l01_interface_delay_us(uint32_t us);
+
+/**
+ * @brief     interface print format data
+ * @param[in] fmt format data
+ * @note      none
+ */
+void nrf24l01_interface_debug_print(const char *const fmt, ...);
+
+/**
+ * @brief     interface irq init
+ * @param[in] *callback function called from the irq line falling edge interrupt
+ * @return    status code
+ *            - 0 success
+ *            - 1 irq init failed
+ * @note      the callback runs in interrupt context
+ */
+uint8_t nrf24l01_interface_irq_init(void (*callback)(void));
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
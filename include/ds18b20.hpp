@@ -0,0 +1,433 @@
+/**
+ * @file      ds18b20.hpp
+ * @brief     DS18B20 driver templated on a compile-time bus policy
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS18B20_HPP
+#define DS18B20_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @defgroup ds18b20_template ds18b20 template driver
+ * @brief    ds18b20 driver with the bus resolved at compile time
+ *
+ * Same commands, timings, crc and decoding as driver_ds18b20.c, but the bus is
+ * a policy class instead of the function pointers in ds18b20_bus_t, so the slot
+ * primitives inline into the byte loops. A bus policy provides:
+ *
+ * @code
+ * struct bus
+ * {
+ *     static uint8_t init();                  // 0 ok
+ *     static void deinit();
+ *     static void low();                      // drive the line low
+ *     static void release();                  // let the pull-up take it high
+ *     static uint8_t sample();                // 0 low, 1 high
+ *     static void delay_us(uint32_t us);      // busy wait
+ *     static void delay_ms(uint32_t ms);      // may sleep
+ *     static void lock();                     // enter the slot critical section
+ *     static void unlock();
+ * };
+ * @endcode
+ *
+ * ds18b20_gpio.hpp has the bit-bang policy for the Pico.
+ * @{
+ */
+
+namespace ds18b20
+{
+
+/**
+ * @brief slot timings of driver_ds18b20.c, in us
+ */
+struct standard_timing
+{
+    static constexpr uint32_t reset_low_us = 750;       /**< reset pulse */
+    static constexpr uint32_t presence_wait_us = 15;    /**< release to first presence sample */
+    static constexpr uint32_t presence_max_us = 200;    /**< presence must start within */
+    static constexpr uint32_t presence_end_us = 240;    /**< presence must end within */
+    static constexpr uint32_t write1_low_us = 2;        /**< write 1 low time */
+    static constexpr uint32_t write1_high_us = 60;      /**< write 1 recovery */
+    static constexpr uint32_t write0_low_us = 60;       /**< write 0 low time */
+    static constexpr uint32_t write0_high_us = 2;       /**< write 0 recovery */
+    static constexpr uint32_t read_low_us = 2;          /**< read slot start */
+    static constexpr uint32_t read_sample_us = 12;      /**< release to sample */
+    static constexpr uint32_t read_high_us = 50;        /**< read recovery */
+};
+
+/**
+ * @brief ds18b20 commands
+ */
+enum : uint8_t
+{
+    cmd_match_rom = 0x55,
+    cmd_skip_rom = 0xCC,
+    cmd_convert_t = 0x44,
+    cmd_read_scratchpad = 0xBE,
+};
+
+/**
+ * @brief     dallas crc8, same result as gc_ds18b20_crc_table
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    crc
+ */
+constexpr uint8_t crc8(const uint8_t *buf, size_t len)
+{
+    uint8_t crc = 0;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        crc = crc ^ buf[i];
+        for (int b = 0; b < 8; b++)
+        {
+            crc = (crc & 0x01) ? (uint8_t)((crc >> 1) ^ 0x8C) : (uint8_t)(crc >> 1);
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * @brief max conversion time in ms, indexed by resolution
+ */
+constexpr uint16_t conversion_ms(uint8_t resolution)
+{
+    constexpr uint16_t ms[4] = {94, 188, 375, 750};
+
+    return ms[resolution & 0x03];
+}
+
+/**
+ * @brief      decode the temperature registers
+ * @param[in]  lsb scratchpad byte 0
+ * @param[in]  msb scratchpad byte 1
+ * @param[in]  resolution scratchpad byte 4 bits 5..6
+ * @param[out] *raw raw value in steps of the resolution
+ * @return     temperature in degrees
+ */
+inline float decode(uint8_t lsb, uint8_t msb, uint8_t resolution, int16_t *raw)
+{
+    uint8_t shift = (uint8_t)(3 - (resolution & 0x03));
+
+    *raw = (int16_t)((int16_t)(((uint16_t)msb << 8) | lsb) >> shift);      /* sign extending shift */
+
+    return (float)(*raw) * (0.0625f * (float)(1 << shift));
+}
+
+/**
+ * @brief one sensor on a bus given by the Bus policy
+ */
+template <class Bus, class Timing = standard_timing>
+class sensor
+{
+  public:
+    /**
+     * @brief     set the rom used for match rom
+     * @param[in] *rom 8 rom bytes, nullptr for skip rom
+     */
+    void set_rom(const uint8_t *rom)
+    {
+        m_match = (rom != nullptr);
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            m_rom[i] = m_match ? rom[i] : 0;
+        }
+    }
+
+    /**
+     * @brief  initialize the bus and check for presence
+     * @return status code
+     *         - 0 success
+     *         - 1 bus initialization failed
+     *         - 4 reset failed
+     */
+    uint8_t init()
+    {
+        if (Bus::init() != 0)
+        {
+            return 1;
+        }
+        if (reset() != 0)
+        {
+            Bus::deinit();
+
+            return 4;
+        }
+        m_resolution = 0x03;                        /* power-on default */
+        m_inited = 1;
+
+        return 0;
+    }
+
+    /**
+     * @brief close the bus
+     */
+    void deinit()
+    {
+        Bus::deinit();
+        m_inited = 0;
+    }
+
+    /**
+     * @brief  start a conversion on this sensor
+     * @return status code
+     *         - 0 success
+     *         - 1 failed
+     *         - 3 not initialized
+     */
+    uint8_t start_conversion()
+    {
+        if (m_inited != 1)
+        {
+            return 3;
+        }
+
+        return (select() != 0 || write_byte(cmd_convert_t) != 0) ? 1 : 0;
+    }
+
+    /**
+     * @brief  wait for the conversion started by start_conversion
+     * @return status code
+     *         - 0 success
+     *         - 1 timeout
+     * @note   sleeps 3/4 of the max time, then polls every 10 ms within 1 s
+     */
+    uint8_t wait_conversion()
+    {
+        uint32_t sleep_ms = conversion_ms(m_resolution);
+
+        sleep_ms = sleep_ms - sleep_ms / 4;
+        Bus::delay_ms(sleep_ms);
+        for (uint32_t cnt = 0; cnt < (1000 - sleep_ms) / 10; cnt++)
+        {
+            Bus::lock();
+            uint8_t done = read_bit();
+            Bus::unlock();
+            if (done != 0)
+            {
+                return 0;
+            }
+            Bus::delay_ms(10);
+        }
+
+        return 1;
+    }
+
+    /**
+     * @brief      read and check the scratchpad
+     * @param[out] *buf 9 bytes
+     * @return     status code
+     *             - 0 success
+     *             - 1 failed or crc error
+     *             - 3 not initialized
+     */
+    uint8_t read_scratchpad(uint8_t buf[9])
+    {
+        if (m_inited != 1)
+        {
+            return 3;
+        }
+        if (select() != 0 || write_byte(cmd_read_scratchpad) != 0)
+        {
+            return 1;
+        }
+        for (uint8_t i = 0; i < 9; i++)
+        {
+            buf[i] = read_byte();
+        }
+        if (crc8(buf, 8) != buf[8])
+        {
+            return 1;
+        }
+        m_resolution = (buf[4] >> 5) & 0x03;
+
+        return 0;
+    }
+
+    /**
+     * @brief      convert and read the temperature, as ds18b20_read
+     * @param[out] *raw raw value in steps of the resolution
+     * @param[out] *temp temperature in degrees
+     * @return     status code
+     *             - 0 success
+     *             - 1 failed
+     *             - 3 not initialized
+     */
+    uint8_t read(int16_t *raw, float *temp)
+    {
+        uint8_t buf[9];
+        uint8_t res;
+
+        res = start_conversion();
+        if (res != 0)
+        {
+            return res;
+        }
+        if (wait_conversion() != 0)
+        {
+            return 1;
+        }
+        res = read_scratchpad(buf);
+        if (res != 0)
+        {
+            return res;
+        }
+        *temp = decode(buf[0], buf[1], m_resolution, raw);
+
+        return 0;
+    }
+
+    /**
+     * @brief  reset the bus
+     * @return status code
+     *         - 0 presence seen
+     *         - 1 no presence or bus stuck low
+     */
+    uint8_t reset()
+    {
+        uint32_t t;
+
+        Bus::lock();
+        Bus::low();
+        Bus::delay_us(Timing::reset_low_us);
+        Bus::release();
+        Bus::delay_us(Timing::presence_wait_us);
+        for (t = 0; t < Timing::presence_max_us && Bus::sample() != 0; t++)
+        {
+            Bus::delay_us(1);
+        }
+        if (t >= Timing::presence_max_us)
+        {
+            Bus::unlock();
+
+            return 1;
+        }
+        for (t = 0; t < Timing::presence_end_us && Bus::sample() == 0; t++)
+        {
+            Bus::delay_us(1);
+        }
+        Bus::unlock();
+
+        return (t >= Timing::presence_end_us) ? 1 : 0;
+    }
+
+    /**
+     * @brief     write one byte, lsb first
+     * @param[in] byte written byte
+     * @return    0, kept as a status for symmetry with driver_ds18b20.c
+     */
+    uint8_t write_byte(uint8_t byte)
+    {
+        Bus::lock();
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            write_bit(byte & 0x01);
+            byte = byte >> 1;
+        }
+        Bus::unlock();
+
+        return 0;
+    }
+
+    /**
+     * @brief  read one byte, lsb first
+     * @return byte
+     */
+    uint8_t read_byte()
+    {
+        uint8_t byte = 0;
+
+        Bus::lock();
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            byte = (uint8_t)((read_bit() << 7) | (byte >> 1));
+        }
+        Bus::unlock();
+
+        return byte;
+    }
+
+  private:
+    /**
+     * @brief  reset and address this sensor
+     * @return 0 success, 1 failed
+     */
+    uint8_t select()
+    {
+        if (reset() != 0)
+        {
+            return 1;
+        }
+        if (!m_match)
+        {
+            return write_byte(cmd_skip_rom);
+        }
+        (void)write_byte(cmd_match_rom);
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            (void)write_byte(m_rom[i]);
+        }
+
+        return 0;
+    }
+
+    static inline void write_bit(uint8_t bit)
+    {
+        Bus::low();
+        Bus::delay_us(bit ? Timing::write1_low_us : Timing::write0_low_us);
+        Bus::release();
+        Bus::delay_us(bit ? Timing::write1_high_us : Timing::write0_high_us);
+    }
+
+    static inline uint8_t read_bit()
+    {
+        uint8_t bit;
+
+        Bus::low();
+        Bus::delay_us(Timing::read_low_us);
+        Bus::release();
+        Bus::delay_us(Timing::read_sample_us);
+        bit = Bus::sample();
+        Bus::delay_us(Timing::read_high_us);
+
+        return bit;
+    }
+
+    uint8_t m_rom[8] = {0};             /**< rom for match rom */
+    bool m_match = false;               /**< match rom, else skip rom */
+    uint8_t m_inited = 0;               /**< inited flag */
+    uint8_t m_resolution = 0x03;        /**< last known resolution */
+};
+
+}
+
+/**
+ * @}
+ */
+
+#endif
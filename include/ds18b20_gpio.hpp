@@ -0,0 +1,113 @@
+/**
+ * @file      ds18b20_gpio.hpp
+ * @brief     GPIO bit-bang bus policy for ds18b20.hpp
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS18B20_GPIO_HPP
+#define DS18B20_GPIO_HPP
+
+#include "ds18b20.hpp"
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+namespace ds18b20
+{
+
+/**
+ * @brief open-drain bit-bang on one GPIO with the internal pull-up,
+ *        the same line handling and per-bus critical section as
+ *        driver_ds18b20_interface.c
+ */
+template <uint Pin>
+struct gpio_bus
+{
+    static uint8_t init()
+    {
+        if (s_lock == nullptr)
+        {
+            s_lock = spin_lock_init(static_cast<uint>(spin_lock_claim_unused(true)));
+        }
+        gpio_init(Pin);
+        gpio_set_function(Pin, GPIO_FUNC_SIO);
+        gpio_set_dir(Pin, GPIO_IN);
+        gpio_pull_up(Pin);
+        gpio_put(Pin, 0);                   /* output latch stays low, dir switches */
+
+        return 0;
+    }
+
+    static void deinit()
+    {
+        gpio_disable_pulls(Pin);
+        gpio_set_dir(Pin, GPIO_IN);
+        gpio_deinit(Pin);
+    }
+
+    static inline void low()
+    {
+        gpio_set_dir(Pin, GPIO_OUT);
+    }
+
+    static inline void release()
+    {
+        gpio_set_dir(Pin, GPIO_IN);
+    }
+
+    static inline uint8_t sample()
+    {
+        return gpio_get(Pin) ? 1 : 0;
+    }
+
+    static inline void delay_us(uint32_t us)
+    {
+        busy_wait_us_32(us);
+    }
+
+    static void delay_ms(uint32_t ms)
+    {
+        vTaskDelay(pdMS_TO_TICKS(ms));
+    }
+
+    /* interrupts off on this core only, plus this bus's hardware spinlock */
+    static inline void lock()
+    {
+        s_save = spin_lock_blocking(s_lock);
+    }
+
+    static inline void unlock()
+    {
+        spin_unlock(s_lock, s_save);
+    }
+
+  private:
+    static inline spin_lock_t *s_lock = nullptr;
+    static inline uint32_t s_save = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,280 @@
+/**
+ * @file      ds18b20_sim.hpp
+ * @brief     Simulated 1-Wire bus policy for ds18b20.hpp
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS18B20_SIM_HPP
+#define DS18B20_SIM_HPP
+
+#include "ds18b20.hpp"
+
+namespace ds18b20
+{
+
+/**
+ * @brief one simulated DS18B20 on a simulated open-drain line, in virtual time
+ *
+ * The line is low while the master or the device pulls it. delay_us and
+ * delay_ms only advance the clock. The device decodes each slot from how long
+ * the master held the line low: a reset is at least 480 us, a 1 is under 15 us
+ * and a 0 at least 60 us. A slot between the two can go either way on a real
+ * part, so it is counted in timing_errors. In a read slot the device holds
+ * the line low for 30 us after the falling edge to send a 0.
+ *
+ * Handles skip rom, match rom, convert t and read scratchpad. Id gives each
+ * test bus its own state.
+ */
+template <int Id = 0>
+struct sim_bus
+{
+    /**
+     * @brief simulated device, set by the test before use
+     */
+    struct device_t
+    {
+        bool present = true;                    /**< answers resets */
+        uint8_t rom[8] = {0x28, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x00};
+        int16_t temp = 0x0550;                  /**< power-on 85 degrees, 1/16 steps */
+        uint8_t resolution = 0x03;              /**< config bits 5..6 */
+        uint32_t conversion_us = 400000;        /**< actual conversion time */
+        uint32_t timing_errors = 0;             /**< slots the device could misread */
+        uint32_t slots = 0;                     /**< bit slots seen, resets excluded */
+        uint32_t calls = 0;                     /**< policy calls */
+        uint64_t now_us = 0;                    /**< virtual time */
+    };
+
+    static device_t &device()
+    {
+        return s_dev;
+    }
+
+    static uint8_t init()
+    {
+        s_dev.calls++;
+        s_master_low = false;
+        s_state = state_idle;
+
+        return 0;
+    }
+
+    static void deinit()
+    {
+        s_dev.calls++;
+    }
+
+    static inline void low()
+    {
+        s_dev.calls++;
+        s_master_low = true;
+        s_fall_us = s_dev.now_us;
+        s_drive_until_us = 0;
+        if (s_state == state_tx)
+        {
+            if (((s_tx[s_bit / 8] >> (s_bit % 8)) & 0x01) == 0)
+            {
+                s_drive_until_us = s_fall_us + 30;
+            }
+            s_bit++;
+            if (s_bit >= 72)
+            {
+                s_state = state_idle;
+            }
+        }
+        else if (s_state == state_busy && s_dev.now_us < s_done_us)
+        {
+            s_drive_until_us = s_fall_us + 30;          /* 0 while converting */
+        }
+    }
+
+    static inline void release()
+    {
+        uint64_t held;
+
+        s_dev.calls++;
+        if (!s_master_low)
+        {
+            return;
+        }
+        s_master_low = false;
+        held = s_dev.now_us - s_fall_us;
+        if (held >= 480)
+        {
+            if (s_dev.present)
+            {
+                s_presence_from_us = s_dev.now_us + 30;
+                s_presence_to_us = s_dev.now_us + 150;
+            }
+            s_state = state_rom;
+            s_bit = 0;
+            s_byte = 0;
+
+            return;
+        }
+        s_dev.slots++;
+        if (held >= 15 && held < 60)
+        {
+            s_dev.timing_errors++;
+        }
+        if (s_state != state_rom && s_state != state_match && s_state != state_function)
+        {
+            return;
+        }
+        s_byte = (uint8_t)((s_byte >> 1) | ((held < 15) ? 0x80 : 0x00));
+        if (++s_bit == 8)
+        {
+            s_bit = 0;
+            a_byte(s_byte);
+        }
+    }
+
+    static inline uint8_t sample()
+    {
+        uint64_t t = s_dev.now_us;
+
+        s_dev.calls++;
+        if (s_master_low || t < s_drive_until_us)
+        {
+            return 0;
+        }
+
+        return (t >= s_presence_from_us && t < s_presence_to_us) ? 0 : 1;
+    }
+
+    static inline void delay_us(uint32_t us)
+    {
+        s_dev.calls++;
+        s_dev.now_us += us;
+    }
+
+    static void delay_ms(uint32_t ms)
+    {
+        s_dev.calls++;
+        s_dev.now_us += (uint64_t)ms * 1000;
+    }
+
+    static inline void lock()
+    {
+        s_dev.calls++;
+    }
+
+    static inline void unlock()
+    {
+        s_dev.calls++;
+    }
+
+  private:
+    enum state_t : uint8_t
+    {
+        state_idle,                             /**< wait for a reset */
+        state_rom,                              /**< rom command */
+        state_match,                            /**< rom bytes of match rom */
+        state_function,                         /**< function command */
+        state_busy,                             /**< converting, read slots give the status */
+        state_tx,                               /**< sending the scratchpad */
+    };
+
+    static void a_byte(uint8_t byte)
+    {
+        switch (s_state)
+        {
+            case state_rom :
+            {
+                if (byte == cmd_skip_rom)
+                {
+                    s_state = state_function;
+                }
+                else if (byte == cmd_match_rom)
+                {
+                    s_state = state_match;
+                    s_match = 0;
+                    s_matched = true;
+                }
+                else
+                {
+                    s_state = state_idle;
+                }
+                break;
+            }
+            case state_match :
+            {
+                s_matched = s_matched && (byte == s_dev.rom[s_match]);
+                if (++s_match == 8)
+                {
+                    s_state = s_matched ? state_function : state_idle;
+                }
+                break;
+            }
+            case state_function :
+            {
+                if (byte == cmd_convert_t)
+                {
+                    s_done_us = s_dev.now_us + s_dev.conversion_us;
+                    s_state = state_busy;
+                }
+                else if (byte == cmd_read_scratchpad)
+                {
+                    s_tx[0] = (uint8_t)((uint16_t)s_dev.temp & 0xFF);
+                    s_tx[1] = (uint8_t)((uint16_t)s_dev.temp >> 8);
+                    s_tx[2] = 0x4B;
+                    s_tx[3] = 0x46;
+                    s_tx[4] = (uint8_t)(((s_dev.resolution & 0x03) << 5) | 0x1F);
+                    s_tx[5] = 0xFF;
+                    s_tx[6] = 0x0C;
+                    s_tx[7] = 0x10;
+                    s_tx[8] = crc8(s_tx, 8);
+                    s_state = state_tx;
+                    s_bit = 0;
+                }
+                else
+                {
+                    s_state = state_idle;
+                }
+                break;
+            }
+            default :
+            {
+                break;
+            }
+        }
+    }
+
+    static inline device_t s_dev;
+    static inline bool s_master_low = false;
+    static inline uint64_t s_fall_us = 0;
+    static inline uint64_t s_drive_until_us = 0;
+    static inline uint64_t s_presence_from_us = 0;
+    static inline uint64_t s_presence_to_us = 0;
+    static inline uint64_t s_done_us = 0;
+    static inline state_t s_state = state_idle;
+    static inline uint8_t s_bit = 0;
+    static inline uint8_t s_byte = 0;
+    static inline uint8_t s_match = 0;
+    static inline bool s_matched = false;
+    static inline uint8_t s_tx[9] = {0};
+};
+
+}
+
+#endif
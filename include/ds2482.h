@@ -0,0 +1,132 @@
+/**
+ * @file      ds2482.h
+ * @brief     DS2482-100/800 I2C to 1-Wire bridge
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS2482_H
+#define DS2482_H
+
+#include <stdint.h>
+
+/*
+ * The bridge generates the 1-Wire slots itself, with its active pull-up
+ * driving long cables; the Pico only queues reset, byte, single bit and
+ * triplet commands over I2C and polls the status register, so no critical
+ * section is taken. All channels of one bridge share its I2C port and are
+ * serialized by a mutex.
+ */
+
+/** I2C instance, 0 or 1 */
+#ifndef DS2482_I2C
+#define DS2482_I2C              0
+#endif
+
+/** I2C SDA GPIO */
+#ifndef DS2482_SDA_PIN
+#define DS2482_SDA_PIN          8
+#endif
+
+/** I2C SCL GPIO */
+#ifndef DS2482_SCL_PIN
+#define DS2482_SCL_PIN          9
+#endif
+
+/** I2C clock */
+#ifndef DS2482_I2C_HZ
+#define DS2482_I2C_HZ           400000
+#endif
+
+/** 7-bit address, 0x18 with AD0..AD2 low */
+#ifndef DS2482_ADDR
+#define DS2482_ADDR             0x18
+#endif
+
+/** 1 for a DS2482-100, 8 for a DS2482-800 */
+#ifndef DS2482_CHANNELS
+#define DS2482_CHANNELS         1
+#endif
+
+/** Active pull-up (APU) on the 1-Wire side, for long cables */
+#ifndef DS2482_ACTIVE_PULLUP
+#define DS2482_ACTIVE_PULLUP    1
+#endif
+
+/** Longest 1-Wire command: a reset takes 1.25 ms at standard speed */
+#ifndef DS2482_BUSY_TIMEOUT_US
+#define DS2482_BUSY_TIMEOUT_US  5000
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Bring up the I2C port and reset and configure the bridge
+ * @return 0 on success, 1 when the bridge does not answer
+ * @note   Counted: each bus on the bridge calls it once
+ */
+uint8_t ds2482_init(void);
+
+/**
+ * @brief  Release the I2C port when the last bus is closed
+ * @return 0 on success, 1 when not initialized
+ */
+uint8_t ds2482_deinit(void);
+
+/**
+ * @brief     Reset one channel's bus
+ * @param[in] channel Bridge channel
+ * @return    0 on presence, 1 when no chip answered, 2 on a short or a bridge error
+ */
+uint8_t ds2482_reset(uint8_t channel);
+
+/**
+ * @brief      Run a block of slots, as ds18b20_bus_t bus_touch
+ * @param[in]  channel Bridge channel
+ * @param[in]  tx      Slot values, bit n (lsb first) for slot n; 1 bits double as read slots
+ * @param[out] rx      Sampled values packed the same way, NULL to drop them
+ * @param[in]  slots   Number of slots
+ * @return     0 on success, 1 on a bridge error
+ * @note       Whole 0xFF bytes run as read byte commands, other whole bytes as
+ *             write byte commands and the remaining slots as single bits
+ */
+uint8_t ds2482_touch(uint8_t channel, const uint8_t *tx, uint8_t *rx, uint16_t slots);
+
+/**
+ * @brief      One search step: read a bit and its complement, write a direction
+ * @param[in]  channel   Bridge channel
+ * @param[in]  direction Bit written when both devices answer 0 and 1
+ * @param[out] id_bit    First bit read
+ * @param[out] cmp_bit   Complement read
+ * @param[out] taken     Bit written
+ * @return     0 on success, 1 on a bridge error
+ */
+uint8_t ds2482_triplet(uint8_t channel, uint8_t direction, uint8_t *id_bit, uint8_t *cmp_bit, uint8_t *taken);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,135 @@
+/**
+ * @file      flash_log.h
+ * @brief     Append-only, wear-leveled sample log in a flash partition, written a page at a time
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLASH_LOG_H
+#define FLASH_LOG_H
+
+#include "radio_protocol.h"
+#include "flash_region.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The partition is one circular log of 256-byte pages. Pages are written in
+ * order and a sector is erased only when the head wraps onto it, so every
+ * sector sees the same number of erase cycles. After a reset the head is found
+ * again by scanning page headers for the highest sequence number.
+ *
+ * Page layout (little endian):
+ *
+ *   0..1   magic     FLASH_LOG_MAGIC
+ *   2..5   seq       page sequence number, increments across the whole log
+ *   6..7   len       block length
+ *   8..9   crc16     CRC-16/CCITT-FALSE over the block
+ *   10..   one sample_codec block, rest of the page 0xFF
+ */
+#define FLASH_LOG_MAGIC          0x4753
+#define FLASH_LOG_HEADER_SIZE    10
+#define FLASH_LOG_BLOCK_MAX      (FLASH_REGION_PAGE_SIZE - FLASH_LOG_HEADER_SIZE)
+
+/** Samples staged in RAM before a page is encoded (a steady sensor takes one byte each) */
+#ifndef FLASH_LOG_STAGE_SAMPLES
+#define FLASH_LOG_STAGE_SAMPLES  240
+#endif
+
+/**
+ * @brief Log counters
+ */
+typedef struct flash_log_stats_s
+{
+    uint32_t samples;         /**< samples written to flash */
+    uint32_t pages;           /**< pages programmed */
+    uint32_t erases;          /**< sectors erased */
+    uint32_t overwritten;     /**< pages lost to wrap-around */
+    uint32_t errors;          /**< failed erase/program, retried */
+    uint32_t dropped;         /**< samples refused while a failed page blocked the full stage */
+} flash_log_stats_t;
+
+/**
+ * @brief Log state
+ */
+typedef struct flash_log_s
+{
+    const flash_region_t *region;                       /**< partition */
+    uint32_t head;                                      /**< offset of the next page to program */
+    uint32_t tail;                                      /**< offset of the oldest page */
+    uint32_t pages;                                     /**< pages stored */
+    uint32_t next_seq;                                  /**< sequence number of the next page */
+    radio_sample_t stage[FLASH_LOG_STAGE_SAMPLES];      /**< samples waiting for a page */
+    uint16_t staged;                                    /**< entries in stage */
+    uint8_t page[FLASH_REGION_PAGE_SIZE];               /**< page being assembled */
+    flash_log_stats_t stats;                            /**< counters */
+} flash_log_t;
+
+/**
+ * @brief     Attach to a partition and find head and tail
+ * @param[in] log    Log
+ * @param[in] region Partition
+ * @return    0 on success, 1 on an invalid partition
+ */
+uint8_t flash_log_init(flash_log_t *log, const flash_region_t *region);
+
+/**
+ * @brief     Stage one sample, programming a page once the stage is full
+ * @param[in] log    Log
+ * @param[in] sample Sample
+ * @return    0 on success, 1 if a page write failed
+ * @note      a failed page keeps its samples staged and is retried on the next call;
+ *            while it keeps failing with a full stage, new samples are dropped
+ */
+uint8_t flash_log_append(flash_log_t *log, const radio_sample_t *sample);
+
+/**
+ * @brief     Program everything staged, even into a partly filled page
+ * @param[in] log Log
+ * @return    0 on success, 1 if a page write failed (the rest stays staged)
+ */
+uint8_t flash_log_flush(flash_log_t *log);
+
+/**
+ * @brief     Pages stored
+ * @param[in] log Log
+ * @return    Page count
+ */
+uint32_t flash_log_pages(const flash_log_t *log);
+
+/**
+ * @brief      Read a page, oldest first
+ * @param[in]  log   Log
+ * @param[in]  index 0 .. flash_log_pages() - 1
+ * @param[out] page  FLASH_REGION_PAGE_SIZE bytes
+ * @return     0 on success, 1 on a bad index, 4 on a corrupted page
+ */
+uint8_t flash_log_read_page(const flash_log_t *log, uint32_t index, uint8_t *page);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,107 @@
+/**
+ * @file      flash_region.h
+ * @brief     Reserved flash partitions: erase, program and read through XIP-safe wrappers
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FLASH_REGION_H
+#define FLASH_REGION_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Erase unit */
+#define FLASH_REGION_SECTOR_SIZE     4096
+/** Program unit */
+#define FLASH_REGION_PAGE_SIZE       256
+
+/** Total flash on the board */
+#ifndef FLASH_REGION_FLASH_SIZE
+#define FLASH_REGION_FLASH_SIZE      (2 * 1024 * 1024)
+#endif
+
+/** Store-and-forward spill area at the very end of flash */
+#ifndef FLASH_REGION_BACKLOG_SIZE
+#define FLASH_REGION_BACKLOG_SIZE    (64 * 1024)
+#endif
+#define FLASH_REGION_BACKLOG_OFFSET  (FLASH_REGION_FLASH_SIZE - FLASH_REGION_BACKLOG_SIZE)
+
+/** Sample log right below the backlog; the firmware image must end before it */
+#ifndef FLASH_REGION_LOG_SIZE
+#define FLASH_REGION_LOG_SIZE        (1024 * 1024)
+#endif
+#define FLASH_REGION_LOG_OFFSET      (FLASH_REGION_BACKLOG_OFFSET - FLASH_REGION_LOG_SIZE)
+
+/**
+ * @brief Partition description
+ *
+ * Erase and program stall XIP and lock out the other core, so anything with
+ * tight timing (1-Wire slots) must not run meanwhile. lock, when set, is
+ * called before each erase/program and unlock after it.
+ */
+typedef struct flash_region_s
+{
+    uint32_t offset;              /**< start, from the beginning of flash, sector aligned */
+    uint32_t size;                /**< length, multiple of FLASH_REGION_SECTOR_SIZE */
+    void (*lock)(void);           /**< optional, claim exclusive use of timing-critical hardware */
+    void (*unlock)(void);         /**< optional, release it */
+} flash_region_t;
+
+/**
+ * @brief     Erase sectors
+ * @param[in] region Partition
+ * @param[in] offset Offset inside the partition, sector aligned
+ * @param[in] len    Length, multiple of FLASH_REGION_SECTOR_SIZE
+ * @return    0 on success, 1 on an out-of-range or misaligned request, 4 if the erase could not run
+ */
+uint8_t flash_region_erase(const flash_region_t *region, uint32_t offset, uint32_t len);
+
+/**
+ * @brief     Program pages
+ * @param[in] region Partition
+ * @param[in] offset Offset inside the partition, page aligned
+ * @param[in] data   Bytes
+ * @param[in] len    Length, multiple of FLASH_REGION_PAGE_SIZE
+ * @return    0 on success, 1 on an out-of-range or misaligned request, 4 if programming could not run
+ */
+uint8_t flash_region_program(const flash_region_t *region, uint32_t offset, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief     Read through the uncached XIP window
+ * @param[in] region Partition
+ * @param[in] offset Offset inside the partition
+ * @param[out] buf   Destination
+ * @param[in] len    Length
+ * @return    0 on success, 1 on an out-of-range request
+ */
+uint8_t flash_region_read(const flash_region_t *region, uint32_t offset, uint8_t *buf, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
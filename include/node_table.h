@@ -0,0 +1,141 @@
+/**
+ * @file      node_table.h
+ * @brief     Per-node sequence tracking on the base station: de-duplication and reordering
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NODE_TABLE_H
+#define NODE_TABLE_H
+
+#include "radio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Nodes tracked at once (override with -DNODE_TABLE_MAX_NODES=N) */
+#ifndef NODE_TABLE_MAX_NODES
+#define NODE_TABLE_MAX_NODES      32
+#endif
+
+/** Payloads held per node while waiting for a missing sequence number */
+#ifndef NODE_TABLE_REORDER_DEPTH
+#define NODE_TABLE_REORDER_DEPTH  4
+#endif
+#if NODE_TABLE_REORDER_DEPTH > 8
+#error "NODE_TABLE_REORDER_DEPTH is limited by the 8-bit held bitmap"
+#endif
+
+/** Longest time a payload is held for a gap before the gap is declared lost */
+#ifndef NODE_TABLE_REORDER_MS
+#define NODE_TABLE_REORDER_MS     200
+#endif
+
+/** Payloads a node can step back by and still be a duplicate; further back is a restart */
+#ifndef NODE_TABLE_DUP_SPAN
+#define NODE_TABLE_DUP_SPAN       (4 * NODE_TABLE_REORDER_DEPTH)
+#endif
+
+/**
+ * @brief Per-node link counters
+ */
+typedef struct node_stats_s
+{
+    uint32_t received;        /**< payloads accepted */
+    uint32_t duplicates;      /**< payloads dropped as already delivered */
+    uint32_t reordered;       /**< payloads delivered from the reorder buffer */
+    uint32_t lost;            /**< sequence numbers skipped */
+    uint32_t restarts;        /**< sequence counter restarts, node reboots */
+} node_stats_t;
+
+/**
+ * @brief Per-node state
+ */
+typedef struct node_entry_s
+{
+    uint8_t used;                                       /**< slot in use */
+    uint8_t node_id;                                    /**< node id */
+    uint16_t next_seq;                                  /**< next sequence number to deliver */
+    uint8_t held;                                       /**< bitmap of occupied reorder slots */
+    uint32_t held_since_ms;                             /**< arrival of the oldest held payload */
+    radio_frame_t reorder[NODE_TABLE_REORDER_DEPTH];    /**< slot (seq % depth) */
+    node_stats_t stats;                                 /**< counters */
+} node_entry_t;
+
+/**
+ * @brief Delivery callback, called in sequence order per node
+ */
+typedef void (*node_table_deliver_t)(void *ctx, const radio_frame_t *frame);
+
+/**
+ * @brief Node table
+ */
+typedef struct node_table_s
+{
+    node_entry_t nodes[NODE_TABLE_MAX_NODES];    /**< entries */
+    node_table_deliver_t deliver;                /**< delivery callback */
+    void *ctx;                                   /**< callback context */
+    uint32_t rejected;                           /**< payloads from nodes that did not fit */
+} node_table_t;
+
+/**
+ * @brief     Reset the table
+ * @param[in] table   Table
+ * @param[in] deliver Callback receiving in-order payloads
+ * @param[in] ctx     Callback context
+ */
+void node_table_init(node_table_t *table, node_table_deliver_t deliver, void *ctx);
+
+/**
+ * @brief     Feed one received payload
+ * @param[in] table   Table
+ * @param[in] node_id Sender id from the payload header
+ * @param[in] seq     Sequence number from the payload header
+ * @param[in] frame   Payload
+ * @param[in] now_ms  Arrival time
+ * @return    0 if accepted (delivered or held), 1 if dropped
+ */
+uint8_t node_table_push(node_table_t *table, uint8_t node_id, uint16_t seq,
+                        const radio_frame_t *frame, uint32_t now_ms);
+
+/**
+ * @brief     Release payloads held longer than NODE_TABLE_REORDER_MS, skipping the gaps
+ * @param[in] table  Table
+ * @param[in] now_ms Current time
+ */
+void node_table_expire(node_table_t *table, uint32_t now_ms);
+
+/**
+ * @brief     Look up a node
+ * @param[in] table   Table
+ * @param[in] node_id Node id
+ * @return    Entry or NULL if the node has not been heard
+ */
+const node_entry_t *node_table_find(const node_table_t *table, uint8_t node_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
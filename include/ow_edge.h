@@ -0,0 +1,123 @@
+/**
+ * @file      ow_edge.h
+ * @brief     Presence pulse edge capture of an interrupt-timed 1-Wire reset
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef OW_EDGE_H
+#define OW_EDGE_H
+
+#include <stdint.h>
+
+/**
+ * The bit-banged reset releases the bus and then leaves it alone for the
+ * receive window while the GPIO interrupt timestamps the presence pulse.
+ * The bookkeeping of the interrupt and the decode after the window are
+ * kept here, free of the SDK, so the host tests can drive edge sequences
+ * through the same code the driver runs.
+ */
+
+/** Receive window after the release in us */
+#define OW_EDGE_WINDOW_US       480
+
+#define OW_EDGE_FALL            0x01    /**< presence pulse start seen */
+#define OW_EDGE_RISE            0x02    /**< presence pulse end seen */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Presence pulse edges of one bus, written by the GPIO interrupt */
+typedef struct {
+    volatile uint32_t fall_us;
+    volatile uint32_t rise_us;
+    volatile uint8_t edges;
+} ow_edge_capture_t;
+
+/**
+ * @brief     Forget the edges of the previous reset
+ * @param[in] c Capture of the bus
+ */
+static inline void ow_edge_arm(ow_edge_capture_t *c)
+{
+    c->edges = 0;
+}
+
+/**
+ * @brief     Record the edge events of one interrupt
+ * @param[in] c    Capture of the bus
+ * @param[in] fall Nonzero when a falling edge is latched
+ * @param[in] rise Nonzero when a rising edge is latched
+ * @param[in] now  Interrupt timestamp in us
+ * @note      The first fall is the presence start. A rise only counts after
+ *            it, so the release edge is ignored, and the last rise wins over
+ *            a release edge latched together with the fall
+ */
+static inline void ow_edge_event(ow_edge_capture_t *c, uint8_t fall, uint8_t rise, uint32_t now)
+{
+    if ((fall != 0) && (c->edges & OW_EDGE_FALL) == 0) {
+        c->fall_us = now;
+        c->edges |= OW_EDGE_FALL;
+    }
+    if ((rise != 0) && (c->edges & OW_EDGE_FALL) != 0) {
+        c->rise_us = now;
+        c->edges |= OW_EDGE_RISE;
+    }
+}
+
+/**
+ * @brief      Decode the capture after the receive window
+ * @param[in]  c           Capture of the bus
+ * @param[in]  t0          Release timestamp in us
+ * @param[in]  line_high   Bus level at the end of the window
+ * @param[out] presence_us Release to presence start, 255 at most
+ * @param[out] width_us    Presence pulse width, 255 at most
+ * @return     0 presence seen, 1 no presence, 2 bus stuck low
+ */
+static inline uint8_t ow_edge_decode(const ow_edge_capture_t *c, uint32_t t0, uint8_t line_high,
+                                     uint8_t *presence_us, uint8_t *width_us)
+{
+    uint8_t edges = c->edges;
+    uint32_t v;
+
+    *presence_us = 0;
+    *width_us = 0;
+    if (line_high == 0) {
+        return 2;
+    }
+    if ((edges & OW_EDGE_FALL) == 0) {
+        return 1;
+    }
+    v = c->fall_us - t0;
+    *presence_us = (uint8_t)((v > 255) ? 255 : v);
+    v = ((edges & OW_EDGE_RISE) != 0) ? c->rise_us - c->fall_us : 0;
+    *width_us = (uint8_t)((v > 255) ? 255 : v);
+    return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,129 @@
+/**
+ * @file      ow_trace.h
+ * @brief     1-Wire bus event recorder, a lock-free flight-recorder ring
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef OW_TRACE_H
+#define OW_TRACE_H
+
+#include <stdint.h>
+
+/** 1 to record bus events; 0 compiles every OW_TRACE() call site out */
+#ifndef OW_TRACE_ENABLE
+#define OW_TRACE_ENABLE    0
+#endif
+
+/** Ring entries, a power of two */
+#ifndef OW_TRACE_SIZE
+#define OW_TRACE_SIZE      256
+#endif
+
+#if (OW_TRACE_SIZE & (OW_TRACE_SIZE - 1)) != 0
+#error "OW_TRACE_SIZE must be a power of two"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief ow trace event type enumeration definition
+ *
+ * ROM and function commands are plain OW_TRACE_WRITE bytes; the host tool
+ * tells them apart by their position after a reset.
+ */
+typedef enum
+{
+    OW_TRACE_RESET   = 0x01,    /**< data: presence delay in us, status: 0 ok, 1 no presence, 2 bus stuck low */
+    OW_TRACE_WRITE   = 0x02,    /**< data: byte written */
+    OW_TRACE_READ    = 0x03,    /**< data: byte read */
+    OW_TRACE_CONVERT = 0x04,    /**< data: polls after the sleep, status: 0 done, 1 timeout */
+    OW_TRACE_CRC     = 0x05,    /**< data: crc received, status: 1 mismatch */
+} ow_trace_type_t;
+
+/**
+ * @brief One recorded event, 8 bytes, also the wire format of USB_FRAME_OW_TRACE
+ */
+typedef struct ow_trace_event_s
+{
+    uint32_t time_us;          /**< low 32 bits of the 1 MHz timer */
+    uint8_t type;              /**< ow_trace_type_t */
+    uint8_t data;              /**< type specific */
+    uint8_t status;            /**< 0 ok, type specific otherwise */
+    uint8_t reserved;          /**< 0 */
+} ow_trace_event_t;
+
+#if OW_TRACE_ENABLE
+
+#include "hardware/timer.h"
+#include "hardware/sync.h"
+
+extern ow_trace_event_t g_ow_trace_ring[OW_TRACE_SIZE];
+extern volatile uint32_t g_ow_trace_head;
+
+/**
+ * @brief     Record one event, overwriting the oldest one when the ring is full
+ * @param[in] type   ow_trace_type_t
+ * @param[in] data   Type specific
+ * @param[in] status Type specific
+ * @note      Single producer: only the task that owns the bus records events
+ */
+static inline void ow_trace_record(uint8_t type, uint8_t data, uint8_t status)
+{
+    uint32_t head = g_ow_trace_head;
+    ow_trace_event_t *e = &g_ow_trace_ring[head & (OW_TRACE_SIZE - 1)];
+
+    e->time_us = time_us_32();
+    e->type = type;
+    e->data = data;
+    e->status = status;
+    e->reserved = 0;
+    __dmb();                                    /* entry visible before the index */
+    g_ow_trace_head = head + 1;
+}
+
+#define OW_TRACE(type, data, status)    ow_trace_record((type), (uint8_t)(data), (uint8_t)(status))
+
+/**
+ * @brief      Copy events not read yet, oldest first
+ * @param[out] events Destination
+ * @param[in]  max    Capacity of events
+ * @param[out] lost   Events overwritten before they could be read, added to
+ * @return     Number of events copied, 0 when the ring is drained
+ * @note       Single consumer; may run on the other core while events are recorded
+ */
+uint16_t ow_trace_read(ow_trace_event_t *events, uint16_t max, uint32_t *lost);
+
+#else
+
+#define OW_TRACE(type, data, status)    ((void)(type), (void)(data), (void)(status))
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * @file      ow_tune.h
+ * @brief     1-Wire slot timing profiles picked from bus measurements
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef OW_TUNE_H
+#define OW_TUNE_H
+
+#include <stdint.h>
+#include "driver_ds18b20.h"
+
+/** Scratchpad reads per revalidation window */
+#ifndef OW_TUNE_WINDOW
+#define OW_TUNE_WINDOW          64
+#endif
+
+/** CRC errors in one window that send a tuned bus back to the standard timing */
+#ifndef OW_TUNE_MAX_ERRORS
+#define OW_TUNE_MAX_ERRORS      1
+#endif
+
+/** Clean windows at the standard timing before a fallen back bus is measured again */
+#ifndef OW_TUNE_RETRY_WINDOWS
+#define OW_TUNE_RETRY_WINDOWS   16
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief ow tune profile enumeration definition
+ */
+typedef enum
+{
+    OW_TUNE_STANDARD = 0,       /**< DS18B20_TIMING_STANDARD, used until measured and after a fallback */
+    OW_TUNE_SHORT    = 1,       /**< fast rise: 500 us reset, 1 us slot starts, minimal recovery */
+    OW_TUNE_LONG     = 2,       /**< slow rise: later sample point and recovery scaled to the rise time */
+} ow_tune_profile_t;
+
+/**
+ * @brief Measured bus, as returned by ds18b20_interface_measure()
+ */
+typedef struct ow_tune_measure_s
+{
+    uint32_t rise_ns;               /**< release to logic high */
+    uint32_t presence_delay_us;     /**< release after reset to presence start */
+    uint32_t presence_width_us;     /**< presence pulse width */
+} ow_tune_measure_t;
+
+/**
+ * @brief Tuning state of one bus
+ */
+typedef struct ow_tune_s
+{
+    ow_tune_measure_t measure;      /**< last measurement */
+    uint8_t profile;                /**< ow_tune_profile_t in use */
+    uint8_t fallen_back;            /**< 1 after CRC errors forced the standard timing */
+    uint16_t clean_windows;         /**< clean windows since the fallback */
+    uint32_t frames_mark;           /**< timing->frames at the window start */
+    uint32_t errors_mark;           /**< timing->crc_errors at the window start */
+    uint32_t fallbacks;             /**< fallbacks since boot */
+} ow_tune_t;
+
+/**
+ * @brief      Pick the fastest in-spec profile for a measured bus
+ * @param[out] tune   Tuning state, records the measurement and profile
+ * @param[out] timing Bus timing, counters are kept
+ * @param[in]  m      Measurement, NULL when the bus could not be measured
+ * @return     Profile applied
+ */
+uint8_t ow_tune_apply(ow_tune_t *tune, ds18b20_timing_t *timing, const ow_tune_measure_t *m);
+
+/**
+ * @brief         Revalidate a bus from its CRC error rate; call once per sampling cycle
+ * @param[in,out] tune   Tuning state
+ * @param[in,out] timing Bus timing, reset to the standard one on too many errors
+ * @return        1 when the bus should be measured and ow_tune_apply() called again
+ */
+uint8_t ow_tune_check(ow_tune_t *tune, ds18b20_timing_t *timing);
+
+/**
+ * @brief     Print the tuning state of one bus as one line
+ * @param[in] bus    Bus number for the line
+ * @param[in] tune   Tuning state
+ * @param[in] timing Bus timing
+ */
+void ow_tune_print(uint8_t bus, const ow_tune_t *tune, const ds18b20_timing_t *timing);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
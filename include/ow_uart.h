@@ -0,0 +1,171 @@
+/**
+ * @file      ow_uart.h
+ * @brief     1-Wire over a UART: slot byte codec and DMA transfers
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef OW_UART_H
+#define OW_UART_H
+
+#include <stdint.h>
+
+/*
+ * A UART byte is one 1-Wire slot. At 115200 baud 0xFF is a write-1 or read
+ * slot (8.7 us start bit low, then released) and 0x00 a write-0 slot (78 us
+ * low); the echo of a read slot comes back 0xFF only when no chip held the
+ * line past the start bit. At 9600 baud 0xF0 is a 520 us reset pulse and a
+ * presence pulse clears some of its high bits in the echo.
+ *
+ * Wiring: TX drives the bus through a Schottky diode (cathode on TX) or an
+ * open drain buffer, RX sits on the bus with the usual 4.7 kOhm pull-up.
+ */
+
+/** Reset baud rate */
+#ifndef OW_UART_RESET_BAUD
+#define OW_UART_RESET_BAUD      9600
+#endif
+
+/** Slot baud rate */
+#ifndef OW_UART_SLOT_BAUD
+#define OW_UART_SLOT_BAUD       115200
+#endif
+
+/** Slots per DMA transfer, a multiple of 8; longer blocks run as several transfers */
+#ifndef OW_UART_MAX_SLOTS
+#define OW_UART_MAX_SLOTS       128
+#endif
+
+/** Time allowed for one transfer before the DMA channels are aborted */
+#ifndef OW_UART_TIMEOUT_MS
+#define OW_UART_TIMEOUT_MS      50
+#endif
+
+#define OW_UART_RESET_BYTE      0xF0    /**< reset pulse at OW_UART_RESET_BAUD */
+#define OW_UART_SLOT_1          0xFF    /**< write-1 or read slot */
+#define OW_UART_SLOT_0          0x00    /**< write-0 slot */
+
+/** Length of one bit at the reset baud rate in us */
+#define OW_UART_RESET_BIT_US    (1000000 / OW_UART_RESET_BAUD)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief      Encode slots as UART bytes
+ * @param[in]  bits  Slot values, bit n (lsb first) for slot n
+ * @param[in]  slots Number of slots
+ * @param[out] out   One byte per slot
+ */
+static inline void ow_uart_encode(const uint8_t *bits, uint16_t slots, uint8_t *out)
+{
+    for (uint16_t i = 0; i < slots; i++) {
+        out[i] = ((bits[i >> 3] >> (i & 7)) & 1) ? OW_UART_SLOT_1 : OW_UART_SLOT_0;
+    }
+}
+
+/**
+ * @brief      Decode the echo of a block of slots
+ * @param[in]  echo  One echoed byte per slot
+ * @param[in]  slots Number of slots
+ * @param[out] bits  Sampled values packed like ow_uart_encode() input; whole bytes are written
+ */
+static inline void ow_uart_decode(const uint8_t *echo, uint16_t slots, uint8_t *bits)
+{
+    for (uint16_t i = 0; i < (uint16_t)((slots + 7) / 8); i++) {
+        bits[i] = 0;
+    }
+    for (uint16_t i = 0; i < slots; i++) {
+        if (echo[i] == OW_UART_SLOT_1) {
+            bits[i >> 3] |= (uint8_t)(1 << (i & 7));
+        }
+    }
+}
+
+/**
+ * @brief      Decode the echo of a reset byte
+ * @param[in]  echo     Echoed byte
+ * @param[out] width_us Presence width, in steps of OW_UART_RESET_BIT_US
+ * @return     0 on presence, 1 when no chip answered, 2 when the bus is stuck low
+ */
+static inline uint8_t ow_uart_reset_decode(uint8_t echo, uint8_t *width_us)
+{
+    uint32_t width = 0;
+
+    *width_us = 0;
+    if (echo == 0x00) {
+        return 2;
+    }
+    if (echo == OW_UART_RESET_BYTE) {
+        return 1;
+    }
+    for (uint8_t i = 4; i < 8; i++) {
+        if ((echo & (1 << i)) == 0) {
+            width += OW_UART_RESET_BIT_US;
+        }
+    }
+    *width_us = (uint8_t)((width > 255) ? 255 : width);
+    return 0;
+}
+
+/**
+ * @brief     Take over a UART, its pins and two DMA channels
+ * @param[in] id     UART instance, 0 or 1
+ * @param[in] tx_pin UART TX GPIO
+ * @param[in] rx_pin UART RX GPIO
+ * @return    0 on success, 1 on failure
+ */
+uint8_t ow_uart_init(uint8_t id, uint32_t tx_pin, uint32_t rx_pin);
+
+/**
+ * @brief     Release the UART, its pins and DMA channels
+ * @param[in] id UART instance
+ * @return    0 on success, 1 when not initialized
+ */
+uint8_t ow_uart_deinit(uint8_t id);
+
+/**
+ * @brief      Send a reset pulse and look for a presence pulse
+ * @param[in]  id       UART instance
+ * @param[out] width_us Presence width estimate
+ * @return     0 on presence, 1 when no chip answered, 2 when the bus is stuck low
+ *             or the transfer failed
+ */
+uint8_t ow_uart_reset(uint8_t id, uint8_t *width_us);
+
+/**
+ * @brief      Run a block of slots by DMA, the caller sleeps until the echo is in
+ * @param[in]  id    UART instance
+ * @param[in]  tx    Slot values, bit n (lsb first) for slot n; 1 bits double as read slots
+ * @param[out] rx    Sampled values packed the same way, NULL to drop them
+ * @param[in]  slots Number of slots
+ * @return     0 on success, 1 on timeout
+ */
+uint8_t ow_uart_touch(uint8_t id, const uint8_t *tx, uint8_t *rx, uint16_t slots);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
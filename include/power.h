@@ -0,0 +1,80 @@
+/**
+ * @file      power.h
+ * @brief     CPU sleep accounting for the FreeRTOS idle hooks
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POWER_H
+#define POWER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of cores tracked */
+#define POWER_CORES    2
+
+/**
+ * @brief Cumulative sleep accounting
+ *
+ * Every idle pass sleeps the core with WFI until the next interrupt (the
+ * scheduler tick at the latest) and adds the time spent to the core's total.
+ * Interrupt handlers that wake the core run before WFI returns and are
+ * counted as sleep; they are short compared to a 1 ms tick.
+ */
+typedef struct power_stats_s
+{
+    uint64_t uptime_us;                   /**< time of the snapshot */
+    uint64_t sleep_us[POWER_CORES];       /**< time each core spent in WFI */
+    uint32_t wakeups[POWER_CORES];        /**< WFI exits per core */
+} power_stats_t;
+
+/**
+ * @brief Sleep the calling core until the next interrupt
+ * @note  Called from the idle and passive idle hooks only
+ */
+void power_idle(void);
+
+/**
+ * @brief      Take a snapshot of the counters
+ * @param[out] stats Snapshot
+ */
+void power_get_stats(power_stats_t *stats);
+
+/**
+ * @brief     Share of a window one core was awake
+ * @param[in] now  Snapshot at the end of the window
+ * @param[in] prev Snapshot at the start of the window
+ * @param[in] core Core number
+ * @return    Awake time in permille, 1000 for an empty window
+ */
+uint16_t power_awake_permille(const power_stats_t *now, const power_stats_t *prev, uint8_t core);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
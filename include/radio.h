@@ -0,0 +1,106 @@
+/**
+ * @file      radio.h
+ * @brief     Transport-neutral radio interface used by the sensor node and base station
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef RADIO_H
+#define RADIO_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Largest payload carried in one radio frame */
+#define RADIO_PAYLOAD_MAX    32
+
+/** Frames that can be queued for one back-to-back burst (nRF24 TX FIFO depth) */
+#define RADIO_TX_BURST_MAX   3
+
+/**
+ * @brief Radio role, selects addresses and default direction
+ */
+typedef enum
+{
+    RADIO_ROLE_NODE = 0x00,        /**< sensor node, transmits uplink, receives broadcasts */
+    RADIO_ROLE_BASE = 0x01,        /**< base station, listens uplink on pipes 1 - 5, transmits broadcasts */
+} radio_role_t;
+
+/**
+ * @brief One over-the-air payload
+ */
+typedef struct radio_frame_s
+{
+    uint8_t len;                         /**< payload length */
+    uint8_t pipe;                        /**< receive pipe, ignored on transmit */
+    uint8_t data[RADIO_PAYLOAD_MAX];     /**< payload bytes */
+} radio_frame_t;
+
+/**
+ * @brief Radio operations
+ *
+ * Firmware links the nRF24L01+ implementation (gc_radio_nrf24l01_ops); a host
+ * build can provide an in-process medium behind the same table.
+ * All functions return 0 on success.
+ */
+typedef struct radio_ops_s
+{
+    /** Bring the radio up for a role, powered down afterwards */
+    uint8_t (*init)(radio_role_t role);
+    /** Power down and release the radio */
+    uint8_t (*deinit)(void);
+    /**
+     * Transmit up to RADIO_TX_BURST_MAX frames back-to-back with one power-up.
+     * *sent receives the number of leading frames that were acknowledged.
+     * Returns 1 only on a hardware failure; lost frames are reported via *sent.
+     */
+    uint8_t (*send_burst)(const radio_frame_t *frames, uint8_t count, uint8_t *sent);
+    /** Enter continuous receive */
+    uint8_t (*listen)(void);
+    /** Block until the radio raises an interrupt; 1 on timeout */
+    uint8_t (*wait)(uint32_t timeout_ms);
+    /** Pop one received frame; 4 when nothing is pending */
+    uint8_t (*receive)(radio_frame_t *frame);
+    /** Power down until the next send_burst or listen */
+    uint8_t (*sleep)(void);
+    /** Send one frame to all nodes without acknowledgement, base role only */
+    uint8_t (*broadcast)(const radio_frame_t *frame);
+    /** Address further uplink frames to base station pipe 1 - 5, node role only */
+    uint8_t (*set_uplink)(uint8_t pipe);
+    /** Make a pending wait return early (task context) */
+    uint8_t (*kick)(void);
+    /** Local time_us_64() captured in the last radio interrupt */
+    uint8_t (*irq_time)(uint64_t *us);
+} radio_ops_t;
+
+/** nRF24L01+ implementation */
+extern const radio_ops_t gc_radio_nrf24l01_ops;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,147 @@
+/**
+ * @file      radio_protocol.h
+ * @brief     Over-the-air payload format shared by sensor node, base station and host tools
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef RADIO_PROTOCOL_H
+#define RADIO_PROTOCOL_H
+
+#include "radio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Sample payload (little endian):
+ *
+ *   0      type      RADIO_PACKET_SAMPLES
+ *   1      node_id
+ *   2..3   seq       per-node, incremented per payload
+ *   4..7   time_ms   timestamp of the first sample
+ *   8..    samples, 4 bytes each:
+ *            0..1  raw        int16 DS18B20 reading
+ *            2..3  sensor:3 | dt_ms:13, dt since the previous sample
+ *
+ * Packed sample payload:
+ *
+ *   0      type      RADIO_PACKET_SAMPLES_PACKED
+ *   1      node_id
+ *   2..3   seq
+ *   4..    one sample_codec block, whose first four bytes are time_ms, so
+ *          the common header decodes unchanged
+ */
+#define RADIO_PROTOCOL_HEADER_SIZE    8
+#define RADIO_PROTOCOL_SAMPLE_SIZE    4
+#define RADIO_PROTOCOL_MAX_SAMPLES    ((RADIO_PAYLOAD_MAX - RADIO_PROTOCOL_HEADER_SIZE) / RADIO_PROTOCOL_SAMPLE_SIZE)
+#define RADIO_PROTOCOL_MAX_SENSOR     7
+#define RADIO_PROTOCOL_MAX_DELTA_MS   0x1FFF
+#define RADIO_PROTOCOL_PACKED_OFFSET  4
+#define RADIO_PROTOCOL_MAX_PACKED     (RADIO_PAYLOAD_MAX - RADIO_PROTOCOL_HEADER_SIZE)  /**< one byte per sample at best */
+
+/**
+ * @brief Payload type
+ */
+typedef enum
+{
+    RADIO_PACKET_SAMPLES        = 0x01,     /**< batched raw samples */
+    RADIO_PACKET_SAMPLES_PACKED = 0x02,     /**< batched samples, sample_codec block */
+    RADIO_PACKET_BEACON         = 0x10,     /**< TDMA frame start, base station broadcast (tdma.h) */
+    RADIO_PACKET_JOIN           = 0x11,     /**< TDMA slot request from a node (tdma.h) */
+} radio_packet_type_t;
+
+/**
+ * @brief Payload header
+ */
+typedef struct radio_header_s
+{
+    uint8_t type;          /**< radio_packet_type_t */
+    uint8_t node_id;       /**< sender */
+    uint16_t seq;          /**< per-node payload sequence number */
+    uint32_t time_ms;      /**< sender timestamp */
+} radio_header_t;
+
+/**
+ * @brief One timestamped sensor reading
+ */
+typedef struct radio_sample_s
+{
+    uint32_t time_ms;      /**< sample time */
+    int16_t raw;           /**< raw DS18B20 reading */
+    uint8_t sensor;        /**< sensor index on the node, 0 - RADIO_PROTOCOL_MAX_SENSOR */
+} radio_sample_t;
+
+/**
+ * @brief      Pack as many samples as fit into one payload
+ * @param[in]  node_id Sender id
+ * @param[in]  seq     Payload sequence number
+ * @param[in]  samples Samples in non-decreasing time order
+ * @param[in]  count   Number of samples available
+ * @param[out] frame   Payload
+ * @param[out] packed  Number of samples consumed (stops early on a gap over RADIO_PROTOCOL_MAX_DELTA_MS)
+ * @return     0 on success, 1 on invalid arguments
+ */
+uint8_t radio_protocol_pack_samples(uint8_t node_id, uint16_t seq,
+                                    const radio_sample_t *samples, uint8_t count,
+                                    radio_frame_t *frame, uint8_t *packed);
+
+/**
+ * @brief      Pack as many samples as fit into one delta-compressed payload
+ * @param[in]  node_id Sender id
+ * @param[in]  seq     Payload sequence number
+ * @param[in]  samples Samples in non-decreasing time order
+ * @param[in]  count   Number of samples available
+ * @param[out] frame   Payload
+ * @param[out] packed  Number of samples consumed, at most RADIO_PROTOCOL_MAX_PACKED
+ * @return     0 on success, 1 on invalid arguments
+ */
+uint8_t radio_protocol_pack_samples_packed(uint8_t node_id, uint16_t seq,
+                                           const radio_sample_t *samples, uint8_t count,
+                                           radio_frame_t *frame, uint8_t *packed);
+
+/**
+ * @brief      Decode the common header
+ * @param[in]  frame  Payload
+ * @param[out] header Header
+ * @return     0 on success, 1 if the payload is too short
+ */
+uint8_t radio_protocol_unpack_header(const radio_frame_t *frame, radio_header_t *header);
+
+/**
+ * @brief      Decode a RADIO_PACKET_SAMPLES or RADIO_PACKET_SAMPLES_PACKED payload
+ * @param[in]  frame   Payload
+ * @param[out] header  Header
+ * @param[out] samples Array of RADIO_PROTOCOL_MAX_PACKED entries
+ * @param[out] count   Number of decoded samples
+ * @return     0 on success, 1 on a malformed payload
+ */
+uint8_t radio_protocol_unpack_samples(const radio_frame_t *frame, radio_header_t *header,
+                                      radio_sample_t *samples, uint8_t *count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
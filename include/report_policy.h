@@ -0,0 +1,121 @@
+/**
+ * @file      report_policy.h
+ * @brief     Send-on-delta reporting: per-sensor deadband and heartbeat, receiver-side held values
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef REPORT_POLICY_H
+#define REPORT_POLICY_H
+
+#include "radio_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define REPORT_POLICY_MAX_SENSORS    (RADIO_PROTOCOL_MAX_SENSOR + 1)
+
+/**
+ * @brief Sender-side state of one sensor
+ */
+typedef struct report_sensor_s
+{
+    uint8_t valid;            /**< a value has been reported */
+    int16_t raw;              /**< last reported value */
+    uint32_t time_ms;         /**< time of the last report */
+} report_sensor_t;
+
+/**
+ * @brief Sender-side policy
+ *
+ * A reading is reported when it differs from the last reported value by more
+ * than deadband_raw, or when heartbeat_ms has passed since the last report.
+ * A heartbeat of 0 reports every reading.
+ */
+typedef struct report_policy_s
+{
+    uint16_t deadband_raw;                               /**< allowed drift in raw LSB */
+    uint32_t heartbeat_ms;                               /**< longest silence per sensor */
+    report_sensor_t sensors[REPORT_POLICY_MAX_SENSORS];  /**< per-sensor state */
+    uint32_t reported;                                   /**< readings committed */
+    uint32_t suppressed;                                 /**< readings held back */
+} report_policy_t;
+
+/**
+ * @brief Receiver-side reconstruction of one sensor
+ */
+typedef struct report_hold_s
+{
+    uint8_t valid;            /**< a value has been received */
+    int16_t raw;              /**< held value */
+    uint32_t sample_ms;       /**< sender timestamp of the held value */
+    uint32_t rx_ms;           /**< local time the held value arrived */
+} report_hold_t;
+
+/**
+ * @brief     Reset the policy
+ * @param[in] policy       Policy
+ * @param[in] deadband_raw Allowed drift in raw LSB
+ * @param[in] heartbeat_ms Longest silence per sensor, 0 to report everything
+ */
+void report_policy_init(report_policy_t *policy, uint16_t deadband_raw, uint32_t heartbeat_ms);
+
+/**
+ * @brief     Decide whether a reading goes on air
+ * @param[in] policy Policy
+ * @param[in] sample Reading
+ * @return    1 to report it, 0 to hold it back
+ * @note      the decision is not remembered; call report_policy_commit() once the
+ *            reading was handed on, so a reading that could not be sent is retried
+ */
+uint8_t report_policy_check(report_policy_t *policy, const radio_sample_t *sample);
+
+/**
+ * @brief     Record a reading as reported
+ * @param[in] policy Policy
+ * @param[in] sample Reading report_policy_check() passed and that was handed on
+ */
+void report_policy_commit(report_policy_t *policy, const radio_sample_t *sample);
+
+/**
+ * @brief     Store a received value
+ * @param[in] hold   Held value
+ * @param[in] sample Received sample
+ * @param[in] now_ms Local time
+ */
+void report_hold_update(report_hold_t *hold, const radio_sample_t *sample, uint32_t now_ms);
+
+/**
+ * @brief     Age of a held value
+ * @param[in] hold   Held value
+ * @param[in] now_ms Local time
+ * @return    Milliseconds since the value arrived, UINT32_MAX if nothing was received
+ */
+uint32_t report_hold_age(const report_hold_t *hold, uint32_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
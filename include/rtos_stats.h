@@ -0,0 +1,143 @@
+/**
+ * @file      rtos_stats.h
+ * @brief     Per-task CPU share and stack high-water marks from FreeRTOS run-time stats
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef RTOS_STATS_H
+#define RTOS_STATS_H
+
+#include <stdint.h>
+#include "power.h"
+#include "usb_frame.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Tasks kept per snapshot, including the idle and timer tasks */
+#ifndef RTOS_STATS_MAX_TASKS
+#define RTOS_STATS_MAX_TASKS     12
+#endif
+
+#define RTOS_STATS_NAME_LEN      16
+
+/*
+ * USB_FRAME_TASK_STATS payload (little endian):
+ *
+ *   window_us u32, awake permille u16 per core, task count u8,
+ *   then per task: name 8 bytes (zero padded), share permille u16 of one
+ *   core, stack_free words u16, priority u8, core affinity mask u8
+ */
+#define RTOS_STATS_EXPORT_HEADER (4 + 2 * POWER_CORES + 1)
+#define RTOS_STATS_EXPORT_TASK   14
+
+/**
+ * @brief One task in a snapshot
+ */
+typedef struct rtos_stats_task_s
+{
+    uint32_t number;                     /**< xTaskNumber, matches a task across snapshots */
+    char name[RTOS_STATS_NAME_LEN];      /**< task name */
+    uint64_t run_us;                     /**< cumulative run time */
+    uint16_t stack_free;                 /**< stack words never used */
+    uint8_t priority;                    /**< current priority */
+    uint8_t affinity;                    /**< core affinity mask */
+} rtos_stats_task_t;
+
+/**
+ * @brief Snapshot of all tasks and both cores
+ */
+typedef struct rtos_stats_s
+{
+    power_stats_t power;                         /**< uptime and per-core sleep */
+    uint8_t count;                               /**< valid entries in tasks */
+    rtos_stats_task_t tasks[RTOS_STATS_MAX_TASKS];
+} rtos_stats_t;
+
+/**
+ * @brief RAM use, from the linker symbols and the FreeRTOS heap
+ */
+typedef struct rtos_stats_ram_s
+{
+    uint32_t total;            /**< main SRAM */
+    uint32_t static_used;      /**< vector table, data and bss: tasks, queues and rings */
+    uint32_t c_heap;           /**< left for malloc (newlib, stdio) */
+    uint32_t rtos_heap;        /**< configTOTAL_HEAP_SIZE, 0 without dynamic allocation */
+    uint32_t rtos_heap_free;   /**< currently free in the FreeRTOS heap */
+    uint32_t rtos_heap_min;    /**< lowest free since boot */
+} rtos_stats_ram_t;
+
+/**
+ * @brief      Take a snapshot
+ * @param[out] snap Snapshot
+ * @return     status code
+ *             - 0 success
+ *             - 1 more than RTOS_STATS_MAX_TASKS tasks, snap->count is 0
+ * @note       Not reentrant, call from one task only
+ */
+uint8_t rtos_stats_snapshot(rtos_stats_t *snap);
+
+/**
+ * @brief     Share of one core a task used between two snapshots
+ * @param[in] now   Later snapshot
+ * @param[in] prev  Earlier snapshot, a zeroed one for the time since boot
+ * @param[in] index Task index in now
+ * @return    Run time in permille of the window
+ */
+uint16_t rtos_stats_task_permille(const rtos_stats_t *now, const rtos_stats_t *prev, uint8_t index);
+
+/**
+ * @brief     Print one line per task and the awake share of each core
+ * @param[in] now  Later snapshot
+ * @param[in] prev Earlier snapshot
+ */
+void rtos_stats_print(const rtos_stats_t *now, const rtos_stats_t *prev);
+
+/**
+ * @brief      Fill in the RAM use
+ * @param[out] ram RAM use
+ * @note       rtos_heap is part of static_used, it lives in bss
+ */
+void rtos_stats_ram(rtos_stats_ram_t *ram);
+
+/**
+ * @brief Print the RAM use as one line
+ */
+void rtos_stats_print_ram(void);
+
+/**
+ * @brief     Append the USB_FRAME_TASK_STATS payload to a frame started with that type
+ * @param[in] frame Frame
+ * @param[in] now   Later snapshot
+ * @param[in] prev  Earlier snapshot
+ * @return    0 on success, 1 if the frame is full
+ */
+uint8_t rtos_stats_append(usb_frame_t *frame, const rtos_stats_t *now, const rtos_stats_t *prev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ * @file      sample_backlog.h
+ * @brief     Store-and-forward sample backlog: RAM ring spilling whole pages to a flash partition
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SAMPLE_BACKLOG_H
+#define SAMPLE_BACKLOG_H
+
+#include "radio_protocol.h"
+#include "flash_region.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Samples held in RAM before the oldest page is spilled (override with -DSAMPLE_BACKLOG_RAM_SAMPLES=N) */
+#ifndef SAMPLE_BACKLOG_RAM_SAMPLES
+#define SAMPLE_BACKLOG_RAM_SAMPLES   128
+#endif
+
+/** Flash record: time_ms u32, raw i16, sensor u8, 0xA5 marker */
+#define SAMPLE_BACKLOG_RECORD_SIZE   8
+#define SAMPLE_BACKLOG_PAGE_SAMPLES  (FLASH_REGION_PAGE_SIZE / SAMPLE_BACKLOG_RECORD_SIZE)
+
+#if SAMPLE_BACKLOG_RAM_SAMPLES < SAMPLE_BACKLOG_PAGE_SAMPLES
+#error "SAMPLE_BACKLOG_RAM_SAMPLES must hold at least one flash page of samples"
+#endif
+
+/**
+ * @brief Backlog counters
+ */
+typedef struct sample_backlog_stats_s
+{
+    uint32_t pushed;          /**< samples accepted */
+    uint32_t drained;         /**< samples popped after delivery */
+    uint32_t spilled;         /**< pages written to flash */
+    uint32_t dropped;         /**< samples overwritten because RAM and flash were full */
+    uint32_t flash_errors;    /**< failed erase/program, the page was dropped */
+} sample_backlog_stats_t;
+
+/**
+ * @brief Backlog, oldest samples first: read-back page, flash pages, RAM ring
+ */
+typedef struct sample_backlog_s
+{
+    const flash_region_t *region;                       /**< spill partition, NULL for RAM only */
+    radio_sample_t ram[SAMPLE_BACKLOG_RAM_SAMPLES];     /**< ring of the newest samples */
+    uint16_t ram_head;                                  /**< oldest entry */
+    uint16_t ram_count;                                 /**< entries */
+    uint32_t flash_rd;                                  /**< offset of the oldest stored page */
+    uint32_t flash_wr;                                  /**< offset of the next page to program */
+    uint32_t flash_pages;                               /**< pages stored */
+    radio_sample_t page[SAMPLE_BACKLOG_PAGE_SAMPLES];   /**< oldest page, read back */
+    uint8_t page_pos;                                   /**< next unread entry in page */
+    uint8_t page_count;                                 /**< valid entries in page */
+    uint8_t buf[FLASH_REGION_PAGE_SIZE];                /**< program staging */
+    sample_backlog_stats_t stats;                       /**< counters */
+} sample_backlog_t;
+
+/**
+ * @brief     Reset to empty
+ * @param[in] backlog Backlog
+ * @param[in] region  Spill partition, NULL to keep the backlog in RAM only
+ * @note      Contents do not survive a reset; the partition is erased sector by sector as it fills
+ */
+void sample_backlog_init(sample_backlog_t *backlog, const flash_region_t *region);
+
+/**
+ * @brief     Append a sample, spilling the oldest RAM page to flash when the ring is full
+ * @param[in] backlog Backlog
+ * @param[in] sample  Sample
+ */
+void sample_backlog_push(sample_backlog_t *backlog, const radio_sample_t *sample);
+
+/**
+ * @brief      Copy the oldest samples without removing them
+ * @param[in]  backlog Backlog
+ * @param[out] samples Destination
+ * @param[in]  max     Capacity of samples
+ * @return     Number of samples copied
+ */
+uint16_t sample_backlog_peek(sample_backlog_t *backlog, radio_sample_t *samples, uint16_t max);
+
+/**
+ * @brief     Remove the oldest samples after they were delivered
+ * @param[in] backlog Backlog
+ * @param[in] count   Samples to remove, at most what the last peek returned
+ */
+void sample_backlog_pop(sample_backlog_t *backlog, uint16_t count);
+
+/**
+ * @brief     Samples waiting
+ * @param[in] backlog Backlog
+ * @return    Depth over RAM and flash
+ */
+uint32_t sample_backlog_depth(const sample_backlog_t *backlog);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
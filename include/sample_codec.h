@@ -0,0 +1,85 @@
+/**
+ * @file      sample_codec.h
+ * @brief     Delta-of-delta / zigzag varint codec for timestamped raw sample streams
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SAMPLE_CODEC_H
+#define SAMPLE_CODEC_H
+
+#include "radio_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A block is self-contained (a keyframe), so losing one radio payload or USB
+ * frame never corrupts the next:
+ *
+ *   0..3   base_time_ms  u32 LE
+ *   4..    samples, each:
+ *            varint  zigzag(dt) << 4 | same_raw << 3 | sensor
+ *            varint  zigzag(raw delta)               omitted when same_raw
+ *
+ * For the first sample of a sensor in a block dt is measured from base_time_ms
+ * and the raw value is absolute (never same_raw). After that dt is the change
+ * in that sensor's sampling interval (delta of delta) and the raw value is a
+ * delta from its previous reading. A steady sensor with flat readings costs
+ * one byte per sample; a few LSB of drift costs two.
+ */
+#define SAMPLE_CODEC_BLOCK_HEADER   4
+#define SAMPLE_CODEC_MAX_SENSORS    (RADIO_PROTOCOL_MAX_SENSOR + 1)
+#define SAMPLE_CODEC_MAX_ENCODED    8           /**< worst case bytes for one sample */
+
+/**
+ * @brief      Encode samples into one block
+ * @param[in]  samples Samples in non-decreasing time order
+ * @param[in]  count   Number of samples available
+ * @param[out] out     Block buffer
+ * @param[in]  max     Block buffer size
+ * @param[out] len     Bytes written
+ * @param[out] encoded Samples consumed, stops when the next one does not fit
+ * @return     0 on success, 1 on invalid arguments or if not even one sample fits
+ */
+uint8_t sample_codec_encode_block(const radio_sample_t *samples, uint8_t count,
+                                  uint8_t *out, uint16_t max, uint16_t *len, uint8_t *encoded);
+
+/**
+ * @brief      Decode one block
+ * @param[in]  in      Block bytes
+ * @param[in]  len     Block length
+ * @param[out] samples Output samples
+ * @param[in]  max     Capacity of samples
+ * @param[out] count   Samples decoded
+ * @return     0 on success, 1 on a malformed or oversize block
+ */
+uint8_t sample_codec_decode_block(const uint8_t *in, uint16_t len,
+                                  radio_sample_t *samples, uint8_t max, uint8_t *count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,242 @@
+/**
+ * @file      tdma.h
+ * @brief     Beacon-driven TDMA slot allocation for sensor nodes sharing one channel
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TDMA_H
+#define TDMA_H
+
+#include "radio_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The base station broadcasts a beacon at the start of every frame. Slot 0
+ * follows the beacon and is the contention slot for RADIO_PACKET_JOIN; slots
+ * 1 .. TDMA_SLOTS-1 are owned by one node each. A node sends its data only in
+ * its own slot, addressed to uplink pipe tdma_slot_pipe(slot), which spreads
+ * the nodes over the five uplink pipes of the base station.
+ *
+ * Beacon payload:
+ *
+ *   0      type      RADIO_PACKET_BEACON
+ *   1      slots     slots per frame, including the join slot
+ *   2..3   frame     frame counter
+ *   4..5   slot_ms   slot length
+ *   6..11  time_us   48-bit network time (base station clock) when the beacon was queued
+ *   12..   (node_id, slot) pairs, rotated so every assignment is repeated
+ *
+ * Join payload:
+ *
+ *   0      type      RADIO_PACKET_JOIN
+ *   1      node_id
+ */
+
+/** Slots per frame including the join slot (override with -DTDMA_SLOTS=N) */
+#ifndef TDMA_SLOTS
+#define TDMA_SLOTS          16
+#endif
+#if TDMA_SLOTS > 255
+#error "TDMA_SLOTS must fit the 8-bit slot field"
+#endif
+
+/** Slot length: one three-frame burst with retransmits plus guard time */
+#ifndef TDMA_SLOT_MS
+#define TDMA_SLOT_MS        16
+#endif
+
+/** Quiet time after the beacon so every node has decoded it before slot 0 */
+#define TDMA_GUARD_MS       2
+
+/** Frame period */
+#define TDMA_FRAME_MS       (TDMA_GUARD_MS + TDMA_SLOTS * TDMA_SLOT_MS)
+
+/**
+ * Slot lease: a slot whose node has neither sent data nor joined for this long
+ * is reclaimed; the node's regular reports (at least one per sensor heartbeat)
+ * renew it
+ */
+#ifndef TDMA_LEASE_MS
+#define TDMA_LEASE_MS       300000
+#endif
+
+/** Lease in frames, compared against the 16-bit frame counter */
+#define TDMA_LEASE_FRAMES   ((TDMA_LEASE_MS + TDMA_FRAME_MS - 1) / TDMA_FRAME_MS)
+#if TDMA_LEASE_FRAMES >= 32768
+#error "TDMA_LEASE_MS is too long for the 16-bit frame counter"
+#endif
+
+/** Beacons a node may miss its own assignment in before it joins again */
+#define TDMA_NODE_MISSING   (2 * ((TDMA_SLOTS - 1 + TDMA_BEACON_PAIRS - 1) / TDMA_BEACON_PAIRS) + 1)
+
+/** Largest join backoff window, 2^N frames */
+#ifndef TDMA_JOIN_BACKOFF_MAX
+#define TDMA_JOIN_BACKOFF_MAX   4
+#endif
+
+/** Slot id meaning "no slot" */
+#define TDMA_SLOT_NONE      0xFF
+
+#define TDMA_BEACON_HEADER  12
+#define TDMA_BEACON_PAIRS   ((RADIO_PAYLOAD_MAX - TDMA_BEACON_HEADER) / 2)
+#define TDMA_JOIN_SIZE      2
+
+/**
+ * @brief Base station side
+ */
+typedef struct tdma_master_s
+{
+    uint16_t frame;                     /**< frame counter */
+    uint8_t cursor;                     /**< next slot announced in a beacon */
+    uint8_t owner[TDMA_SLOTS];          /**< node id per slot, index 0 unused */
+    uint8_t used[TDMA_SLOTS];           /**< slot assigned */
+    uint16_t heard[TDMA_SLOTS];         /**< frame the owner last joined or sent data in */
+    uint32_t joins;                     /**< join requests served */
+    uint32_t rejected;                  /**< join requests with no free slot */
+    uint32_t expired;                   /**< slots reclaimed after their lease ran out */
+} tdma_master_t;
+
+/**
+ * @brief Sensor node side
+ */
+typedef struct tdma_node_s
+{
+    uint8_t node_id;                    /**< own id */
+    uint8_t slot;                       /**< assigned slot or TDMA_SLOT_NONE */
+    uint8_t slots;                      /**< slots per frame from the last beacon */
+    uint16_t slot_ms;                   /**< slot length from the last beacon */
+    uint16_t frame;                     /**< frame counter from the last beacon */
+    uint64_t time_us;                   /**< network time from the last beacon */
+    uint8_t missing;                    /**< beacons in a row without the own assignment */
+    uint8_t join_wait;                  /**< beacons to let pass before the next join request */
+    uint8_t join_fails;                 /**< join requests not answered with a slot yet */
+} tdma_node_t;
+
+/**
+ * @brief     Uplink pipe used in a slot
+ * @param[in] slot Slot
+ * @return    Pipe 1 - 5
+ */
+uint8_t tdma_slot_pipe(uint8_t slot);
+
+/**
+ * @brief     Reset the master, all slots free
+ * @param[in] master Master
+ */
+void tdma_master_init(tdma_master_t *master);
+
+/**
+ * @brief     Serve a join request, a node that already owns a slot keeps it
+ * @param[in] master  Master
+ * @param[in] node_id Requesting node
+ * @return    Slot or TDMA_SLOT_NONE when all slots are taken
+ * @note      starts or renews the slot's lease
+ */
+uint8_t tdma_master_join(tdma_master_t *master, uint8_t node_id);
+
+/**
+ * @brief     Renew the lease of a node's slot on data received from it
+ * @param[in] master  Master
+ * @param[in] node_id Sender
+ * @return    0 if the node owns a slot, 1 otherwise
+ */
+uint8_t tdma_master_heard(tdma_master_t *master, uint8_t node_id);
+
+/**
+ * @brief      Reclaim expired slots, build the next beacon and advance the frame counter
+ * @param[in]  master Master
+ * @param[in]  now_us Network time, taken right before the beacon is sent
+ * @param[out] frame  Beacon payload
+ */
+void tdma_master_beacon(tdma_master_t *master, uint64_t now_us, radio_frame_t *frame);
+
+/**
+ * @brief      Decode a join payload
+ * @param[in]  frame   Payload
+ * @param[out] node_id Requesting node
+ * @return     0 on success, 1 if this is not a join payload
+ */
+uint8_t tdma_parse_join(const radio_frame_t *frame, uint8_t *node_id);
+
+/**
+ * @brief     Reset the node, no slot
+ * @param[in] node    Node
+ * @param[in] node_id Own id
+ */
+void tdma_node_init(tdma_node_t *node, uint8_t node_id);
+
+/**
+ * @brief     Feed a received payload, picks up frame timing, network time and the own slot
+ * @param[in] node  Node
+ * @param[in] frame Payload
+ * @return    0 if it was a beacon, 1 otherwise
+ * @note      the slot is dropped, so the node joins again, when another node is
+ *            announced in it or the own assignment is missing from TDMA_NODE_MISSING
+ *            beacons in a row
+ */
+uint8_t tdma_node_on_beacon(tdma_node_t *node, const radio_frame_t *frame);
+
+/**
+ * @brief     Build a join request
+ * @param[in] node  Node
+ * @param[out] frame Payload
+ */
+void tdma_node_join(const tdma_node_t *node, radio_frame_t *frame);
+
+/**
+ * @brief     Decide whether a node without a slot joins in the frame of the last beacon
+ * @param[in] node Node
+ * @return    1 to send a join request, 0 to let the frame pass
+ * @note      random backoff over a window that doubles with every unanswered
+ *            request up to 2^TDMA_JOIN_BACKOFF_MAX frames, so a crowd of nodes
+ *            powering up together does not keep the join slot jammed
+ */
+uint8_t tdma_node_join_due(tdma_node_t *node);
+
+/**
+ * @brief     Part of the join slot to send a join request in
+ * @param[in] node  Node
+ * @param[in] parts Parts the join slot is split into
+ * @return    0 - parts-1
+ * @note      changes with the frame counter of the last beacon, so nodes that
+ *            collided once are spread apart again in the next frame
+ */
+uint8_t tdma_node_join_offset(const tdma_node_t *node, uint8_t parts);
+
+/**
+ * @brief     Offset from the beacon to the start of a slot
+ * @param[in] node Node
+ * @param[in] slot Slot, 0 for the join slot
+ * @return    Milliseconds
+ */
+uint32_t tdma_node_slot_offset_ms(const tdma_node_t *node, uint8_t slot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * @file      timesync.h
+ * @brief     Network time from radio beacons: offset and drift model over the local microsecond clock
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TIMESYNC_H
+#define TIMESYNC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Prediction error beyond which the model is reset instead of corrected */
+#ifndef TIMESYNC_STEP_US
+#define TIMESYNC_STEP_US        5000
+#endif
+
+/** Largest drift accepted, crystal tolerance with margin */
+#define TIMESYNC_MAX_DRIFT_PPB  500000
+
+/** Drift correction gain, 1/N of the measured rate error per beacon */
+#define TIMESYNC_DRIFT_GAIN     2
+
+/**
+ * @brief Offset/drift model
+ *
+ * network = ref_net_us + (local - ref_local_us) * (1 + drift_ppb / 1e9)
+ *
+ * Every beacon yields one (local, network) pair. The prediction error at that
+ * point is the sync error metric; it also corrects the drift estimate, and the
+ * pair becomes the new reference.
+ */
+typedef struct timesync_s
+{
+    uint8_t synced;            /**< at least one beacon seen */
+    uint64_t ref_local_us;     /**< local time of the last beacon */
+    uint64_t ref_net_us;       /**< network time of the last beacon */
+    int32_t drift_ppb;         /**< network clock rate relative to the local one */
+    int32_t error_us;          /**< prediction error at the last beacon */
+    uint32_t max_error_us;     /**< largest absolute error since the last step */
+    uint32_t updates;          /**< beacons applied */
+    uint32_t steps;            /**< model resets on a large error */
+} timesync_t;
+
+/**
+ * @brief     Reset to unsynchronised
+ * @param[in] ts Model
+ */
+void timesync_init(timesync_t *ts);
+
+/**
+ * @brief     Apply one beacon
+ * @param[in] ts       Model
+ * @param[in] local_us Local time the beacon arrived
+ * @param[in] net_us   Network time carried by the beacon, corrected for air latency
+ */
+void timesync_update(timesync_t *ts, uint64_t local_us, uint64_t net_us);
+
+/**
+ * @brief     Convert a local timestamp
+ * @param[in] ts       Model
+ * @param[in] local_us Local time
+ * @return    Network time, local_us itself before the first beacon
+ */
+uint64_t timesync_to_network(const timesync_t *ts, uint64_t local_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,89 @@
+/**
+ * @file      topology.h
+ * @brief     Fixed 1-Wire installation: buses, pins, sensor ROMs and resolutions
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include "driver_ds18b20.h"
+
+/*
+ * The one place that describes the installation. The interface builds one
+ * bus operations table per bus from it, driver_ds18b20_dual.c its handle
+ * table and read schedule, and topology_check.cpp rejects ROMs with a bad
+ * CRC or family code at compile time. Nothing is searched for at startup.
+ */
+
+/**
+ * X(name, gpio): one 1-Wire bus, bit-banged on gpio with the internal pull-up,
+ * or run by DS2482 bridge channel ch when gpio is TOPOLOGY_DS2482(ch) (ds2482.h)
+ */
+#define TOPOLOGY_BUSES(X) \
+    X(MAIN, 4)
+
+/** Bus gpio field for a DS2482 channel */
+#define TOPOLOGY_DS2482(ch)                        (0x100 | (ch))
+#define TOPOLOGY_IS_DS2482(gpio)                   (((gpio) & 0x100) != 0)
+#define TOPOLOGY_DS2482_CHANNEL(gpio)              ((gpio) & 0xFF)
+
+/** X(arg, bus, resolution, rom0..rom7): one DS18B20; arg is passed through to X */
+#define TOPOLOGY_SENSORS(X, arg) \
+    X(arg, MAIN, DS18B20_RESOLUTION_12BIT, 0x28, 0xAE, 0x76, 0x56, 0x00, 0x00, 0x00, 0x71) \
+    X(arg, MAIN, DS18B20_RESOLUTION_12BIT, 0x28, 0x9E, 0x1C, 0x58, 0x00, 0x00, 0x00, 0x25)
+
+#define TOPOLOGY_X_BUS_ID(name, gpio)              TOPOLOGY_BUS_##name,
+#define TOPOLOGY_X_DS2482(name, gpio)              | TOPOLOGY_IS_DS2482(gpio)
+#define TOPOLOGY_X_ONE(arg, bus, res, ...)         + 1
+#define TOPOLOGY_X_ON_BUS(b, bus, res, ...)        + ((TOPOLOGY_BUS_##bus) == (b))
+#define TOPOLOGY_X_RES(b, bus, res, ...)           | ((((b) < 0) || ((TOPOLOGY_BUS_##bus) == (b))) ? (1 << (res)) : 0)
+#define TOPOLOGY_HIGHEST(mask)                     (((mask) & 8) ? 3 : ((mask) & 4) ? 2 : ((mask) & 2) ? 1 : 0)
+#define TOPOLOGY_CONVERSION_MS(res)                (((res) == 3) ? 750 : ((res) == 2) ? 375 : ((res) == 1) ? 188 : 94)
+
+/**
+ * @brief topology bus enumeration definition
+ */
+typedef enum
+{
+    TOPOLOGY_BUSES(TOPOLOGY_X_BUS_ID)
+    TOPOLOGY_BUS_COUNT
+} topology_bus_t;
+
+/** 1 when any bus is on a DS2482; usable in #if */
+#define TOPOLOGY_HAS_DS2482            (0 TOPOLOGY_BUSES(TOPOLOGY_X_DS2482))
+
+/** Sensors in the whole installation */
+#define TOPOLOGY_SENSOR_COUNT          (0 TOPOLOGY_SENSORS(TOPOLOGY_X_ONE, 0))
+
+/** Sensors on bus b */
+#define TOPOLOGY_BUS_SENSORS(b)        (0 TOPOLOGY_SENSORS(TOPOLOGY_X_ON_BUS, b))
+
+/** Highest resolution on bus b, -1 for the whole installation */
+#define TOPOLOGY_RESOLUTION(b)         TOPOLOGY_HIGHEST(0 TOPOLOGY_SENSORS(TOPOLOGY_X_RES, b))
+
+/** Sleep before polling for a conversion: 3/4 of the slowest sensor's max time */
+#define TOPOLOGY_CONVERT_SLEEP_MS      ((uint32_t)TOPOLOGY_CONVERSION_MS(TOPOLOGY_RESOLUTION(-1)) * 3 / 4)
+
+#endif
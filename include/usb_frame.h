@@ -0,0 +1,141 @@
+/**
+ * @file      usb_frame.h
+ * @brief     Binary framing for the base station USB stream
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef USB_FRAME_H
+#define USB_FRAME_H
+
+#include <stdint.h>
+#include "radio_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Frame layout (little endian):
+ *
+ *   0..1   sync      0xA5 0x5A
+ *   2      type      usb_frame_type_t
+ *   3      seq       frame counter, lets the host count dropped frames
+ *   4..5   len       payload length
+ *   6..    payload
+ *   ..     crc16     CRC-16/CCITT-FALSE over type..payload
+ */
+#define USB_FRAME_SYNC0          0xA5
+#define USB_FRAME_SYNC1          0x5A
+#define USB_FRAME_HEADER_SIZE    6
+#define USB_FRAME_CRC_SIZE       2
+#define USB_FRAME_MAX_PAYLOAD    480
+#define USB_FRAME_MAX_SIZE       (USB_FRAME_HEADER_SIZE + USB_FRAME_MAX_PAYLOAD + USB_FRAME_CRC_SIZE)
+
+/** Size of one record in a USB_FRAME_SAMPLES payload */
+#define USB_FRAME_SAMPLE_SIZE    8
+
+/** Size of one record in a USB_FRAME_HELD payload */
+#define USB_FRAME_HELD_SIZE      8
+
+/**
+ * @brief Frame type
+ */
+typedef enum
+{
+    USB_FRAME_SAMPLES        = 0x01,    /**< records: node u8, sensor u8, raw i16, time_ms u32 */
+    USB_FRAME_NODE_STATS     = 0x02,    /**< records: node u8, received u32, duplicates u32, reordered u32, lost u32 */
+    USB_FRAME_LOG            = 0x03,    /**< free text */
+    USB_FRAME_SAMPLES_PACKED = 0x04,    /**< records: node u8, len u8, sample_codec block of len bytes */
+    USB_FRAME_HELD           = 0x05,    /**< records: node u8, sensor:7 | stale:1, raw i16, age_ms u32 */
+    USB_FRAME_LOG_PAGE       = 0x06,    /**< one flash_log page, empty payload ends a dump */
+    USB_FRAME_TASK_STATS     = 0x07,    /**< per-task CPU share and stack, see rtos_stats.h */
+    USB_FRAME_OW_TRACE       = 0x08,    /**< lost u32, then ow_trace_event_t records; no records ends a dump */
+} usb_frame_type_t;
+
+/**
+ * @brief Frame under construction
+ */
+typedef struct usb_frame_s
+{
+    uint16_t len;                        /**< payload bytes so far */
+    uint8_t buf[USB_FRAME_MAX_SIZE];     /**< header, payload and crc */
+} usb_frame_t;
+
+/**
+ * @brief     Start a frame
+ * @param[in] frame Frame
+ * @param[in] type  usb_frame_type_t
+ */
+void usb_frame_begin(usb_frame_t *frame, uint8_t type);
+
+/**
+ * @brief     Append payload bytes
+ * @param[in] frame Frame
+ * @param[in] data  Bytes
+ * @param[in] len   Byte count
+ * @return    0 on success, 1 if the bytes do not fit (frame unchanged)
+ */
+uint8_t usb_frame_append(usb_frame_t *frame, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief     Append one USB_FRAME_SAMPLES record
+ * @return    0 on success, 1 if the frame is full
+ */
+uint8_t usb_frame_append_sample(usb_frame_t *frame, uint8_t node_id, uint8_t sensor,
+                                int16_t raw, uint32_t time_ms);
+
+/**
+ * @brief      Append one USB_FRAME_SAMPLES_PACKED record
+ * @param[in]  frame   Frame
+ * @param[in]  node_id Sender of the samples
+ * @param[in]  samples Samples in non-decreasing time order
+ * @param[in]  count   Number of samples
+ * @param[out] encoded Samples that fit into the record
+ * @return     0 on success, 1 if the frame is full
+ */
+uint8_t usb_frame_append_block(usb_frame_t *frame, uint8_t node_id,
+                               const radio_sample_t *samples, uint8_t count, uint8_t *encoded);
+
+/**
+ * @brief     Seal the frame with sequence number and crc
+ * @param[in] frame Frame
+ * @param[in] seq   Frame counter
+ * @return    Total frame size in frame->buf
+ */
+uint16_t usb_frame_finish(usb_frame_t *frame, uint8_t seq);
+
+/**
+ * @brief     CRC-16/CCITT-FALSE
+ * @param[in] crc  Initial value (0xFFFF)
+ * @param[in] data Bytes
+ * @param[in] len  Byte count
+ * @return    Updated crc
+ */
+uint16_t usb_frame_crc16(uint16_t crc, const uint8_t *data, uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
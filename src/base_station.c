@@ -0,0 +1,395 @@
+/**
+ * @file      base_station.c
+ * @brief     Base station firmware: IRQ-driven nRF24L01+ receive, ordering and batched USB frames
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include "radio_protocol.h"
+#include "node_table.h"
+#include "usb_frame.h"
+#include "report_policy.h"
+#include "tdma.h"
+#include "rtos_stats.h"
+
+#define RX_TASK_STACK      1024
+#define RX_TASK_PRIO       (tskIDLE_PRIORITY + 3)
+#define USB_TASK_STACK     1024
+#define USB_TASK_PRIO      (tskIDLE_PRIORITY + 1)
+
+/* In-order payloads waiting for the USB task (one burst from each of 10 nodes) */
+#ifndef BASE_FRAME_QUEUE_LEN
+#define BASE_FRAME_QUEUE_LEN   32
+#endif
+
+/* Longest time a sample waits before a partly filled USB frame is sent */
+#ifndef BASE_USB_FLUSH_MS
+#define BASE_USB_FLUSH_MS      50
+#endif
+
+/* Forward samples as delta-compressed blocks (0 selects 8-byte USB_FRAME_SAMPLES records) */
+#ifndef BASE_USB_PACKED
+#define BASE_USB_PACKED        1
+#endif
+
+#if BASE_USB_PACKED
+#define BASE_USB_SAMPLE_FRAME  USB_FRAME_SAMPLES_PACKED
+#else
+#define BASE_USB_SAMPLE_FRAME  USB_FRAME_SAMPLES
+#endif
+
+/* Period of the per-node link statistics frame */
+#ifndef BASE_STATS_PERIOD_MS
+#define BASE_STATS_PERIOD_MS   5000
+#endif
+
+/* Beacon-driven slot schedule for the nodes (0: nodes transmit whenever they like) */
+#ifndef BASE_TDMA
+#define BASE_TDMA              1
+#endif
+
+/* A held value older than this is flagged stale (node heartbeat plus its flush delay) */
+#ifndef BASE_HOLD_STALE_MS
+#define BASE_HOLD_STALE_MS     90000
+#endif
+
+static const radio_ops_t *const gs_radio = &gc_radio_nrf24l01_ops;
+static QueueHandle_t gs_frame_queue;
+static node_table_t gs_nodes;
+static uint32_t gs_queue_overflows;
+static tdma_master_t gs_tdma;
+static TaskHandle_t gs_rx_task;
+static report_hold_t gs_held[NODE_TABLE_MAX_NODES][REPORT_POLICY_MAX_SENSORS];   /* by node_table slot */
+
+/* Kernel objects, all static */
+static StaticQueue_t gs_frame_queue_buf;
+static radio_frame_t gs_frame_queue_items[BASE_FRAME_QUEUE_LEN];
+static StaticTask_t gs_rx_tcb;
+static StackType_t gs_rx_stack[RX_TASK_STACK];
+static StaticTask_t gs_usb_tcb;
+static StackType_t gs_usb_stack[USB_TASK_STACK];
+#if BASE_TDMA
+static StaticTimer_t gs_beacon_timer_buf;
+#endif
+
+static uint32_t now_ms(void)
+{
+    return to_ms_since_boot(get_absolute_time());
+}
+
+/**
+ * @brief node_table delivery: hand in-order payloads to the USB task
+ */
+static void deliver_frame(void *ctx, const radio_frame_t *frame)
+{
+    if (xQueueSend(gs_frame_queue, frame, 0) != pdPASS) {
+        gs_queue_overflows++;
+    }
+}
+
+/**
+ * @brief Frame timer (timer task context): have radio_rx_task send the beacon
+ *
+ * The radio belongs to radio_rx_task, so the timer only flags the frame start
+ * and kicks the task out of its IRQ wait.
+ */
+static void beacon_timer(TimerHandle_t timer)
+{
+    xTaskNotifyGive(gs_rx_task);
+    (void)gs_radio->kick();
+}
+
+/**
+ * @brief Wakes on the radio IRQ and drains the whole RX FIFO each time
+ *
+ * The nRF24 FIFO holds only three payloads, so the task runs at the highest
+ * application priority and does no formatting; ordering happens here, USB
+ * encoding in usb_task. It also sends the TDMA beacon when the frame timer
+ * fires and serves join requests.
+ */
+static void radio_rx_task(void *params)
+{
+    radio_frame_t frame;
+    radio_header_t header;
+    uint8_t node_id;
+
+    if ((gs_radio->init(RADIO_ROLE_BASE) != 0) || (gs_radio->listen() != 0)) {
+        vTaskDelete(NULL);
+    }
+
+    for (;;) {
+        (void)gs_radio->wait(NODE_TABLE_REORDER_MS / 2);
+        if (ulTaskNotifyTake(pdTRUE, 0) != 0) {
+            tdma_master_beacon(&gs_tdma, time_us_64(), &frame);     /* base clock is network time */
+            (void)gs_radio->broadcast(&frame);
+            (void)gs_radio->listen();
+        }
+        while (gs_radio->receive(&frame) == 0) {
+            if (tdma_parse_join(&frame, &node_id) == 0) {
+                (void)tdma_master_join(&gs_tdma, node_id);  /* announced in the next beacons */
+                continue;
+            }
+            if (radio_protocol_unpack_header(&frame, &header) != 0) {
+                continue;
+            }
+            (void)tdma_master_heard(&gs_tdma, header.node_id);     /* renew the slot lease */
+            (void)node_table_push(&gs_nodes, header.node_id, header.seq, &frame, now_ms());
+        }
+        node_table_expire(&gs_nodes, now_ms());
+    }
+}
+
+/**
+ * @brief     Write a finished frame to the USB CDC stream
+ */
+static void usb_write(usb_frame_t *frame, uint8_t *seq)
+{
+    uint16_t n = usb_frame_finish(frame, (*seq)++);
+
+    fwrite(frame->buf, 1, n, stdout);
+    fflush(stdout);
+}
+
+/**
+ * @brief     Emit one USB_FRAME_NODE_STATS frame
+ */
+static void usb_write_stats(usb_frame_t *frame, uint8_t *seq)
+{
+    uint8_t rec[17];
+
+    usb_frame_begin(frame, USB_FRAME_NODE_STATS);
+    for (uint8_t i = 0; i < NODE_TABLE_MAX_NODES; ++i) {
+        const node_entry_t *e = &gs_nodes.nodes[i];
+        const uint32_t v[4] = {e->stats.received, e->stats.duplicates, e->stats.reordered, e->stats.lost};
+        if (!e->used) {
+            continue;
+        }
+        rec[0] = e->node_id;
+        for (uint8_t k = 0; k < 4; ++k) {
+            rec[1 + 4 * k] = (uint8_t)v[k];
+            rec[2 + 4 * k] = (uint8_t)(v[k] >> 8);
+            rec[3 + 4 * k] = (uint8_t)(v[k] >> 16);
+            rec[4 + 4 * k] = (uint8_t)(v[k] >> 24);
+        }
+        if (usb_frame_append(frame, rec, sizeof(rec)) != 0) {
+            usb_write(frame, seq);
+            usb_frame_begin(frame, USB_FRAME_NODE_STATS);
+            (void)usb_frame_append(frame, rec, sizeof(rec));
+        }
+    }
+    usb_write(frame, seq);
+}
+
+/**
+ * @brief     Emit one USB_FRAME_TASK_STATS frame covering the time since the previous one
+ */
+static void usb_write_task_stats(usb_frame_t *frame, uint8_t *seq)
+{
+    static rtos_stats_t prev;
+    static rtos_stats_t now;
+
+    if (rtos_stats_snapshot(&now) != 0) {
+        return;                                         /* more tasks than RTOS_STATS_MAX_TASKS */
+    }
+    usb_frame_begin(frame, USB_FRAME_TASK_STATS);
+    (void)rtos_stats_append(frame, &now, &prev);
+    usb_write(frame, seq);
+    prev = now;
+}
+
+/**
+ * @brief     Track the last value of every sensor; nodes only report changes and heartbeats
+ */
+static void hold_update(uint8_t node_id, const radio_sample_t *samples, uint8_t count)
+{
+    const node_entry_t *e = node_table_find(&gs_nodes, node_id);
+    uint32_t now = now_ms();
+
+    if (e == NULL) {
+        return;
+    }
+    for (uint8_t i = 0; i < count; ++i) {
+        if (samples[i].sensor < REPORT_POLICY_MAX_SENSORS) {
+            report_hold_update(&gs_held[e - gs_nodes.nodes][samples[i].sensor], &samples[i], now);
+        }
+    }
+}
+
+/**
+ * @brief     Emit one USB_FRAME_HELD frame
+ */
+static void usb_write_held(usb_frame_t *frame, uint8_t *seq)
+{
+    uint8_t rec[USB_FRAME_HELD_SIZE];
+    uint32_t now = now_ms();
+    uint32_t age;
+
+    usb_frame_begin(frame, USB_FRAME_HELD);
+    for (uint8_t i = 0; i < NODE_TABLE_MAX_NODES; ++i) {
+        if (!gs_nodes.nodes[i].used) {
+            continue;
+        }
+        for (uint8_t k = 0; k < REPORT_POLICY_MAX_SENSORS; ++k) {
+            const report_hold_t *h = &gs_held[i][k];
+            if (!h->valid) {
+                continue;
+            }
+            age = report_hold_age(h, now);
+            rec[0] = gs_nodes.nodes[i].node_id;
+            rec[1] = (uint8_t)(k | ((age > BASE_HOLD_STALE_MS) ? 0x80 : 0x00));
+            rec[2] = (uint8_t)h->raw;
+            rec[3] = (uint8_t)((uint16_t)h->raw >> 8);
+            rec[4] = (uint8_t)age;
+            rec[5] = (uint8_t)(age >> 8);
+            rec[6] = (uint8_t)(age >> 16);
+            rec[7] = (uint8_t)(age >> 24);
+            if (usb_frame_append(frame, rec, sizeof(rec)) != 0) {
+                usb_write(frame, seq);
+                usb_frame_begin(frame, USB_FRAME_HELD);
+                (void)usb_frame_append(frame, rec, sizeof(rec));
+            }
+        }
+    }
+    usb_write(frame, seq);
+}
+
+/**
+ * @brief     Append decoded samples of one payload, writing out the frame whenever it fills up
+ */
+static void usb_append_samples(usb_frame_t *frame, uint8_t *seq, uint8_t node_id,
+                               const radio_sample_t *samples, uint8_t count)
+{
+    uint8_t i = 0;
+    uint8_t n;
+
+    while (i < count) {
+#if BASE_USB_PACKED
+        if (usb_frame_append_block(frame, node_id, &samples[i], (uint8_t)(count - i), &n) == 0) {
+            i += n;
+            continue;
+        }
+#else
+        if (usb_frame_append_sample(frame, node_id, samples[i].sensor,
+                                    samples[i].raw, samples[i].time_ms) == 0) {
+            i++;
+            continue;
+        }
+#endif
+        if (frame->len == 0) {
+            i++;                                        /* not encodable even in an empty frame */
+            continue;
+        }
+        usb_write(frame, seq);
+        usb_frame_begin(frame, BASE_USB_SAMPLE_FRAME);
+    }
+}
+
+/**
+ * @brief Packs in-order samples from all nodes into sample frames
+ */
+static void usb_task(void *params)
+{
+    static usb_frame_t frame;
+    static usb_frame_t stats;
+    radio_frame_t payload;
+    radio_header_t header;
+    radio_sample_t samples[RADIO_PROTOCOL_MAX_PACKED];
+    uint8_t count;
+    uint8_t seq = 0;
+    TickType_t flush_at = 0;
+    TickType_t stats_at = xTaskGetTickCount() + pdMS_TO_TICKS(BASE_STATS_PERIOD_MS);
+    TickType_t wait;
+
+    /* Frames are binary: no \n -> \r\n rewriting */
+    stdio_set_translate_crlf(&stdio_usb, false);
+    usb_frame_begin(&frame, BASE_USB_SAMPLE_FRAME);
+
+    for (;;) {
+        wait = pdMS_TO_TICKS(BASE_USB_FLUSH_MS);
+        if (frame.len != 0) {
+            wait = ((TickType_t)(flush_at - xTaskGetTickCount()) <= wait) ? (flush_at - xTaskGetTickCount()) : 0;
+        }
+
+        if (xQueueReceive(gs_frame_queue, &payload, wait) == pdPASS) {
+            if (radio_protocol_unpack_samples(&payload, &header, samples, &count) == 0) {
+                if (frame.len == 0) {
+                    flush_at = xTaskGetTickCount() + pdMS_TO_TICKS(BASE_USB_FLUSH_MS);
+                }
+                hold_update(header.node_id, samples, count);
+                usb_append_samples(&frame, &seq, header.node_id, samples, count);
+            }
+            /* A steady stream never lets the receive time out: flush on the deadline too */
+            if ((frame.len != 0) && ((int32_t)(xTaskGetTickCount() - flush_at) >= 0)) {
+                usb_write(&frame, &seq);
+                usb_frame_begin(&frame, BASE_USB_SAMPLE_FRAME);
+            }
+        } else if (frame.len != 0) {
+            usb_write(&frame, &seq);
+            usb_frame_begin(&frame, BASE_USB_SAMPLE_FRAME);
+        }
+
+        if ((int32_t)(xTaskGetTickCount() - stats_at) >= 0) {
+            usb_write_stats(&stats, &seq);
+            usb_write_held(&stats, &seq);
+            usb_write_task_stats(&stats, &seq);
+            stats_at += pdMS_TO_TICKS(BASE_STATS_PERIOD_MS);
+        }
+    }
+}
+
+int main(void)
+{
+    /* Initialize stdio over USB/UART */
+    stdio_init_all();
+
+    node_table_init(&gs_nodes, deliver_frame, NULL);
+    tdma_master_init(&gs_tdma);
+    gs_frame_queue = xQueueCreateStatic(BASE_FRAME_QUEUE_LEN, sizeof(radio_frame_t),
+                                        (uint8_t *)gs_frame_queue_items, &gs_frame_queue_buf);
+    gs_rx_task = xTaskCreateStatic(radio_rx_task, "radio_rx", RX_TASK_STACK, NULL, RX_TASK_PRIO,
+                                   gs_rx_stack, &gs_rx_tcb);
+    (void)xTaskCreateStatic(usb_task, "usb_tx", USB_TASK_STACK, NULL, USB_TASK_PRIO, gs_usb_stack, &gs_usb_tcb);
+
+#if BASE_TDMA
+    {
+        TimerHandle_t timer = xTimerCreateStatic("beacon", pdMS_TO_TICKS(TDMA_FRAME_MS), pdTRUE, NULL,
+                                                 beacon_timer, &gs_beacon_timer_buf);
+        if (xTimerStart(timer, 0) != pdPASS) {
+            while (1) { tight_loop_contents(); }
+        }
+    }
+#endif
+
+    /* Start the FreeRTOS scheduler */
+    vTaskStartScheduler();
+
+    /* Should never reach here */
+    for (;;) { tight_loop_contents(); }
+}
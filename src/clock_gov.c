@@ -0,0 +1,126 @@
+/**
+ * @file      clock_gov.c
+ * @brief     System clock governor, lowers clk_sys during long waits
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "clock_gov.h"
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define CLOCK_GOV_PLL_USB_HZ    (48u * 1000u * 1000u)
+
+#if (48000 % CLOCK_GOV_LOW_KHZ) != 0
+#error "CLOCK_GOV_LOW_KHZ must divide 48000"
+#endif
+
+static uint32_t gs_full_hz;
+static clock_gov_level_t gs_level;
+static uint64_t gs_since_us;
+static clock_gov_stats_t gs_stats;
+
+uint8_t clock_gov_init(void)
+{
+    if (!clock_configure(clk_peri, 0, CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB,
+                         CLOCK_GOV_PLL_USB_HZ, CLOCK_GOV_PLL_USB_HZ)) {
+        return 1;
+    }
+    gs_full_hz = clock_get_hz(clk_sys);
+    gs_level = CLOCK_GOV_FULL;
+    gs_since_us = time_us_64();
+    return 0;
+}
+
+uint8_t clock_gov_set(clock_gov_level_t level)
+{
+    uint32_t start;
+    uint32_t took;
+    uint64_t now;
+    bool ok;
+
+    if (gs_full_hz == 0) {
+        return 1;                                       /* not initialised */
+    }
+    if (level == gs_level) {
+        return 0;
+    }
+    start = time_us_32();
+    taskENTER_CRITICAL();
+    if (level == CLOCK_GOV_LOW) {
+        ok = clock_configure(clk_sys, CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX,
+                             CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB,
+                             CLOCK_GOV_PLL_USB_HZ, CLOCK_GOV_LOW_KHZ * 1000u);
+    } else {
+        ok = clock_configure(clk_sys, CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX,
+                             CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS,
+                             gs_full_hz, gs_full_hz);
+    }
+    if (ok) {
+        now = time_us_64();
+        gs_stats.level_us[gs_level] += now - gs_since_us;
+        gs_since_us = now;
+        gs_level = level;
+        gs_stats.transitions++;
+        took = time_us_32() - start;
+        if (took > gs_stats.max_switch_us) {
+            gs_stats.max_switch_us = took;
+        }
+    } else {
+        gs_stats.errors++;
+    }
+    taskEXIT_CRITICAL();
+    if (!ok) {
+        return 1;
+    }
+
+#if CLOCK_GOV_MEASURE
+    {
+        uint32_t expected = (level == CLOCK_GOV_LOW) ? CLOCK_GOV_LOW_KHZ : (gs_full_hz / 1000u);
+        uint32_t khz = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_SYS);
+        uint32_t diff = (khz > expected) ? (khz - expected) : (expected - khz);
+
+        gs_stats.checks++;
+        gs_stats.last_khz = khz;
+        if (diff * 1000u > expected * CLOCK_GOV_TOLERANCE) {
+            gs_stats.check_errors++;
+        }
+    }
+#endif
+    return 0;
+}
+
+clock_gov_level_t clock_gov_level(void)
+{
+    return gs_level;
+}
+
+void clock_gov_get_stats(clock_gov_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = gs_stats;
+    stats->level_us[gs_level] += time_us_64() - gs_since_us;
+    taskEXIT_CRITICAL();
+}
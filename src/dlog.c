@@ -0,0 +1,206 @@
+/**
+ * @file      dlog.c
+ * @brief     Deferred binary logging: call sites store a message id and arguments, a task formats them later
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "dlog.h"
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/** Poll period of the print task */
+#ifndef DLOG_TASK_PERIOD_MS
+#define DLOG_TASK_PERIOD_MS    100
+#endif
+
+#define DLOG_TASK_STACK        512
+
+/** 1 to time dlog_write() against formatting the same message when the task starts */
+#ifndef DLOG_BENCH
+#define DLOG_BENCH             0
+#endif
+
+#define DLOG_X_TEXT(name, level, text)    text,
+
+static const char *const gc_dlog_text[DLOG_COUNT] = { DLOG_MESSAGES(DLOG_X_TEXT) };
+
+/**
+ * @brief One core's ring; the core's tasks and ISRs write, one task reads
+ */
+typedef struct dlog_ring_s
+{
+    volatile uint32_t head;              /**< next write, owned by the producer core */
+    volatile uint32_t tail;              /**< next read, owned by the consumer */
+    uint32_t dropped;                    /**< records lost to a full ring */
+    dlog_record_t buf[DLOG_SIZE];        /**< records */
+} dlog_ring_t;
+
+static dlog_ring_t gs_rings[DLOG_CORES];
+
+void dlog_write(uint16_t id, uint32_t arg0, uint32_t arg1)
+{
+    dlog_ring_t *r;
+    dlog_record_t *rec;
+    uint32_t irq;
+    uint32_t head;
+    uint core;
+
+    irq = save_and_disable_interrupts();        /* only this core writes the ring */
+    core = get_core_num();                      /* no migration once interrupts are off */
+    r = &gs_rings[core];
+    head = r->head;
+    if ((head - r->tail) >= DLOG_SIZE) {
+        r->dropped++;
+    } else {
+        rec = &r->buf[head & (DLOG_SIZE - 1)];
+        rec->time_us = time_us_32();
+        rec->id = id;
+        rec->core = (uint8_t)core;
+        rec->reserved = 0;
+        rec->arg[0] = arg0;
+        rec->arg[1] = arg1;
+        __dmb();                                /* record visible before the index */
+        r->head = head + 1;
+    }
+    restore_interrupts(irq);
+}
+
+uint16_t dlog_read(uint8_t core, dlog_record_t *out, uint16_t max)
+{
+    dlog_ring_t *r = &gs_rings[core];
+    uint32_t tail = r->tail;
+    uint32_t n = r->head - tail;
+
+    __dmb();
+    if (n > max) {
+        n = max;
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+        out[i] = r->buf[(tail + i) & (DLOG_SIZE - 1)];
+    }
+    __dmb();                                    /* copied before the slots are released */
+    r->tail = tail + n;
+    return (uint16_t)n;
+}
+
+uint32_t dlog_dropped(uint8_t core)
+{
+    return gs_rings[core].dropped;
+}
+
+uint16_t dlog_format(const dlog_record_t *rec, char *buf, uint16_t len)
+{
+    int n;
+    int m;
+
+    n = snprintf(buf, len, "[%lu.%06lu c%u] ", (unsigned long)(rec->time_us / 1000000u),
+                 (unsigned long)(rec->time_us % 1000000u), rec->core);
+    if ((n < 0) || (n >= len)) {
+        return (uint16_t)((len == 0) ? 0 : (len - 1));
+    }
+    if (rec->id < DLOG_COUNT) {
+        m = snprintf(&buf[n], len - n, gc_dlog_text[rec->id],
+                     (unsigned long)rec->arg[0], (unsigned long)rec->arg[1]);
+    } else {
+        m = snprintf(&buf[n], len - n, "dlog: unknown id %u", rec->id);
+    }
+    if (m < 0) {
+        m = 0;
+    }
+    n += m;
+    return (uint16_t)((n >= len) ? (len - 1) : n);
+}
+
+#if DLOG_BENCH
+/**
+ * @brief Print the cost of a deferred record next to formatting the same text
+ */
+static void a_dlog_bench(void)
+{
+    char text[96];
+    dlog_record_t rec = { 0 };
+    uint32_t start;
+    uint32_t write_us;
+    uint32_t format_us;
+    const uint32_t n = 1000;
+
+    start = time_us_32();
+    for (uint32_t i = 0; i < n; ++i) {
+        dlog_write(DLOG_DS18B20_WRITE_CMD_FAILED, i, 0);
+        (void)dlog_read(get_core_num(), &rec, 1);
+    }
+    write_us = time_us_32() - start;
+    start = time_us_32();
+    for (uint32_t i = 0; i < n; ++i) {
+        (void)dlog_format(&rec, text, sizeof(text));
+    }
+    format_us = time_us_32() - start;
+    printf("dlog: %lu ns per write+read, %lu ns per format (stdio output comes on top)\r\n",
+           (unsigned long)write_us, (unsigned long)format_us);
+}
+#endif
+
+/**
+ * @brief Prints both rings, then sleeps DLOG_TASK_PERIOD_MS
+ */
+static void a_dlog_task(void *params)
+{
+    dlog_record_t rec[8];
+    char text[96];
+    uint32_t dropped[DLOG_CORES] = { 0 };
+    uint16_t n;
+
+#if DLOG_BENCH
+    a_dlog_bench();
+#endif
+    for (;;) {
+        for (uint8_t core = 0; core < DLOG_CORES; ++core) {
+            while ((n = dlog_read(core, rec, sizeof(rec) / sizeof(rec[0]))) != 0) {
+                for (uint16_t i = 0; i < n; ++i) {
+                    (void)dlog_format(&rec[i], text, sizeof(text));
+                    printf("%s\r\n", text);
+                }
+            }
+            if (dlog_dropped(core) != dropped[core]) {
+                dropped[core] = dlog_dropped(core);
+                printf("dlog: core %u dropped %lu records\r\n", core, (unsigned long)dropped[core]);
+            }
+        }
+        vTaskDelay(pdMS_TO_TICKS(DLOG_TASK_PERIOD_MS));
+    }
+}
+
+uint8_t dlog_task_create(uint32_t priority)
+{
+    static StaticTask_t tcb;
+    static StackType_t stack[DLOG_TASK_STACK];
+
+    if (xTaskCreateStatic(a_dlog_task, "dlog", DLOG_TASK_STACK, NULL, (UBaseType_t)priority, stack, &tcb) == NULL) {
+        return 1;
+    }
+    return 0;
+}
@@ -36,6 +36,8 @@
  */
 
 #include "driver_ds18b20.h"
+#include "ow_trace.h"
+#include "dlog.h"
 
 /**
  * @brief chip information definition
@@ -64,6 +66,11 @@
 #define DS18B20_CMD_RECALL_EE                0xB8        /**< recall ee command */
 #define DS18B20_CMD_READ_POWER_SUPPLY        0xB4        /**< read power supply command */
 
+/**
+ * @brief deferred log of a dlog_msgs.h DS18B20_* message, tagged with the rom crc byte
+ */
+#define DS18B20_LOG(handle, id)              DLOG1(DS18B20_##id, (handle)->rom[7])
+
 /**
  * @brief crc table
  */
@@ -91,6 +98,14 @@ const uint8_t gc_ds18b20_crc_table[256] =
     0XF7, 0XB6, 0XE8, 0X0A, 0X54, 0XD7, 0X89, 0X6B, 0X35,
 };
 
+/**
+ * @brief max conversion time in ms, indexed by resolution
+ */
+const uint16_t gc_ds18b20_conversion_ms[4] =
+{
+    94, 188, 375, 750,
+};
+
 /**
  * @brief     check the crc
  * @param[in] *buf pointer to a data buffer
@@ -116,6 +131,8 @@ static uint8_t a_ds18b20_check_crc(uint8_t *buf, uint8_t len, uint8_t crc)
     }
     else
     {
+        OW_TRACE(OW_TRACE_CRC, crc, 1);                    /* trace mismatch */
+        
         return 1;                                          /* return wrong */
     }
 }
@@ -130,71 +147,92 @@ static uint8_t a_ds18b20_check_crc(uint8_t *buf, uint8_t len, uint8_t crc)
  */
 static uint8_t a_ds18b20_reset(ds18b20_handle_t *handle)
 {
+    const ds18b20_timing_t *t = handle->bus->timing;
     uint8_t retry = 0;
+    uint8_t presence = 0;
     uint8_t res;
     
-    handle->disable_irq();                                              /* disable irq */
-    if (handle->bus_write(0) != 0)                                      /* write 0 */
+    if (handle->bus->bus_reset != NULL)                                 /* edge capture reset */
+    {
+        res = handle->bus->bus_reset(&presence, &handle->presence_width);   /* fixed duration, may sleep */
+        if (res != 0)                                                   /* no presence or stuck low */
+        {
+            OW_TRACE(OW_TRACE_RESET, presence, res);                    /* trace failure */
+            DS18B20_LOG(handle, NO_RESPONSE);                           /* no response */
+            
+            return 1;                                                   /* return error */
+        }
+        OW_TRACE(OW_TRACE_RESET, presence, 0);                          /* trace presence */
+        
+        return 0;                                                       /* success return 0 */
+    }
+    handle->bus->disable_irq();                                         /* disable irq */
+    if (handle->bus->bus_write(0) != 0)                                 /* write 0 */
     {
-        handle->enable_irq();                                           /* enable irq */
-        handle->debug_print("ds18b20: bus write failed.\n");            /* write failed */
+        handle->bus->enable_irq();                                      /* enable irq */
+        DS18B20_LOG(handle, BUS_WRITE_FAILED);                          /* write failed */
         
         return 1;                                                       /* return error */
     }
-    handle->delay_us(750);                                              /* wait 750 us */
-    if (handle->bus_write(1) != 0)                                      /* write 1 */
+    handle->bus->delay_us(t->reset_low_us);                             /* reset pulse */
+    if (handle->bus->bus_write(1) != 0)                                 /* write 1 */
     {
-        handle->enable_irq();                                           /* enable irq */
-        handle->debug_print("ds18b20: bus write failed.\n");            /* write failed */
+        handle->bus->enable_irq();                                      /* enable irq */
+        DS18B20_LOG(handle, BUS_WRITE_FAILED);                          /* write failed */
         
         return 1;                                                       /* return error */
     }
-    handle->delay_us(15);                                               /* wait 15 us */
+    handle->bus->delay_us(t->presence_wait_us);                         /* wait for presence */
     res = 1;                                                            /* reset res */
-    while ((res != 0) && (retry < 200))                                 /* wait 200 us */
+    while ((res != 0) && (retry < t->presence_max_us))                  /* wait for presence start */
     {
-        if (handle->bus_read((uint8_t *)&res) != 0)                     /* read 1 bit */
+        if (handle->bus->bus_read((uint8_t *)&res) != 0)                /* read 1 bit */
         {
-            handle->enable_irq();                                       /* enable irq */
-            handle->debug_print("ds18b20: bus read failed.\n");         /* read failed */
+            handle->bus->enable_irq();                                  /* enable irq */
+            DS18B20_LOG(handle, BUS_READ_FAILED);                       /* read failed */
             
             return 1;                                                   /* return error */
         }
         retry++;                                                        /* retry times++ */
-        handle->delay_us(1);                                            /* delay 1 us */
+        handle->bus->delay_us(1);                                       /* delay 1 us */
     }
-    if (retry >= 200)                                                   /* if retry times is over 200 times */
+    if (retry >= t->presence_max_us)                                    /* if no presence */
     {
-        handle->enable_irq();                                           /* enable irq */
-        handle->debug_print("ds18b20: bus read no response.\n");        /* no response */
+        handle->bus->enable_irq();                                      /* enable irq */
+        OW_TRACE(OW_TRACE_RESET, 0, 1);                                 /* trace no presence */
+        DS18B20_LOG(handle, NO_RESPONSE);                               /* no response */
         
         return 1;                                                       /* return error */
     }
     else
     {
+        presence = retry;                                               /* save presence delay */
         retry = 0;                                                      /* reset retry */
     }
     res = 0;                                                            /* reset res */
-    while ((res == 0)&& (retry < 240))                                  /* wait 240 us */
+    while ((res == 0)&& (retry < t->presence_end_us))                   /* wait for presence end */
     {
-        if (handle->bus_read((uint8_t *)&res) != 0)                     /* read one bit */
+        if (handle->bus->bus_read((uint8_t *)&res) != 0)                /* read one bit */
         {
-            handle->enable_irq();                                       /* enable irq */
-            handle->debug_print("ds18b20: bus read failed.\n");         /* read failed */
+            handle->bus->enable_irq();                                  /* enable irq */
+            DS18B20_LOG(handle, BUS_READ_FAILED);                       /* read failed */
             
             return 1;                                                   /* return error */
         }
         retry++;                                                        /* retry times++ */
-        handle->delay_us(1);                                            /* delay 1 us */
+        handle->bus->delay_us(1);                                       /* delay 1 us */
     }
-    if (retry >= 240)                                                   /* if retry times is over 240 times */
+    if (retry >= t->presence_end_us)                                    /* if bus stays low */
     {
-        handle->enable_irq();                                           /* enable irq */
-        handle->debug_print("ds18b20: bus read no response.\n");        /* no response */
+        handle->bus->enable_irq();                                      /* enable irq */
+        OW_TRACE(OW_TRACE_RESET, presence, 2);                          /* trace bus stuck low */
+        DS18B20_LOG(handle, NO_RESPONSE);                               /* no response */
         
         return 1;                                                       /* return error */
     }
-    handle->enable_irq();                                               /* enable irq */
+    handle->presence_width = retry;                                     /* save presence width */
+    handle->bus->enable_irq();                                          /* enable irq */
+    OW_TRACE(OW_TRACE_RESET, presence, 0);                              /* trace presence */
     
     return 0;                                                           /* success return 0 */
 }
@@ -210,27 +248,41 @@ static uint8_t a_ds18b20_reset(ds18b20_handle_t *handle)
  */
 static uint8_t a_ds18b20_read_bit(ds18b20_handle_t *handle, uint8_t *data)
 {
-    if (handle->bus_write(0) != 0)                                  /* write 0 */
+    const ds18b20_timing_t *t = handle->bus->timing;
+    uint8_t one = 1;
+    
+    if (handle->bus->bus_touch != NULL)                             /* slot transfer */
+    {
+        if (handle->bus->bus_touch(&one, data, 1) != 0)             /* one read slot */
+        {
+            DS18B20_LOG(handle, BUS_READ_FAILED);                   /* read failed */
+            
+            return 1;                                               /* return error */
+        }
+        
+        return 0;                                                   /* success return 0 */
+    }
+    if (handle->bus->bus_write(0) != 0)                             /* write 0 */
     {
-        handle->debug_print("ds18b20: bus write failed.\n");        /* write failed */
+        DS18B20_LOG(handle, BUS_WRITE_FAILED);                      /* write failed */
         
         return 1;                                                   /* return error */
     }
-    handle->delay_us(2);                                            /* wait 2 us */
-    if (handle->bus_write(1) != 0)                                  /* write 1 */
+    handle->bus->delay_us(t->read_low_us);                          /* start slot */
+    if (handle->bus->bus_write(1) != 0)                             /* write 1 */
     {
-        handle->debug_print("ds18b20: bus write failed.\n");        /* write failed */
+        DS18B20_LOG(handle, BUS_WRITE_FAILED);                      /* write failed */
         
         return 1;                                                   /* return error */
     }
-    handle->delay_us(12);                                           /* wait 12 us */
-    if (handle->bus_read(data) != 0)                                /* read 1 bit */
+    handle->bus->delay_us(t->read_sample_us);                       /* wait for sample point */
+    if (handle->bus->bus_read(data) != 0)                           /* read 1 bit */
     {
-        handle->debug_print("ds18b20: bus read failed.\n");         /* read failed */
+        DS18B20_LOG(handle, BUS_READ_FAILED);                       /* read failed */
         
         return 1;                                                   /* return error */
     }
-    handle->delay_us(50);                                           /* wait 50 us */
+    handle->bus->delay_us(t->read_high_us);                         /* rest of slot */
     
     return 0;                                                       /* success return 0 */
 }
@@ -249,19 +301,33 @@ static uint8_t a_ds18b20_read_byte(ds18b20_handle_t *handle, uint8_t *byte)
     uint8_t i, j;
     
     *byte = 0;                                                              /* set byte 0 */
-    handle->disable_irq();                                                  /* disable irq */
+    if (handle->bus->bus_touch != NULL)                                     /* slot transfer */
+    {
+        j = 0xFF;                                                           /* 8 read slots */
+        if (handle->bus->bus_touch(&j, byte, 8) != 0)                       /* read 8 bits */
+        {
+            DS18B20_LOG(handle, BUS_READ_BYTE_FAILED);                      /* read byte failed */
+            
+            return 1;                                                       /* return error */
+        }
+        OW_TRACE(OW_TRACE_READ, *byte, 0);                                  /* trace byte */
+        
+        return 0;                                                           /* success return 0 */
+    }
+    handle->bus->disable_irq();                                             /* disable irq */
     for (i = 1; i <= 8; i++)
     {
         if (a_ds18b20_read_bit(handle, (uint8_t *)&j) != 0)                 /* read 1 bit */
         {
-            handle->enable_irq();                                           /* enable irq */
-            handle->debug_print("ds18b20: bus read byte failed.\n");        /* read byte failed */
+            handle->bus->enable_irq();                                      /* enable irq */
+            DS18B20_LOG(handle, BUS_READ_BYTE_FAILED);                      /* read byte failed */
             
             return 1;                                                       /* return error */
         }
         *byte = (j << 7) | ((*byte) >> 1);                                  /* set MSB */
     }
-    handle->enable_irq();                                                   /* enable irq */
+    handle->bus->enable_irq();                                              /* enable irq */
+    OW_TRACE(OW_TRACE_READ, *byte, 0);                                      /* trace byte */
     
     return 0;                                                               /* success return 0 */
 }
@@ -277,58 +343,315 @@ static uint8_t a_ds18b20_read_byte(ds18b20_handle_t *handle, uint8_t *byte)
  */
 static uint8_t a_ds18b20_write_byte(ds18b20_handle_t *handle, uint8_t byte)
 {
+    const ds18b20_timing_t *t = handle->bus->timing;
     uint8_t j;
     uint8_t test_b;
     
-    handle->disable_irq();                                                  /* disable irq */
+    OW_TRACE(OW_TRACE_WRITE, byte, 0);                                      /* trace byte */
+    if (handle->bus->bus_touch != NULL)                                     /* slot transfer */
+    {
+        if (handle->bus->bus_touch(&byte, NULL, 8) != 0)                    /* write 8 bits */
+        {
+            DS18B20_LOG(handle, BUS_WRITE_FAILED);                          /* write failed */
+            
+            return 1;                                                       /* return error */
+        }
+        
+        return 0;                                                           /* success return 0 */
+    }
+    handle->bus->disable_irq();                                             /* disable irq */
     for (j = 1; j <= 8; j++)                                                /* run 8 times, 8 bits = 1 Byte */
     {
         test_b = byte & 0x01;                                               /* get 1 bit */
         byte = byte >> 1;                                                   /* right shift 1 bit */
         if (test_b != 0)                                                    /* write 1 */
         {
-            if (handle->bus_write(0) != 0)                                  /* write 0 */
+            if (handle->bus->bus_write(0) != 0)                             /* write 0 */
             {
-                handle->enable_irq();                                       /* enable irq */
-                handle->debug_print("ds18b20: bus write failed.\n");        /* write failed */
+                handle->bus->enable_irq();                                  /* enable irq */
+                DS18B20_LOG(handle, BUS_WRITE_FAILED);                      /* write failed */
                 
                 return 1;                                                   /* return error */
             }
-            handle->delay_us(2);                                            /* wait 2 us */
-            if (handle->bus_write(1) != 0)                                  /* write 1 */
+            handle->bus->delay_us(t->write1_low_us);                        /* write 1 low time */
+            if (handle->bus->bus_write(1) != 0)                             /* write 1 */
             {
-                handle->enable_irq();                                       /* enable irq */
-                handle->debug_print("ds18b20: bus write failed.\n");        /* write failed */
+                handle->bus->enable_irq();                                  /* enable irq */
+                DS18B20_LOG(handle, BUS_WRITE_FAILED);                      /* write failed */
                 
                 return 1;                                                   /* return error */
             }
-            handle->delay_us(60);                                           /* wait 60 us */
+            handle->bus->delay_us(t->write1_high_us);                       /* rest of slot */
         }
         else                                                                /* write 0 */
         {
-            if (handle->bus_write(0) != 0)                                  /* write 0 */
+            if (handle->bus->bus_write(0) != 0)                             /* write 0 */
             {
-                handle->enable_irq();                                       /* enable irq */
-                handle->debug_print("ds18b20: bus write failed.\n");        /* write failed */
+                handle->bus->enable_irq();                                  /* enable irq */
+                DS18B20_LOG(handle, BUS_WRITE_FAILED);                      /* write failed */
                 
                 return 1;                                                   /* return error */
             }
-            handle->delay_us(60);                                           /* wait 60 us */
-            if (handle->bus_write(1) != 0)                                  /* write 1 */
+            handle->bus->delay_us(t->write0_low_us);                        /* write 0 low time */
+            if (handle->bus->bus_write(1) != 0)                             /* write 1 */
             {
-                handle->enable_irq();                                       /* enable irq */
-                handle->debug_print("ds18b20: bus write failed.\n");        /* write failed */
+                handle->bus->enable_irq();                                  /* enable irq */
+                DS18B20_LOG(handle, BUS_WRITE_FAILED);                      /* write failed */
                 
                 return 1;                                                   /* return error */
             }
-            handle->delay_us(2);                                            /* wait 2 us */
+            handle->bus->delay_us(t->write0_high_us);                       /* recovery */
         }
     }
-    handle->enable_irq();                                                   /* enable irq */
+    handle->bus->enable_irq();                                              /* enable irq */
     
     return 0;                                                               /* success return 0 */
 }
 
+/**
+ * @brief      read a block of bytes from the chip
+ * @param[in]  *handle pointer to a ds18b20 handle structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len buffer length, at most 16
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       a bus_touch op reads the whole block in one transfer
+ */
+static uint8_t a_ds18b20_read_bytes(ds18b20_handle_t *handle, uint8_t *buf, uint8_t len)
+{
+    uint8_t i;
+    uint8_t ones[16];
+    
+    if ((handle->bus->bus_touch != NULL) && (len <= sizeof(ones)))              /* slot transfer */
+    {
+        memset(ones, 0xFF, len);                                                /* read slots only */
+        if (handle->bus->bus_touch(ones, buf, (uint16_t)(len * 8)) != 0)        /* read all bits */
+        {
+            DS18B20_LOG(handle, BUS_READ_BYTE_FAILED);                          /* read failed */
+            
+            return 1;                                                           /* return error */
+        }
+        for (i = 0; i < len; i++)
+        {
+            OW_TRACE(OW_TRACE_READ, buf[i], 0);                                 /* trace byte */
+        }
+        
+        return 0;                                                               /* success return 0 */
+    }
+    for (i = 0; i < len; i++)
+    {
+        if (a_ds18b20_read_byte(handle, &buf[i]) != 0)                          /* read byte */
+        {
+            return 1;                                                           /* return error */
+        }
+    }
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     wait for a started temperature conversion to finish
+ * @param[in] *handle pointer to a ds18b20 handle structure
+ * @param[in] sleep_ms time to sleep before polling, at most 750 ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait conversion failed
+ * @note      sleeping through most of the conversion lets the caller's core idle
+ *            instead of polling
+ */
+static uint8_t a_ds18b20_wait_conversion(ds18b20_handle_t *handle, uint32_t sleep_ms)
+{
+    uint8_t res;
+    uint16_t cnt;
+    uint16_t max_cnt;
+    
+    if (sleep_ms > 750)                                                         /* keep room for polling */
+    {
+        sleep_ms = 750;                                                         /* longest conversion */
+    }
+    if (sleep_ms != 0)                                                          /* check sleep */
+    {
+        handle->bus->delay_ms(sleep_ms);                                        /* sleep */
+    }
+    max_cnt = (uint16_t)((1000 - sleep_ms) / 10);                               /* poll for the rest of 1 s */
+    cnt = 0;                                                                    /* reset cnt */
+    res = 0;                                                                    /* reset res */
+    while ((res == 0) && (cnt < max_cnt))                                       /* wait 1 s in total */
+    {
+        if (a_ds18b20_read_bit(handle, (uint8_t *)&res) != 0)                   /* read 1 bit */
+        {
+            DS18B20_LOG(handle, READ_BIT_FAILED);                               /* read a bit failed */
+            
+            return 1;                                                           /* return error */
+        }
+        if (res != 0)                                                           /* conversion done */
+        {
+            break;                                                              /* break */
+        }
+        handle->bus->delay_ms(10);                                              /* delay 10 ms */
+        cnt++;                                                                  /* cnt++ */
+    }
+    if (cnt >= max_cnt)                                                         /* if timeout */
+    {
+        OW_TRACE(OW_TRACE_CONVERT, cnt, 1);                                     /* trace timeout */
+        DS18B20_LOG(handle, CONVERT_TIMEOUT);                                   /* bus read timeout */
+        
+        return 1;                                                               /* return error */
+    }
+    OW_TRACE(OW_TRACE_CONVERT, cnt, 0);                                         /* trace conversion done */
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     reset the bus and address the chip in the handle's mode
+ * @param[in] *handle pointer to a ds18b20 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ * @note      none
+ */
+static uint8_t a_ds18b20_select(ds18b20_handle_t *handle)
+{
+    uint8_t i;
+    
+    if ((handle->mode != DS18B20_MODE_SKIP_ROM) && (handle->mode != DS18B20_MODE_MATCH_ROM))  /* check mode */
+    {
+        DS18B20_LOG(handle, MODE_INVALID);                                      /* ds18b20 mode is invalid */
+        
+        return 1;                                                               /* return error */
+    }
+    if (a_ds18b20_reset(handle) != 0)                                           /* reset bus */
+    {
+        DS18B20_LOG(handle, BUS_RESET_FAILED);                                  /* bus reset failed */
+        
+        return 1;                                                               /* return error */
+    }
+    if (handle->mode == DS18B20_MODE_SKIP_ROM)                                  /* if use skip rom mode */
+    {
+        if (a_ds18b20_write_byte(handle, DS18B20_CMD_SKIP_ROM) != 0)            /* sent skip rom command */
+        {
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
+            
+            return 1;                                                           /* return error */
+        }
+        
+        return 0;                                                               /* success return 0 */
+    }
+    if (a_ds18b20_write_byte(handle, DS18B20_CMD_MATCH_ROM) != 0)               /* sent match rom command */
+    {
+        DS18B20_LOG(handle, WRITE_CMD_FAILED);                                  /* write command failed */
+        
+        return 1;                                                               /* return error */
+    }
+    for (i = 0; i < 8; i++)
+    {
+        if (a_ds18b20_write_byte(handle, handle->rom[i]) != 0)                  /* send rom */
+        {
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
+            
+            return 1;                                                           /* return error */
+        }
+    }
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      read the scratchpad and decode the last conversion
+ * @param[in]  *handle pointer to a ds18b20 handle structure
+ * @param[out] *raw pointer to a raw adc buffer
+ * @param[out] *temp pointer to a converted temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_ds18b20_read_temperature(ds18b20_handle_t *handle, int16_t *raw, float *temp)
+{
+    uint8_t buf[9];
+    
+    if (a_ds18b20_select(handle) != 0)                                          /* address chip */
+    {
+        return 1;                                                               /* return error */
+    }
+    if (a_ds18b20_write_byte(handle, DS18B20_CMD_READ_SCRATCHPAD) != 0)         /* write read scratchpad command */
+    {
+        DS18B20_LOG(handle, WRITE_CMD_FAILED);                                  /* write command failed */
+        
+        return 1;                                                               /* return error */
+    }
+    if (a_ds18b20_read_bytes(handle, buf, 9) != 0)                              /* read 9 bytes */
+    {
+        DS18B20_LOG(handle, READ_BYTE_FAILED);                                  /* read byte failed */
+        
+        return 1;                                                               /* return error */
+    }
+    handle->bus->timing->frames++;                                              /* count frame */
+    if (a_ds18b20_check_crc((uint8_t *)buf, 8, buf[8]) != 0)                    /* check crc */
+    {
+        handle->bus->timing->crc_errors++;                                      /* count error */
+        DS18B20_LOG(handle, CRC_ERROR);                                         /* crc check failed */
+        
+        return 1;                                                               /* return error */
+    }
+    *raw = (int16_t)(((uint16_t)buf[1]) << 8) | buf[0];                         /* get raw data */
+    handle->resolution = (buf[4] >> 5) & 0x03;                                  /* cache resolution */
+    if (((buf[4] >> 5) & 0x03) == DS18B20_RESOLUTION_9BIT)                      /* if 9 bit resolution */
+    {
+        if ((((uint16_t)(*raw)) & (1 << 15)) != 0)                              /* if negative */
+        {
+            *raw = (*raw ) >> 3;                                                /* right shift 3 */
+            *raw = (*raw) | 0xE000U;                                            /* set negative part */
+        }
+        else                                                                    /* if positive */
+        {
+            *raw = (*raw ) >> 3;                                                /* right shift 3 */
+        }
+        *temp = (float)(*raw) * 0.5f;                                           /* convert to real data */
+    }
+    else if (((buf[4] >> 5) & 0x03) == DS18B20_RESOLUTION_10BIT)                /* if 10 bit resolution */
+    {
+        if ((((uint16_t)(*raw)) & (1 << 15)) != 0)                              /* if negative */
+        {
+            *raw = (*raw ) >> 2;                                                /* right shift 2 */
+            *raw = (*raw) | 0xC000U;                                            /* set negative part */
+        }
+        else
+        {
+            *raw = (*raw ) >> 2;                                                /* right shift 2 */
+        }
+        *temp = (float)(*raw) * 0.25f;                                          /* convert to real data */
+    }
+    else if (((buf[4] >> 5) & 0x03) == DS18B20_RESOLUTION_11BIT)                /* if 11 bit resolution */
+    {
+        if ((((uint16_t)(*raw)) & (1 << 15)) != 0)                              /* if negative */
+        {
+            *raw = (*raw ) >> 1;                                                /* right shift 1 */
+            *raw = (*raw) | 0x8000U;                                            /* set negative part */
+        }
+        else
+        {
+            *raw = (*raw ) >> 1;                                                /* right shift 1 */
+        }
+        *temp = (float)(*raw) * 0.125f;                                         /* convert to real data */
+    }
+    else if (((buf[4] >> 5) & 0x03) == DS18B20_RESOLUTION_12BIT)                /* if 12 bit resolution */
+    {
+        *raw = (*raw ) >> 0;                                                    /* right shift 0 */
+        *temp = (float)(*raw) * 0.0625f;                                        /* convert to real data */
+    }
+    else
+    {
+        DS18B20_LOG(handle, RESOLUTION_INVALID);                                /* resolution is invalid */
+        
+        return 1;                                                               /* return error */
+    }
+    
+    return 0;                                                                   /* success return 0 */
+}
+
 /**
  * @brief     set the chip mode
  * @param[in] *handle pointer to a ds18b20 handle structure
@@ -381,6 +704,32 @@ uint8_t ds18b20_get_mode(ds18b20_handle_t *handle, ds18b20_mode_t *mode)
     return 0;                                      /* success return 0 */
 }
 
+/**
+ * @brief      get the presence pulse width of the last reset
+ * @param[in]  *handle pointer to a ds18b20 handle structure
+ * @param[out] *width_us pointer to a width buffer in us
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       exact with a bus_reset op, counted in poll iterations otherwise
+ */
+uint8_t ds18b20_get_presence_width(ds18b20_handle_t *handle, uint8_t *width_us)
+{
+    if (handle == NULL)                            /* check handle */
+    {
+        return 2;                                  /* return error */
+    }
+    if (handle->inited != 1)                       /* check handle initialization */
+    {
+        return 3;                                  /* return error */
+    }
+    
+    *width_us = handle->presence_width;            /* get width */
+    
+    return 0;                                      /* success return 0 */
+}
+
 /**
  * @brief     set the handle rom
  * @param[in] *handle pointer to a ds18b20 handle structure
@@ -432,13 +781,13 @@ uint8_t ds18b20_get_rom(ds18b20_handle_t *handle, uint8_t rom[8])
     
     if (a_ds18b20_reset(handle) != 0)                                   /* reset bus */
     {
-        handle->debug_print("ds18b20: bus rest failed.\n");             /* reset bus failed */
+        DS18B20_LOG(handle, BUS_RESET_FAILED);                          /* reset bus failed */
         
         return 1;                                                       /* return error */
     }
     if (a_ds18b20_write_byte(handle, DS18B20_CMD_READ_ROM) != 0)        /* write read rom command */
     {
-        handle->debug_print("ds18b20: write command failed.\n");        /* write command failed */
+        DS18B20_LOG(handle, WRITE_CMD_FAILED);                          /* write command failed */
         
         return 1;                                                       /* return error */
     }
@@ -446,7 +795,7 @@ uint8_t ds18b20_get_rom(ds18b20_handle_t *handle, uint8_t rom[8])
     {
         if (a_ds18b20_read_byte(handle, (uint8_t *)&rom[i]) != 0)       /* read 1 byte */
         {
-            handle->debug_print("ds18b20: read rom failed.\n");         /* read failed */
+            DS18B20_LOG(handle, READ_ROM_FAILED);                       /* read failed */
             
             return 1;                                                   /* return error */
         }
@@ -483,19 +832,19 @@ uint8_t ds18b20_scratchpad_set_resolution(ds18b20_handle_t *handle, ds18b20_reso
     {
         if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* bus reset failed */
+            DS18B20_LOG(handle, BUS_RESET_FAILED);                              /* bus reset failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_SKIP_ROM) != 0)            /* sent skip rom command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         } 
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_READ_SCRATCHPAD) != 0)     /* sent read scratchpad command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         } 
@@ -503,32 +852,32 @@ uint8_t ds18b20_scratchpad_set_resolution(ds18b20_handle_t *handle, ds18b20_reso
         {
             if (a_ds18b20_read_byte(handle, (uint8_t *)&buf[i]) != 0)           /* read 9 bytes */
             {
-                handle->debug_print("ds18b20: read data failed.\n");            /* read data failed */
+                DS18B20_LOG(handle, READ_DATA_FAILED);                          /* read data failed */
                 
                 return 1;                                                       /* return error */
             }
         }
         if (a_ds18b20_check_crc((uint8_t *)buf, 8, buf[8]) != 0)                /* check crc */
         {
-            handle->debug_print("ds18b20: crc check error.\n");                 /* crc check error */
+            DS18B20_LOG(handle, CRC_ERROR);                                     /* crc check error */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* bus reset failed */
+            DS18B20_LOG(handle, BUS_RESET_FAILED);                              /* bus reset failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_SKIP_ROM) != 0)            /* write skip rom command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_WRITE_SCRATCHPAD) != 0)    /* write scratchpad command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -538,11 +887,12 @@ uint8_t ds18b20_scratchpad_set_resolution(ds18b20_handle_t *handle, ds18b20_reso
         {
             if (a_ds18b20_write_byte(handle, buf[2+i]) != 0)                    /* write command */
             {
-                handle->debug_print("ds18b20: write command failed.\n");        /* write command failed */
+                DS18B20_LOG(handle, WRITE_CMD_FAILED);                          /* write command failed */
                 
                 return 1;                                                       /* return error */
             }
         }
+        handle->resolution = (uint8_t)resolution;                               /* cache resolution */
         
         return 0;                                                               /* success return 0 */
     }
@@ -550,13 +900,13 @@ uint8_t ds18b20_scratchpad_set_resolution(ds18b20_handle_t *handle, ds18b20_reso
     {
         if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* bus reset failed */
+            DS18B20_LOG(handle, BUS_RESET_FAILED);                              /* bus reset failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_MATCH_ROM) != 0)           /* send match rom command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -564,14 +914,14 @@ uint8_t ds18b20_scratchpad_set_resolution(ds18b20_handle_t *handle, ds18b20_reso
         {
             if (a_ds18b20_write_byte(handle, handle->rom[i]) != 0)              /* send rom */
             {
-                handle->debug_print("ds18b20: write command failed.\n");        /* write command failed */
+                DS18B20_LOG(handle, WRITE_CMD_FAILED);                          /* write command failed */
                 
                 return 1;                                                       /* return error */
             }
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_READ_SCRATCHPAD) != 0)     /* send read scratchpad command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         } 
@@ -579,26 +929,26 @@ uint8_t ds18b20_scratchpad_set_resolution(ds18b20_handle_t *handle, ds18b20_reso
         {
             if (a_ds18b20_read_byte(handle, (uint8_t *)&buf[i]) != 0)           /* read 9 bytes */
             {
-                handle->debug_print("ds18b20: read data failed.\n");            /* read data failed */
+                DS18B20_LOG(handle, READ_DATA_FAILED);                          /* read data failed */
                 
                 return 1;                                                       /* return error */
             }
         }
         if (a_ds18b20_check_crc((uint8_t *)buf, 8, buf[8]) != 0)                /* check crc */
         {
-            handle->debug_print("ds18b20: crc check error.\n");                 /* crc check error */
+            DS18B20_LOG(handle, CRC_ERROR);                                     /* crc check error */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* reset bus failed */
+            DS18B20_LOG(handle, BUS_RESET_FAILED);                              /* reset bus failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_MATCH_ROM) != 0)           /* match rom */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -606,14 +956,14 @@ uint8_t ds18b20_scratchpad_set_resolution(ds18b20_handle_t *handle, ds18b20_reso
         {
             if (a_ds18b20_write_byte(handle, handle->rom[i]) != 0)              /* send rom */
             {
-                handle->debug_print("ds18b20: write command failed.\n");        /* write command failed */
+                DS18B20_LOG(handle, WRITE_CMD_FAILED);                          /* write command failed */
                 
                 return 1;                                                       /* return error */
             }
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_WRITE_SCRATCHPAD) != 0)    /* write scratchpad command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -623,17 +973,18 @@ uint8_t ds18b20_scratchpad_set_resolution(ds18b20_handle_t *handle, ds18b20_reso
         {
             if (a_ds18b20_write_byte(handle, buf[2 + i]) != 0)                  /* write command */
             {
-                handle->debug_print("ds18b20: write command failed.\n");        /* write command failed */
+                DS18B20_LOG(handle, WRITE_CMD_FAILED);                          /* write command failed */
                 
                 return 1;                                                       /* return error */
             }
         }
+        handle->resolution = (uint8_t)resolution;                               /* cache resolution */
         
         return 0;                                                               /* success return 0 */
     }    
     else
     {
-        handle->debug_print("ds18b20: mode invalid.\n");                        /* ds18b20 mode invalid */
+        DS18B20_LOG(handle, MODE_INVALID);                                      /* ds18b20 mode invalid */
         
         return 1;                                                               /* return error */
     }
@@ -667,19 +1018,19 @@ uint8_t ds18b20_scratchpad_get_resolution(ds18b20_handle_t *handle, ds18b20_reso
     {
         if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* reset bus */
+            DS18B20_LOG(handle, BUS_RESET_FAILED);                              /* reset bus */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_SKIP_ROM) != 0)            /* sent skip rom command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_READ_SCRATCHPAD) != 0)     /* write read scratchpad command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -687,18 +1038,19 @@ uint8_t ds18b20_scratchpad_get_resolution(ds18b20_handle_t *handle, ds18b20_reso
         {
             if (a_ds18b20_read_byte(handle, (uint8_t *)&buf[i]) != 0)           /* read bytes */
             {
-                handle->debug_print("ds18b20: read data failed.\n");            /* read data failed */
+                DS18B20_LOG(handle, READ_DATA_FAILED);                          /* read data failed */
                 
                 return 1;                                                       /* return error */
             }
         }
         if (a_ds18b20_check_crc((uint8_t *)buf, 8, buf[8]) != 0)                /* check crc */
         {
-            handle->debug_print("ds18b20: crc check error.\n");                 /* crc check failed */
+            DS18B20_LOG(handle, CRC_ERROR);                                     /* crc check failed */
             
             return 1;                                                           /* return error */
         }
         *resolution = (ds18b20_resolution_t)(buf[4] >> 5);                      /* get resolution */
+        handle->resolution = (uint8_t)(*resolution);                            /* cache resolution */
         
         return 0;                                                               /* success return 0 */
     }
@@ -706,13 +1058,13 @@ uint8_t ds18b20_scratchpad_get_resolution(ds18b20_handle_t *handle, ds18b20_reso
     {
         if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* reset failed */
+            DS18B20_LOG(handle, BUS_RESET_FAILED);                              /* reset failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_MATCH_ROM) != 0)           /* sent match rom command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -720,14 +1072,14 @@ uint8_t ds18b20_scratchpad_get_resolution(ds18b20_handle_t *handle, ds18b20_reso
         {
             if (a_ds18b20_write_byte(handle, handle->rom[i]) != 0)              /* send rom */
             {
-                handle->debug_print("ds18b20: write command failed.\n");        /* write command failed */
+                DS18B20_LOG(handle, WRITE_CMD_FAILED);                          /* write command failed */
                 
                 return 1;                                                       /* return error */
             }
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_READ_SCRATCHPAD) != 0)     /* sent read scratchpad command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
          } 
@@ -735,24 +1087,25 @@ uint8_t ds18b20_scratchpad_get_resolution(ds18b20_handle_t *handle, ds18b20_reso
         {
             if (a_ds18b20_read_byte(handle, (uint8_t *)&buf[i]) != 0)           /* read 9 bytes */
             {
-                handle->debug_print("ds18b20: read data failed.\n");            /* read failed */
+                DS18B20_LOG(handle, READ_DATA_FAILED);                          /* read failed */
                 
                 return 1;                                                       /* return error */
             }
         }
         if (a_ds18b20_check_crc((uint8_t *)buf, 8, buf[8]) != 0)                /* check crc */
         {
-            handle->debug_print("ds18b20: crc check error.\n");                 /* check crc failed */
+            DS18B20_LOG(handle, CRC_ERROR);                                     /* check crc failed */
             
             return 1;                                                           /* return error */
         }
         *resolution = (ds18b20_resolution_t)(buf[4] >> 5);                      /* get resolution */
+        handle->resolution = (uint8_t)(*resolution);                            /* cache resolution */
         
         return 0;                                                               /* success return 0 */
     }
     else
     {
-        handle->debug_print("ds18b20: mode invalid.\n");                        /* ds18b20 mode invalid */
+        DS18B20_LOG(handle, MODE_INVALID);                                      /* ds18b20 mode invalid */
         
         return 1;                                                               /* return error */
     }
@@ -787,19 +1140,19 @@ uint8_t ds18b20_scratchpad_set_alarm_threshold(ds18b20_handle_t *handle, int8_t
     {
         if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* reset bus failed */
+            DS18B20_LOG(handle, BUS_RESET_FAILED);                              /* reset bus failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_SKIP_ROM) != 0)            /* sent skip rom command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_READ_SCRATCHPAD) != 0)     /* sent read scratchpad command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -807,32 +1160,32 @@ uint8_t ds18b20_scratchpad_set_alarm_threshold(ds18b20_handle_t *handle, int8_t
         {
             if (a_ds18b20_read_byte(handle, (uint8_t *)&buf[i]) != 0)           /* read 9 bytes */
             {
-                handle->debug_print("ds18b20: read data failed.\n");            /* read data failed */
+                DS18B20_LOG(handle, READ_DATA_FAILED);                          /* read data failed */
                 
                 return 1;                                                       /* return error */
             }
         }
         if (a_ds18b20_check_crc((uint8_t *)buf, 8, buf[8]) != 0)                /* check crc */
         {
-            handle->debug_print("ds18b20: crc check error.\n");                 /* crc check error */
+            DS18B20_LOG(handle, CRC_ERROR);                                     /* crc check error */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* reset bus failed */
+            DS18B20_LOG(handle, BUS_RESET_FAILED);                              /* reset bus failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_SKIP_ROM) != 0)            /* sent skip rom command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_WRITE_SCRATCHPAD) != 0)    /* sent write scratchpad command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -842,7 +1195,7 @@ uint8_t ds18b20_scratchpad_set_alarm_threshold(ds18b20_handle_t *handle, int8_t
         {
             if (a_ds18b20_write_byte(handle, buf[2 + i]) != 0)                  /* write command */
             {
-                handle->debug_print("ds18b20: write command failed.\n");        /* write command failed */
+                DS18B20_LOG(handle, WRITE_CMD_FAILED);                          /* write command failed */
                 
                 return 1;                                                       /* return error */
             }
@@ -854,13 +1207,13 @@ uint8_t ds18b20_scratchpad_set_alarm_threshold(ds18b20_handle_t *handle, int8_t
     {
         if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* bus reset failed */
+            DS18B20_LOG(handle, BUS_RESET_FAILED);                              /* bus reset failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_MATCH_ROM) != 0)           /* sent match rom command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -868,14 +1221,14 @@ uint8_t ds18b20_scratchpad_set_alarm_threshold(ds18b20_handle_t *handle, int8_t
         {
             if (a_ds18b20_write_byte(handle, handle->rom[i]) != 0)              /* send rom */
             {
-                handle->debug_print("ds18b20: write command failed.\n");        /* write command failed */
+                DS18B20_LOG(handle, WRITE_CMD_FAILED);                          /* write command failed */
                 
                 return 1;                                                       /* return error */
             }
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_READ_SCRATCHPAD) != 0)     /* sent read scratchpad command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -883,26 +1236,26 @@ uint8_t ds18b20_scratchpad_set_alarm_threshold(ds18b20_handle_t *handle, int8_t
         {
             if (a_ds18b20_read_byte(handle, (uint8_t *)&buf[i]) != 0)           /* read 9 byte */
             {
-                handle->debug_print("ds18b20: read data failed.\n");            /* read data failed */
+                DS18B20_LOG(handle, READ_DATA_FAILED);                          /* read data failed */
                 
                 return 1;                                                       /* return error */
             }
         }
         if (a_ds18b20_check_crc((uint8_t *)buf, 8, buf[8]) != 0)                /* check crc */
         {
-            handle->debug_print("ds18b20: crc check error.\n");                 /* crc check error */
+            DS18B20_LOG(handle, CRC_ERROR);                                     /* crc check error */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* reset bus failed */
+            DS18B20_LOG(handle, BUS_RESET_FAILED);                              /* reset bus failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_MATCH_ROM) != 0)           /* sent match rom command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -910,14 +1263,14 @@ uint8_t ds18b20_scratchpad_set_alarm_threshold(ds18b20_handle_t *handle, int8_t
         {
             if (a_ds18b20_write_byte(handle, handle->rom[i]) != 0)              /* send rom */
             {
-                handle->debug_print("ds18b20: write command failed.\n");        /* write command failed */
+                DS18B20_LOG(handle, WRITE_CMD_FAILED);                          /* write command failed */
                 
                 return 1;                                                       /* return error */
             }
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_WRITE_SCRATCHPAD) != 0)    /* write scratchpad command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -927,7 +1280,7 @@ uint8_t ds18b20_scratchpad_set_alarm_threshold(ds18b20_handle_t *handle, int8_t
         {
             if (a_ds18b20_write_byte(handle, buf[2 + i]) != 0)                  /* write command */
             {
-                handle->debug_print("ds18b20: write command failed.\n");        /* write command failed */
+                DS18B20_LOG(handle, WRITE_CMD_FAILED);                          /* write command failed */
                 
                 return 1;                                                       /* return error */
             }
@@ -937,7 +1290,7 @@ uint8_t ds18b20_scratchpad_set_alarm_threshold(ds18b20_handle_t *handle, int8_t
     }    
     else
     {
-        handle->debug_print("ds18b20: mode invalid.\n");                        /* ds18b20 mode is invalid */
+        DS18B20_LOG(handle, MODE_INVALID);                                      /* ds18b20 mode is invalid */
         
         return 1;                                                               /* return error */
     }
@@ -972,19 +1325,19 @@ uint8_t ds18b20_scrachpad_get_alarm_threshold(ds18b20_handle_t *handle, int8_t *
     {
         if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* reset bus failed */
+            DS18B20_LOG(handle, BUS_RESET_FAILED);                              /* reset bus failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_SKIP_ROM) != 0)            /* sent skip rom command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_READ_SCRATCHPAD) != 0)     /* sent read scratchpad command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -992,14 +1345,14 @@ uint8_t ds18b20_scrachpad_get_alarm_threshold(ds18b20_handle_t *handle, int8_t *
         {
             if (a_ds18b20_read_byte(handle, (uint8_t *)&buf[i]) != 0)           /* read 9 bytes */
             {
-                handle->debug_print("ds18b20: read data failed.\n");            /* read data failed */
+                DS18B20_LOG(handle, READ_DATA_FAILED);                          /* read data failed */
                 
                 return 1;                                                       /* return error */
             }
         }
         if (a_ds18b20_check_crc((uint8_t *)buf, 8, buf[8]) != 0)                /* check crc */
         {
-            handle->debug_print("ds18b20: crc check error.\n");                 /* crc check error */
+            DS18B20_LOG(handle, CRC_ERROR);                                     /* crc check error */
             
             return 1;                                                           /* return error */
         }
@@ -1012,13 +1365,13 @@ uint8_t ds18b20_scrachpad_get_alarm_threshold(ds18b20_handle_t *handle, int8_t *
     {
         if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* reset bus failed */
+            DS18B20_LOG(handle, BUS_RESET_FAILED);                              /* reset bus failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_MATCH_ROM) != 0)           /* write match rom command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -1026,14 +1379,14 @@ uint8_t ds18b20_scrachpad_get_alarm_threshold(ds18b20_handle_t *handle, int8_t *
         {
             if (a_ds18b20_write_byte(handle, handle->rom[i]) != 0)              /* send rom */
             {
-                handle->debug_print("ds18b20: write command failed.\n");        /* write command failed */
+                DS18B20_LOG(handle, WRITE_CMD_FAILED);                          /* write command failed */
                 
                 return 1;                                                       /* return error */
             }
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_READ_SCRATCHPAD) != 0)     /* sent read scratchpad command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -1041,14 +1394,14 @@ uint8_t ds18b20_scrachpad_get_alarm_threshold(ds18b20_handle_t *handle, int8_t *
         {
             if (a_ds18b20_read_byte(handle, (uint8_t *)&buf[i]) != 0)           /* read bytes */
             {
-                handle->debug_print("ds18b20: read data failed.\n");            /* read byte failed */
+                DS18B20_LOG(handle, READ_DATA_FAILED);                          /* read byte failed */
                 
                 return 1;                                                       /* return error */ 
             }
         }
         if (a_ds18b20_check_crc((uint8_t *)buf, 8, buf[8]) != 0)                /* check crc */
         {
-            handle->debug_print("ds18b20: crc check error.\n");                 /* crc error */
+            DS18B20_LOG(handle, CRC_ERROR);                                     /* crc error */
             
             return 1;                                                           /* return error */
         }
@@ -1059,7 +1412,7 @@ uint8_t ds18b20_scrachpad_get_alarm_threshold(ds18b20_handle_t *handle, int8_t *
     }
     else
     {
-        handle->debug_print("ds18b20: mode invalid.\n");                        /* ds18b20 mode invalid */
+        DS18B20_LOG(handle, MODE_INVALID);                                      /* ds18b20 mode invalid */
         
         return 1;                                                               /* return error */
     }
@@ -1092,19 +1445,19 @@ uint8_t ds18b20_copy_scratchpad_to_eeprom(ds18b20_handle_t *handle)
     {
         if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* reset bus failed */
+            DS18B20_LOG(handle, BUS_RESET_FAILED);                              /* reset bus failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_SKIP_ROM) != 0)            /* sent skip rom command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_COPY_SCRATCHPAD) != 0)     /* write copy scratchpad command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -1115,13 +1468,13 @@ uint8_t ds18b20_copy_scratchpad_to_eeprom(ds18b20_handle_t *handle)
     {
         if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* bus reset failed */
+            DS18B20_LOG(handle, BUS_RESET_FAILED);                              /* bus reset failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_MATCH_ROM) != 0)           /* write match rom command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }    
@@ -1129,14 +1482,14 @@ uint8_t ds18b20_copy_scratchpad_to_eeprom(ds18b20_handle_t *handle)
         {
             if (a_ds18b20_write_byte(handle, handle->rom[i]) != 0)              /* send rom */
             {
-                handle->debug_print("ds18b20: write command failed.\n");        /* write command */
+                DS18B20_LOG(handle, WRITE_CMD_FAILED);                          /* write command */
                 
                 return 1;                                                       /* return error */
             }
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_COPY_SCRATCHPAD) != 0)     /* write copy scratchpad command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -1145,7 +1498,7 @@ uint8_t ds18b20_copy_scratchpad_to_eeprom(ds18b20_handle_t *handle)
     }
     else
     {
-        handle->debug_print("ds18b20: mode invalid.\n");                        /* ds18b20 mode is invalid */
+        DS18B20_LOG(handle, MODE_INVALID);                                      /* ds18b20 mode is invalid */
         
         return 1;                                                               /* return error */
     }
@@ -1178,19 +1531,19 @@ uint8_t ds18b20_copy_eeprom_to_scratchpad(ds18b20_handle_t *handle)
     {
         if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* reset bus failed */
+            DS18B20_LOG(handle, BUS_RESET_FAILED);                              /* reset bus failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_SKIP_ROM) != 0)            /* sent skip rom command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_RECALL_EE) != 0)           /* write recall ee command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -1201,13 +1554,13 @@ uint8_t ds18b20_copy_eeprom_to_scratchpad(ds18b20_handle_t *handle)
     {
         if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
         {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* reset bus failed */
+            DS18B20_LOG(handle, BUS_RESET_FAILED);                              /* reset bus failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_MATCH_ROM) != 0)           /* sent match rom command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command */
             
             return 1;                                                           /* return error */
         }
@@ -1215,14 +1568,14 @@ uint8_t ds18b20_copy_eeprom_to_scratchpad(ds18b20_handle_t *handle)
         {
             if (a_ds18b20_write_byte(handle, handle->rom[i]) != 0)              /* send rom */
             {
-                handle->debug_print("ds18b20: write command failed.\n");        /* write command failed */
+                DS18B20_LOG(handle, WRITE_CMD_FAILED);                          /* write command failed */
                 
                 return 1;                                                       /* return error */
             }
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_RECALL_EE) != 0)           /* sent recall ee command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
@@ -1231,7 +1584,7 @@ uint8_t ds18b20_copy_eeprom_to_scratchpad(ds18b20_handle_t *handle)
     }
     else
     {
-        handle->debug_print("ds18b20: mode invalid.\n");                        /* ds18b20 mode is invalid */
+        DS18B20_LOG(handle, MODE_INVALID);                                      /* ds18b20 mode is invalid */
         
         return 1;                                                               /* return error */
     }
@@ -1308,72 +1661,83 @@ uint8_t ds18b20_init(ds18b20_handle_t *handle)
     {
         return 2;                                                      /* return error */
     }
-    if (handle->debug_print == NULL)                                   /* check debug_print */
+    if (handle->bus == NULL)                                           /* check bus */
+    {
+        return 3;                                                      /* return error */
+    }
+    if (handle->bus->debug_print == NULL)                              /* check debug_print */
     {
         return 3;                                                      /* return error */
     }
-    if (handle->bus_init == NULL)                                      /* check bus_init */
+    if (handle->bus->bus_init == NULL)                                 /* check bus_init */
     {
-        handle->debug_print("ds18b20: bus_init is null.\n");           /* bus_init is null */
+        DLOG(DS18B20_BUS_INIT_NULL);                                   /* bus_init is null */
         
         return 3;                                                      /* return error */
     }
-    if (handle->bus_deinit == NULL)                                    /* check bus_deinit */
+    if (handle->bus->bus_deinit == NULL)                               /* check bus_deinit */
     {
-        handle->debug_print("ds18b20: bus_deinit is null.\n");         /* bus_read is null */
+        DLOG(DS18B20_BUS_DEINIT_NULL);                                 /* bus_read is null */
         
         return 3;                                                      /* return error */
     }
-    if (handle->bus_read == NULL)                                      /* check bus_read */
+    if (handle->bus->bus_read == NULL)                                 /* check bus_read */
     {
-        handle->debug_print("ds18b20: bus_read is null.\n");           /* bus_read is null */
+        DLOG(DS18B20_BUS_READ_NULL);                                   /* bus_read is null */
         
         return 3;                                                      /* return error */
     }
-    if (handle->bus_write == NULL)                                     /* check bus_write */
+    if (handle->bus->bus_write == NULL)                                /* check bus_write */
     {
-        handle->debug_print("ds18b20: bus_write is null.\n");          /* bus_write is null */
+        DLOG(DS18B20_BUS_WRITE_NULL);                                  /* bus_write is null */
         
         return 3;                                                      /* return error */
     }
-    if (handle->delay_ms == NULL)                                      /* check delay_ms */
+    if (handle->bus->delay_ms == NULL)                                 /* check delay_ms */
     {
-        handle->debug_print("ds18b20: delay_ms is null.\n");           /* delay_ms is null */
+        DLOG(DS18B20_DELAY_MS_NULL);                                   /* delay_ms is null */
         
         return 3;                                                      /* return error */
     }
-    if (handle->delay_us == NULL)                                      /* check delay_us */
+    if (handle->bus->delay_us == NULL)                                 /* check delay_us */
     {
-        handle->debug_print("ds18b20: delay_us is null.\n");           /* delay_us is null */
+        DLOG(DS18B20_DELAY_US_NULL);                                   /* delay_us is null */
        
         return 3;                                                      /* return error */
     }
-    if (handle->enable_irq == NULL)                                    /* check enable_irq */
+    if (handle->bus->enable_irq == NULL)                               /* check enable_irq */
+    {
+        DLOG(DS18B20_ENABLE_IRQ_NULL);                                 /* enable_irq is null */
+        
+        return 3;                                                      /* return error */
+    }
+    if (handle->bus->disable_irq == NULL)                              /* check disable_irq */
     {
-        handle->debug_print("ds18b20: enable_irq is null.\n");         /* enable_irq is null */
+        DLOG(DS18B20_DISABLE_IRQ_NULL);                                /* disable_irq is null */
         
         return 3;                                                      /* return error */
     }
-    if (handle->disable_irq == NULL)                                   /* check disable_irq */
+    if (handle->bus->timing == NULL)                                   /* check timing */
     {
-        handle->debug_print("ds18b20: disable_irq is null.\n");        /* disable_irq is null */
+        DLOG(DS18B20_TIMING_NULL);                                     /* timing is null */
         
         return 3;                                                      /* return error */
     }
     
-    if (handle->bus_init() != 0)                                       /* initialize bus */
+    if (handle->bus->bus_init() != 0)                                  /* initialize bus */
     {
-        handle->debug_print("ds18b20: bus init failed.\n");            /* bus innit failed */
+        DS18B20_LOG(handle, BUS_INIT_FAILED);                          /* bus innit failed */
         
         return 1;                                                      /* return error */
     }
     if (a_ds18b20_reset(handle) != 0)                                  /* reset chip */
     {
-        handle->debug_print("ds18b20: reset failed.\n");               /* reset chip failed */
-        (void)handle->bus_deinit();                                    /* close bus */
+        DS18B20_LOG(handle, RESET_FAILED);                             /* reset chip failed */
+        (void)handle->bus->bus_deinit();                               /* close bus */
         
         return 4;                                                      /* return error */
     }
+    handle->resolution = DS18B20_RESOLUTION_12BIT;                    /* power-on default resolution */
     handle->inited = 1;                                                /* flag finish initialization */
     
     return 0;                                                          /* success return 0 */
@@ -1400,9 +1764,9 @@ uint8_t ds18b20_deinit(ds18b20_handle_t *handle)
         return 3;                                                /* return error */
     }
     
-    if (handle->bus_deinit() != 0)                               /* close bus */
+    if (handle->bus->bus_deinit() != 0)                          /* close bus */
     {
-        handle->debug_print("ds18b20: deinit failed.\n");        /* deinit failed */
+        DS18B20_LOG(handle, DEINIT_FAILED);                      /* deinit failed */
         
         return 1;                                                /* return error */
     }   
@@ -1425,9 +1789,7 @@ uint8_t ds18b20_deinit(ds18b20_handle_t *handle)
  */
 uint8_t ds18b20_read(ds18b20_handle_t *handle, int16_t *raw, float *temp)
 {
-    uint8_t i, buf[9];
-    uint8_t res;
-    uint32_t cnt;
+    uint32_t sleep_ms;
     
     if (handle == NULL)                                                         /* check handle */
     {
@@ -1438,282 +1800,111 @@ uint8_t ds18b20_read(ds18b20_handle_t *handle, int16_t *raw, float *temp)
         return 3;                                                               /* return error */
     }
     
-    if (handle->mode == DS18B20_MODE_SKIP_ROM)                                  /* if use skip rom mode */
+    if (a_ds18b20_select(handle) != 0)                                          /* address chip */
     {
-        if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
-        {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* bus reset failed */
-            
-            return 1;                                                           /* return error */
-        }
-        if (a_ds18b20_write_byte(handle, DS18B20_CMD_SKIP_ROM) != 0)            /* sent skip rom command */
-        {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
-            
-            return 1;                                                           /* return error */
-        }
-        if (a_ds18b20_write_byte(handle, DS18B20_CMD_CONVERT_T) != 0)           /* sent convert temp command */
-        {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
-            
-            return 1;                                                           /* return error */
-        }
-        cnt = 0;                                                                /* reset cnt */
-        res = 0;                                                                /* reset res */
-        while ((res == 0) && (cnt < 100))                                       /* wait 1 s */
-        {
-            if (a_ds18b20_read_bit(handle, (uint8_t *)&res) != 0)               /* read 1 bit */
-            {
-                handle->debug_print("ds18b20: read bit failed.\n");             /* read a bit failed */
-                
-                return 1;                                                       /* return error */
-            }
-            handle->delay_ms(10);                                               /* delay 10 ms */
-            cnt++;                                                              /* cnt++ */
-        }
-        if (cnt >= 100)                                                         /* if cnt is over 100 times */
-        {
-            handle->debug_print("ds18b20: bus read timeout.\n");                /* bus read timeout */
-            
-            return 1;                                                           /* reset error */
-        }
-        if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
-        {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* bus reset failed */
-            
-            return 1;                                                           /* return error */
-        }
-        if (a_ds18b20_write_byte(handle, DS18B20_CMD_SKIP_ROM) != 0)            /* send skip rom command */
-        {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command */
-            
-            return 1;                                                           /* return error */
-        }
-        if (a_ds18b20_write_byte(handle, DS18B20_CMD_READ_SCRATCHPAD) != 0)     /* write read scratchpad command */
-        {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
-            
-            return 1;                                                           /* return error */
-        }
-        for (i = 0; i < 9; i++)                                                 /* read 9 bytes */
-        {
-            if (a_ds18b20_read_byte(handle, (uint8_t *)&buf[i]) != 0)           /* read bytes */
-            {
-                handle->debug_print("ds18b20: read byte failed.\n");            /* read byte failed */
-                
-                return 1;                                                       /* return error */
-            }
-        }
-        if (a_ds18b20_check_crc((uint8_t *)buf, 8, buf[8]) != 0)                /* check crc */
-        {
-            handle->debug_print("ds18b20: crc check error.\n");                 /* crc check failed */
-            
-            return 1;                                                           /* return error */
-        }
-        *raw = (int16_t)(((uint16_t)buf[1]) << 8) | buf[0];                     /* get raw data */
-        if (((buf[4] >> 5) & 0x03) == DS18B20_RESOLUTION_9BIT)                  /* if 9 bit resolution */
-        {
-            if ((((uint16_t)(*raw)) & (1 << 15)) != 0)                          /* if negative */
-            {
-                *raw = (*raw ) >> 3;                                            /* right shift 3 */
-                *raw = (*raw) | 0xE000U;                                        /* set negative part */
-            }
-            else                                                                /* if positive */
-            {
-                *raw = (*raw ) >> 3;                                            /* right shift 3 */
-            }
-            *temp = (float)(*raw) * 0.5f;                                       /* convert to real data */
-        }
-        else if (((buf[4] >> 5) & 0x03) == DS18B20_RESOLUTION_10BIT)            /* if 10 bit resolution */
-        {
-            if ((((uint16_t)(*raw)) & (1 << 15)) != 0)                          /* if negative */
-            {
-                *raw = (*raw ) >> 2;                                            /* right shift 2 */
-                *raw = (*raw) | 0xC000U;                                        /* set negative part */
-            }
-            else
-            {
-                *raw = (*raw ) >> 2;                                            /* right shift 2 */
-            }
-            *temp = (float)(*raw) * 0.25f;                                      /* convert to real data */
-        }
-        else if (((buf[4] >> 5) & 0x03) == DS18B20_RESOLUTION_11BIT)            /* if 11 bit resolution */
-        {
-            if ((((uint16_t)(*raw)) & (1 << 15)) != 0)                          /* if negative */
-            {
-                *raw = (*raw ) >> 1;                                            /* right shift 1 */
-                *raw = (*raw) | 0x8000U;                                        /* set negative part */
-            }
-            else
-            {
-                *raw = (*raw ) >> 1;                                            /* right shift 1 */
-            }
-            *temp = (float)(*raw) * 0.125f;                                     /* convert to real data */
-        }
-        else if (((buf[4] >> 5) & 0x03) == DS18B20_RESOLUTION_12BIT)            /* if 12 bit resolution */
-        {
-            *raw = (*raw ) >> 0;                                                /* right shift 0 */
-            *temp = (float)(*raw) * 0.0625f;                                    /* convert to real data */
-        }
-        else
-        {
-            handle->debug_print("ds18b20: resolution invalid.\n");              /* resolution is invalid */
-            
-            return 1;                                                           /* return error */
-        }
-        
-        return 0;                                                               /* success return 0 */
+        return 1;                                                               /* return error */
     }
-    else if (handle->mode == DS18B20_MODE_MATCH_ROM)                            /* if we use match rom mode */
+    if (a_ds18b20_write_byte(handle, DS18B20_CMD_CONVERT_T) != 0)               /* sent convert temp command */
     {
-        if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
-        {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* reset bus failed */
+        DS18B20_LOG(handle, WRITE_CMD_FAILED);                                  /* write command failed */
         
-            return 1;                                                           /* return error */
-        }
-        if (a_ds18b20_write_byte(handle, DS18B20_CMD_MATCH_ROM) != 0)           /* sent match rom command */
-        {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+        return 1;                                                               /* return error */
+    }
+    sleep_ms = gc_ds18b20_conversion_ms[handle->resolution & 0x03];             /* get max conversion time */
+    sleep_ms = sleep_ms - sleep_ms / 4;                                         /* typical time is shorter */
+    if (a_ds18b20_wait_conversion(handle, sleep_ms) != 0)                       /* wait conversion */
+    {
+        return 1;                                                               /* return error */
+    }
+    
+    return a_ds18b20_read_temperature(handle, raw, temp);                       /* read and decode */
+}
 
-            return 1;                                                           /* return error */
-        }
-        for (i = 0; i < 8; i++)
-        {
-            if (a_ds18b20_write_byte(handle, handle->rom[i]) != 0)              /* send rom */
-            {
-                handle->debug_print("ds18b20: write command failed.\n");        /* write command failed */
-                
-                return 1;                                                       /* return error */
-            }
-        }
-        if (a_ds18b20_write_byte(handle, DS18B20_CMD_CONVERT_T) != 0)           /* sent convert temp command */
-        {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
-            
-            return 1;                                                           /* return error */
-        }
-        cnt = 0;                                                                /* reset cnt */
-        res = 0;                                                                /* reset res */
-        while ((res == 0) && (cnt < 100))                                       /* read max 1s */
-        {
-            if (a_ds18b20_read_bit(handle, (uint8_t *)&res) != 0)               /* read 1 bit */
-            {
-                handle->debug_print("ds18b20: read bit failed.\n");             /* read 1 bit failed */
-                
-                return 1;                                                       /* return error */
-            }
-            handle->delay_ms(10);                                               /* delay 10 ms */
-            cnt++;                                                              /* cnt++ */
-        }
-        if (cnt >= 100)                                                         /* if cnt is over 100 times */
-        {
-            handle->debug_print("ds18b20: bus read timeout.\n");                /* read timeout */
-            
-            return 1;                                                           /* return error */
-        }
-        if (a_ds18b20_reset(handle) != 0)                                       /* reset bus */
-        {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* reset bus failed */
-            
-            return 1;                                                           /* return error */
-        }
-        if (a_ds18b20_write_byte(handle, DS18B20_CMD_MATCH_ROM) != 0)           /* sent match rom command */
-        {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
-            
-            return 1;                                                           /* return error */
-        }
-        for (i = 0; i < 8; i++)
-        {
-            if (a_ds18b20_write_byte(handle, handle->rom[i]) != 0)              /* send rom */
-            {
-                handle->debug_print("ds18b20: write command failed.\n");        /* write command failed */
-                
-                return 1;                                                       /* return error */
-            }
-        } 
-        if (a_ds18b20_write_byte(handle, DS18B20_CMD_READ_SCRATCHPAD) != 0)     /* send read scratchpad command */
-        {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
-            
-            return 1;                                                           /* return error */
-        }
-        for (i = 0; i < 9; i++)                                                 /* read 9 bytes */
-        {
-            if (a_ds18b20_read_byte(handle, (uint8_t *)&buf[i]) != 0)           /* read byte */
-            {
-                handle->debug_print("ds18b20: read byte failed.\n");            /* read failed */
-                
-                return 1;                                                       /* return error */
-            }
-        }
-        if (a_ds18b20_check_crc((uint8_t *)buf, 8, buf[8]) != 0)                /* check crc */
-        {
-            handle->debug_print("ds18b20: crc check error.\n");                 /* crc check error */
-            
-            return 1;                                                           /* return error */
-        }
-        *raw = (int16_t)(((uint16_t)buf[1]) << 8) | buf[0];                     /* get raw data */
-        if (((buf[4] >> 5) & 0x03) == DS18B20_RESOLUTION_9BIT)                  /* if 9 bit resolution */
-        {
-            if ((((uint16_t)(*raw)) & (1 << 15)) != 0)                          /* if negative */
-            {
-                *raw = (*raw ) >> 3;                                            /* right shift 3 */
-                *raw = (*raw) | 0xE000U;                                        /* set negative part */
-            }
-            else                                                                /* if positive */
-            {
-                *raw = (*raw ) >> 3;                                            /* right shift 3 */
-            }
-            *temp = (float)(*raw) * 0.5f;                                       /* convert to real data */
-        }
-        else if (((buf[4] >> 5) & 0x03) == DS18B20_RESOLUTION_10BIT)            /* if 10 bit resolution */
-        {
-            if ((((uint16_t)(*raw)) & (1 << 15)) != 0)                          /* if negative */
-            {
-                *raw = (*raw ) >> 2;                                            /* right shift 2 */
-                *raw = (*raw) | 0xC000U;                                        /* set negative part */
-            }
-            else
-            {
-                *raw = (*raw ) >> 2;                                            /* right shift 2 */
-            }
-            *temp = (float)(*raw) * 0.25f;                                      /* convert to real data */
-        }
-        else if (((buf[4] >> 5) & 0x03) == DS18B20_RESOLUTION_11BIT)            /* if 11 bit resolution */
-        {
-            if ((((uint16_t)(*raw)) & (1 << 15)) != 0)                          /* if negative */
-            {
-                *raw = (*raw ) >> 1;                                            /* right shift 1 */
-                *raw = (*raw) | 0x8000U;                                        /* set negative part */
-            }
-            else
-            {
-                *raw = (*raw ) >> 1;                                            /* right shift 1 */
-            }
-            *temp = (float)(*raw) * 0.125f;                                     /* convert to real data */
-        }
-        else if (((buf[4] >> 5) & 0x03) == DS18B20_RESOLUTION_12BIT)            /* if 12 bit resolution */
-        {
-            *raw = (*raw ) >> 0;                                                /* right shift 0 */
-            *temp = (float)(*raw) * 0.0625f;                                    /* convert to real data */
-        }
-        else
-        {
-            handle->debug_print("ds18b20: resolution invalid.\n");              /* resolution is invalid */
-            
-            return 1;                                                           /* return error */
-        }
-        
-        return 0;                                                               /* success return 0 */
+/**
+ * @brief     start a temperature conversion without waiting for it
+ * @param[in] *handle pointer to a ds18b20 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      in skip rom mode every chip on the bus converts at once
+ */
+uint8_t ds18b20_start_conversion(ds18b20_handle_t *handle)
+{
+    if (handle == NULL)                                                         /* check handle */
+    {
+        return 2;                                                               /* return error */
     }
-    else
+    if (handle->inited != 1)                                                    /* check handle initialization */
+    {
+        return 3;                                                               /* return error */
+    }
+    
+    if (a_ds18b20_select(handle) != 0)                                          /* address chip */
+    {
+        return 1;                                                               /* return error */
+    }
+    if (a_ds18b20_write_byte(handle, DS18B20_CMD_CONVERT_T) != 0)               /* sent convert temp command */
     {
-        handle->debug_print("ds18b20: mode invalid.\n");                        /* ds18b20 mode is invalid */
+        DS18B20_LOG(handle, WRITE_CMD_FAILED);                                  /* write command failed */
         
         return 1;                                                               /* return error */
     }
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     wait for the conversions running on the handle's bus
+ * @param[in] *handle pointer to a ds18b20 handle structure
+ * @param[in] sleep_ms time to sleep before polling, 0 to poll at once
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait failed or timed out
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the bus reads low while any chip on it is still converting, so
+ *            one wait covers a skip rom conversion of the whole bus
+ */
+uint8_t ds18b20_wait_conversion(ds18b20_handle_t *handle, uint32_t sleep_ms)
+{
+    if (handle == NULL)                                                         /* check handle */
+    {
+        return 2;                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                    /* check handle initialization */
+    {
+        return 3;                                                               /* return error */
+    }
+    
+    return a_ds18b20_wait_conversion(handle, sleep_ms);                         /* wait */
+}
+
+/**
+ * @brief      read the result of a finished conversion
+ * @param[in]  *handle pointer to a ds18b20 handle structure
+ * @param[out] *raw pointer to a raw adc buffer
+ * @param[out] *temp pointer to a converted temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the handle must be in match rom mode when the bus has several chips
+ */
+uint8_t ds18b20_read_converted(ds18b20_handle_t *handle, int16_t *raw, float *temp)
+{
+    if (handle == NULL)                                                         /* check handle */
+    {
+        return 2;                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                    /* check handle initialization */
+    {
+        return 3;                                                               /* return error */
+    }
+    
+    return a_ds18b20_read_temperature(handle, raw, temp);                       /* read and decode */
 }
 
 /**
@@ -1731,20 +1922,33 @@ static uint8_t a_ds18b20_read_2bit(ds18b20_handle_t *handle, uint8_t *data)
     uint8_t res;
     
     *data = 0;                                                          /* reset data */
-    handle->disable_irq();                                              /* disable irq */
+    if (handle->bus->bus_touch != NULL)                                 /* slot transfer */
+    {
+        i = 0x03;                                                       /* 2 read slots */
+        if (handle->bus->bus_touch(&i, &res, 2) != 0)                   /* read 2 bits */
+        {
+            DS18B20_LOG(handle, READ_BIT_FAILED);                       /* read a bit failed */
+            
+            return 1;                                                   /* return error */
+        }
+        *data = (uint8_t)(((res & 0x01) << 1) | ((res >> 1) & 0x01));   /* first bit in bit 1 */
+        
+        return 0;                                                       /* success return 0 */
+    }
+    handle->bus->disable_irq();                                         /* disable irq */
     for (i = 0; i < 2; i++)                                             /* read 2 bit */
     {
         *data <<= 1;                                                    /* left shift 1 */
         if (a_ds18b20_read_bit(handle, (uint8_t *)&res) != 0)           /* read one bit */
         {
-            handle->enable_irq();                                       /* enable irq */
-            handle->debug_print("ds18b20: read bit failed.\n");         /* read a bit failed */
+            handle->bus->enable_irq();                                  /* enable irq */
+            DS18B20_LOG(handle, READ_BIT_FAILED);                       /* read a bit failed */
             
             return 1;                                                   /* return error */
         }
         *data = (*data) | res;                                          /* get 1 bit */
     }
-    handle->enable_irq();                                               /* enable irq */
+    handle->bus->enable_irq();                                          /* enable irq */
     
     return 0;                                                           /* success return 0 */
 }
@@ -1760,37 +1964,96 @@ static uint8_t a_ds18b20_read_2bit(ds18b20_handle_t *handle, uint8_t *data)
  * @note      none
  */
 static uint8_t a_ds18b20_write_bit(ds18b20_handle_t *handle, uint8_t bit)
-{    
-    handle->disable_irq();                                          /* disable irq */
-    if (handle->bus_write(0) != 0)                                  /* write 0 */
+{
+    const ds18b20_timing_t *t = handle->bus->timing;
+    
+    if (handle->bus->bus_touch != NULL)                             /* slot transfer */
     {
-        handle->enable_irq();                                       /* enable irq */
-        handle->debug_print("ds18b20: write bit failed.\n");        /* write bit failed */
+        if (handle->bus->bus_touch(&bit, NULL, 1) != 0)             /* one write slot */
+        {
+            DS18B20_LOG(handle, WRITE_BIT_FAILED);                  /* write bit failed */
+            
+            return 1;                                               /* return error */
+        }
         
-        return 1;                                                   /* return error */
+        return 0;                                                   /* success return 0 */
     }
-    handle->delay_us(12);                                           /* wait 12 us */
-    if (handle->bus_write(bit) != 0)                                /* write bit */
+    handle->bus->disable_irq();                                     /* disable irq */
+    if (handle->bus->bus_write(0) != 0)                             /* write 0 */
     {
-        handle->enable_irq();                                       /* enable irq */
-        handle->debug_print("ds18b20: write bit failed.\n");        /* write bit failed */
+        handle->bus->enable_irq();                                  /* enable irq */
+        DS18B20_LOG(handle, WRITE_BIT_FAILED);                      /* write bit failed */
         
         return 1;                                                   /* return error */
-    } 
-    handle->delay_us(30);                                           /* wait 30 us */
-    if (handle->bus_write(1) != 0)                                  /* write 1 */
+    }
+    handle->bus->delay_us((bit != 0) ? t->write1_low_us
+                                     : t->write0_low_us);           /* same slot as a_ds18b20_write_byte */
+    if (handle->bus->bus_write(1) != 0)                             /* write 1 */
     {
-        handle->enable_irq();                                       /* enable irq */
-        handle->debug_print("ds18b20: write bit failed.\n");        /* write bit failed */
+        handle->bus->enable_irq();                                  /* enable irq */
+        DS18B20_LOG(handle, WRITE_BIT_FAILED);                      /* write bit failed */
         
         return 1;                                                   /* return error */
     }
-    handle->delay_us(5);                                            /* wait 5 us */
-    handle->enable_irq();                                           /* enable irq */
+    handle->bus->delay_us((bit != 0) ? t->write1_high_us
+                                     : t->write0_high_us);          /* rest of slot */
+    handle->bus->enable_irq();                                      /* enable irq */
     
     return 0;                                                       /* success return 0 */
 }    
 
+/**
+ * @brief      run one search step
+ * @param[in]  *handle pointer to a ds18b20 handle structure
+ * @param[in]  direction bit written when both a 0 and a 1 answered
+ * @param[out] *bits pointer to a buffer for the rom bit (bit 1) and its complement (bit 0)
+ * @param[out] *taken pointer to a buffer for the bit written
+ * @return     status code
+ *             - 0 success
+ *             - 1 bus failed
+ * @note       nothing is written when no device answered (bits 0x03)
+ */
+static uint8_t a_ds18b20_triplet(ds18b20_handle_t *handle, uint8_t direction, uint8_t *bits, uint8_t *taken)
+{
+    uint8_t id_bit, cmp_bit;
+    
+    if (handle->bus->bus_triplet != NULL)                                           /* native triplet */
+    {
+        if (handle->bus->bus_triplet(direction, &id_bit, &cmp_bit, taken) != 0)     /* one search step */
+        {
+            DS18B20_LOG(handle, READ_2BIT_FAILED);                                  /* bus failed */
+            
+            return 1;                                                               /* return error */
+        }
+        *bits = (uint8_t)((id_bit << 1) | cmp_bit);                                 /* set bits */
+        
+        return 0;                                                                   /* success return 0 */
+    }
+    if (a_ds18b20_read_2bit(handle, bits) != 0)                                     /* read 2 bit */
+    {
+        DS18B20_LOG(handle, READ_2BIT_FAILED);                                      /* read 2 bit failed */
+        
+        return 1;                                                                   /* return error */
+    }
+    *bits = (*bits) & 0x03;                                                         /* get valid bits */
+    if ((*bits) == 0x03)                                                            /* no device */
+    {
+        *taken = 1;                                                                 /* bus stays high */
+        
+        return 0;                                                                   /* success return 0 */
+    }
+    *taken = ((*bits) == 0x00) ? direction : ((*bits) >> 1);                        /* conflict or rom bit */
+    if (a_ds18b20_write_bit(handle, *taken) != 0)                                   /* write bit */
+    {
+        DS18B20_LOG(handle, WRITE_BIT_FAILED);                                      /* write bit failed */
+        
+        return 1;                                                                   /* return error */
+    }
+    handle->bus->delay_us(5);                                                       /* delay 5 us */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
 /**
  * @brief         search the ds18b20 bus
  * @param[in]     *handle pointer to a ds18b20 handle structure
@@ -1804,125 +2067,68 @@ static uint8_t a_ds18b20_write_bit(ds18b20_handle_t *handle, uint8_t bit)
  */
 static uint8_t a_ds18b20_search(ds18b20_handle_t *handle, uint8_t (*pid)[8], uint8_t cmd, uint8_t *number)
 {     
-    uint8_t k, l = 0, conflict_bit, m, n;
-    uint8_t buffer[DS18B20_MAX_SEARCH_SIZE];
-    uint8_t ss[64];
-    uint8_t s = 0;
+    uint64_t path = 0;                                                                    /* direction per rom bit */
+    uint64_t zeros;                                                                       /* conflicts that took 0 */
+    uint64_t rom;                                                                         /* rom of this pass */
+    uint8_t i, k, taken;
     uint8_t num = 0;
     
     if ((*number) > DS18B20_MAX_SEARCH_SIZE)                                              /* check number */
     {
-        handle->debug_print("ds18b20: number is over DS18B20_MAX_SEARCH_SIZE.\n");        /* number is over */
+        DLOG(DS18B20_SEARCH_OVERFLOW);                                                    /* number is over */
         
         return 1;                                                                         /* return error */
     }
-    memset((uint8_t *)buffer, 0, DS18B20_MAX_SEARCH_SIZE);                                /* clear buffer */
-    memset((uint8_t *)ss, 0, sizeof(uint8_t) * 64);                                       /* clear buffer */
-    do
+    while (num < (*number))                                                               /* one rom per pass */
     {
         if (a_ds18b20_reset(handle) != 0)                                                 /* reset bus */
         {
-            handle->debug_print("ds18b20: reset failed.\n");                              /* reset bus failed */
+            DS18B20_LOG(handle, RESET_FAILED);                                            /* reset bus failed */
             
             return 1;                                                                     /* return error */
         }
         if (a_ds18b20_write_byte(handle, cmd) != 0)                                       /* write 1 byte */
         {
-            handle->debug_print("ds18b20: write command failed.\n");                      /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                                        /* write command failed */
             
             return 1;                                                                     /* return error */
         }
-        for (m = 0; m < 8; m++)                                                           /* read 8 byte */
+        rom = 0;                                                                          /* reset rom */
+        zeros = 0;                                                                        /* reset zeros */
+        for (i = 0; i < 64; i++)                                                          /* 64 rom bits */
         {
-            for (n = 0; n < 8; n++)                                                       /* read 8 bit */
+            if (a_ds18b20_triplet(handle, (uint8_t)((path >> i) & 0x01),
+                                  (uint8_t *)&k, (uint8_t *)&taken) != 0)                 /* search step */
             {
-                if (a_ds18b20_read_2bit(handle, (uint8_t *)&k) != 0)                      /* read 2 bit */
-                {
-                    handle->debug_print("ds18b20: read 2bit failed.\n");                  /* read 2 bit failed */
-                    
-                    return 1;                                                             /* return error */
-                }
-                k = k & 0x03;                                                             /* get valid bits */
-                s = s >> 1;                                                               /* right shift 1 bit */
-                if (k == 0x01)                                                            /* 0000 0001 */
-                {
-                    if (a_ds18b20_write_bit(handle, 0) != 0)                              /* write 0 */
-                    {
-                        handle->debug_print("ds18b20: write bit failed.\n");              /* write bit failed */
-                        
-                        return 1;                                                         /* return error */
-                    }
-                    ss[(m * 8 + n)] = 0;                                                  /* set 0 */
-                }
-                else if (k == 0x02)                                                       /* 0000 0010 */
-                {
-                    s = s | 0x80;                                                         /* set 7 bit */
-                    if (a_ds18b20_write_bit(handle, 1) != 0)                              /* write 1 */
-                    {
-                        handle->debug_print("ds18b20: write bit failed.\n");              /* write bit failed */
-                        
-                        return 1;                                                         /* return error */
-                    }
-                    ss[(m * 8 + n)] = 1;                                                  /* set 1 */
-                }    
-                else if (k == 0x00)                                                       /* if 0000 */
-                {
-                    conflict_bit = (uint8_t)(m * 8 + n + 1);                              /* flag conflict bit */
-                    if (conflict_bit > buffer[l])                                         /* check buffer */
-                    {
-                        if (a_ds18b20_write_bit(handle, 0) != 0)                          /* write 0 */
-                        {
-                            handle->debug_print("ds18b20: write bit failed.\n");          /* write bit failed */
-                            
-                            return 1;                                                     /* return error */
-                        }
-                        ss[(m * 8 + n)] = 0;                                              /* set 0 */
-                        buffer[++l] = conflict_bit;                                       /* set conflict bit */
-                    }
-                    else if (conflict_bit < buffer[l])                                    /* if > buffer */
-                    {
-                        s = s|((ss[(m * 8 + n)] & 0x01) << 7);                            /* get s */
-                        if (a_ds18b20_write_bit(handle, ss[(m*8+n)]) != 0)                /* write data */
-                        {
-                            handle->debug_print("ds18b20: write bit failed.\n");          /* write bit failed */
-                            
-                            return 1;                                                     /* return error */
-                        }
-                    }    
-                    else if (conflict_bit == buffer[l])                                   /* if == buffer */
-                    {
-                        s = s | 0x80;                                                     /* set 7 bit */
-                        if (a_ds18b20_write_bit(handle, 1) != 0)                          /* write 1 */
-                        {
-                            handle->debug_print("ds18b20: write bit failed.\n");          /* write bit failed */
-                            
-                            return 1;                                                     /* return error */
-                        }
-                        ss[(m * 8 + n)] = 1;                                              /* set 1 */
-                        l = l-1;                                                          /* l-- */
-                    }
-                    else
-                    {
-                        
-                    }
-                }
-                else
-                {
-                    *number = num;                                                        /* save num */
-                    
-                    return 0;                                                             /* success return 0 */
-                }
-                handle->delay_us(5);                                                      /* delay 5 us */
+                return 1;                                                                 /* return error */
             }
-            pid[num][m] = s;                                                              /* save s */
-            s = 0;                                                                        /* reset s */
+            if (k == 0x03)                                                                /* no device */
+            {
+                *number = num;                                                            /* save num */
+                
+                return 0;                                                                 /* success return 0 */
+            }
+            if ((k == 0x00) && (taken == 0))                                              /* conflict, took 0 */
+            {
+                zeros |= (uint64_t)1 << i;                                                /* 1 path left */
+            }
+            rom |= (uint64_t)taken << i;                                                  /* save bit */
+        }
+        for (i = 0; i < 8; i++)                                                           /* 8 bytes */
+        {
+            pid[num][i] = (uint8_t)(rom >> (i * 8));                                      /* save byte */
         }
         num++;                                                                            /* num++ */
-        if (num > (*number))                                                              /* check num range */
+        if (zeros == 0)                                                                   /* every path taken */
         {
             break;                                                                        /* break */
         }
-    } while (buffer[l] != 0);                                                             /* check buffer[l] */
+        for (i = 63; ((zeros >> i) & 0x01) == 0; i--)                                    /* last 0 conflict */
+        {
+            
+        }
+        path = (rom & (((uint64_t)1 << i) - 1)) | ((uint64_t)1 << i);                     /* same prefix, then 1 */
+    }
     *number = num;                                                                        /* set number */
     
     return 0;                                                                             /* success return 0 */
@@ -1976,6 +2182,56 @@ uint8_t ds18b20_search_alarm(ds18b20_handle_t *handle, uint8_t (*rom)[8], uint8_
     return a_ds18b20_search(handle, rom, DS18B20_CMD_ALARM_SEARCH, num);       /* return search result */
 }
 
+/**
+ * @brief      verify that the chip in the handle's rom is on the bus
+ * @param[in]  *handle pointer to a ds18b20 handle structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 chip not found
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds18b20_verify_rom(ds18b20_handle_t *handle)
+{
+    uint8_t i, k, taken, bit;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    if (a_ds18b20_reset(handle) != 0)                                          /* reset bus */
+    {
+        DS18B20_LOG(handle, RESET_FAILED);                                     /* reset bus failed */
+        
+        return 1;                                                              /* return error */
+    }
+    if (a_ds18b20_write_byte(handle, DS18B20_CMD_SEARCH_ROM) != 0)             /* write search rom command */
+    {
+        DS18B20_LOG(handle, WRITE_CMD_FAILED);                                 /* write command failed */
+        
+        return 1;                                                              /* return error */
+    }
+    for (i = 0; i < 64; i++)                                                   /* 64 rom bits */
+    {
+        bit = (handle->rom[i >> 3] >> (i & 7)) & 0x01;                         /* rom bit */
+        if (a_ds18b20_triplet(handle, bit, (uint8_t *)&k, (uint8_t *)&taken) != 0)   /* search step */
+        {
+            return 1;                                                          /* return error */
+        }
+        if ((k == 0x03) || (taken != bit))                                     /* nobody has this bit */
+        {
+            return 1;                                                          /* return error */
+        }
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+
 /**
  * @brief      get the power mode
  * @param[in]  *handle pointer to a ds18b20 handle structure
@@ -2002,25 +2258,25 @@ uint8_t ds18b20_get_power_mode(ds18b20_handle_t *handle, ds18b20_power_mode_t *p
     {
         if (a_ds18b20_reset(handle) != 0)                                       /* bus reset */
         {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* bus reset failed */
+            DS18B20_LOG(handle, BUS_RESET_FAILED);                              /* bus reset failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_SKIP_ROM) != 0)            /* sent skip rom command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_READ_POWER_SUPPLY) != 0)   /* write read power supply command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_read_bit(handle, (uint8_t *)power_mode) != 0)             /* get power mode */
         {
-            handle->debug_print("ds18b20: read bit failed.\n");                 /* read a bit failed */
+            DS18B20_LOG(handle, READ_BIT_FAILED);                               /* read a bit failed */
             
             return 1;                                                           /* return error */
         }
@@ -2031,13 +2287,13 @@ uint8_t ds18b20_get_power_mode(ds18b20_handle_t *handle, ds18b20_power_mode_t *p
     {
         if (a_ds18b20_reset(handle) != 0)                                       /* bus reset */
         {
-            handle->debug_print("ds18b20: bus reset failed.\n");                /* bus reset failed */
+            DS18B20_LOG(handle, BUS_RESET_FAILED);                              /* bus reset failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_MATCH_ROM) != 0)           /* sent match rom command */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
 
             return 1;                                                           /* return error */
         }
@@ -2045,20 +2301,20 @@ uint8_t ds18b20_get_power_mode(ds18b20_handle_t *handle, ds18b20_power_mode_t *p
         {
             if (a_ds18b20_write_byte(handle, handle->rom[i]) != 0)              /* send rom */
             {
-                handle->debug_print("ds18b20: write command failed.\n");        /* write command failed */
+                DS18B20_LOG(handle, WRITE_CMD_FAILED);                          /* write command failed */
                 
                 return 1;                                                       /* return error */
             }
         }
         if (a_ds18b20_write_byte(handle, DS18B20_CMD_READ_POWER_SUPPLY) != 0)   /* write read power supply */
         {
-            handle->debug_print("ds18b20: write command failed.\n");            /* write command failed */
+            DS18B20_LOG(handle, WRITE_CMD_FAILED);                              /* write command failed */
             
             return 1;                                                           /* return error */
         }
         if (a_ds18b20_read_bit(handle, (uint8_t *)power_mode) != 0)             /* get power mode */
         {
-            handle->debug_print("ds18b20: read bit failed.\n");                 /* read a bit failed */
+            DS18B20_LOG(handle, READ_BIT_FAILED);                               /* read a bit failed */
             
             return 1;                                                           /* return error */
         }
@@ -2067,7 +2323,7 @@ uint8_t ds18b20_get_power_mode(ds18b20_handle_t *handle, ds18b20_power_mode_t *p
     }
     else
     {
-        handle->debug_print("ds18b20: mode invalid.\n");                        /* mode is invalid */
+        DS18B20_LOG(handle, MODE_INVALID);                                      /* mode is invalid */
         
         return 1;                                                               /* return error */
     }
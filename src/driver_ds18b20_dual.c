@@ -1,63 +1,528 @@
 // driver_ds18b20_dual.c
 /**
- * DS18B20 dual-sensor driver implementation with hard-coded ROMs
+ * DS18B20 driver for the fixed sensor set in topology.h
  */
 
 #include "driver_ds18b20_dual.h"
+#include "ow_tune.h"
+#include "dlog.h"
+#include "pico/stdlib.h"
 #include <stdio.h>
+#if DS18B20_DUAL_CORES > 1
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
 
-// Hardcoded ROMs for two sensors
-static const uint8_t gs_sensor_roms[DS18B20_DUAL_MAX_SENSORS][8] = {
-    {0x28, 0xAE, 0x76, 0x56, 0x00, 0x00, 0x00, 0x71},  // Sensor 0
-    {0x28, 0x9E, 0x1C, 0x58, 0x00, 0x00, 0x00, 0x25}   // Sensor 1
+// Sensor table generated from topology.h
+typedef struct {
+    uint8_t bus;           // topology_bus_t
+    uint8_t resolution;    // ds18b20_resolution_t
+    uint8_t rom[8];
+} ds18b20_dual_sensor_t;
+
+#define A_SENSOR(arg, bus, res, r0, r1, r2, r3, r4, r5, r6, r7) \
+    { TOPOLOGY_BUS_##bus, res, { r0, r1, r2, r3, r4, r5, r6, r7 } },
+
+static const ds18b20_dual_sensor_t gs_sensors[DS18B20_DUAL_MAX_SENSORS] = {
+    TOPOLOGY_SENSORS(A_SENSOR, 0)
 };
 
-static ds18b20_handle_t gs_handles[DS18B20_DUAL_MAX_SENSORS];
+#define A_BUS_NOT_EMPTY(name, gpio) \
+    _Static_assert(TOPOLOGY_BUS_SENSORS(TOPOLOGY_BUS_##name) > 0, "topology bus " #name " has no sensors");
+
+TOPOLOGY_BUSES(A_BUS_NOT_EMPTY)
+
+#define A_BUS_ON_A_CORE(name, gpio) \
+    _Static_assert(DS18B20_DUAL_BUS_CORE(TOPOLOGY_BUS_##name) < DS18B20_DUAL_CORES, "topology bus " #name " has no core");
+
+TOPOLOGY_BUSES(A_BUS_ON_A_CORE)
+
+#if DS18B20_DUAL_CORES > 1
+_Static_assert(DS18B20_DUAL_CORES <= configNUMBER_OF_CORES, "more bus owners than cores");
+#if OW_TRACE_ENABLE
+#error "OW_TRACE_ENABLE needs DS18B20_DUAL_CORES 1, the trace ring has a single producer"
+#endif
+#endif
+
+static ds18b20_handle_t gs_handles[DS18B20_DUAL_MAX_SENSORS];   // match rom, one per sensor
+static ds18b20_handle_t gs_bus_handles[TOPOLOGY_BUS_COUNT];      // skip rom, whole bus
+static ow_tune_t gs_tune[TOPOLOGY_BUS_COUNT];                    // slot timing per bus
+
+_Static_assert(DS18B20_DUAL_BACKOFF_MAX_SHIFT <= 7, "backoff must fit in uint8_t");
+
+// Failure history of one sensor or bus
+typedef struct {
+    uint8_t failures;      // consecutive failed reads, probes or conversions
+    uint8_t skip;          // quarantined cycles left before the next try
+    uint32_t quarantines;  // quarantines since boot
+} ds18b20_dual_health_t;
+
+static ds18b20_dual_health_t gs_health[DS18B20_DUAL_MAX_SENSORS];
+static ds18b20_dual_health_t gs_bus_health[TOPOLOGY_BUS_COUNT];
+
+// One read cycle; each core's group touches only its own buses and sensors
+typedef struct {
+    int16_t *raw;
+    float *temps;
+    uint8_t *status;
+    uint8_t converted[TOPOLOGY_BUS_COUNT];
+    uint8_t fresh[DS18B20_DUAL_CORES];     // DS18B20_DUAL_OK sensors per group
+    uint8_t phase;                         // DS18B20_DUAL_PHASE_*
+} ds18b20_dual_cycle_t;
+
+#define DS18B20_DUAL_PHASE_START   0       // start the conversions
+#define DS18B20_DUAL_PHASE_READ    1       // poll, read the sensors, revalidate the timing
+
+static ds18b20_dual_cycle_t gs_cycle;
+
+// Bus work of one core's group
+typedef struct {
+    uint32_t reads;        // sensors read or probed
+    uint64_t busy_us;      // time spent driving its buses
+} ds18b20_dual_core_stats_t;
+
+static ds18b20_dual_core_stats_t gs_core_stats[DS18B20_DUAL_CORES];
+static uint32_t gs_cycles;                 // read cycles with at least one conversion
+static uint64_t gs_wall_us;                // time the caller waited for the bus phases
+static void (*gs_bus_lock)(void);          // held over each bus phase, never over the sleep
+static void (*gs_bus_unlock)(void);
+
+#if DS18B20_DUAL_CORES > 1
+// Bus owner task of one core
+typedef struct {
+    TaskHandle_t task;
+    StaticTask_t tcb;
+    StackType_t stack[DS18B20_DUAL_OWNER_STACK];
+} ds18b20_dual_owner_t;
+
+static ds18b20_dual_owner_t gs_owners[DS18B20_DUAL_CORES];
+static const char *const gc_owner_names[] = { "ow_core0", "ow_core1" };
+static TaskHandle_t gs_caller;             // notified once by every owner per phase
+#endif
+
+// Count a failure; from DS18B20_DUAL_QUARANTINE_FAILS on, sit out 1, 2, 4... cycles.
+// Returns 1 when this failure starts a quarantine
+static uint8_t a_health_failed(ds18b20_dual_health_t *h)
+{
+    uint8_t shift;
+
+    if (h->failures < UINT8_MAX) {
+        h->failures++;
+    }
+    if (h->failures < DS18B20_DUAL_QUARANTINE_FAILS) {
+        return 0;
+    }
+    shift = (uint8_t)(h->failures - DS18B20_DUAL_QUARANTINE_FAILS);
+    if (shift > DS18B20_DUAL_BACKOFF_MAX_SHIFT) {
+        shift = DS18B20_DUAL_BACKOFF_MAX_SHIFT;
+    }
+    h->skip = (uint8_t)(1u << shift);
+    if (h->failures == DS18B20_DUAL_QUARANTINE_FAILS) {
+        h->quarantines++;
+        return 1;
+    }
+    return 0;
+}
+
+// Count a success; returns the failures it ended a quarantine after, 0 if none
+static uint8_t a_health_ok(ds18b20_dual_health_t *h)
+{
+    uint8_t failures = (h->failures >= DS18B20_DUAL_QUARANTINE_FAILS) ? h->failures : 0;
+
+    h->failures = 0;
+    h->skip = 0;
+    return failures;
+}
+
+// 1 while a quarantine sits this cycle out
+static uint8_t a_health_skip(ds18b20_dual_health_t *h)
+{
+    if (h->skip == 0) {
+        return 0;
+    }
+    h->skip--;
+    return 1;
+}
+
+static uint8_t a_health_quarantined(const ds18b20_dual_health_t *h)
+{
+    return (h->failures >= DS18B20_DUAL_QUARANTINE_FAILS) ? 1 : 0;
+}
+
+// A bus or sensor that failed at boot starts out quarantined instead of working up to it
+static void a_health_boot_failed(ds18b20_dual_health_t *h)
+{
+    if (h->failures < DS18B20_DUAL_QUARANTINE_FAILS - 1) {
+        h->failures = DS18B20_DUAL_QUARANTINE_FAILS - 1;
+    }
+    (void)a_health_failed(h);
+}
+
+// Read one sensor whose bus converted this cycle
+static uint8_t a_read_sensor(uint8_t i, int16_t *raw, float *temp)
+{
+    uint8_t failures;
+
+    if (a_health_skip(&gs_health[i])) {
+        return DS18B20_DUAL_QUARANTINED;
+    }
+    /* a quarantined sensor must answer a search for its rom before it costs a scratchpad read */
+    if ((a_health_quarantined(&gs_health[i]) && (ds18b20_verify_rom(&gs_handles[i]) != 0)) ||
+        (ds18b20_read_converted(&gs_handles[i], raw, temp) != 0)) {
+        if (a_health_failed(&gs_health[i])) {
+            DLOG2(DS18B20_DUAL_QUARANTINE, i, gs_health[i].failures);
+        }
+        return DS18B20_DUAL_FAILED;
+    }
+    failures = a_health_ok(&gs_health[i]);
+    if (failures != 0) {
+        DLOG2(DS18B20_DUAL_RECOVERED, i, failures);
+    }
+    return DS18B20_DUAL_OK;
+}
+
+// Measure a bus and switch it to the fastest profile its wiring allows
+static void a_tune_bus(uint8_t b)
+{
+    ow_tune_measure_t m;
+
+    if (gc_ds18b20_interface_buses[b].bus_touch != NULL) {
+        return;                         /* slots timed by the UART or the bridge */
+    }
+    if (ds18b20_interface_measure(b, &m.rise_ns, &m.presence_delay_us, &m.presence_width_us) != 0) {
+        ow_tune_apply(&gs_tune[b], gc_ds18b20_interface_buses[b].timing, NULL);
+        return;
+    }
+    ow_tune_apply(&gs_tune[b], gc_ds18b20_interface_buses[b].timing, &m);
+}
+
+// Bring up the skip rom handle of a bus; also retried while the bus is quarantined
+static uint8_t a_init_bus(uint8_t b)
+{
+    DRIVER_DS18B20_LINK_INIT   (&gs_bus_handles[b], ds18b20_handle_t);
+    DRIVER_DS18B20_LINK_BUS    (&gs_bus_handles[b], &gc_ds18b20_interface_buses[b]);
+    if (ds18b20_init(&gs_bus_handles[b]) != 0) {
+        return 1;
+    }
+    ds18b20_set_mode(&gs_bus_handles[b], DS18B20_MODE_SKIP_ROM);
+    a_tune_bus(b);
+    return 0;
+}
+
+// Link a sensor to its bus and give it its fixed ROM; also retried while the sensor is quarantined
+static uint8_t a_init_sensor(uint8_t i)
+{
+    DRIVER_DS18B20_LINK_INIT   (&gs_handles[i], ds18b20_handle_t);
+    DRIVER_DS18B20_LINK_BUS    (&gs_handles[i], &gc_ds18b20_interface_buses[gs_sensors[i].bus]);
+    if (ds18b20_init(&gs_handles[i]) != 0) {
+        return 1;
+    }
+    ds18b20_set_rom     (&gs_handles[i], (uint8_t *)gs_sensors[i].rom);
+    ds18b20_set_mode    (&gs_handles[i], DS18B20_MODE_MATCH_ROM);
+    if (ds18b20_scratchpad_set_resolution(&gs_handles[i], (ds18b20_resolution_t)gs_sensors[i].resolution) != 0) {
+        gs_handles[i].inited = 0;       /* the bus stays up for the other handles; retried like a failed init */
+        return 1;
+    }
+    return 0;
+}
+
+// Start the conversions of one core's buses
+static void a_group_start(uint8_t core)
+{
+    for (uint8_t b = 0; b < TOPOLOGY_BUS_COUNT; ++b) {
+        if (DS18B20_DUAL_BUS_CORE(b) != core) {
+            continue;
+        }
+        gs_cycle.converted[b] = 0;
+        if (a_health_skip(&gs_bus_health[b])) {
+            continue;
+        }
+        /* Buses and sensors that failed at boot get their init retried when their quarantine is up */
+        if ((gs_bus_handles[b].inited != 1) && (a_init_bus(b) != 0)) {
+            (void)a_health_failed(&gs_bus_health[b]);
+            continue;
+        }
+        for (uint8_t i = 0; i < DS18B20_DUAL_MAX_SENSORS; ++i) {
+            if ((gs_sensors[i].bus == b) && (gs_handles[i].inited != 1) && (gs_health[i].skip == 0)) {
+                (void)a_init_sensor(i);     /* still uninited, its read counts the failure */
+            }
+        }
+        if (ds18b20_start_conversion(&gs_bus_handles[b]) != 0) {
+            (void)a_health_failed(&gs_bus_health[b]);
+            continue;
+        }
+        gs_cycle.converted[b] = 1;
+    }
+}
+
+// Finish one core's buses after the sleep: poll, read every sensor, revalidate the timing
+static void a_group_read(uint8_t core)
+{
+    uint8_t b;
+
+    for (b = 0; b < TOPOLOGY_BUS_COUNT; ++b) {
+        if ((DS18B20_DUAL_BUS_CORE(b) != core) || (gs_cycle.converted[b] == 0)) {
+            continue;
+        }
+        if (ds18b20_wait_conversion(&gs_bus_handles[b], 0) != 0) {
+            gs_cycle.converted[b] = 0;
+            (void)a_health_failed(&gs_bus_health[b]);
+        } else {
+            (void)a_health_ok(&gs_bus_health[b]);
+        }
+    }
+    /* A failed or quarantined sensor costs only its own slots */
+    gs_cycle.fresh[core] = 0;
+    for (uint8_t i = 0; i < DS18B20_DUAL_MAX_SENSORS; ++i) {
+        b = gs_sensors[i].bus;
+        if (DS18B20_DUAL_BUS_CORE(b) != core) {
+            continue;
+        }
+        if (gs_cycle.converted[b] == 0) {
+            gs_cycle.status[i] = DS18B20_DUAL_BUS_FAILED;
+            continue;
+        }
+        gs_cycle.status[i] = a_read_sensor(i, &gs_cycle.raw[i], &gs_cycle.temps[i]);
+        if (gs_cycle.status[i] == DS18B20_DUAL_OK) {
+            gs_cycle.fresh[core]++;
+        }
+        if (gs_cycle.status[i] != DS18B20_DUAL_QUARANTINED) {
+            gs_core_stats[core].reads++;
+        }
+    }
+    /* Revalidate the timing from the CRC error rate, failed cycles included */
+    for (b = 0; b < TOPOLOGY_BUS_COUNT; ++b) {
+        if ((DS18B20_DUAL_BUS_CORE(b) == core) &&
+            (ow_tune_check(&gs_tune[b], gc_ds18b20_interface_buses[b].timing) != 0)) {
+            a_tune_bus(b);
+        }
+    }
+}
+
+// Run the current phase for one core's group of buses
+static void a_group_run(uint8_t core)
+{
+    uint32_t t0 = time_us_32();
+
+    if (gs_cycle.phase == DS18B20_DUAL_PHASE_START) {
+        a_group_start(core);
+    } else {
+        a_group_read(core);
+    }
+    gs_core_stats[core].busy_us += time_us_32() - t0;
+}
+
+#if DS18B20_DUAL_CORES > 1
+// Bus owner pinned to one core; runs its group's part of each phase
+static void a_owner_task(void *params)
+{
+    uint8_t core = (uint8_t)(uintptr_t)params;
+
+    for (;;) {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        a_group_run(core);
+        (void)xTaskNotifyGive(gs_caller);
+    }
+}
+#endif
+
+static void a_lock(void)
+{
+    if (gs_bus_lock != NULL) {
+        gs_bus_lock();
+    }
+}
+
+static void a_unlock(void)
+{
+    if (gs_bus_unlock != NULL) {
+        gs_bus_unlock();
+    }
+}
+
+// Run one phase on every group and return once all of them finished it
+static void a_run_groups(uint8_t phase)
+{
+    gs_cycle.phase = phase;
+#if DS18B20_DUAL_CORES > 1
+    gs_caller = xTaskGetCurrentTaskHandle();
+    for (uint8_t c = 0; c < DS18B20_DUAL_CORES; ++c) {
+        (void)xTaskNotifyGive(gs_owners[c].task);
+    }
+    for (uint8_t c = 0; c < DS18B20_DUAL_CORES; ++c) {
+        (void)ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+    }
+#else
+    a_group_run(0);
+#endif
+}
+
+void ds18b20_dual_set_bus_lock(void (*lock)(void), void (*unlock)(void))
+{
+    gs_bus_lock = lock;
+    gs_bus_unlock = unlock;
+}
 
 uint8_t ds18b20_dual_init(void)
 {
-    /* Link interface to each handle */
+    uint8_t buses = 0;
+
+    /* One skip rom handle per bus starts the conversions; a bus that is down starts quarantined */
+    a_lock();
+    for (uint8_t b = 0; b < TOPOLOGY_BUS_COUNT; ++b) {
+        if (a_init_bus(b) != 0) {
+            ds18b20_interface_debug_print("ds18b20_dual: no presence on bus %d\r\n", b);
+            a_health_boot_failed(&gs_bus_health[b]);
+            continue;
+        }
+        buses++;
+    }
+    if (buses == 0) {
+        a_unlock();
+        return 1;
+    }
+
+    /* A sensor that fails here is read as failed and retried after its quarantine */
     for (uint8_t i = 0; i < DS18B20_DUAL_MAX_SENSORS; ++i) {
-        DRIVER_DS18B20_LINK_INIT   (&gs_handles[i], ds18b20_handle_t);
-        DRIVER_DS18B20_LINK_BUS_INIT   (&gs_handles[i], ds18b20_interface_init);
-        DRIVER_DS18B20_LINK_BUS_DEINIT (&gs_handles[i], ds18b20_interface_deinit);
-        DRIVER_DS18B20_LINK_BUS_READ   (&gs_handles[i], ds18b20_interface_read);
-        DRIVER_DS18B20_LINK_BUS_WRITE  (&gs_handles[i], ds18b20_interface_write);
-        DRIVER_DS18B20_LINK_DELAY_MS   (&gs_handles[i], ds18b20_interface_delay_ms);
-        DRIVER_DS18B20_LINK_DELAY_US   (&gs_handles[i], ds18b20_interface_delay_us);
-        DRIVER_DS18B20_LINK_ENABLE_IRQ (&gs_handles[i], ds18b20_interface_disable_irq);
-        DRIVER_DS18B20_LINK_DISABLE_IRQ(&gs_handles[i], ds18b20_interface_enable_irq);
-        DRIVER_DS18B20_LINK_DEBUG_PRINT(&gs_handles[i], ds18b20_interface_debug_print);
-
-        /* Initialize core driver */
-        if (ds18b20_init(&gs_handles[i]) != 0) {
+        if (a_init_sensor(i) != 0) {
             ds18b20_interface_debug_print("ds18b20_dual: init sensor %d failed\r\n", i);
-            return 1;
+            a_health_boot_failed(&gs_health[i]);
+        }
+    }
+    a_unlock();
+
+#if DS18B20_DUAL_CORES > 1
+    /* One bus owner per core; the spinlocks only mask interrupts on the core holding them */
+    for (uint8_t c = 0; c < DS18B20_DUAL_CORES; ++c) {
+        if (gs_owners[c].task != NULL) {
+            continue;
         }
-        /* Assign fixed ROM and set to MATCH_ROM */
-        ds18b20_set_rom     (&gs_handles[i], (uint8_t *)gs_sensor_roms[i]);
-        ds18b20_set_mode    (&gs_handles[i], DS18B20_MODE_MATCH_ROM);
-        ds18b20_scratchpad_set_resolution(&gs_handles[i], DS18B20_RESOLUTION_12BIT);
+        gs_owners[c].task = xTaskCreateStaticAffinitySet(a_owner_task, gc_owner_names[c], DS18B20_DUAL_OWNER_STACK,
+                                                         (void *)(uintptr_t)c, DS18B20_DUAL_OWNER_PRIO,
+                                                         gs_owners[c].stack, &gs_owners[c].tcb, 1u << c);
     }
+#endif
     return 0;
 }
 
 uint8_t ds18b20_dual_read(float temps[DS18B20_DUAL_MAX_SENSORS])
 {
-    int16_t raw;
+    int16_t raw[DS18B20_DUAL_MAX_SENSORS];
+
+    return ds18b20_dual_read_raw(raw, temps);
+}
+
+uint8_t ds18b20_dual_read_raw(int16_t raw[DS18B20_DUAL_MAX_SENSORS],
+                              float temps[DS18B20_DUAL_MAX_SENSORS])
+{
+    uint8_t status[DS18B20_DUAL_MAX_SENSORS];
+
+    return ds18b20_dual_read_status(raw, temps, status);
+}
+
+uint8_t ds18b20_dual_read_status(int16_t raw[DS18B20_DUAL_MAX_SENSORS],
+                                 float temps[DS18B20_DUAL_MAX_SENSORS],
+                                 uint8_t status[DS18B20_DUAL_MAX_SENSORS])
+{
+    uint8_t fresh = 0;
+    uint8_t any = 0;
+    uint32_t t0;
+
+    gs_cycle.raw = raw;
+    gs_cycle.temps = temps;
+    gs_cycle.status = status;
+
+    /* Every bus converts at once; a quarantined bus sits the cycle out */
+    a_lock();
+    t0 = time_us_32();
+    a_run_groups(DS18B20_DUAL_PHASE_START);
+    gs_wall_us += time_us_32() - t0;
+    a_unlock();
+    for (uint8_t b = 0; b < TOPOLOGY_BUS_COUNT; ++b) {
+        any |= gs_cycle.converted[b];
+    }
+    /* One sleep sized for the slowest sensor, taken here while no core drives a bus */
+    if (any != 0) {
+        ds18b20_interface_delay_ms(TOPOLOGY_CONVERT_SLEEP_MS);
+        gs_cycles++;
+    }
+    a_lock();
+    t0 = time_us_32();
+    a_run_groups(DS18B20_DUAL_PHASE_READ);
+    gs_wall_us += time_us_32() - t0;
+    a_unlock();
+    for (uint8_t c = 0; c < DS18B20_DUAL_CORES; ++c) {
+        fresh += gs_cycle.fresh[c];
+    }
+    return (fresh == DS18B20_DUAL_MAX_SENSORS) ? 0 : 1;
+}
+
+void ds18b20_dual_print_health(void)
+{
     for (uint8_t i = 0; i < DS18B20_DUAL_MAX_SENSORS; ++i) {
-        if (ds18b20_read(&gs_handles[i], &raw, &temps[i]) != 0) {
-            return 1;
+        printf("ds18b20 sensor %u (bus %u): %u failures, %s, %lu quarantines\r\n", i, gs_sensors[i].bus,
+               gs_health[i].failures, a_health_quarantined(&gs_health[i]) ? "quarantined" : "ok",
+               (unsigned long)gs_health[i].quarantines);
+    }
+    for (uint8_t b = 0; b < TOPOLOGY_BUS_COUNT; ++b) {
+        printf("ds18b20 bus %u: %u failures, %s, %lu quarantines\r\n", b,
+               gs_bus_health[b].failures, a_health_quarantined(&gs_bus_health[b]) ? "quarantined" : "ok",
+               (unsigned long)gs_bus_health[b].quarantines);
+    }
+}
+
+void ds18b20_dual_print_timing(void)
+{
+    ds18b20_interface_lock_stats_t lock;
+    uint8_t width;
+
+    for (uint8_t b = 0; b < TOPOLOGY_BUS_COUNT; ++b) {
+        ow_tune_print(b, &gs_tune[b], gc_ds18b20_interface_buses[b].timing);
+        if (ds18b20_get_presence_width(&gs_bus_handles[b], &width) == 0) {
+            printf("ow bus %u: last presence pulse %u us\r\n", b, width);
         }
+        ds18b20_interface_lock_stats(b, &lock);
+        printf("ow bus %u: %lu critical sections, longest %lu us, %lu us total\r\n", b,
+               (unsigned long)lock.sections, (unsigned long)lock.max_us, (unsigned long)lock.total_us);
     }
-    return 0;
+    for (uint8_t c = 0; c < DS18B20_DUAL_CORES; ++c) {
+        printf("ow core %u: %lu sensor reads, %lu ms on its buses\r\n", c,
+               (unsigned long)gs_core_stats[c].reads, (unsigned long)(gs_core_stats[c].busy_us / 1000));
+    }
+    printf("ow: %lu cycles, %lu ms waiting for the buses\r\n",
+           (unsigned long)gs_cycles, (unsigned long)(gs_wall_us / 1000));
 }
 
 uint8_t ds18b20_dual_deinit(void)
 {
-    for (uint8_t i = 0; i < DS18B20_DUAL_MAX_SENSORS; ++i) {
-        ds18b20_deinit(&gs_handles[i]);
+    uint8_t res = 0;
+
+#if DS18B20_DUAL_CORES > 1
+    for (uint8_t c = 0; c < DS18B20_DUAL_CORES; ++c) {
+        if (gs_owners[c].task != NULL) {
+            vTaskDelete(gs_owners[c].task);
+            gs_owners[c].task = NULL;
+        }
     }
-    ds18b20_interface_deinit();
-    return 0;
+#endif
+    /* The handles of a bus share it: the first one still up releases it, the rest are just closed */
+    for (uint8_t b = 0; b < TOPOLOGY_BUS_COUNT; ++b) {
+        uint8_t released = 0;
+
+        if (gs_bus_handles[b].inited == 1) {
+            res |= (ds18b20_deinit(&gs_bus_handles[b]) != 0) ? 1 : 0;
+            released = 1;
+        }
+        for (uint8_t i = 0; i < DS18B20_DUAL_MAX_SENSORS; ++i) {
+            if ((gs_sensors[i].bus != b) || (gs_handles[i].inited != 1)) {
+                continue;
+            }
+            if (released == 0) {
+                res |= (ds18b20_deinit(&gs_handles[i]) != 0) ? 1 : 0;
+                released = 1;
+            }
+            gs_handles[i].inited = 0;
+        }
+    }
+    return res;
 }
\ No newline at end of file
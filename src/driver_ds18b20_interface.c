@@ -38,80 +38,513 @@
 
 #include "driver_ds18b20_interface.h"
 #include "pico/stdlib.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
 #include "FreeRTOS.h"
 #include "task.h"
+#include "semphr.h"
 #include <stdarg.h>
 #include <stdio.h>
+#include <string.h>
 
-/* 1-Wire bus GPIO pin (override with -DDS18B20_INTERFACE_PIN=N if needed) */
-#ifndef DS18B20_INTERFACE_PIN
-#define DS18B20_INTERFACE_PIN  4
+/* Lower clk_sys during long waits (conversions); needs clock_gov.c linked */
+#ifndef DS18B20_INTERFACE_CLOCK_GOV
+#define DS18B20_INTERFACE_CLOCK_GOV  0
+#endif
+
+#if DS18B20_INTERFACE_CLOCK_GOV
+#include "clock_gov.h"
+#endif
+
+/* Time the presence pulse with GPIO edge interrupts instead of polling it with interrupts off */
+#ifndef DS18B20_INTERFACE_EDGE_RESET
+#define DS18B20_INTERFACE_EDGE_RESET  1
+#endif
+
+#if DS18B20_INTERFACE_EDGE_RESET
+#include "ow_edge.h"
+#endif
+
+/* Topology bus run by a UART with DMA slots instead of GPIO bit-banging (ow_uart.h), -1 for none */
+#ifndef DS18B20_INTERFACE_UART_BUS
+#define DS18B20_INTERFACE_UART_BUS    -1
+#endif
+
+/* UART instance for that bus; its TX is the topology GPIO */
+#ifndef DS18B20_INTERFACE_UART_ID
+#define DS18B20_INTERFACE_UART_ID     1
+#endif
+
+/* UART RX GPIO, tied to the bus */
+#ifndef DS18B20_INTERFACE_UART_RX_PIN
+#define DS18B20_INTERFACE_UART_RX_PIN (gc_ds18b20_bus_pins[DS18B20_INTERFACE_UART_BUS] + 1)
+#endif
+
+#if DS18B20_INTERFACE_UART_BUS >= 0
+#include "ow_uart.h"
+#endif
+
+#if TOPOLOGY_HAS_DS2482
+#include "ds2482.h"
 #endif
 
 /**
- * @brief  Initialize the 1-Wire bus GPIO
- * @return 0 on success, 1 on failure
+ * @brief      Initialize one 1-Wire bus GPIO
+ * @param[in]  pin bus GPIO
+ * @return     0 on success, 1 on failure
  */
-uint8_t ds18b20_interface_init(void)
+static inline uint8_t a_ds18b20_gpio_init(uint pin)
 {
-    gpio_init(DS18B20_INTERFACE_PIN);
-    gpio_set_function(DS18B20_INTERFACE_PIN, GPIO_FUNC_SIO);
+    gpio_init(pin);
+    gpio_set_function(pin, GPIO_FUNC_SIO);
     /* Release bus: input with pull-up */
-    gpio_set_dir(DS18B20_INTERFACE_PIN, GPIO_IN);
-    gpio_pull_up(DS18B20_INTERFACE_PIN);
+    gpio_set_dir(pin, GPIO_IN);
+    gpio_pull_up(pin);
     return 0;
 }
 
 /**
- * @brief  Deinitialize the 1-Wire bus GPIO
- * @return 0 on success, 1 on failure
+ * @brief      Deinitialize one 1-Wire bus GPIO
+ * @param[in]  pin bus GPIO
+ * @return     0 on success, 1 on failure
  */
-uint8_t ds18b20_interface_deinit(void)
+static inline uint8_t a_ds18b20_gpio_deinit(uint pin)
 {
-    gpio_disable_pulls(DS18B20_INTERFACE_PIN);
-    gpio_set_dir(DS18B20_INTERFACE_PIN, GPIO_IN);
-    gpio_deinit(DS18B20_INTERFACE_PIN);
+    gpio_disable_pulls(pin);
+    gpio_set_dir(pin, GPIO_IN);
+    gpio_deinit(pin);
     return 0;
 }
 
 /**
  * @brief      Drive or release the bus line
+ * @param[in]  pin bus GPIO
  * @param[in]  bit 0 to pull low, 1 to release (let high)
  * @return     0 on success, 1 on failure
  */
-uint8_t ds18b20_interface_write(uint8_t bit)
+static inline uint8_t a_ds18b20_gpio_write(uint pin, uint8_t bit)
 {
     if (bit == 0) {
         /* Drive bus low */
-        gpio_set_dir(DS18B20_INTERFACE_PIN, GPIO_OUT);
-        gpio_put(DS18B20_INTERFACE_PIN, 0);
+        gpio_set_dir(pin, GPIO_OUT);
+        gpio_put(pin, 0);
     } else {
         /* Release bus (internal pull-up holds it high) */
-        gpio_set_dir(DS18B20_INTERFACE_PIN, GPIO_IN);
+        gpio_set_dir(pin, GPIO_IN);
     }
     return 0;
 }
 
 /**
  * @brief      Sample the bus line
+ * @param[in]  pin bus GPIO
  * @param[out] *bit receives 0 if low, 1 if high
  * @return     0 on success, 1 on failure
  */
-uint8_t ds18b20_interface_read(uint8_t *bit)
+static inline uint8_t a_ds18b20_gpio_read(uint pin, uint8_t *bit)
 {
     if (bit == NULL) {
         return 1;
     }
-    *bit = gpio_get(DS18B20_INTERFACE_PIN) ? 1 : 0;
+    *bit = gpio_get(pin) ? 1 : 0;
     return 0;
 }
 
+#define A_DS18B20_BUS_PIN(name, gpio)       [TOPOLOGY_BUS_##name] = (gpio),
+#define A_DS18B20_BUS_TIMING(name, gpio)    [TOPOLOGY_BUS_##name] = DS18B20_TIMING_STANDARD,
+
+static const uint gc_ds18b20_bus_pins[TOPOLOGY_BUS_COUNT] = { TOPOLOGY_BUSES(A_DS18B20_BUS_PIN) };
+
+/* Slot timing per bus, tuned at run time (ow_tune.h) */
+static ds18b20_timing_t gs_ds18b20_timing[TOPOLOGY_BUS_COUNT] = { TOPOLOGY_BUSES(A_DS18B20_BUS_TIMING) };
+
+/*
+ * Slot critical section of one bus: interrupts off on the calling core and
+ * the bus's own hardware spinlock, so the other core keeps its interrupts
+ * and scheduler and can bit-bang a different bus at the same time.
+ */
+typedef struct {
+    spin_lock_t *lock;
+    uint32_t save;
+    uint32_t t0;
+    uint8_t depth;
+    uint8_t core;
+    ds18b20_interface_lock_stats_t stats;
+} a_ds18b20_lock_t;
+
+static a_ds18b20_lock_t gs_ds18b20_lock[TOPOLOGY_BUS_COUNT];
+
+/**
+ * @brief     Claim a hardware spinlock for a bus
+ * @param[in] bus topology_bus_t
+ */
+static void a_ds18b20_lock_claim(uint8_t bus)
+{
+    if (gs_ds18b20_lock[bus].lock == NULL) {
+        gs_ds18b20_lock[bus].lock = spin_lock_init((uint)spin_lock_claim_unused(true));
+    }
+}
+
+/**
+ * @brief     Enter the slot critical section of a bus; nests on the same core
+ * @param[in] bus topology_bus_t
+ */
+static inline void a_ds18b20_lock_enter(uint8_t bus)
+{
+    a_ds18b20_lock_t *l = &gs_ds18b20_lock[bus];
+    uint32_t save;
+
+    save = save_and_disable_interrupts();
+    if ((l->depth != 0) && (l->core == get_core_num())) {
+        l->depth++;                             /* already ours, interrupts were off */
+        return;
+    }
+    restore_interrupts(save);
+    save = spin_lock_blocking(l->lock);
+    l->save = save;
+    l->core = (uint8_t)get_core_num();
+    l->depth = 1;
+    l->t0 = time_us_32();
+}
+
+/**
+ * @brief     Leave the slot critical section of a bus
+ * @param[in] bus topology_bus_t
+ */
+static inline void a_ds18b20_lock_exit(uint8_t bus)
+{
+    a_ds18b20_lock_t *l = &gs_ds18b20_lock[bus];
+    uint32_t held;
+
+    if (--l->depth != 0) {
+        return;
+    }
+    held = time_us_32() - l->t0;
+    l->stats.sections++;
+    l->stats.total_us += held;
+    if (held > l->stats.max_us) {
+        l->stats.max_us = held;
+    }
+    spin_unlock(l->lock, l->save);
+}
+
+#if DS18B20_INTERFACE_EDGE_RESET
+
+/* Presence pulse edges and the receive window wakeup of one bus */
+typedef struct {
+    ow_edge_capture_t edge;
+    SemaphoreHandle_t window;
+    StaticSemaphore_t window_buf;
+} a_ds18b20_capture_t;
+
+static a_ds18b20_capture_t gs_ds18b20_capture[TOPOLOGY_BUS_COUNT];
+static uint8_t gs_ds18b20_edge_installed[TOPOLOGY_BUS_COUNT];
+static uint8_t gs_ds18b20_edge_users;      /* buses in gs_ds18b20_edge_installed */
+
+/**
+ * @brief Timestamp presence pulse edges on every bus pin
+ * @note  Raw handler on IO_IRQ_BANK0, shared with the radio IRQ pin
+ */
+static void a_ds18b20_edge_irq(void)
+{
+    uint32_t now = time_us_32();
+
+    for (uint8_t b = 0; b < TOPOLOGY_BUS_COUNT; ++b) {
+        uint pin = gc_ds18b20_bus_pins[b];
+        uint32_t events;
+        a_ds18b20_capture_t *c = &gs_ds18b20_capture[b];
+
+        if (TOPOLOGY_IS_DS2482(pin)) {
+            continue;                           /* bridge channel, no GPIO */
+        }
+        events = gpio_get_irq_event_mask(pin) & (GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE);
+        if (events == 0) {
+            continue;
+        }
+        gpio_acknowledge_irq(pin, events);
+        ow_edge_event(&c->edge, (events & GPIO_IRQ_EDGE_FALL) != 0, (events & GPIO_IRQ_EDGE_RISE) != 0, now);
+    }
+}
+
+/**
+ * @brief  GPIO mask of the bit-banged bus pins, the ones a_ds18b20_edge_irq serves
+ * @return mask
+ */
+static uint32_t a_ds18b20_edge_mask(void)
+{
+    uint32_t mask = 0;
+
+    for (int b = 0; b < TOPOLOGY_BUS_COUNT; ++b) {
+        if (!TOPOLOGY_IS_DS2482(gc_ds18b20_bus_pins[b]) && (b != DS18B20_INTERFACE_UART_BUS)) {
+            mask |= 1u << gc_ds18b20_bus_pins[b];
+        }
+    }
+    return mask;
+}
+
+/**
+ * @brief     Mark one bus as using the edge handler; the first one registers it for all bus pins
+ * @param[in] bus topology_bus_t
+ * @note      Bus owners on both cores may retry a bus init at once, hence the critical section
+ */
+static void a_ds18b20_edge_install(uint8_t bus)
+{
+    taskENTER_CRITICAL();
+    if (gs_ds18b20_capture[bus].window == NULL) {
+        gs_ds18b20_capture[bus].window = xSemaphoreCreateBinaryStatic(&gs_ds18b20_capture[bus].window_buf);
+    }
+    if (gs_ds18b20_edge_installed[bus] == 0) {
+        if (gs_ds18b20_edge_users++ == 0) {
+            gpio_add_raw_irq_handler_masked(a_ds18b20_edge_mask(), a_ds18b20_edge_irq);
+        }
+        gs_ds18b20_edge_installed[bus] = 1;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief     Stop edge interrupts of one bus; the last one removes the handler
+ * @param[in] bus topology_bus_t
+ */
+static void a_ds18b20_edge_remove(uint8_t bus)
+{
+    taskENTER_CRITICAL();
+    if (gs_ds18b20_edge_installed[bus] != 0) {
+        gpio_set_irq_enabled(gc_ds18b20_bus_pins[bus], GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, false);
+        gs_ds18b20_edge_installed[bus] = 0;
+        if (--gs_ds18b20_edge_users == 0) {
+            gpio_remove_raw_irq_handler_masked(a_ds18b20_edge_mask(), a_ds18b20_edge_irq);
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief     End of the receive window, wakes the resetting task
+ * @param[in] id alarm id
+ * @param[in] user_data window semaphore of the bus
+ * @return    0, no repeat
+ */
+static int64_t a_ds18b20_window_alarm(alarm_id_t id, void *user_data)
+{
+    BaseType_t woken = pdFALSE;
+
+    (void)id;
+    (void)xSemaphoreGiveFromISR((SemaphoreHandle_t)user_data, &woken);
+    portYIELD_FROM_ISR(woken);
+    return 0;
+}
+
+/**
+ * @brief     Sleep until the receive window that started at t0 is over
+ * @param[in] bus topology_bus_t
+ * @param[in] t0 release timestamp
+ * @note      A hardware alarm wakes the task at the window end; before the
+ *            scheduler runs, or without a free alarm, the rest is busy-waited
+ */
+static void a_ds18b20_window_wait(uint8_t bus, uint32_t t0)
+{
+    SemaphoreHandle_t window = gs_ds18b20_capture[bus].window;
+    uint32_t elapsed = time_us_32() - t0;
+    alarm_id_t id;
+
+    if ((elapsed < OW_EDGE_WINDOW_US) && (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)) {
+        (void)xSemaphoreTake(window, 0);                /* stale give of a timed out wait */
+        id = add_alarm_in_us(OW_EDGE_WINDOW_US - elapsed, a_ds18b20_window_alarm, window, false);
+        if (id > 0) {
+            if (xSemaphoreTake(window, pdMS_TO_TICKS(2)) != pdTRUE) {
+                (void)cancel_alarm(id);
+            }
+        }
+    }
+    elapsed = time_us_32() - t0;
+    if (elapsed < OW_EDGE_WINDOW_US) {
+        busy_wait_us_32(OW_EDGE_WINDOW_US - elapsed);
+    }
+}
+
+/**
+ * @brief      Reset pulse with interrupt-timestamped presence detection
+ * @param[in]  bus topology_bus_t
+ * @param[out] *presence_us release to presence start, 255 at most
+ * @param[out] *width_us presence pulse width, 255 at most
+ * @return     0 presence seen, 1 no presence, 2 bus stuck low
+ * @note       The low phase runs in the bus critical section; the task then
+ *             sleeps through the 480 us receive window while the GPIO
+ *             interrupt on the calling core timestamps the edges
+ */
+static uint8_t a_ds18b20_gpio_reset(uint8_t bus, uint8_t *presence_us, uint8_t *width_us)
+{
+    uint pin = gc_ds18b20_bus_pins[bus];
+    const ds18b20_timing_t *t = &gs_ds18b20_timing[bus];
+    a_ds18b20_capture_t *c = &gs_ds18b20_capture[bus];
+    uint32_t t0;
+
+    a_ds18b20_lock_enter(bus);
+    a_ds18b20_gpio_write(pin, 0);
+    busy_wait_us_32(t->reset_low_us);
+    /* arm before the release: the edges are latched now and served once the
+       section ends. The release edge is a rise without a fall and is ignored */
+    ow_edge_arm(&c->edge);
+    gpio_acknowledge_irq(pin, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE);
+    gpio_set_irq_enabled(pin, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+    a_ds18b20_gpio_write(pin, 1);
+    t0 = time_us_32();                  /* with the release, so the presence delay cannot go negative */
+    a_ds18b20_lock_exit(bus);
+
+    a_ds18b20_window_wait(bus, t0);
+    gpio_set_irq_enabled(pin, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, false);
+
+    return ow_edge_decode(&c->edge, t0, gpio_get(pin) ? 1 : 0, presence_us, width_us);
+}
+
+/* Per-bus entry points for the ds18b20_bus_t tables, one set per topology bus */
+#define A_DS18B20_BUS_FUNCS(name, gpio)                                                                 \
+    static uint8_t a_ds18b20_##name##_init(void)                                                        \
+    {                                                                                                   \
+        a_ds18b20_lock_claim(TOPOLOGY_BUS_##name);                                                      \
+        a_ds18b20_edge_install(TOPOLOGY_BUS_##name);                                                    \
+        return a_ds18b20_gpio_init(gpio);                                                               \
+    }                                                                                                   \
+    static uint8_t a_ds18b20_##name##_deinit(void)                                                      \
+    {                                                                                                   \
+        a_ds18b20_edge_remove(TOPOLOGY_BUS_##name);                                                     \
+        return a_ds18b20_gpio_deinit(gpio);                                                             \
+    }                                                                                                   \
+    static uint8_t a_ds18b20_##name##_reset(uint8_t *presence_us, uint8_t *width_us)                    \
+    {                                                                                                   \
+        return a_ds18b20_gpio_reset(TOPOLOGY_BUS_##name, presence_us, width_us);                        \
+    }                                                                                                   \
+    static uint8_t a_ds18b20_##name##_read(uint8_t *value) { return a_ds18b20_gpio_read(gpio, value); } \
+    static uint8_t a_ds18b20_##name##_write(uint8_t value) { return a_ds18b20_gpio_write(gpio, value); } \
+    static void a_ds18b20_##name##_disable_irq(void) { a_ds18b20_lock_enter(TOPOLOGY_BUS_##name); }     \
+    static void a_ds18b20_##name##_enable_irq(void) { a_ds18b20_lock_exit(TOPOLOGY_BUS_##name); }
+
+#define A_DS18B20_BUS_RESET(name)    a_ds18b20_##name##_reset
+
+#else
+
+/* Per-bus entry points for the ds18b20_bus_t tables, one set per topology bus */
+#define A_DS18B20_BUS_FUNCS(name, gpio)                                                                 \
+    static uint8_t a_ds18b20_##name##_init(void)                                                        \
+    {                                                                                                   \
+        a_ds18b20_lock_claim(TOPOLOGY_BUS_##name);                                                      \
+        return a_ds18b20_gpio_init(gpio);                                                               \
+    }                                                                                                   \
+    static uint8_t a_ds18b20_##name##_deinit(void) { return a_ds18b20_gpio_deinit(gpio); }              \
+    static uint8_t a_ds18b20_##name##_read(uint8_t *value) { return a_ds18b20_gpio_read(gpio, value); } \
+    static uint8_t a_ds18b20_##name##_write(uint8_t value) { return a_ds18b20_gpio_write(gpio, value); } \
+    static void a_ds18b20_##name##_disable_irq(void) { a_ds18b20_lock_enter(TOPOLOGY_BUS_##name); }     \
+    static void a_ds18b20_##name##_enable_irq(void) { a_ds18b20_lock_exit(TOPOLOGY_BUS_##name); }
+
+#define A_DS18B20_BUS_RESET(name)    NULL
+
+#endif
+
+TOPOLOGY_BUSES(A_DS18B20_BUS_FUNCS)
+
+/* Slot entry points of buses timed by the UART or a bridge: the driver only
+   uses bus_touch and bus_reset there, and the bus never claims a spinlock */
+static uint8_t a_ds18b20_none_read(uint8_t *value)
+{
+    *value = 1;
+    return 1;
+}
+
+static uint8_t a_ds18b20_none_write(uint8_t value)
+{
+    return 1;
+}
+
+static void a_ds18b20_none_irq(void)
+{
+}
+
+#if DS18B20_INTERFACE_UART_BUS >= 0
+
+/* Entry points of the UART bus; reset and slots run without critical sections */
+static uint8_t a_ds18b20_uart_init(void)
+{
+    return ow_uart_init(DS18B20_INTERFACE_UART_ID, gc_ds18b20_bus_pins[DS18B20_INTERFACE_UART_BUS],
+                        DS18B20_INTERFACE_UART_RX_PIN);
+}
+
+static uint8_t a_ds18b20_uart_deinit(void)
+{
+    return ow_uart_deinit(DS18B20_INTERFACE_UART_ID);
+}
+
+static uint8_t a_ds18b20_uart_reset(uint8_t *presence_us, uint8_t *width_us)
+{
+    *presence_us = 0;                   /* not resolved at 9600 baud */
+    return ow_uart_reset(DS18B20_INTERFACE_UART_ID, width_us);
+}
+
+static uint8_t a_ds18b20_uart_touch(const uint8_t *tx, uint8_t *rx, uint16_t slots)
+{
+    return ow_uart_touch(DS18B20_INTERFACE_UART_ID, tx, rx, slots);
+}
+
+#define A_DS18B20_UART_OR(name, uart, gpio)    ((TOPOLOGY_BUS_##name == DS18B20_INTERFACE_UART_BUS) ? (uart) : (gpio))
+
+#else
+
+#define A_DS18B20_UART_OR(name, uart, gpio)    (gpio)
+
+#endif
+
+#if TOPOLOGY_HAS_DS2482
+
+/* Per-bus entry points for buses on a DS2482 channel; the bridge times every slot */
+#define A_DS18B20_BRIDGE_FUNCS(name, gpio)                                                                  \
+    static uint8_t a_ds18b20_##name##_bridge_init(void) { return ds2482_init(); }                          \
+    static uint8_t a_ds18b20_##name##_bridge_deinit(void) { return ds2482_deinit(); }                      \
+    static uint8_t a_ds18b20_##name##_bridge_reset(uint8_t *presence_us, uint8_t *width_us)                \
+    {                                                                                                       \
+        *presence_us = 0;                                                                                   \
+        *width_us = 0;                                                                                      \
+        return ds2482_reset(TOPOLOGY_DS2482_CHANNEL(gpio));                                                 \
+    }                                                                                                       \
+    static uint8_t a_ds18b20_##name##_bridge_touch(const uint8_t *tx, uint8_t *rx, uint16_t slots)         \
+    {                                                                                                       \
+        return ds2482_touch(TOPOLOGY_DS2482_CHANNEL(gpio), tx, rx, slots);                                  \
+    }                                                                                                       \
+    static uint8_t a_ds18b20_##name##_bridge_triplet(uint8_t direction, uint8_t *id_bit, uint8_t *cmp_bit, \
+                                                     uint8_t *taken)                                        \
+    {                                                                                                       \
+        return ds2482_triplet(TOPOLOGY_DS2482_CHANNEL(gpio), direction, id_bit, cmp_bit, taken);            \
+    }
+
+TOPOLOGY_BUSES(A_DS18B20_BRIDGE_FUNCS)
+
+#define A_DS18B20_BRIDGE_OR(name, gpio, op, other)    (TOPOLOGY_IS_DS2482(gpio) ? a_ds18b20_##name##_bridge_##op : (other))
+
+#else
+
+#define A_DS18B20_BRIDGE_OR(name, gpio, op, other)    (other)
+
+#endif
+
+/* GPIO slot and critical section entry points of a bus, no-ops off the GPIO backend */
+#define A_DS18B20_GPIO_OR(name, gpio, op, none) \
+    (TOPOLOGY_IS_DS2482(gpio) ? (none) : A_DS18B20_UART_OR(name, (none), a_ds18b20_##name##_##op))
+
 /**
  * @brief Delay for given milliseconds (yields to FreeRTOS)
  * @param[in] ms Time to wait in ms
+ * @note  Long waits run at the governor's low clock when enabled
  */
 void ds18b20_interface_delay_ms(uint32_t ms)
 {
+#if DS18B20_INTERFACE_CLOCK_GOV
+    if (ms >= CLOCK_GOV_MIN_WAIT_MS) {
+        (void)clock_gov_set(CLOCK_GOV_LOW);
+        vTaskDelay(pdMS_TO_TICKS(ms));
+        (void)clock_gov_set(CLOCK_GOV_FULL);    /* bus slots follow */
+        return;
+    }
+#endif
     vTaskDelay(pdMS_TO_TICKS(ms));
 }
 
@@ -125,19 +558,24 @@ void ds18b20_interface_delay_us(uint32_t us)
 }
 
 /**
- * @brief Disable interrupts (enter critical section)
+ * @brief      Critical section statistics of one bus
+ * @param[in]  bus topology_bus_t
+ * @param[out] stats Sections, longest and total time with interrupts off
+ * @note       Copied under the bus spinlock, so a section exiting on the other
+ *             core cannot tear it; all zero for a bus without GPIO slots
  */
-void ds18b20_interface_disable_irq(void)
+void ds18b20_interface_lock_stats(uint8_t bus, ds18b20_interface_lock_stats_t *stats)
 {
-    taskENTER_CRITICAL();
-}
+    a_ds18b20_lock_t *l = &gs_ds18b20_lock[bus];
+    uint32_t save;
 
-/**
- * @brief Enable interrupts (exit critical section)
- */
-void ds18b20_interface_enable_irq(void)
-{
-    taskEXIT_CRITICAL();
+    if (l->lock == NULL) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    save = spin_lock_blocking(l->lock);
+    *stats = l->stats;
+    spin_unlock(l->lock, save);
 }
 
 /**
@@ -150,3 +588,103 @@ void ds18b20_interface_debug_print(const char *const fmt, ...)
     vprintf(fmt, args);
     va_end(args);
 }
+
+/**
+ * @brief      Measure rise time and presence timing of one bus
+ * @param[in]  bus topology_bus_t
+ * @param[out] *rise_ns release to logic high, best of 8
+ * @param[out] *presence_delay_us release after a reset pulse to presence start
+ * @param[out] *presence_width_us presence pulse width
+ * @return     0 on success, 1 when no presence pulse was seen or the bus
+ *             has no GPIO slots (UART, bridge or not initialized)
+ * @note       Runs with interrupts off for about 1.5 ms and leaves the bus
+ *             after a reset; the caller must own the bus
+ */
+uint8_t ds18b20_interface_measure(uint8_t bus, uint32_t *rise_ns,
+                                  uint32_t *presence_delay_us, uint32_t *presence_width_us)
+{
+    uint pin = gc_ds18b20_bus_pins[bus];
+    uint32_t poll_ns;
+    uint32_t best = UINT32_MAX;
+    uint32_t n;
+    uint32_t t0, t1, t2;
+
+    if (gs_ds18b20_lock[bus].lock == NULL) {
+        return 1;                               /* not a GPIO bus, or not up yet */
+    }
+    a_ds18b20_lock_enter(bus);
+    /* cost of one poll, timed over many: 10000 polls take n us, so n/10 ns each */
+    t0 = time_us_32();
+    for (n = 0; n < 10000; n++) {
+        if (!gpio_get(pin)) {
+            __asm volatile ("nop");
+        }
+    }
+    poll_ns = (time_us_32() - t0) / 10;
+    if (poll_ns == 0) {
+        poll_ns = 1;
+    }
+
+    /* rise: a short low pulse, like the start of a write-1 slot, then count polls until high */
+    for (uint8_t i = 0; i < 8; i++) {
+        a_ds18b20_gpio_write(pin, 0);
+        busy_wait_us_32(2);
+        a_ds18b20_gpio_write(pin, 1);
+        for (n = 0; (n < 10000) && !gpio_get(pin); n++) {
+        }
+        if (n < best) {
+            best = n;
+        }
+        busy_wait_us_32(60);
+    }
+    *rise_ns = best * poll_ns;
+
+    /* presence: 480 us reset, then time both edges of the presence pulse */
+    a_ds18b20_gpio_write(pin, 0);
+    busy_wait_us_32(480);
+    a_ds18b20_gpio_write(pin, 1);
+    t0 = time_us_32();
+    do {
+        t1 = time_us_32();
+    } while (gpio_get(pin) && (t1 - t0) < 300);
+    do {
+        t2 = time_us_32();
+    } while (!gpio_get(pin) && (t2 - t0) < 600);
+    a_ds18b20_lock_exit(bus);
+
+    *presence_delay_us = t1 - t0;
+    *presence_width_us = t2 - t1;
+    if (((t1 - t0) >= 300) || ((t2 - t0) >= 600)) {
+        return 1;
+    }
+    if ((t2 - t0) < 480) {
+        busy_wait_us_32(480 - (t2 - t0));       /* finish the 480 us receive window */
+    }
+    return 0;
+}
+
+#define A_DS18B20_BUS_TABLE(name, gpio)                                                                     \
+    [TOPOLOGY_BUS_##name] = {                                                                               \
+        .bus_init    = A_DS18B20_BRIDGE_OR(name, gpio, init,                                                \
+                           A_DS18B20_UART_OR(name, a_ds18b20_uart_init, a_ds18b20_##name##_init)),          \
+        .bus_deinit  = A_DS18B20_BRIDGE_OR(name, gpio, deinit,                                              \
+                           A_DS18B20_UART_OR(name, a_ds18b20_uart_deinit, a_ds18b20_##name##_deinit)),      \
+        .bus_read    = A_DS18B20_GPIO_OR(name, gpio, read, a_ds18b20_none_read),                            \
+        .bus_write   = A_DS18B20_GPIO_OR(name, gpio, write, a_ds18b20_none_write),                          \
+        .delay_ms    = ds18b20_interface_delay_ms,                                                          \
+        .delay_us    = ds18b20_interface_delay_us,                                                          \
+        .enable_irq  = A_DS18B20_GPIO_OR(name, gpio, enable_irq, a_ds18b20_none_irq),                       \
+        .disable_irq = A_DS18B20_GPIO_OR(name, gpio, disable_irq, a_ds18b20_none_irq),                      \
+        .debug_print = ds18b20_interface_debug_print,                                                       \
+        .timing      = &gs_ds18b20_timing[TOPOLOGY_BUS_##name],                                             \
+        .bus_reset   = A_DS18B20_BRIDGE_OR(name, gpio, reset,                                               \
+                           A_DS18B20_UART_OR(name, a_ds18b20_uart_reset, A_DS18B20_BUS_RESET(name))),       \
+        .bus_touch   = A_DS18B20_BRIDGE_OR(name, gpio, touch,                                               \
+                           A_DS18B20_UART_OR(name, a_ds18b20_uart_touch, NULL)),                            \
+        .bus_triplet = A_DS18B20_BRIDGE_OR(name, gpio, triplet, NULL),                                      \
+    },
+
+const ds18b20_bus_t gc_ds18b20_interface_buses[TOPOLOGY_BUS_COUNT] =
+{
+    TOPOLOGY_BUSES(A_DS18B20_BUS_TABLE)
+};
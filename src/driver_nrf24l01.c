@@ -0,0 +1,764 @@
+/**
+ * @file      driver_nrf24l01.c
+ * @brief     nRF24L01+ register-level driver (handle + linked bus functions)
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "driver_nrf24l01.h"
+
+/**
+ * @brief chip command definition
+ */
+#define NRF24L01_CMD_R_REGISTER          0x00        /**< read register, or-ed with address */
+#define NRF24L01_CMD_W_REGISTER          0x20        /**< write register, or-ed with address */
+#define NRF24L01_CMD_R_RX_PAYLOAD        0x61        /**< read rx payload */
+#define NRF24L01_CMD_W_TX_PAYLOAD        0xA0        /**< write tx payload */
+#define NRF24L01_CMD_W_TX_PAYLOAD_NOACK  0xB0        /**< write tx payload without ack */
+#define NRF24L01_CMD_FLUSH_TX            0xE1        /**< flush tx fifo */
+#define NRF24L01_CMD_FLUSH_RX            0xE2        /**< flush rx fifo */
+#define NRF24L01_CMD_R_RX_PL_WID         0x60        /**< read rx payload width */
+#define NRF24L01_CMD_NOP                 0xFF        /**< no operation, returns status */
+
+/**
+ * @brief chip register definition
+ */
+#define NRF24L01_REG_CONFIG              0x00        /**< configuration register */
+#define NRF24L01_REG_EN_AA               0x01        /**< enable auto acknowledgment */
+#define NRF24L01_REG_EN_RXADDR           0x02        /**< enabled rx addresses */
+#define NRF24L01_REG_SETUP_AW            0x03        /**< setup of address widths */
+#define NRF24L01_REG_SETUP_RETR          0x04        /**< setup of automatic retransmission */
+#define NRF24L01_REG_RF_CH               0x05        /**< rf channel */
+#define NRF24L01_REG_RF_SETUP            0x06        /**< rf setup register */
+#define NRF24L01_REG_STATUS              0x07        /**< status register */
+#define NRF24L01_REG_RX_ADDR_P0          0x0A        /**< receive address data pipe 0 */
+#define NRF24L01_REG_TX_ADDR             0x10        /**< transmit address */
+#define NRF24L01_REG_FIFO_STATUS         0x17        /**< fifo status register */
+#define NRF24L01_REG_DYNPD               0x1C        /**< enable dynamic payload length */
+#define NRF24L01_REG_FEATURE             0x1D        /**< feature register */
+
+/**
+ * @brief config register bit definition
+ */
+#define NRF24L01_CONFIG_EN_CRC           (1 << 3)        /**< enable crc */
+#define NRF24L01_CONFIG_CRCO             (1 << 2)        /**< 2 byte crc */
+#define NRF24L01_CONFIG_PWR_UP           (1 << 1)        /**< power up */
+#define NRF24L01_CONFIG_PRIM_RX          (1 << 0)        /**< rx/tx control */
+
+/**
+ * @brief feature register bit definition
+ */
+#define NRF24L01_FEATURE_EN_DPL          (1 << 2)        /**< enable dynamic payload length */
+#define NRF24L01_FEATURE_EN_ACK_PAY      (1 << 1)        /**< enable payload with ack */
+#define NRF24L01_FEATURE_EN_DYN_ACK      (1 << 0)        /**< enable the w_tx_payload_noack command */
+
+/**
+ * @brief     write a register
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_nrf24l01_write_reg(nrf24l01_handle_t *handle, uint8_t reg, const uint8_t *buf, uint8_t len)
+{
+    uint8_t tx[1 + NRF24L01_ADDR_WIDTH];
+    uint8_t rx[1 + NRF24L01_ADDR_WIDTH];
+
+    tx[0] = NRF24L01_CMD_W_REGISTER | reg;                                  /* set command */
+    memcpy(&tx[1], buf, len);                                               /* copy data */
+    if (handle->spi_transfer(tx, rx, (uint16_t)(len + 1)) != 0)             /* transfer */
+    {
+        handle->debug_print("nrf24l01: spi write failed.\n");               /* spi write failed */
+
+        return 1;                                                           /* return error */
+    }
+
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      read a register
+ * @param[in]  *handle pointer to an nrf24l01 handle structure
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_nrf24l01_read_reg(nrf24l01_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len)
+{
+    uint8_t tx[1 + NRF24L01_ADDR_WIDTH];
+    uint8_t rx[1 + NRF24L01_ADDR_WIDTH];
+
+    memset(tx, NRF24L01_CMD_NOP, sizeof(tx));                               /* clock out nop */
+    tx[0] = NRF24L01_CMD_R_REGISTER | reg;                                  /* set command */
+    if (handle->spi_transfer(tx, rx, (uint16_t)(len + 1)) != 0)             /* transfer */
+    {
+        handle->debug_print("nrf24l01: spi read failed.\n");                /* spi read failed */
+
+        return 1;                                                           /* return error */
+    }
+    memcpy(buf, &rx[1], len);                                               /* copy data */
+
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief     write one register byte
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @param[in] reg register address
+ * @param[in] value register value
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_nrf24l01_write_reg8(nrf24l01_handle_t *handle, uint8_t reg, uint8_t value)
+{
+    return a_nrf24l01_write_reg(handle, reg, &value, 1);                    /* write 1 byte */
+}
+
+/**
+ * @brief      send a single byte command
+ * @param[in]  *handle pointer to an nrf24l01 handle structure
+ * @param[in]  cmd command
+ * @param[out] *status pointer to a status buffer, may be NULL
+ * @return     status code
+ *             - 0 success
+ *             - 1 command failed
+ * @note       none
+ */
+static uint8_t a_nrf24l01_command(nrf24l01_handle_t *handle, uint8_t cmd, uint8_t *status)
+{
+    uint8_t rx;
+
+    if (handle->spi_transfer(&cmd, &rx, 1) != 0)                            /* transfer */
+    {
+        handle->debug_print("nrf24l01: spi command failed.\n");             /* spi command failed */
+
+        return 1;                                                           /* return error */
+    }
+    if (status != NULL)
+    {
+        *status = rx;                                                       /* status is clocked out first */
+    }
+
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief     initialize the chip
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 chip not responding
+ * @note      leaves the chip powered down with both fifos flushed
+ */
+uint8_t nrf24l01_init(nrf24l01_handle_t *handle)
+{
+    uint8_t config;
+
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->debug_print == NULL)                                        /* check debug_print */
+    {
+        return 3;                                                           /* return error */
+    }
+    if (handle->spi_init == NULL)                                           /* check spi_init */
+    {
+        handle->debug_print("nrf24l01: spi_init is null.\n");               /* spi_init is null */
+
+        return 3;                                                           /* return error */
+    }
+    if (handle->spi_deinit == NULL)                                         /* check spi_deinit */
+    {
+        handle->debug_print("nrf24l01: spi_deinit is null.\n");             /* spi_deinit is null */
+
+        return 3;                                                           /* return error */
+    }
+    if (handle->spi_transfer == NULL)                                       /* check spi_transfer */
+    {
+        handle->debug_print("nrf24l01: spi_transfer is null.\n");           /* spi_transfer is null */
+
+        return 3;                                                           /* return error */
+    }
+    if (handle->ce_write == NULL)                                           /* check ce_write */
+    {
+        handle->debug_print("nrf24l01: ce_write is null.\n");               /* ce_write is null */
+
+        return 3;                                                           /* return error */
+    }
+    if (handle->delay_ms == NULL)                                           /* check delay_ms */
+    {
+        handle->debug_print("nrf24l01: delay_ms is null.\n");               /* delay_ms is null */
+
+        return 3;                                                           /* return error */
+    }
+    if (handle->delay_us == NULL)                                           /* check delay_us */
+    {
+        handle->debug_print("nrf24l01: delay_us is null.\n");               /* delay_us is null */
+
+        return 3;                                                           /* return error */
+    }
+
+    if (handle->spi_init() != 0)                                            /* initialize spi */
+    {
+        handle->debug_print("nrf24l01: spi init failed.\n");                /* spi init failed */
+
+        return 1;                                                           /* return error */
+    }
+    (void)handle->ce_write(0);                                              /* standby */
+    handle->delay_ms(5);                                                    /* power on reset time */
+    config = NRF24L01_CONFIG_EN_CRC | NRF24L01_CONFIG_CRCO;                 /* 2 byte crc, powered down */
+    if ((a_nrf24l01_write_reg8(handle, NRF24L01_REG_CONFIG, config) != 0) ||
+        (a_nrf24l01_read_reg(handle, NRF24L01_REG_CONFIG, &config, 1) != 0) ||
+        (config != (NRF24L01_CONFIG_EN_CRC | NRF24L01_CONFIG_CRCO)))        /* read back config */
+    {
+        handle->debug_print("nrf24l01: chip not responding.\n");            /* no chip on the bus */
+        (void)handle->spi_deinit();                                         /* close spi */
+
+        return 4;                                                           /* return error */
+    }
+    handle->config = config;                                                /* save config shadow */
+    if ((a_nrf24l01_command(handle, NRF24L01_CMD_FLUSH_TX, NULL) != 0) ||
+        (a_nrf24l01_command(handle, NRF24L01_CMD_FLUSH_RX, NULL) != 0) ||
+        (a_nrf24l01_write_reg8(handle, NRF24L01_REG_STATUS, NRF24L01_STATUS_IRQ_MASK) != 0))
+    {
+        handle->debug_print("nrf24l01: flush failed.\n");                   /* flush failed */
+        (void)handle->spi_deinit();                                         /* close spi */
+
+        return 1;                                                           /* return error */
+    }
+    handle->inited = 1;                                                     /* flag finish initialization */
+
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief     close the chip
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t nrf24l01_deinit(nrf24l01_handle_t *handle)
+{
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+
+    if (nrf24l01_set_mode(handle, NRF24L01_MODE_POWER_DOWN) != 0)           /* power down */
+    {
+        handle->debug_print("nrf24l01: power down failed.\n");              /* power down failed */
+
+        return 1;                                                           /* return error */
+    }
+    if (handle->spi_deinit() != 0)                                          /* close spi */
+    {
+        handle->debug_print("nrf24l01: spi deinit failed.\n");              /* spi deinit failed */
+
+        return 1;                                                           /* return error */
+    }
+    handle->inited = 0;                                                     /* flag close */
+
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief     apply the rf configuration
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @param[in] *config pointer to a configuration structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 configure failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      enables 16 bit crc, dynamic payload length, payload with ack and no-ack transmit
+ */
+uint8_t nrf24l01_configure(nrf24l01_handle_t *handle, const nrf24l01_config_t *config)
+{
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+
+    if ((a_nrf24l01_write_reg8(handle, NRF24L01_REG_SETUP_AW, 0x03) != 0) ||                    /* 5 byte address */
+        (a_nrf24l01_write_reg8(handle, NRF24L01_REG_RF_CH, config->channel & 0x7F) != 0) ||     /* set channel */
+        (a_nrf24l01_write_reg8(handle, NRF24L01_REG_RF_SETUP,
+                               (uint8_t)config->data_rate | (uint8_t)config->power) != 0) ||    /* set rate and power */
+        (a_nrf24l01_write_reg8(handle, NRF24L01_REG_SETUP_RETR,
+                               (uint8_t)(((config->retransmit_delay & 0x0F) << 4) |
+                                         (config->retransmit_count & 0x0F))) != 0) ||           /* set retransmit */
+        (a_nrf24l01_write_reg8(handle, NRF24L01_REG_EN_AA, 0x3F) != 0) ||                       /* auto ack on all pipes */
+        (a_nrf24l01_write_reg8(handle, NRF24L01_REG_FEATURE,
+                               NRF24L01_FEATURE_EN_DPL | NRF24L01_FEATURE_EN_ACK_PAY |
+                               NRF24L01_FEATURE_EN_DYN_ACK) != 0) ||                            /* set features */
+        (a_nrf24l01_write_reg8(handle, NRF24L01_REG_DYNPD, 0x3F) != 0))                         /* dynamic payload on all pipes */
+    {
+        handle->debug_print("nrf24l01: configure failed.\n");                                   /* configure failed */
+
+        return 1;                                                                               /* return error */
+    }
+
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     set the transmit address
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @param[in] *addr pointer to a NRF24L01_ADDR_WIDTH byte address
+ * @return    status code
+ *            - 0 success
+ *            - 1 set tx address failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      pipe 0 receive address is set to the same value so auto ack works
+ */
+uint8_t nrf24l01_set_tx_address(nrf24l01_handle_t *handle, const uint8_t addr[NRF24L01_ADDR_WIDTH])
+{
+    uint8_t en;
+
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                                    /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+
+    if ((a_nrf24l01_write_reg(handle, NRF24L01_REG_TX_ADDR, addr, NRF24L01_ADDR_WIDTH) != 0) ||
+        (a_nrf24l01_write_reg(handle, NRF24L01_REG_RX_ADDR_P0, addr, NRF24L01_ADDR_WIDTH) != 0) ||
+        (a_nrf24l01_read_reg(handle, NRF24L01_REG_EN_RXADDR, &en, 1) != 0) ||
+        (a_nrf24l01_write_reg8(handle, NRF24L01_REG_EN_RXADDR, en | 0x01) != 0))                /* enable pipe 0 for ack */
+    {
+        handle->debug_print("nrf24l01: set tx address failed.\n");                              /* set tx address failed */
+
+        return 1;                                                                               /* return error */
+    }
+
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     set and enable a receive pipe address
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @param[in] pipe pipe number 0 - 5
+ * @param[in] *addr pointer to the address, pipes 2 - 5 only use addr[0]
+ * @return    status code
+ *            - 0 success
+ *            - 1 set rx address failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 pipe is invalid
+ * @note      pipes 2 - 5 share bytes 1 - 4 with pipe 1
+ */
+uint8_t nrf24l01_set_rx_address(nrf24l01_handle_t *handle, uint8_t pipe, const uint8_t addr[NRF24L01_ADDR_WIDTH])
+{
+    uint8_t en;
+    uint8_t len;
+
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                                    /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    if (pipe > 5)                                                                               /* check pipe */
+    {
+        handle->debug_print("nrf24l01: pipe is invalid.\n");                                    /* pipe is invalid */
+
+        return 4;                                                                               /* return error */
+    }
+
+    len = (pipe < 2) ? NRF24L01_ADDR_WIDTH : 1;                                                 /* only lsb for pipe 2 - 5 */
+    if ((a_nrf24l01_write_reg(handle, (uint8_t)(NRF24L01_REG_RX_ADDR_P0 + pipe), addr, len) != 0) ||
+        (a_nrf24l01_read_reg(handle, NRF24L01_REG_EN_RXADDR, &en, 1) != 0) ||
+        (a_nrf24l01_write_reg8(handle, NRF24L01_REG_EN_RXADDR, (uint8_t)(en | (1 << pipe))) != 0))
+    {
+        handle->debug_print("nrf24l01: set rx address failed.\n");                              /* set rx address failed */
+
+        return 1;                                                                               /* return error */
+    }
+
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     set the chip mode
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @param[in] mode chip mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 set mode failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      waits the power up time when leaving power down
+ */
+uint8_t nrf24l01_set_mode(nrf24l01_handle_t *handle, nrf24l01_mode_t mode)
+{
+    uint8_t config;
+
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+
+    if (handle->ce_write(0) != 0)                                           /* leave rx/tx first */
+    {
+        handle->debug_print("nrf24l01: ce write failed.\n");                /* ce write failed */
+
+        return 1;                                                           /* return error */
+    }
+    config = handle->config & (uint8_t)~(NRF24L01_CONFIG_PWR_UP | NRF24L01_CONFIG_PRIM_RX);
+    if (mode != NRF24L01_MODE_POWER_DOWN)
+    {
+        config |= NRF24L01_CONFIG_PWR_UP;                                   /* power up */
+    }
+    if (mode == NRF24L01_MODE_RX)
+    {
+        config |= NRF24L01_CONFIG_PRIM_RX;                                  /* primary receiver */
+    }
+    if (config != handle->config)
+    {
+        if (a_nrf24l01_write_reg8(handle, NRF24L01_REG_CONFIG, config) != 0)    /* write config */
+        {
+            handle->debug_print("nrf24l01: set mode failed.\n");                /* set mode failed */
+
+            return 1;                                                           /* return error */
+        }
+        if ((handle->config & NRF24L01_CONFIG_PWR_UP) == 0 &&
+            (config & NRF24L01_CONFIG_PWR_UP) != 0)
+        {
+            handle->delay_us(1500);                                             /* tpd2stby with crystal */
+        }
+        handle->config = config;                                                /* save config shadow */
+    }
+    if (mode == NRF24L01_MODE_RX)
+    {
+        if (handle->ce_write(1) != 0)                                       /* start listening */
+        {
+            handle->debug_print("nrf24l01: ce write failed.\n");            /* ce write failed */
+
+            return 1;                                                       /* return error */
+        }
+        handle->delay_us(130);                                              /* rx settling */
+    }
+
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief     drive the ce line
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @param[in] level 0 or 1
+ * @return    status code
+ *            - 0 success
+ *            - 1 ce write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      in tx mode the chip sends the whole tx fifo while ce is high
+ */
+uint8_t nrf24l01_set_ce(nrf24l01_handle_t *handle, uint8_t level)
+{
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+
+    if (handle->ce_write(level) != 0)                                       /* write ce */
+    {
+        handle->debug_print("nrf24l01: ce write failed.\n");                /* ce write failed */
+
+        return 1;                                                           /* return error */
+    }
+
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief     write one payload to the tx fifo
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @param[in] *buf pointer to a payload buffer
+ * @param[in] len payload length 1 - NRF24L01_MAX_PAYLOAD
+ * @param[in] ack 1 to request an ack, 0 for a no-ack payload
+ * @return    status code
+ *            - 0 success
+ *            - 1 write payload failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 length is invalid
+ * @note      none
+ */
+uint8_t nrf24l01_write_tx_payload(nrf24l01_handle_t *handle, const uint8_t *buf, uint8_t len, uint8_t ack)
+{
+    uint8_t tx[1 + NRF24L01_MAX_PAYLOAD];
+    uint8_t rx[1 + NRF24L01_MAX_PAYLOAD];
+
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    if ((len == 0) || (len > NRF24L01_MAX_PAYLOAD))                         /* check length */
+    {
+        handle->debug_print("nrf24l01: length is invalid.\n");              /* length is invalid */
+
+        return 4;                                                           /* return error */
+    }
+
+    tx[0] = (ack != 0) ? NRF24L01_CMD_W_TX_PAYLOAD : NRF24L01_CMD_W_TX_PAYLOAD_NOACK;
+    memcpy(&tx[1], buf, len);                                               /* copy payload */
+    if (handle->spi_transfer(tx, rx, (uint16_t)(len + 1)) != 0)             /* transfer */
+    {
+        handle->debug_print("nrf24l01: write payload failed.\n");           /* write payload failed */
+
+        return 1;                                                           /* return error */
+    }
+
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      read the oldest payload from the rx fifo
+ * @param[in]  *handle pointer to an nrf24l01 handle structure
+ * @param[out] *buf pointer to a NRF24L01_MAX_PAYLOAD byte buffer
+ * @param[out] *len pointer to a payload length buffer
+ * @param[out] *pipe pointer to a pipe number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read payload failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 rx fifo is empty
+ * @note       corrupt payload widths flush the rx fifo and return 1
+ */
+uint8_t nrf24l01_read_rx_payload(nrf24l01_handle_t *handle, uint8_t *buf, uint8_t *len, uint8_t *pipe)
+{
+    uint8_t tx[1 + NRF24L01_MAX_PAYLOAD];
+    uint8_t rx[1 + NRF24L01_MAX_PAYLOAD];
+    uint8_t p;
+
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+
+    tx[0] = NRF24L01_CMD_R_RX_PL_WID;                                       /* read payload width */
+    tx[1] = NRF24L01_CMD_NOP;
+    if (handle->spi_transfer(tx, rx, 2) != 0)                               /* transfer */
+    {
+        handle->debug_print("nrf24l01: read width failed.\n");              /* read width failed */
+
+        return 1;                                                           /* return error */
+    }
+    p = (rx[0] >> 1) & 0x07;                                                /* pipe number from status */
+    if (p == 0x07)                                                          /* rx fifo empty */
+    {
+        return 4;                                                           /* return empty */
+    }
+    if ((rx[1] == 0) || (rx[1] > NRF24L01_MAX_PAYLOAD))                     /* datasheet: flush on bad width */
+    {
+        (void)a_nrf24l01_command(handle, NRF24L01_CMD_FLUSH_RX, NULL);      /* flush rx */
+        handle->debug_print("nrf24l01: payload width invalid.\n");          /* payload width invalid */
+
+        return 1;                                                           /* return error */
+    }
+    *len = rx[1];                                                           /* save length */
+    *pipe = p;                                                              /* save pipe */
+    memset(tx, NRF24L01_CMD_NOP, sizeof(tx));                               /* clock out nop */
+    tx[0] = NRF24L01_CMD_R_RX_PAYLOAD;                                      /* read payload */
+    if (handle->spi_transfer(tx, rx, (uint16_t)(*len + 1)) != 0)            /* transfer */
+    {
+        handle->debug_print("nrf24l01: read payload failed.\n");            /* read payload failed */
+
+        return 1;                                                           /* return error */
+    }
+    memcpy(buf, &rx[1], *len);                                              /* copy payload */
+
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      get the status register
+ * @param[in]  *handle pointer to an nrf24l01 handle structure
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get status failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t nrf24l01_get_status(nrf24l01_handle_t *handle, uint8_t *status)
+{
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+
+    return a_nrf24l01_command(handle, NRF24L01_CMD_NOP, status);            /* nop returns status */
+}
+
+/**
+ * @brief      get the fifo status register
+ * @param[in]  *handle pointer to an nrf24l01 handle structure
+ * @param[out] *fifo pointer to a fifo status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get fifo status failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t nrf24l01_get_fifo_status(nrf24l01_handle_t *handle, uint8_t *fifo)
+{
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+
+    return a_nrf24l01_read_reg(handle, NRF24L01_REG_FIFO_STATUS, fifo, 1);  /* read fifo status */
+}
+
+/**
+ * @brief     clear interrupt flags
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @param[in] mask NRF24L01_STATUS_* interrupt bits to clear
+ * @return    status code
+ *            - 0 success
+ *            - 1 clear irq failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t nrf24l01_clear_irq(nrf24l01_handle_t *handle, uint8_t mask)
+{
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+
+    return a_nrf24l01_write_reg8(handle, NRF24L01_REG_STATUS,
+                                 mask & NRF24L01_STATUS_IRQ_MASK);          /* write 1 to clear */
+}
+
+/**
+ * @brief     flush the tx fifo
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t nrf24l01_flush_tx(nrf24l01_handle_t *handle)
+{
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+
+    return a_nrf24l01_command(handle, NRF24L01_CMD_FLUSH_TX, NULL);         /* flush tx */
+}
+
+/**
+ * @brief     flush the rx fifo
+ * @param[in] *handle pointer to an nrf24l01 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t nrf24l01_flush_rx(nrf24l01_handle_t *handle)
+{
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+
+    return a_nrf24l01_command(handle, NRF24L01_CMD_FLUSH_RX, NULL);         /* flush rx */
+}
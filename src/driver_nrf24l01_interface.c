@@ -0,0 +1,192 @@
+/**
+ * @file      driver_nrf24l01_interface.c
+ * @brief     nRF24L01+ interface for the Raspberry Pi Pico (SPI, CE, IRQ)
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "driver_nrf24l01_interface.h"
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+#include "hardware/gpio.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+/* SPI instance and pins (override with -DNRF24L01_INTERFACE_*=N per target) */
+#ifndef NRF24L01_INTERFACE_SPI
+#define NRF24L01_INTERFACE_SPI       1
+#endif
+#ifndef NRF24L01_INTERFACE_PIN_SCK
+#define NRF24L01_INTERFACE_PIN_SCK   10
+#endif
+#ifndef NRF24L01_INTERFACE_PIN_MOSI
+#define NRF24L01_INTERFACE_PIN_MOSI  11
+#endif
+#ifndef NRF24L01_INTERFACE_PIN_MISO
+#define NRF24L01_INTERFACE_PIN_MISO  12
+#endif
+#ifndef NRF24L01_INTERFACE_PIN_CSN
+#define NRF24L01_INTERFACE_PIN_CSN   13
+#endif
+#ifndef NRF24L01_INTERFACE_PIN_CE
+#define NRF24L01_INTERFACE_PIN_CE    14
+#endif
+#ifndef NRF24L01_INTERFACE_PIN_IRQ
+#define NRF24L01_INTERFACE_PIN_IRQ   15
+#endif
+#ifndef NRF24L01_INTERFACE_BAUD
+#define NRF24L01_INTERFACE_BAUD      (8 * 1000 * 1000)
+#endif
+
+#if NRF24L01_INTERFACE_SPI == 0
+#define NRF24L01_INTERFACE_SPI_INST  spi0
+#else
+#define NRF24L01_INTERFACE_SPI_INST  spi1
+#endif
+
+static void (*gs_irq_callback)(void);
+
+/**
+ * @brief Raw GPIO interrupt handler for the irq line
+ */
+static void a_nrf24l01_interface_irq_handler(void)
+{
+    if (gpio_get_irq_event_mask(NRF24L01_INTERFACE_PIN_IRQ) & GPIO_IRQ_EDGE_FALL) {
+        gpio_acknowledge_irq(NRF24L01_INTERFACE_PIN_IRQ, GPIO_IRQ_EDGE_FALL);
+        if (gs_irq_callback != NULL) {
+            gs_irq_callback();
+        }
+    }
+}
+
+/**
+ * @brief  Initialize SPI, CSN (idle high) and CE (idle low)
+ * @return 0 on success, 1 on failure
+ */
+uint8_t nrf24l01_interface_spi_init(void)
+{
+    spi_init(NRF24L01_INTERFACE_SPI_INST, NRF24L01_INTERFACE_BAUD);
+    spi_set_format(NRF24L01_INTERFACE_SPI_INST, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+    gpio_set_function(NRF24L01_INTERFACE_PIN_SCK, GPIO_FUNC_SPI);
+    gpio_set_function(NRF24L01_INTERFACE_PIN_MOSI, GPIO_FUNC_SPI);
+    gpio_set_function(NRF24L01_INTERFACE_PIN_MISO, GPIO_FUNC_SPI);
+
+    gpio_init(NRF24L01_INTERFACE_PIN_CSN);
+    gpio_put(NRF24L01_INTERFACE_PIN_CSN, 1);
+    gpio_set_dir(NRF24L01_INTERFACE_PIN_CSN, GPIO_OUT);
+
+    gpio_init(NRF24L01_INTERFACE_PIN_CE);
+    gpio_put(NRF24L01_INTERFACE_PIN_CE, 0);
+    gpio_set_dir(NRF24L01_INTERFACE_PIN_CE, GPIO_OUT);
+    return 0;
+}
+
+/**
+ * @brief  Release SPI and control lines
+ * @return 0 on success, 1 on failure
+ */
+uint8_t nrf24l01_interface_spi_deinit(void)
+{
+    gpio_set_irq_enabled(NRF24L01_INTERFACE_PIN_IRQ, GPIO_IRQ_EDGE_FALL, false);
+    spi_deinit(NRF24L01_INTERFACE_SPI_INST);
+    gpio_deinit(NRF24L01_INTERFACE_PIN_CE);
+    gpio_deinit(NRF24L01_INTERFACE_PIN_CSN);
+    return 0;
+}
+
+/**
+ * @brief      Full-duplex transfer with CSN held low for the whole frame
+ * @param[in]  tx  Bytes to send
+ * @param[out] rx  Bytes clocked in
+ * @param[in]  len Frame length
+ * @return     0 on success, 1 on failure
+ */
+uint8_t nrf24l01_interface_spi_transfer(const uint8_t *tx, uint8_t *rx, uint16_t len)
+{
+    int n;
+
+    gpio_put(NRF24L01_INTERFACE_PIN_CSN, 0);
+    n = spi_write_read_blocking(NRF24L01_INTERFACE_SPI_INST, tx, rx, len);
+    gpio_put(NRF24L01_INTERFACE_PIN_CSN, 1);
+    return (n == (int)len) ? 0 : 1;
+}
+
+/**
+ * @brief     Drive the CE line
+ * @param[in] level 0 or 1
+ * @return    0 on success, 1 on failure
+ */
+uint8_t nrf24l01_interface_ce_write(uint8_t level)
+{
+    gpio_put(NRF24L01_INTERFACE_PIN_CE, level != 0);
+    return 0;
+}
+
+/**
+ * @brief Delay for given milliseconds (yields to FreeRTOS)
+ * @param[in] ms Time to wait in ms
+ */
+void nrf24l01_interface_delay_ms(uint32_t ms)
+{
+    vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+/**
+ * @brief Delay for given microseconds (busy-wait)
+ * @param[in] us Time to wait in µs
+ */
+void nrf24l01_interface_delay_us(uint32_t us)
+{
+    busy_wait_us(us);
+}
+
+/**
+ * @brief Formatted debug output (uses stdio)
+ */
+void nrf24l01_interface_debug_print(const char *const fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
+
+/**
+ * @brief     Route the active-low IRQ line to a callback
+ * @param[in] callback Called from interrupt context on each falling edge
+ * @return    0 on success, 1 on failure
+ */
+uint8_t nrf24l01_interface_irq_init(void (*callback)(void))
+{
+    gs_irq_callback = callback;
+    gpio_init(NRF24L01_INTERFACE_PIN_IRQ);
+    gpio_set_dir(NRF24L01_INTERFACE_PIN_IRQ, GPIO_IN);
+    gpio_pull_up(NRF24L01_INTERFACE_PIN_IRQ);
+    /* Raw handler so the 1-Wire and radio pins can share IO_IRQ_BANK0 */
+    gpio_add_raw_irq_handler(NRF24L01_INTERFACE_PIN_IRQ, a_nrf24l01_interface_irq_handler);
+    gpio_set_irq_enabled(NRF24L01_INTERFACE_PIN_IRQ, GPIO_IRQ_EDGE_FALL, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+    return 0;
+}
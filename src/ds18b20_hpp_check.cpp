@@ -0,0 +1,38 @@
+/**
+ * @file      ds18b20_hpp_check.cpp
+ * @brief     Compile-only instantiation of the ds18b20.hpp GPIO driver
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ds18b20.hpp"
+#include "ds18b20_gpio.hpp"
+
+/*
+ * ds18b20.hpp is header-only and no firmware code uses it yet, so without an
+ * instantiation the GPIO policy would never meet the real Pico headers. The
+ * explicit instantiation compiles every member. Nothing references them, so
+ * --gc-sections drops the code again. The pin does not matter.
+ */
+
+template class ds18b20::sensor<ds18b20::gpio_bus<0>>;
@@ -0,0 +1,291 @@
+/**
+ * @file      ds2482.c
+ * @brief     DS2482-100/800 I2C to 1-Wire bridge
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ds2482.h"
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+#define DS2482_CMD_DRST         0xF0    /* device reset */
+#define DS2482_CMD_SRP          0xE1    /* set read pointer */
+#define DS2482_CMD_WCFG         0xD2    /* write configuration */
+#define DS2482_CMD_CHSL         0xC3    /* channel select, DS2482-800 */
+#define DS2482_CMD_1WRS         0xB4    /* 1-Wire reset */
+#define DS2482_CMD_1WSB         0x87    /* 1-Wire single bit */
+#define DS2482_CMD_1WWB         0xA5    /* 1-Wire write byte */
+#define DS2482_CMD_1WRB         0x96    /* 1-Wire read byte */
+#define DS2482_CMD_1WT          0x78    /* 1-Wire triplet */
+
+#define DS2482_PTR_DATA         0xE1    /* read data register */
+
+#define DS2482_STATUS_1WB       0x01    /* 1-Wire busy */
+#define DS2482_STATUS_PPD       0x02    /* presence pulse detected */
+#define DS2482_STATUS_SD        0x04    /* short detected */
+#define DS2482_STATUS_RST       0x10    /* device reset since the last config write */
+#define DS2482_STATUS_SBR       0x20    /* single bit result, first triplet bit */
+#define DS2482_STATUS_TSB       0x40    /* triplet second bit */
+#define DS2482_STATUS_DIR       0x80    /* triplet direction taken */
+
+#define DS2482_CFG_APU          0x01
+
+/* I2C timeout for a few bytes at 400 kHz, with clock stretching margin */
+#define DS2482_I2C_TIMEOUT_US   1000
+
+/* CHSL codes, and the channel register values read back after each */
+static const uint8_t gc_ds2482_chsl[8] = { 0xF0, 0xE1, 0xD2, 0xC3, 0xB4, 0xA5, 0x96, 0x87 };
+static const uint8_t gc_ds2482_chsl_ack[8] = { 0xB8, 0xB1, 0xAA, 0xA3, 0x9C, 0x95, 0x8E, 0x87 };
+
+static SemaphoreHandle_t gs_ds2482_lock;
+static StaticSemaphore_t gs_ds2482_lock_buf;
+static uint8_t gs_ds2482_users;
+static uint8_t gs_ds2482_channel = 0xFF;
+
+/**
+ * @brief     Write a command, with an optional parameter byte
+ * @param[in] cmd   Command
+ * @param[in] param Parameter
+ * @param[in] len   1 for the command alone, 2 with the parameter
+ * @return    0 on success, 1 on an I2C error
+ */
+static uint8_t a_ds2482_cmd(uint8_t cmd, uint8_t param, uint8_t len)
+{
+    uint8_t buf[2] = { cmd, param };
+
+    return (i2c_write_timeout_us(I2C_INSTANCE(DS2482_I2C), DS2482_ADDR, buf, len, false,
+                                 DS2482_I2C_TIMEOUT_US) == (int)len) ? 0 : 1;
+}
+
+/**
+ * @brief      Read the register under the read pointer
+ * @param[out] value Register value
+ * @return     0 on success, 1 on an I2C error
+ */
+static uint8_t a_ds2482_read(uint8_t *value)
+{
+    return (i2c_read_timeout_us(I2C_INSTANCE(DS2482_I2C), DS2482_ADDR, value, 1, false,
+                                DS2482_I2C_TIMEOUT_US) == 1) ? 0 : 1;
+}
+
+/**
+ * @brief      Poll the status register until the 1-Wire command is done
+ * @param[out] status Last status
+ * @return     0 on success, 1 on an I2C error or timeout
+ */
+static uint8_t a_ds2482_wait(uint8_t *status)
+{
+    uint32_t start = time_us_32();
+
+    do {
+        if (a_ds2482_read(status) != 0) {
+            return 1;
+        }
+        if ((*status & DS2482_STATUS_1WB) == 0) {
+            return 0;
+        }
+    } while ((time_us_32() - start) < DS2482_BUSY_TIMEOUT_US);
+    return 1;
+}
+
+/**
+ * @brief     Take the bridge and switch it to a channel
+ * @param[in] channel Bridge channel
+ * @return    0 on success, 1 on a bad channel or bridge error, with the bridge released
+ */
+static uint8_t a_ds2482_take(uint8_t channel)
+{
+    uint8_t ack;
+
+    if (channel >= DS2482_CHANNELS) {
+        return 1;
+    }
+    (void)xSemaphoreTake(gs_ds2482_lock, portMAX_DELAY);
+    if ((DS2482_CHANNELS > 1) && (channel != gs_ds2482_channel)) {
+        if ((a_ds2482_cmd(DS2482_CMD_CHSL, gc_ds2482_chsl[channel], 2) != 0) ||
+            (a_ds2482_read(&ack) != 0) || (ack != gc_ds2482_chsl_ack[channel])) {
+            gs_ds2482_channel = 0xFF;
+            (void)xSemaphoreGive(gs_ds2482_lock);
+            return 1;
+        }
+        gs_ds2482_channel = channel;
+    }
+    return 0;
+}
+
+/**
+ * @brief  Release the bridge
+ */
+static void a_ds2482_give(void)
+{
+    (void)xSemaphoreGive(gs_ds2482_lock);
+}
+
+/**
+ * @brief      Run one 1-Wire command and wait for it; the previous one has always finished
+ * @param[in]  cmd    Command
+ * @param[in]  param  Parameter
+ * @param[in]  len    1 for the command alone, 2 with the parameter
+ * @param[out] status Status at the end of the command
+ * @return     0 on success, 1 on a bridge error
+ */
+static uint8_t a_ds2482_run(uint8_t cmd, uint8_t param, uint8_t len, uint8_t *status)
+{
+    /* 1-Wire commands move the read pointer back to the status register */
+    if (a_ds2482_cmd(cmd, param, len) != 0) {
+        return 1;
+    }
+    return a_ds2482_wait(status);
+}
+
+uint8_t ds2482_init(void)
+{
+    uint8_t cfg = DS2482_ACTIVE_PULLUP ? DS2482_CFG_APU : 0;
+    uint8_t status;
+
+    if (gs_ds2482_users != 0) {
+        gs_ds2482_users++;
+        return 0;
+    }
+    if (gs_ds2482_lock == NULL) {
+        gs_ds2482_lock = xSemaphoreCreateMutexStatic(&gs_ds2482_lock_buf);
+        if (gs_ds2482_lock == NULL) {
+            return 1;
+        }
+    }
+    (void)i2c_init(I2C_INSTANCE(DS2482_I2C), DS2482_I2C_HZ);
+    gpio_set_function(DS2482_SDA_PIN, GPIO_FUNC_I2C);
+    gpio_set_function(DS2482_SCL_PIN, GPIO_FUNC_I2C);
+    gpio_pull_up(DS2482_SDA_PIN);
+    gpio_pull_up(DS2482_SCL_PIN);
+
+    /* reset, then the config byte goes with its complement in the high nibble */
+    if ((a_ds2482_cmd(DS2482_CMD_DRST, 0, 1) != 0) || (a_ds2482_read(&status) != 0) ||
+        ((status & DS2482_STATUS_RST) == 0) ||
+        (a_ds2482_cmd(DS2482_CMD_WCFG, (uint8_t)(cfg | ((~cfg & 0x0F) << 4)), 2) != 0) ||
+        (a_ds2482_read(&status) != 0) || (status != cfg)) {
+        i2c_deinit(I2C_INSTANCE(DS2482_I2C));
+        return 1;
+    }
+    gs_ds2482_channel = (DS2482_CHANNELS > 1) ? 0xFF : 0;   /* select before the first command */
+    gs_ds2482_users = 1;
+    return 0;
+}
+
+uint8_t ds2482_deinit(void)
+{
+    if (gs_ds2482_users == 0) {
+        return 1;
+    }
+    if (--gs_ds2482_users == 0) {
+        i2c_deinit(I2C_INSTANCE(DS2482_I2C));
+        gpio_disable_pulls(DS2482_SDA_PIN);
+        gpio_disable_pulls(DS2482_SCL_PIN);
+        gpio_deinit(DS2482_SDA_PIN);
+        gpio_deinit(DS2482_SCL_PIN);
+    }
+    return 0;
+}
+
+uint8_t ds2482_reset(uint8_t channel)
+{
+    uint8_t status;
+    uint8_t res;
+
+    if (a_ds2482_take(channel) != 0) {
+        return 2;
+    }
+    if (a_ds2482_run(DS2482_CMD_1WRS, 0, 1, &status) != 0) {
+        res = 2;
+    } else if ((status & DS2482_STATUS_SD) != 0) {
+        res = 2;
+    } else {
+        res = ((status & DS2482_STATUS_PPD) != 0) ? 0 : 1;
+    }
+    a_ds2482_give();
+    return res;
+}
+
+uint8_t ds2482_touch(uint8_t channel, const uint8_t *tx, uint8_t *rx, uint16_t slots)
+{
+    uint8_t status;
+    uint8_t value;
+    uint16_t i;
+
+    if (a_ds2482_take(channel) != 0) {
+        return 1;
+    }
+    for (i = 0; (i + 8) <= slots; i += 8) {
+        value = tx[i >> 3];
+        if (value == 0xFF) {
+            if ((a_ds2482_run(DS2482_CMD_1WRB, 0, 1, &status) != 0) ||
+                (a_ds2482_cmd(DS2482_CMD_SRP, DS2482_PTR_DATA, 2) != 0) || (a_ds2482_read(&value) != 0)) {
+                a_ds2482_give();
+                return 1;
+            }
+        } else if (a_ds2482_run(DS2482_CMD_1WWB, value, 2, &status) != 0) {
+            a_ds2482_give();
+            return 1;
+        }
+        if (rx != NULL) {
+            rx[i >> 3] = value;
+        }
+    }
+    if ((rx != NULL) && (i < slots)) {
+        rx[i >> 3] = 0;
+    }
+    for (; i < slots; i++) {
+        value = (uint8_t)((tx[i >> 3] >> (i & 7)) & 1);
+        if (a_ds2482_run(DS2482_CMD_1WSB, value ? 0x80 : 0x00, 2, &status) != 0) {
+            a_ds2482_give();
+            return 1;
+        }
+        if ((rx != NULL) && ((status & DS2482_STATUS_SBR) != 0)) {
+            rx[i >> 3] |= (uint8_t)(1 << (i & 7));
+        }
+    }
+    a_ds2482_give();
+    return 0;
+}
+
+uint8_t ds2482_triplet(uint8_t channel, uint8_t direction, uint8_t *id_bit, uint8_t *cmp_bit, uint8_t *taken)
+{
+    uint8_t status;
+    uint8_t res;
+
+    if (a_ds2482_take(channel) != 0) {
+        return 1;
+    }
+    res = a_ds2482_run(DS2482_CMD_1WT, direction ? 0x80 : 0x00, 2, &status);
+    a_ds2482_give();
+    if (res != 0) {
+        return 1;
+    }
+    *id_bit = ((status & DS2482_STATUS_SBR) != 0) ? 1 : 0;
+    *cmp_bit = ((status & DS2482_STATUS_TSB) != 0) ? 1 : 0;
+    *taken = ((status & DS2482_STATUS_DIR) != 0) ? 1 : 0;
+    return 0;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file      flash_log.c
+ * @brief     Append-only, wear-leveled sample log in a flash partition, written a page at a time
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "flash_log.h"
+#include "sample_codec.h"
+#include "usb_frame.h"
+#include <string.h>
+
+static uint32_t a_next_page(const flash_log_t *log, uint32_t offset)
+{
+    offset += FLASH_REGION_PAGE_SIZE;
+    return (offset >= log->region->size) ? 0 : offset;
+}
+
+/**
+ * @brief Encode as many staged samples as fit into one page and program it at the head
+ */
+static uint8_t a_flash_log_write_page(flash_log_t *log)
+{
+    uint8_t *p = log->page;
+    uint16_t len = 0;
+    uint16_t crc;
+    uint8_t n = 0;
+    uint8_t res = 0;
+
+    if (sample_codec_encode_block(log->stage, (uint8_t)log->staged, &p[FLASH_LOG_HEADER_SIZE],
+                                  FLASH_LOG_BLOCK_MAX, &len, &n) != 0) {
+        log->staged--;                                  /* unencodable sample, drop it */
+        memmove(log->stage, &log->stage[1], log->staged * sizeof(radio_sample_t));
+        return 1;
+    }
+    crc = usb_frame_crc16(0xFFFF, &p[FLASH_LOG_HEADER_SIZE], len);
+    p[0] = (uint8_t)FLASH_LOG_MAGIC;
+    p[1] = (uint8_t)(FLASH_LOG_MAGIC >> 8);
+    p[2] = (uint8_t)log->next_seq;
+    p[3] = (uint8_t)(log->next_seq >> 8);
+    p[4] = (uint8_t)(log->next_seq >> 16);
+    p[5] = (uint8_t)(log->next_seq >> 24);
+    p[6] = (uint8_t)len;
+    p[7] = (uint8_t)(len >> 8);
+    p[8] = (uint8_t)crc;
+    p[9] = (uint8_t)(crc >> 8);
+    memset(&p[FLASH_LOG_HEADER_SIZE + len], 0xFF, FLASH_LOG_BLOCK_MAX - len);
+
+    if ((log->head % FLASH_REGION_SECTOR_SIZE) == 0) {
+        if ((log->pages != 0) &&
+            ((log->tail / FLASH_REGION_SECTOR_SIZE) == (log->head / FLASH_REGION_SECTOR_SIZE))) {
+            /* log full: the oldest sector goes */
+            uint32_t lost = (log->head + FLASH_REGION_SECTOR_SIZE - log->tail) / FLASH_REGION_PAGE_SIZE;
+            log->pages -= lost;
+            log->stats.overwritten += lost;
+            log->tail = (log->head + FLASH_REGION_SECTOR_SIZE >= log->region->size) ?
+                        0 : log->head + FLASH_REGION_SECTOR_SIZE;
+        }
+        if (flash_region_erase(log->region, log->head, FLASH_REGION_SECTOR_SIZE) != 0) {
+            log->stats.errors++;
+            return 1;                                   /* keep the samples, retry on the next page */
+        }
+        log->stats.erases++;
+    }
+    if (log->pages == 0) {
+        log->tail = log->head;
+    }
+
+    res = flash_region_program(log->region, log->head, p, FLASH_REGION_PAGE_SIZE);
+    if (res != 0) {
+        log->stats.errors++;                            /* never ran, the page is still erased: retry it */
+        return 1;
+    }
+    log->stats.pages++;
+    log->stats.samples += n;
+    log->head = a_next_page(log, log->head);
+    log->pages++;
+    log->next_seq++;
+
+    log->staged = (uint16_t)(log->staged - n);
+    memmove(log->stage, &log->stage[n], log->staged * sizeof(radio_sample_t));
+    return 0;
+}
+
+uint8_t flash_log_init(flash_log_t *log, const flash_region_t *region)
+{
+    uint8_t hdr[FLASH_LOG_HEADER_SIZE];
+    uint32_t seq;
+    uint32_t max_seq = 0;
+    uint32_t min_seq = 0;
+    uint32_t off;
+    uint8_t found = 0;
+
+    if ((region == NULL) || (region->size < 2 * FLASH_REGION_SECTOR_SIZE) ||
+        ((region->size % FLASH_REGION_SECTOR_SIZE) != 0)) {
+        return 1;
+    }
+    memset(log, 0, sizeof(*log));
+    log->region = region;
+
+    for (off = 0; off < region->size; off += FLASH_REGION_PAGE_SIZE) {
+        if ((flash_region_read(region, off, hdr, sizeof(hdr)) != 0) ||
+            ((hdr[0] | ((uint16_t)hdr[1] << 8)) != FLASH_LOG_MAGIC)) {
+            continue;
+        }
+        seq = (uint32_t)hdr[2] | ((uint32_t)hdr[3] << 8) | ((uint32_t)hdr[4] << 16) | ((uint32_t)hdr[5] << 24);
+        if (!found || (seq > max_seq)) {
+            max_seq = seq;
+            log->head = a_next_page(log, off);
+        }
+        if (!found || (seq < min_seq)) {
+            min_seq = seq;
+            log->tail = off;
+        }
+        found = 1;
+    }
+    if (!found) {
+        return 0;                                       /* empty, first page erases sector 0 */
+    }
+
+    log->next_seq = max_seq + 1;
+    log->pages = ((log->head + region->size - log->tail) % region->size) / FLASH_REGION_PAGE_SIZE;
+    if (log->pages == 0) {
+        log->pages = region->size / FLASH_REGION_PAGE_SIZE;
+    }
+
+    /* a page torn by a reset mid-write is not erased; skip to the next sector */
+    if ((log->head % FLASH_REGION_SECTOR_SIZE) != 0) {
+        (void)flash_region_read(region, log->head, log->page, FLASH_REGION_PAGE_SIZE);
+        for (uint16_t i = 0; i < FLASH_REGION_PAGE_SIZE; ++i) {
+            if (log->page[i] != 0xFF) {
+                while ((log->head % FLASH_REGION_SECTOR_SIZE) != 0) {
+                    log->head = a_next_page(log, log->head);
+                    log->pages++;
+                }
+                break;
+            }
+        }
+    }
+    return 0;
+}
+
+uint8_t flash_log_append(flash_log_t *log, const radio_sample_t *sample)
+{
+    if (log->staged == FLASH_LOG_STAGE_SAMPLES) {
+        /* the last page write failed: retry it before staging more */
+        if ((a_flash_log_write_page(log) != 0) && (log->staged == FLASH_LOG_STAGE_SAMPLES)) {
+            log->stats.dropped++;
+            return 1;
+        }
+    }
+    log->stage[log->staged++] = *sample;
+    if (log->staged < FLASH_LOG_STAGE_SAMPLES) {
+        return 0;
+    }
+    return a_flash_log_write_page(log);
+}
+
+uint8_t flash_log_flush(flash_log_t *log)
+{
+    uint8_t res = 0;
+
+    while ((log->staged != 0) && (res == 0)) {
+        res = a_flash_log_write_page(log);
+    }
+    return res;
+}
+
+uint32_t flash_log_pages(const flash_log_t *log)
+{
+    return log->pages;
+}
+
+uint8_t flash_log_read_page(const flash_log_t *log, uint32_t index, uint8_t *page)
+{
+    uint32_t off;
+    uint16_t len;
+
+    if (index >= log->pages) {
+        return 1;
+    }
+    off = (log->tail + index * FLASH_REGION_PAGE_SIZE) % log->region->size;
+    if (flash_region_read(log->region, off, page, FLASH_REGION_PAGE_SIZE) != 0) {
+        return 1;
+    }
+    len = (uint16_t)(page[6] | ((uint16_t)page[7] << 8));
+    if (((page[0] | ((uint16_t)page[1] << 8)) != FLASH_LOG_MAGIC) || (len > FLASH_LOG_BLOCK_MAX) ||
+        (usb_frame_crc16(0xFFFF, &page[FLASH_LOG_HEADER_SIZE], len) != (uint16_t)(page[8] | ((uint16_t)page[9] << 8)))) {
+        return 4;
+    }
+    return 0;
+}
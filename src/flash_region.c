@@ -0,0 +1,108 @@
+/**
+ * @file      flash_region.c
+ * @brief     Reserved flash partitions: erase, program and read through XIP-safe wrappers
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "flash_region.h"
+#include <string.h>
+#include "hardware/flash.h"
+#include "hardware/regs/addressmap.h"
+#include "pico/flash.h"
+
+/** Longest wait for the other core to park before giving up */
+#define FLASH_REGION_SAFE_TIMEOUT_MS  100
+
+/**
+ * @brief erase/program request handed to flash_safe_execute
+ */
+typedef struct flash_region_op_s
+{
+    uint32_t addr;            /**< absolute flash offset */
+    const uint8_t *data;      /**< NULL for erase */
+    uint32_t len;             /**< bytes */
+} flash_region_op_t;
+
+/**
+ * @brief Runs with XIP stalled and the other core parked
+ */
+static void a_flash_region_op(void *param)
+{
+    const flash_region_op_t *op = (const flash_region_op_t *)param;
+
+    if (op->data == NULL) {
+        flash_range_erase(op->addr, op->len);
+    } else {
+        flash_range_program(op->addr, op->data, op->len);
+    }
+}
+
+static uint8_t a_flash_region_run(const flash_region_t *region, flash_region_op_t *op)
+{
+    int res;
+
+    if (region->lock != NULL) {
+        region->lock();
+    }
+    res = flash_safe_execute(a_flash_region_op, op, FLASH_REGION_SAFE_TIMEOUT_MS);
+    if (region->unlock != NULL) {
+        region->unlock();
+    }
+    return (res == PICO_OK) ? 0 : 4;
+}
+
+uint8_t flash_region_erase(const flash_region_t *region, uint32_t offset, uint32_t len)
+{
+    flash_region_op_t op;
+
+    if (((offset | len) % FLASH_REGION_SECTOR_SIZE) != 0 || (offset + len > region->size)) {
+        return 1;
+    }
+    op.addr = region->offset + offset;
+    op.data = NULL;
+    op.len = len;
+    return a_flash_region_run(region, &op);
+}
+
+uint8_t flash_region_program(const flash_region_t *region, uint32_t offset, const uint8_t *data, uint32_t len)
+{
+    flash_region_op_t op;
+
+    if (((offset | len) % FLASH_REGION_PAGE_SIZE) != 0 || (offset + len > region->size) || (data == NULL)) {
+        return 1;
+    }
+    op.addr = region->offset + offset;
+    op.data = data;
+    op.len = len;
+    return a_flash_region_run(region, &op);
+}
+
+uint8_t flash_region_read(const flash_region_t *region, uint32_t offset, uint8_t *buf, uint32_t len)
+{
+    if (offset + len > region->size) {
+        return 1;
+    }
+    memcpy(buf, (const void *)(uintptr_t)(XIP_NOCACHE_NOALLOC_BASE + region->offset + offset), len);
+    return 0;
+}
@@ -0,0 +1,204 @@
+/**
+ * @file      node_table.c
+ * @brief     Per-node sequence tracking on the base station: de-duplication and reordering
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "node_table.h"
+#include <string.h>
+
+/** Sequence jumps beyond this are treated as a node restart, not as loss */
+#define NODE_TABLE_RESYNC_SPAN  1024
+
+/**
+ * @brief Tell a rebooted node from a retransmission: a node retransmits only its last
+ *        payload, so a step back past NODE_TABLE_DUP_SPAN, or back to seq 0 from
+ *        anything but seq 1, means the node restarted its counter
+ */
+static uint8_t a_node_table_restarted(uint16_t seq, int16_t d)
+{
+    if ((d <= -NODE_TABLE_RESYNC_SPAN) || (d >= NODE_TABLE_RESYNC_SPAN)) {
+        return 1;
+    }
+    if (d <= -NODE_TABLE_DUP_SPAN) {
+        return 1;
+    }
+    return ((seq == 0) && (d < -1)) ? 1 : 0;
+}
+
+/**
+ * @brief Find a node entry, optionally claiming a free slot
+ */
+static node_entry_t *a_node_table_lookup(node_table_t *table, uint8_t node_id, uint8_t create)
+{
+    node_entry_t *free_slot = NULL;
+
+    for (uint8_t i = 0; i < NODE_TABLE_MAX_NODES; ++i) {
+        node_entry_t *e = &table->nodes[i];
+        if (e->used && (e->node_id == node_id)) {
+            return e;
+        }
+        if (!e->used && (free_slot == NULL)) {
+            free_slot = e;
+        }
+    }
+    if (!create || (free_slot == NULL)) {
+        return NULL;
+    }
+    memset(free_slot, 0, sizeof(*free_slot));
+    free_slot->used = 1;
+    free_slot->node_id = node_id;
+    return free_slot;
+}
+
+/**
+ * @brief Deliver held payloads that are now in sequence
+ */
+static void a_node_table_release_ready(node_table_t *table, node_entry_t *e)
+{
+    uint8_t slot;
+
+    for (;;) {
+        slot = (uint8_t)(e->next_seq % NODE_TABLE_REORDER_DEPTH);
+        if ((e->held & (1u << slot)) == 0) {
+            return;
+        }
+        e->held &= (uint8_t)~(1u << slot);
+        table->deliver(table->ctx, &e->reorder[slot]);
+        e->stats.reordered++;
+        e->next_seq++;
+    }
+}
+
+/**
+ * @brief Move next_seq forward to target, delivering held payloads and counting gaps as lost
+ */
+static void a_node_table_advance(node_table_t *table, node_entry_t *e, uint16_t target)
+{
+    uint8_t slot;
+
+    while (e->next_seq != target) {
+        slot = (uint8_t)(e->next_seq % NODE_TABLE_REORDER_DEPTH);
+        if (e->held & (1u << slot)) {
+            e->held &= (uint8_t)~(1u << slot);
+            table->deliver(table->ctx, &e->reorder[slot]);
+            e->stats.reordered++;
+        } else {
+            e->stats.lost++;
+        }
+        e->next_seq++;
+    }
+    a_node_table_release_ready(table, e);
+}
+
+void node_table_init(node_table_t *table, node_table_deliver_t deliver, void *ctx)
+{
+    memset(table, 0, sizeof(*table));
+    table->deliver = deliver;
+    table->ctx = ctx;
+}
+
+uint8_t node_table_push(node_table_t *table, uint8_t node_id, uint16_t seq,
+                        const radio_frame_t *frame, uint32_t now_ms)
+{
+    node_entry_t *e;
+    int16_t d;
+    uint8_t slot;
+
+    e = a_node_table_lookup(table, node_id, 1);
+    if (e == NULL) {
+        table->rejected++;
+        return 1;
+    }
+    if (e->stats.received == 0) {
+        e->next_seq = seq;                          /* first payload from this node */
+    }
+
+    d = (int16_t)(uint16_t)(seq - e->next_seq);
+    if (a_node_table_restarted(seq, d)) {
+        /* Node restarted or was out of range for a long time: flush and follow it */
+        a_node_table_advance(table, e, (uint16_t)(e->next_seq + NODE_TABLE_REORDER_DEPTH));
+        e->held = 0;
+        e->next_seq = seq;
+        e->stats.restarts++;
+        d = 0;
+    }
+    if (d < 0) {
+        e->stats.duplicates++;                      /* already delivered or given up on */
+        return 1;
+    }
+    if (d >= NODE_TABLE_REORDER_DEPTH) {
+        /* Slide the window so seq becomes its last slot */
+        a_node_table_advance(table, e, (uint16_t)(seq - (NODE_TABLE_REORDER_DEPTH - 1)));
+        d = (int16_t)(uint16_t)(seq - e->next_seq);
+        if (d < 0) {
+            e->stats.duplicates++;
+            return 1;
+        }
+    }
+
+    e->stats.received++;
+    if (d == 0) {
+        table->deliver(table->ctx, frame);
+        e->next_seq++;
+        a_node_table_release_ready(table, e);
+        return 0;
+    }
+
+    slot = (uint8_t)(seq % NODE_TABLE_REORDER_DEPTH);
+    if (e->held & (1u << slot)) {
+        e->stats.received--;
+        e->stats.duplicates++;                      /* retransmission of a held payload */
+        return 1;
+    }
+    if (e->held == 0) {
+        e->held_since_ms = now_ms;
+    }
+    e->reorder[slot] = *frame;
+    e->held |= (uint8_t)(1u << slot);
+    return 0;
+}
+
+void node_table_expire(node_table_t *table, uint32_t now_ms)
+{
+    for (uint8_t i = 0; i < NODE_TABLE_MAX_NODES; ++i) {
+        node_entry_t *e = &table->nodes[i];
+        if (!e->used || (e->held == 0) || ((uint32_t)(now_ms - e->held_since_ms) < NODE_TABLE_REORDER_MS)) {
+            continue;
+        }
+        while (e->held != 0) {
+            a_node_table_advance(table, e, (uint16_t)(e->next_seq + 1));
+        }
+    }
+}
+
+const node_entry_t *node_table_find(const node_table_t *table, uint8_t node_id)
+{
+    for (uint8_t i = 0; i < NODE_TABLE_MAX_NODES; ++i) {
+        if (table->nodes[i].used && (table->nodes[i].node_id == node_id)) {
+            return &table->nodes[i];
+        }
+    }
+    return NULL;
+}
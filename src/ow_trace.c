@@ -0,0 +1,75 @@
+/**
+ * @file      ow_trace.c
+ * @brief     1-Wire bus event recorder, a lock-free flight-recorder ring
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ow_trace.h"
+
+#if OW_TRACE_ENABLE
+
+#include <string.h>
+
+ow_trace_event_t g_ow_trace_ring[OW_TRACE_SIZE];
+volatile uint32_t g_ow_trace_head;
+
+static uint32_t gs_tail;                        /* consumer only */
+
+uint16_t ow_trace_read(ow_trace_event_t *events, uint16_t max, uint32_t *lost)
+{
+    uint32_t head = g_ow_trace_head;
+    uint32_t start = gs_tail;
+    uint32_t n;
+    uint32_t gone;
+
+    __dmb();
+    if ((head - start) > OW_TRACE_SIZE) {
+        *lost += head - start - OW_TRACE_SIZE;
+        start = head - OW_TRACE_SIZE;
+    }
+    n = head - start;
+    if (n > max) {
+        n = max;
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+        events[i] = g_ow_trace_ring[(start + i) & (OW_TRACE_SIZE - 1)];
+    }
+    __dmb();
+
+    /* drop entries the producer overwrote while they were copied, and the one it may
+       be writing now: slot head is published only after it is complete */
+    head = g_ow_trace_head + 1;
+    gone = ((head - start) > OW_TRACE_SIZE) ? (head - start - OW_TRACE_SIZE) : 0;
+    if (gone > n) {
+        gone = n;
+    }
+    if (gone != 0) {
+        memmove(events, &events[gone], (n - gone) * sizeof(ow_trace_event_t));
+        *lost += gone;
+    }
+    gs_tail = start + n;
+    return (uint16_t)(n - gone);
+}
+
+#endif
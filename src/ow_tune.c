@@ -0,0 +1,141 @@
+/**
+ * @file      ow_tune.c
+ * @brief     1-Wire slot timing profiles picked from bus measurements
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ow_tune.h"
+#include "dlog.h"
+#include <stdio.h>
+
+/* Buses rising within this run the short profile */
+#define OW_TUNE_SHORT_RISE_NS   1000
+
+/* A '1' must be high before 15 us from the slot start; beyond this the bus is out of spec */
+#define OW_TUNE_MAX_RISE_US     11
+
+static const char *const gc_ow_tune_names[] = { "standard", "short", "long" };
+
+/**
+ * @brief      Set the slot times, keeping the frame counters
+ * @param[out] timing Bus timing
+ * @param[in]  src    New slot times
+ */
+static void a_ow_tune_set(ds18b20_timing_t *timing, const ds18b20_timing_t *src)
+{
+    uint32_t frames = timing->frames;
+    uint32_t crc_errors = timing->crc_errors;
+
+    *timing = *src;
+    timing->frames = frames;
+    timing->crc_errors = crc_errors;
+}
+
+uint8_t ow_tune_apply(ow_tune_t *tune, ds18b20_timing_t *timing, const ow_tune_measure_t *m)
+{
+    static const ds18b20_timing_t standard = DS18B20_TIMING_STANDARD;
+    ds18b20_timing_t t = standard;
+    uint32_t rise_us;
+    uint32_t limit;
+
+    tune->profile = OW_TUNE_STANDARD;
+    if (m != NULL) {
+        tune->measure = *m;
+        rise_us = (m->rise_ns + 999) / 1000;
+
+        /* presence loops count polls of at least 1 us: twice the measured time is a safe bound */
+        limit = 2 * m->presence_delay_us + 20;
+        t.presence_max_us = (uint8_t)((limit < standard.presence_max_us) ? limit : standard.presence_max_us);
+        limit = 2 * m->presence_width_us + 20;
+        t.presence_end_us = (uint8_t)((limit < standard.presence_end_us) ? limit : standard.presence_end_us);
+
+        if (m->rise_ns < OW_TUNE_SHORT_RISE_NS) {
+            t.reset_low_us = 500;                       /* 480 min plus margin */
+            t.write1_low_us = 1;
+            t.write1_high_us = 60;                      /* 61 us slot, 60 min */
+            t.write0_low_us = 60;
+            t.write0_high_us = 2;
+            t.read_low_us = 1;
+            t.read_sample_us = 10;                      /* sampled 11 us into the slot */
+            t.read_high_us = 50;
+            tune->profile = OW_TUNE_SHORT;
+        } else if (rise_us <= OW_TUNE_MAX_RISE_US) {
+            t.write1_low_us = 1;                        /* leave the line time to rise */
+            t.write1_high_us = (uint8_t)(59 + 2 * rise_us);
+            t.write0_high_us = (uint8_t)(2 + 2 * rise_us);
+            t.read_low_us = 1;
+            t.read_sample_us = (uint8_t)(rise_us + 2);  /* after the rise, before 15 us */
+            t.read_high_us = (uint8_t)(60 - t.read_sample_us + 2 * rise_us);
+            tune->profile = OW_TUNE_LONG;
+        }
+    }
+    a_ow_tune_set(timing, &t);
+    tune->fallen_back = 0;
+    tune->clean_windows = 0;
+    tune->frames_mark = timing->frames;
+    tune->errors_mark = timing->crc_errors;
+    DLOG2(OW_TUNE_PROFILE, tune->profile, tune->measure.rise_ns);
+
+    return tune->profile;
+}
+
+uint8_t ow_tune_check(ow_tune_t *tune, ds18b20_timing_t *timing)
+{
+    static const ds18b20_timing_t standard = DS18B20_TIMING_STANDARD;
+    uint32_t frames = timing->frames - tune->frames_mark;
+    uint32_t errors = timing->crc_errors - tune->errors_mark;
+
+    if (frames < OW_TUNE_WINDOW) {
+        return 0;
+    }
+    tune->frames_mark = timing->frames;
+    tune->errors_mark = timing->crc_errors;
+
+    if (tune->profile != OW_TUNE_STANDARD && errors >= OW_TUNE_MAX_ERRORS) {
+        a_ow_tune_set(timing, &standard);
+        DLOG2(OW_TUNE_FALLBACK, tune->profile, errors);
+        tune->profile = OW_TUNE_STANDARD;
+        tune->fallen_back = 1;
+        tune->clean_windows = 0;
+        tune->fallbacks++;
+        return 0;
+    }
+    if (tune->fallen_back != 0) {
+        if (errors != 0) {
+            tune->clean_windows = 0;                    /* not the timing: keep waiting */
+        } else if (++tune->clean_windows >= OW_TUNE_RETRY_WINDOWS) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void ow_tune_print(uint8_t bus, const ow_tune_t *tune, const ds18b20_timing_t *timing)
+{
+    printf("ow bus %u: %s timing, rise %lu ns, presence %lu/%lu us, reset %u us, crc errors %lu/%lu, fallbacks %lu\r\n",
+           bus, gc_ow_tune_names[tune->profile],
+           (unsigned long)tune->measure.rise_ns, (unsigned long)tune->measure.presence_delay_us,
+           (unsigned long)tune->measure.presence_width_us, timing->reset_low_us,
+           (unsigned long)timing->crc_errors, (unsigned long)timing->frames, (unsigned long)tune->fallbacks);
+}
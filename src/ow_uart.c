@@ -0,0 +1,220 @@
+/**
+ * @file      ow_uart.c
+ * @brief     1-Wire over a UART with DMA slot transfers
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ow_uart.h"
+#include "pico/stdlib.h"
+#include "hardware/uart.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+typedef struct
+{
+    uart_inst_t *uart;
+    uint32_t tx_pin;
+    uint32_t rx_pin;
+    int dma_tx;
+    int dma_rx;
+    uint32_t baud;
+    SemaphoreHandle_t done;
+    StaticSemaphore_t done_buf;
+    uint8_t slots[OW_UART_MAX_SLOTS];
+    uint8_t echo[OW_UART_MAX_SLOTS];
+} ow_uart_ctx_t;
+
+static ow_uart_ctx_t gs_ow_uart[2] = {
+    { .dma_tx = -1, .dma_rx = -1 },
+    { .dma_tx = -1, .dma_rx = -1 },
+};
+
+static uint8_t gs_ow_uart_irq_installed;
+
+/**
+ * @brief DMA_IRQ_1 handler: the RX channel finishing means every echo is in
+ */
+static void a_ow_uart_dma_irq(void)
+{
+    BaseType_t woken = pdFALSE;
+
+    for (uint8_t i = 0; i < 2; i++) {
+        ow_uart_ctx_t *ctx = &gs_ow_uart[i];
+
+        if ((ctx->dma_rx >= 0) && dma_channel_get_irq1_status((uint)ctx->dma_rx)) {
+            dma_channel_acknowledge_irq1((uint)ctx->dma_rx);
+            xSemaphoreGiveFromISR(ctx->done, &woken);
+        }
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief     Send ctx->slots and collect the echo into ctx->echo
+ * @param[in] ctx  UART context
+ * @param[in] baud Baud rate for the block
+ * @param[in] len  Bytes to send
+ * @return    0 on success, 1 on timeout
+ */
+static uint8_t a_ow_uart_xfer(ow_uart_ctx_t *ctx, uint32_t baud, uint16_t len)
+{
+    uart_hw_t *hw = uart_get_hw(ctx->uart);
+    dma_channel_config c;
+
+    if (ctx->baud != baud) {
+        (void)uart_set_baudrate(ctx->uart, baud);           /* line idle: last echo is in */
+        ctx->baud = baud;
+    }
+    while (uart_is_readable(ctx->uart)) {
+        (void)uart_getc(ctx->uart);                         /* stale echo */
+    }
+    (void)xSemaphoreTake(ctx->done, 0);
+
+    c = dma_channel_get_default_config((uint)ctx->dma_rx);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_dreq(&c, uart_get_dreq(ctx->uart, false));
+    dma_channel_configure((uint)ctx->dma_rx, &c, ctx->echo, &hw->dr, len, false);
+
+    c = dma_channel_get_default_config((uint)ctx->dma_tx);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, uart_get_dreq(ctx->uart, true));
+    dma_channel_configure((uint)ctx->dma_tx, &c, &hw->dr, ctx->slots, len, false);
+
+    dma_start_channel_mask((1u << ctx->dma_rx) | (1u << ctx->dma_tx));
+    if (xSemaphoreTake(ctx->done, pdMS_TO_TICKS(OW_UART_TIMEOUT_MS)) != pdTRUE) {
+        dma_channel_abort((uint)ctx->dma_tx);
+        dma_channel_abort((uint)ctx->dma_rx);
+        return 1;
+    }
+    return 0;
+}
+
+uint8_t ow_uart_init(uint8_t id, uint32_t tx_pin, uint32_t rx_pin)
+{
+    ow_uart_ctx_t *ctx;
+
+    if (id > 1) {
+        return 1;
+    }
+    ctx = &gs_ow_uart[id];
+    if (ctx->dma_rx >= 0) {
+        return 0;
+    }
+    if (ctx->done == NULL) {
+        ctx->done = xSemaphoreCreateBinaryStatic(&ctx->done_buf);
+        if (ctx->done == NULL) {
+            return 1;
+        }
+    }
+    ctx->dma_tx = dma_claim_unused_channel(false);
+    ctx->dma_rx = dma_claim_unused_channel(false);
+    if ((ctx->dma_tx < 0) || (ctx->dma_rx < 0)) {
+        if (ctx->dma_tx >= 0) {
+            dma_channel_unclaim((uint)ctx->dma_tx);
+        }
+        if (ctx->dma_rx >= 0) {
+            dma_channel_unclaim((uint)ctx->dma_rx);
+        }
+        ctx->dma_tx = -1;
+        ctx->dma_rx = -1;
+        return 1;
+    }
+
+    ctx->uart = UART_INSTANCE(id);
+    ctx->tx_pin = tx_pin;
+    ctx->rx_pin = rx_pin;
+    (void)uart_init(ctx->uart, OW_UART_RESET_BAUD);
+    ctx->baud = OW_UART_RESET_BAUD;
+    uart_set_format(ctx->uart, 8, 1, UART_PARITY_NONE);
+    gpio_set_function(tx_pin, GPIO_FUNC_UART);
+    gpio_set_function(rx_pin, GPIO_FUNC_UART);
+    gpio_pull_up(rx_pin);
+
+    if (!gs_ow_uart_irq_installed) {
+        irq_add_shared_handler(DMA_IRQ_1, a_ow_uart_dma_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_1, true);
+        gs_ow_uart_irq_installed = 1;
+    }
+    dma_channel_set_irq1_enabled((uint)ctx->dma_rx, true);
+    return 0;
+}
+
+uint8_t ow_uart_deinit(uint8_t id)
+{
+    ow_uart_ctx_t *ctx;
+
+    if ((id > 1) || (gs_ow_uart[id].dma_rx < 0)) {
+        return 1;
+    }
+    ctx = &gs_ow_uart[id];
+    dma_channel_set_irq1_enabled((uint)ctx->dma_rx, false);
+    dma_channel_unclaim((uint)ctx->dma_tx);
+    dma_channel_unclaim((uint)ctx->dma_rx);
+    ctx->dma_tx = -1;
+    ctx->dma_rx = -1;
+    uart_deinit(ctx->uart);
+    gpio_disable_pulls(ctx->rx_pin);
+    gpio_deinit(ctx->tx_pin);
+    gpio_deinit(ctx->rx_pin);
+    return 0;
+}
+
+uint8_t ow_uart_reset(uint8_t id, uint8_t *width_us)
+{
+    ow_uart_ctx_t *ctx = &gs_ow_uart[id];
+
+    *width_us = 0;
+    ctx->slots[0] = OW_UART_RESET_BYTE;
+    if (a_ow_uart_xfer(ctx, OW_UART_RESET_BAUD, 1) != 0) {
+        return 2;
+    }
+    return ow_uart_reset_decode(ctx->echo[0], width_us);
+}
+
+uint8_t ow_uart_touch(uint8_t id, const uint8_t *tx, uint8_t *rx, uint16_t slots)
+{
+    ow_uart_ctx_t *ctx = &gs_ow_uart[id];
+    uint16_t n;
+
+    while (slots > 0) {
+        n = (slots > OW_UART_MAX_SLOTS) ? OW_UART_MAX_SLOTS : slots;
+        ow_uart_encode(tx, n, ctx->slots);
+        if (a_ow_uart_xfer(ctx, OW_UART_SLOT_BAUD, n) != 0) {
+            return 1;
+        }
+        if (rx != NULL) {
+            ow_uart_decode(ctx->echo, n, rx);
+            rx += OW_UART_MAX_SLOTS / 8;
+        }
+        tx += OW_UART_MAX_SLOTS / 8;
+        slots = (uint16_t)(slots - n);
+    }
+    return 0;
+}
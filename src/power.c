@@ -0,0 +1,83 @@
+/**
+ * @file      power.c
+ * @brief     CPU sleep accounting for the FreeRTOS idle hooks
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "power.h"
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+static volatile uint64_t gs_sleep_us[POWER_CORES];
+static volatile uint32_t gs_wakeups[POWER_CORES];
+
+/**
+ * @brief     Read a counter written by the other core without tearing
+ * @param[in] value Counter
+ * @return    Consistent value
+ */
+static uint64_t a_power_read(const volatile uint64_t *value)
+{
+    uint64_t a;
+    uint64_t b;
+
+    do {
+        a = *value;
+        b = *value;
+    } while (a != b);
+    return a;
+}
+
+void power_idle(void)
+{
+    uint core = get_core_num();
+    uint64_t start = time_us_64();
+
+    __wfi();
+    gs_sleep_us[core] += time_us_64() - start;    /* only this core writes its slot */
+    gs_wakeups[core]++;
+}
+
+void power_get_stats(power_stats_t *stats)
+{
+    stats->uptime_us = time_us_64();
+    for (uint8_t i = 0; i < POWER_CORES; ++i) {
+        stats->sleep_us[i] = a_power_read(&gs_sleep_us[i]);
+        stats->wakeups[i] = gs_wakeups[i];
+    }
+}
+
+uint16_t power_awake_permille(const power_stats_t *now, const power_stats_t *prev, uint8_t core)
+{
+    uint64_t window = now->uptime_us - prev->uptime_us;
+    uint64_t slept = now->sleep_us[core] - prev->sleep_us[core];
+
+    if (window == 0) {
+        return 1000;
+    }
+    if (slept >= window) {
+        return 0;
+    }
+    return (uint16_t)(((window - slept) * 1000) / window);
+}
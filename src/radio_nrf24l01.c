@@ -0,0 +1,320 @@
+/**
+ * @file      radio_nrf24l01.c
+ * @brief     radio_ops_t implementation on top of the nRF24L01+ driver
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "radio.h"
+#include "driver_nrf24l01_interface.h"
+#include "pico/time.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include <string.h>
+
+/* RF settings (override with -DRADIO_NRF24L01_*=N if needed) */
+#ifndef RADIO_NRF24L01_CHANNEL
+#define RADIO_NRF24L01_CHANNEL       76
+#endif
+#ifndef RADIO_NRF24L01_DATA_RATE
+#define RADIO_NRF24L01_DATA_RATE     NRF24L01_DATA_RATE_1M
+#endif
+#ifndef RADIO_NRF24L01_POWER
+#define RADIO_NRF24L01_POWER         NRF24L01_POWER_0_DBM
+#endif
+
+/** Upper bound for one burst: 3 frames x 15 retries x 4 ms */
+#define RADIO_NRF24L01_TX_TIMEOUT_MS 200
+
+/** Upper bound for a no-ack broadcast to leave the chip */
+#define RADIO_NRF24L01_BCAST_TIMEOUT_MS 10
+
+/** Uplink address of base station pipe 1; pipes 2 - 5 differ in the first (least significant) byte */
+static const uint8_t gs_uplink_addr[NRF24L01_ADDR_WIDTH] = {0xE7, 0xD3, 0xF0, 0x35, 0x01};
+
+/** Broadcast address, the base station transmits to it and nodes listen on pipe 1 */
+static const uint8_t gs_bcast_addr[NRF24L01_ADDR_WIDTH] = {0xB5, 0x5B, 0xA5, 0x5A, 0x02};
+
+static nrf24l01_handle_t gs_handle;
+static SemaphoreHandle_t gs_irq_sem;
+static StaticSemaphore_t gs_irq_sem_buf;
+static volatile uint64_t gs_irq_us;
+static radio_role_t gs_role;
+static uint8_t gs_uplink_pipe = 1;
+
+/**
+ * @brief IRQ line callback (interrupt context)
+ */
+static void a_radio_nrf24l01_irq(void)
+{
+    BaseType_t woken = pdFALSE;
+
+    gs_irq_us = time_us_64();                       /* receive timestamp for time sync */
+    xSemaphoreGiveFromISR(gs_irq_sem, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief Uplink address of base station pipe 1 - 5
+ */
+static void a_radio_nrf24l01_uplink_addr(uint8_t pipe, uint8_t addr[NRF24L01_ADDR_WIDTH])
+{
+    memcpy(addr, gs_uplink_addr, NRF24L01_ADDR_WIDTH);
+    addr[0] = (uint8_t)(addr[0] + pipe - 1);
+}
+
+/**
+ * @brief Select the uplink pipe and write the matching TX and pipe 0 address
+ */
+static uint8_t a_radio_nrf24l01_set_uplink(uint8_t pipe)
+{
+    uint8_t addr[NRF24L01_ADDR_WIDTH];
+
+    if ((pipe < 1) || (pipe > 5)) {
+        return 1;
+    }
+    gs_uplink_pipe = pipe;
+    a_radio_nrf24l01_uplink_addr(pipe, addr);
+    return nrf24l01_set_tx_address(&gs_handle, addr);
+}
+
+static uint8_t a_radio_nrf24l01_init(radio_role_t role)
+{
+    const nrf24l01_config_t config = {
+        .channel = RADIO_NRF24L01_CHANNEL,
+        .data_rate = RADIO_NRF24L01_DATA_RATE,
+        .power = RADIO_NRF24L01_POWER,
+        .retransmit_delay = 1,                      /* 500 us, enough for ack payloads */
+        .retransmit_count = 5,
+    };
+
+    if (gs_irq_sem == NULL) {
+        gs_irq_sem = xSemaphoreCreateBinaryStatic(&gs_irq_sem_buf);
+        if (gs_irq_sem == NULL) {
+            return 1;
+        }
+    }
+
+    DRIVER_NRF24L01_LINK_INIT        (&gs_handle, nrf24l01_handle_t);
+    DRIVER_NRF24L01_LINK_SPI_INIT    (&gs_handle, nrf24l01_interface_spi_init);
+    DRIVER_NRF24L01_LINK_SPI_DEINIT  (&gs_handle, nrf24l01_interface_spi_deinit);
+    DRIVER_NRF24L01_LINK_SPI_TRANSFER(&gs_handle, nrf24l01_interface_spi_transfer);
+    DRIVER_NRF24L01_LINK_CE_WRITE    (&gs_handle, nrf24l01_interface_ce_write);
+    DRIVER_NRF24L01_LINK_DELAY_MS    (&gs_handle, nrf24l01_interface_delay_ms);
+    DRIVER_NRF24L01_LINK_DELAY_US    (&gs_handle, nrf24l01_interface_delay_us);
+    DRIVER_NRF24L01_LINK_DEBUG_PRINT (&gs_handle, nrf24l01_interface_debug_print);
+
+    if (nrf24l01_init(&gs_handle) != 0) {
+        return 1;
+    }
+    if (nrf24l01_configure(&gs_handle, &config) != 0) {
+        return 1;
+    }
+    gs_role = role;
+    if (role == RADIO_ROLE_NODE) {
+        if ((nrf24l01_set_tx_address(&gs_handle, gs_uplink_addr) != 0) ||
+            (nrf24l01_set_rx_address(&gs_handle, 1, gs_bcast_addr) != 0)) {
+            return 1;
+        }
+    } else {
+        if (nrf24l01_set_tx_address(&gs_handle, gs_bcast_addr) != 0) {
+            return 1;
+        }
+        for (uint8_t pipe = 1; pipe <= 5; ++pipe) {
+            uint8_t addr[NRF24L01_ADDR_WIDTH];
+            a_radio_nrf24l01_uplink_addr(pipe, addr);
+            if (nrf24l01_set_rx_address(&gs_handle, pipe, addr) != 0) {
+                return 1;
+            }
+        }
+    }
+    return nrf24l01_interface_irq_init(a_radio_nrf24l01_irq);
+}
+
+static uint8_t a_radio_nrf24l01_deinit(void)
+{
+    return nrf24l01_deinit(&gs_handle);
+}
+
+/**
+ * @brief Queue up to three frames and let the chip send them in one CE-high window
+ *
+ * The chip walks the TX FIFO on its own while CE is high, so all frames share
+ * one power-up and one TX settling period per frame instead of a full
+ * standby/active cycle each. TX_DS is counted per interrupt; on MAX_RT the
+ * failed head frame and everything behind it are flushed.
+ */
+static uint8_t a_radio_nrf24l01_send_burst(const radio_frame_t *frames, uint8_t count, uint8_t *sent)
+{
+    uint8_t i;
+    uint8_t status;
+    uint8_t fifo;
+    uint8_t acked = 0;
+    uint8_t res = 0;
+
+    *sent = 0;
+    if (count == 0) {
+        return 0;
+    }
+    if (count > RADIO_TX_BURST_MAX) {
+        count = RADIO_TX_BURST_MAX;
+    }
+
+    if (nrf24l01_set_mode(&gs_handle, NRF24L01_MODE_TX) != 0) {
+        return 1;
+    }
+    if ((gs_role == RADIO_ROLE_NODE) && (a_radio_nrf24l01_set_uplink(gs_uplink_pipe) != 0)) {
+        return 1;                                           /* pipe 0 back to the ack address */
+    }
+    (void)nrf24l01_clear_irq(&gs_handle, NRF24L01_STATUS_IRQ_MASK);
+    (void)xSemaphoreTake(gs_irq_sem, 0);
+    for (i = 0; i < count; i++) {
+        if (nrf24l01_write_tx_payload(&gs_handle, frames[i].data, frames[i].len, 1) != 0) {
+            (void)nrf24l01_flush_tx(&gs_handle);
+            return 1;
+        }
+    }
+    (void)nrf24l01_set_ce(&gs_handle, 1);
+
+    for (;;) {
+        if (xSemaphoreTake(gs_irq_sem, pdMS_TO_TICKS(RADIO_NRF24L01_TX_TIMEOUT_MS)) != pdTRUE) {
+            res = 1;                                        /* chip stopped signalling */
+            break;
+        }
+        if (nrf24l01_get_status(&gs_handle, &status) != 0) {
+            res = 1;
+            break;
+        }
+        (void)nrf24l01_clear_irq(&gs_handle, status);
+        if (status & NRF24L01_STATUS_TX_DS) {
+            acked++;
+        }
+        if (nrf24l01_get_fifo_status(&gs_handle, &fifo) != 0) {
+            res = 1;
+            break;
+        }
+        if (fifo & NRF24L01_FIFO_TX_EMPTY) {
+            acked = count;                                  /* everything left the fifo */
+            break;
+        }
+        if (status & NRF24L01_STATUS_MAX_RT) {
+            break;
+        }
+    }
+
+    (void)nrf24l01_set_ce(&gs_handle, 0);
+    if (acked < count) {
+        (void)nrf24l01_flush_tx(&gs_handle);
+    }
+    *sent = acked;
+    return res;
+}
+
+/**
+ * @brief Enter receive; a node also points pipe 0 at the broadcast address so it
+ *        does not pick up and acknowledge uplink frames of other nodes
+ */
+static uint8_t a_radio_nrf24l01_listen(void)
+{
+    if ((gs_role == RADIO_ROLE_NODE) && (nrf24l01_set_rx_address(&gs_handle, 0, gs_bcast_addr) != 0)) {
+        return 1;
+    }
+    (void)nrf24l01_clear_irq(&gs_handle, NRF24L01_STATUS_IRQ_MASK);
+    return nrf24l01_set_mode(&gs_handle, NRF24L01_MODE_RX);
+}
+
+static uint8_t a_radio_nrf24l01_wait(uint32_t timeout_ms)
+{
+    return (xSemaphoreTake(gs_irq_sem, pdMS_TO_TICKS(timeout_ms)) == pdTRUE) ? 0 : 1;
+}
+
+/**
+ * @brief Pop one frame; RX_DR is cleared first so a frame arriving mid-drain re-arms the IRQ
+ */
+static uint8_t a_radio_nrf24l01_receive(radio_frame_t *frame)
+{
+    (void)nrf24l01_clear_irq(&gs_handle, NRF24L01_STATUS_RX_DR);
+    return nrf24l01_read_rx_payload(&gs_handle, frame->data, &frame->len, &frame->pipe);
+}
+
+static uint8_t a_radio_nrf24l01_sleep(void)
+{
+    return nrf24l01_set_mode(&gs_handle, NRF24L01_MODE_POWER_DOWN);
+}
+
+/**
+ * @brief Send one frame without acknowledgement; the caller goes back to listen afterwards
+ */
+static uint8_t a_radio_nrf24l01_broadcast(const radio_frame_t *frame)
+{
+    uint8_t status = 0;
+    uint8_t res = 0;
+
+    if (nrf24l01_set_mode(&gs_handle, NRF24L01_MODE_TX) != 0) {
+        return 1;
+    }
+    (void)nrf24l01_clear_irq(&gs_handle, NRF24L01_STATUS_IRQ_MASK);
+    (void)xSemaphoreTake(gs_irq_sem, 0);
+    if (nrf24l01_write_tx_payload(&gs_handle, frame->data, frame->len, 0) != 0) {
+        (void)nrf24l01_flush_tx(&gs_handle);
+        return 1;
+    }
+    (void)nrf24l01_set_ce(&gs_handle, 1);
+    if ((xSemaphoreTake(gs_irq_sem, pdMS_TO_TICKS(RADIO_NRF24L01_BCAST_TIMEOUT_MS)) != pdTRUE) ||
+        (nrf24l01_get_status(&gs_handle, &status) != 0) ||
+        ((status & NRF24L01_STATUS_TX_DS) == 0)) {
+        res = 1;
+    }
+    (void)nrf24l01_set_ce(&gs_handle, 0);
+    (void)nrf24l01_clear_irq(&gs_handle, NRF24L01_STATUS_IRQ_MASK);
+    if (res != 0) {
+        (void)nrf24l01_flush_tx(&gs_handle);
+    }
+    return res;
+}
+
+static uint8_t a_radio_nrf24l01_kick(void)
+{
+    (void)xSemaphoreGive(gs_irq_sem);
+    return 0;
+}
+
+static uint8_t a_radio_nrf24l01_irq_time(uint64_t *us)
+{
+    *us = gs_irq_us;
+    return 0;
+}
+
+const radio_ops_t gc_radio_nrf24l01_ops = {
+    .init       = a_radio_nrf24l01_init,
+    .deinit     = a_radio_nrf24l01_deinit,
+    .send_burst = a_radio_nrf24l01_send_burst,
+    .listen     = a_radio_nrf24l01_listen,
+    .wait       = a_radio_nrf24l01_wait,
+    .receive    = a_radio_nrf24l01_receive,
+    .sleep      = a_radio_nrf24l01_sleep,
+    .broadcast  = a_radio_nrf24l01_broadcast,
+    .set_uplink = a_radio_nrf24l01_set_uplink,
+    .kick       = a_radio_nrf24l01_kick,
+    .irq_time   = a_radio_nrf24l01_irq_time,
+};
@@ -0,0 +1,169 @@
+/**
+ * @file      radio_protocol.c
+ * @brief     Over-the-air payload format shared by sensor node, base station and host tools
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "radio_protocol.h"
+#include "sample_codec.h"
+#include <stddef.h>
+
+static void a_put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void a_put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint16_t a_get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static uint32_t a_get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+uint8_t radio_protocol_pack_samples(uint8_t node_id, uint16_t seq,
+                                    const radio_sample_t *samples, uint8_t count,
+                                    radio_frame_t *frame, uint8_t *packed)
+{
+    uint8_t n = 0;
+    uint32_t prev;
+    uint32_t dt;
+    uint8_t *p;
+
+    if ((samples == NULL) || (frame == NULL) || (packed == NULL) || (count == 0)) {
+        return 1;
+    }
+
+    frame->data[0] = RADIO_PACKET_SAMPLES;
+    frame->data[1] = node_id;
+    a_put_u16(&frame->data[2], seq);
+    a_put_u32(&frame->data[4], samples[0].time_ms);
+
+    prev = samples[0].time_ms;
+    p = &frame->data[RADIO_PROTOCOL_HEADER_SIZE];
+    while ((n < count) && (n < RADIO_PROTOCOL_MAX_SAMPLES)) {
+        dt = samples[n].time_ms - prev;
+        if ((dt > RADIO_PROTOCOL_MAX_DELTA_MS) || (samples[n].sensor > RADIO_PROTOCOL_MAX_SENSOR)) {
+            break;                                  /* start a new payload with a fresh base time */
+        }
+        a_put_u16(&p[0], (uint16_t)samples[n].raw);
+        a_put_u16(&p[2], (uint16_t)(((uint16_t)samples[n].sensor << 13) | dt));
+        prev = samples[n].time_ms;
+        p += RADIO_PROTOCOL_SAMPLE_SIZE;
+        n++;
+    }
+    if (n == 0) {
+        return 1;                                   /* first sample has an out-of-range sensor index */
+    }
+
+    frame->len = (uint8_t)(RADIO_PROTOCOL_HEADER_SIZE + n * RADIO_PROTOCOL_SAMPLE_SIZE);
+    frame->pipe = 0;
+    *packed = n;
+    return 0;
+}
+
+uint8_t radio_protocol_pack_samples_packed(uint8_t node_id, uint16_t seq,
+                                           const radio_sample_t *samples, uint8_t count,
+                                           radio_frame_t *frame, uint8_t *packed)
+{
+    uint16_t len;
+
+    if ((frame == NULL) || (packed == NULL)) {
+        return 1;
+    }
+    if (count > RADIO_PROTOCOL_MAX_PACKED) {
+        count = RADIO_PROTOCOL_MAX_PACKED;
+    }
+    if (sample_codec_encode_block(samples, count, &frame->data[RADIO_PROTOCOL_PACKED_OFFSET],
+                                  RADIO_PAYLOAD_MAX - RADIO_PROTOCOL_PACKED_OFFSET, &len, packed) != 0) {
+        return 1;
+    }
+
+    frame->data[0] = RADIO_PACKET_SAMPLES_PACKED;
+    frame->data[1] = node_id;
+    a_put_u16(&frame->data[2], seq);
+    frame->len = (uint8_t)(RADIO_PROTOCOL_PACKED_OFFSET + len);
+    frame->pipe = 0;
+    return 0;
+}
+
+uint8_t radio_protocol_unpack_header(const radio_frame_t *frame, radio_header_t *header)
+{
+    if ((frame == NULL) || (header == NULL) || (frame->len < RADIO_PROTOCOL_HEADER_SIZE)) {
+        return 1;
+    }
+    header->type = frame->data[0];
+    header->node_id = frame->data[1];
+    header->seq = a_get_u16(&frame->data[2]);
+    header->time_ms = a_get_u32(&frame->data[4]);
+    return 0;
+}
+
+uint8_t radio_protocol_unpack_samples(const radio_frame_t *frame, radio_header_t *header,
+                                      radio_sample_t *samples, uint8_t *count)
+{
+    uint8_t i;
+    uint8_t n;
+    uint16_t word;
+    uint32_t t;
+    const uint8_t *p;
+
+    if (radio_protocol_unpack_header(frame, header) != 0) {
+        return 1;
+    }
+    if (header->type == RADIO_PACKET_SAMPLES_PACKED) {
+        return sample_codec_decode_block(&frame->data[RADIO_PROTOCOL_PACKED_OFFSET],
+                                         (uint16_t)(frame->len - RADIO_PROTOCOL_PACKED_OFFSET),
+                                         samples, RADIO_PROTOCOL_MAX_PACKED, count);
+    }
+    if ((header->type != RADIO_PACKET_SAMPLES) ||
+        (((frame->len - RADIO_PROTOCOL_HEADER_SIZE) % RADIO_PROTOCOL_SAMPLE_SIZE) != 0)) {
+        return 1;
+    }
+
+    n = (uint8_t)((frame->len - RADIO_PROTOCOL_HEADER_SIZE) / RADIO_PROTOCOL_SAMPLE_SIZE);
+    t = header->time_ms;
+    p = &frame->data[RADIO_PROTOCOL_HEADER_SIZE];
+    for (i = 0; i < n; i++) {
+        word = a_get_u16(&p[2]);
+        t += word & RADIO_PROTOCOL_MAX_DELTA_MS;
+        samples[i].raw = (int16_t)a_get_u16(&p[0]);
+        samples[i].sensor = (uint8_t)(word >> 13);
+        samples[i].time_ms = t;
+        p += RADIO_PROTOCOL_SAMPLE_SIZE;
+    }
+    *count = n;
+    return 0;
+}
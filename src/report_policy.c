@@ -0,0 +1,90 @@
+/**
+ * @file      report_policy.c
+ * @brief     Send-on-delta reporting: per-sensor deadband and heartbeat, receiver-side held values
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "report_policy.h"
+#include <string.h>
+
+void report_policy_init(report_policy_t *policy, uint16_t deadband_raw, uint32_t heartbeat_ms)
+{
+    memset(policy, 0, sizeof(*policy));
+    policy->deadband_raw = deadband_raw;
+    policy->heartbeat_ms = heartbeat_ms;
+}
+
+uint8_t report_policy_check(report_policy_t *policy, const radio_sample_t *sample)
+{
+    report_sensor_t *s;
+    int32_t diff;
+
+    if (sample->sensor >= REPORT_POLICY_MAX_SENSORS) {
+        return 1;                                   /* not ours to judge, let the packer reject it */
+    }
+    s = &policy->sensors[sample->sensor];
+
+    if (s->valid && (policy->heartbeat_ms != 0)) {
+        diff = (int32_t)sample->raw - s->raw;
+        if (diff < 0) {
+            diff = -diff;
+        }
+        if ((diff <= policy->deadband_raw) && ((uint32_t)(sample->time_ms - s->time_ms) < policy->heartbeat_ms)) {
+            policy->suppressed++;
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+void report_policy_commit(report_policy_t *policy, const radio_sample_t *sample)
+{
+    report_sensor_t *s;
+
+    if (sample->sensor >= REPORT_POLICY_MAX_SENSORS) {
+        return;
+    }
+    s = &policy->sensors[sample->sensor];
+    s->valid = 1;
+    s->raw = sample->raw;
+    s->time_ms = sample->time_ms;
+    policy->reported++;
+}
+
+void report_hold_update(report_hold_t *hold, const radio_sample_t *sample, uint32_t now_ms)
+{
+    hold->valid = 1;
+    hold->raw = sample->raw;
+    hold->sample_ms = sample->time_ms;
+    hold->rx_ms = now_ms;
+}
+
+uint32_t report_hold_age(const report_hold_t *hold, uint32_t now_ms)
+{
+    if (!hold->valid) {
+        return UINT32_MAX;
+    }
+    return now_ms - hold->rx_ms;
+}
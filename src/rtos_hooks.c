@@ -0,0 +1,66 @@
+/**
+ * @file      rtos_hooks.c
+ * @brief     FreeRTOS application hooks shared by all firmware targets
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "power.h"
+
+/**
+ * @brief Malloc-failed hook
+ */
+void vApplicationMallocFailedHook(void)
+{
+    printf("FreeRTOS malloc failed!\r\n");
+    for (;;) { tight_loop_contents(); }
+}
+
+/**
+ * @brief Stack-overflow hook
+ */
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
+{
+    printf("FreeRTOS stack overflow in task %s!\r\n", pcTaskName);
+    for (;;) { tight_loop_contents(); }
+}
+
+/**
+ * @brief Idle hook, sleeps the core until the next interrupt
+ */
+void vApplicationIdleHook(void)
+{
+    power_idle();
+}
+
+/**
+ * @brief Passive idle hook, same for the idle task of the other core
+ */
+void vApplicationPassiveIdleHook(void)
+{
+    power_idle();
+}
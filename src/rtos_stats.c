@@ -0,0 +1,173 @@
+/**
+ * @file      rtos_stats.c
+ * @brief     Per-task CPU share and stack high-water marks from FreeRTOS run-time stats
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "rtos_stats.h"
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "hardware/regs/addressmap.h"
+
+extern char __bss_end__;                         /* linker script symbols */
+extern char __end__;
+extern char __HeapLimit;
+
+/**
+ * @brief     Run time of a task in an earlier snapshot
+ * @param[in] prev   Snapshot
+ * @param[in] number xTaskNumber
+ * @return    Run time, 0 for a task created since
+ */
+static uint64_t a_rtos_stats_prev_run(const rtos_stats_t *prev, uint32_t number)
+{
+    for (uint8_t i = 0; i < prev->count; ++i) {
+        if (prev->tasks[i].number == number) {
+            return prev->tasks[i].run_us;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief      Store a little-endian field
+ * @param[out] p     Destination
+ * @param[in]  value Value
+ * @param[in]  len   Field size in bytes
+ */
+static void a_rtos_stats_put_le(uint8_t *p, uint32_t value, uint8_t len)
+{
+    for (uint8_t i = 0; i < len; ++i) {
+        p[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+uint8_t rtos_stats_snapshot(rtos_stats_t *snap)
+{
+    static TaskStatus_t status[RTOS_STATS_MAX_TASKS];
+    UBaseType_t n;
+
+    snap->count = 0;
+    n = uxTaskGetSystemState(status, RTOS_STATS_MAX_TASKS, NULL);
+    power_get_stats(&snap->power);
+    if (n == 0) {
+        return 1;
+    }
+    for (UBaseType_t i = 0; i < n; ++i) {
+        rtos_stats_task_t *t = &snap->tasks[i];
+
+        t->number = (uint32_t)status[i].xTaskNumber;
+        strncpy(t->name, status[i].pcTaskName, RTOS_STATS_NAME_LEN - 1);
+        t->name[RTOS_STATS_NAME_LEN - 1] = '\0';
+        t->run_us = status[i].ulRunTimeCounter;
+        t->stack_free = (uint16_t)status[i].usStackHighWaterMark;
+        t->priority = (uint8_t)status[i].uxCurrentPriority;
+        t->affinity = (uint8_t)(status[i].uxCoreAffinityMask & ((1u << POWER_CORES) - 1));
+    }
+    snap->count = (uint8_t)n;
+    return 0;
+}
+
+uint16_t rtos_stats_task_permille(const rtos_stats_t *now, const rtos_stats_t *prev, uint8_t index)
+{
+    uint64_t window = now->power.uptime_us - prev->power.uptime_us;
+    uint64_t run = now->tasks[index].run_us - a_rtos_stats_prev_run(prev, now->tasks[index].number);
+
+    if (window == 0) {
+        return 0;
+    }
+    if (run > window) {
+        run = window;                                   /* counter read a little after the task list */
+    }
+    return (uint16_t)((run * 1000) / window);
+}
+
+void rtos_stats_print(const rtos_stats_t *now, const rtos_stats_t *prev)
+{
+    uint16_t share;
+
+    for (uint8_t i = 0; i < now->count; ++i) {
+        share = rtos_stats_task_permille(now, prev, i);
+        printf("task: %-12s %3u.%u%% stack free %4u prio %2u cores %x\r\n", now->tasks[i].name,
+               share / 10, share % 10, now->tasks[i].stack_free, now->tasks[i].priority,
+               now->tasks[i].affinity);
+    }
+    for (uint8_t c = 0; c < POWER_CORES; ++c) {
+        share = power_awake_permille(&now->power, &prev->power, c);
+        printf("core%u: awake %u.%u%%\r\n", c, share / 10, share % 10);
+    }
+}
+
+uint8_t rtos_stats_append(usb_frame_t *frame, const rtos_stats_t *now, const rtos_stats_t *prev)
+{
+    uint8_t head[RTOS_STATS_EXPORT_HEADER];
+    uint8_t rec[RTOS_STATS_EXPORT_TASK];
+
+    if ((frame->len + RTOS_STATS_EXPORT_HEADER + now->count * RTOS_STATS_EXPORT_TASK) > USB_FRAME_MAX_PAYLOAD) {
+        return 1;
+    }
+    a_rtos_stats_put_le(head, (uint32_t)(now->power.uptime_us - prev->power.uptime_us), 4);
+    for (uint8_t c = 0; c < POWER_CORES; ++c) {
+        a_rtos_stats_put_le(&head[4 + 2 * c], power_awake_permille(&now->power, &prev->power, c), 2);
+    }
+    head[4 + 2 * POWER_CORES] = now->count;
+    (void)usb_frame_append(frame, head, sizeof(head));
+    for (uint8_t i = 0; i < now->count; ++i) {
+        strncpy((char *)rec, now->tasks[i].name, 8);    /* truncated, zero padded */
+        a_rtos_stats_put_le(&rec[8], rtos_stats_task_permille(now, prev, i), 2);
+        a_rtos_stats_put_le(&rec[10], now->tasks[i].stack_free, 2);
+        rec[12] = now->tasks[i].priority;
+        rec[13] = now->tasks[i].affinity;
+        (void)usb_frame_append(frame, rec, sizeof(rec));
+    }
+    return 0;
+}
+
+void rtos_stats_ram(rtos_stats_ram_t *ram)
+{
+    ram->total = SRAM_END - SRAM_BASE;
+    ram->static_used = (uint32_t)((uintptr_t)&__bss_end__ - SRAM_BASE);
+    ram->c_heap = (uint32_t)(&__HeapLimit - &__end__);
+#if configSUPPORT_DYNAMIC_ALLOCATION
+    ram->rtos_heap = configTOTAL_HEAP_SIZE;
+    ram->rtos_heap_free = (uint32_t)xPortGetFreeHeapSize();
+    ram->rtos_heap_min = (uint32_t)xPortGetMinimumEverFreeHeapSize();
+#else
+    ram->rtos_heap = 0;
+    ram->rtos_heap_free = 0;
+    ram->rtos_heap_min = 0;
+#endif
+}
+
+void rtos_stats_print_ram(void)
+{
+    rtos_stats_ram_t ram;
+
+    rtos_stats_ram(&ram);
+    printf("ram: static %lu of %lu bytes, malloc %lu, rtos heap %lu (free %lu, min %lu)\r\n",
+           (unsigned long)ram.static_used, (unsigned long)ram.total, (unsigned long)ram.c_heap,
+           (unsigned long)ram.rtos_heap, (unsigned long)ram.rtos_heap_free, (unsigned long)ram.rtos_heap_min);
+}
@@ -0,0 +1,191 @@
+/**
+ * @file      sample_backlog.c
+ * @brief     Store-and-forward sample backlog: RAM ring spilling whole pages to a flash partition
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "sample_backlog.h"
+#include <string.h>
+
+#define SAMPLE_BACKLOG_MARKER  0xA5
+
+static uint32_t a_next_page(const sample_backlog_t *backlog, uint32_t offset)
+{
+    offset += FLASH_REGION_PAGE_SIZE;
+    return (offset >= backlog->region->size) ? 0 : offset;
+}
+
+/**
+ * @brief Write the oldest RAM page to flash, erasing a fresh sector first when needed
+ */
+static void a_spill(sample_backlog_t *backlog)
+{
+    const radio_sample_t *s;
+    uint8_t *p = backlog->buf;
+    uint32_t sector;
+    uint32_t lost;
+    uint8_t res = 0;
+
+    if ((backlog->flash_wr % FLASH_REGION_SECTOR_SIZE) == 0) {
+        sector = backlog->flash_wr;
+        if ((backlog->flash_pages != 0) &&
+            ((backlog->flash_rd / FLASH_REGION_SECTOR_SIZE) == (sector / FLASH_REGION_SECTOR_SIZE))) {
+            /* partition full: give up the oldest sector */
+            lost = (sector + FLASH_REGION_SECTOR_SIZE - backlog->flash_rd) / FLASH_REGION_PAGE_SIZE;
+            backlog->flash_pages -= lost;
+            backlog->stats.dropped += lost * SAMPLE_BACKLOG_PAGE_SAMPLES;
+            backlog->flash_rd = (sector + FLASH_REGION_SECTOR_SIZE >= backlog->region->size) ?
+                                0 : sector + FLASH_REGION_SECTOR_SIZE;
+        }
+        res = flash_region_erase(backlog->region, sector, FLASH_REGION_SECTOR_SIZE);
+    }
+
+    if (res == 0) {
+        for (uint8_t i = 0; i < SAMPLE_BACKLOG_PAGE_SAMPLES; ++i) {
+            s = &backlog->ram[(backlog->ram_head + i) % SAMPLE_BACKLOG_RAM_SAMPLES];
+            p[0] = (uint8_t)s->time_ms;
+            p[1] = (uint8_t)(s->time_ms >> 8);
+            p[2] = (uint8_t)(s->time_ms >> 16);
+            p[3] = (uint8_t)(s->time_ms >> 24);
+            p[4] = (uint8_t)s->raw;
+            p[5] = (uint8_t)((uint16_t)s->raw >> 8);
+            p[6] = s->sensor;
+            p[7] = SAMPLE_BACKLOG_MARKER;
+            p += SAMPLE_BACKLOG_RECORD_SIZE;
+        }
+        res = flash_region_program(backlog->region, backlog->flash_wr, backlog->buf, FLASH_REGION_PAGE_SIZE);
+    }
+    if (res == 0) {
+        backlog->flash_wr = a_next_page(backlog, backlog->flash_wr);
+        backlog->flash_pages++;
+        backlog->stats.spilled++;
+    } else {
+        backlog->stats.flash_errors++;              /* the page is lost, keep sampling */
+        backlog->stats.dropped += SAMPLE_BACKLOG_PAGE_SAMPLES;
+    }
+
+    backlog->ram_head = (uint16_t)((backlog->ram_head + SAMPLE_BACKLOG_PAGE_SAMPLES) % SAMPLE_BACKLOG_RAM_SAMPLES);
+    backlog->ram_count = (uint16_t)(backlog->ram_count - SAMPLE_BACKLOG_PAGE_SAMPLES);
+}
+
+/**
+ * @brief Read the oldest flash page into the read-back buffer
+ */
+static void a_load_page(sample_backlog_t *backlog)
+{
+    const uint8_t *p = backlog->buf;
+    uint8_t n = 0;
+
+    backlog->page_pos = 0;
+    backlog->page_count = 0;
+    if (flash_region_read(backlog->region, backlog->flash_rd, backlog->buf, FLASH_REGION_PAGE_SIZE) == 0) {
+        for (uint8_t i = 0; i < SAMPLE_BACKLOG_PAGE_SAMPLES; ++i) {
+            if (p[7] == SAMPLE_BACKLOG_MARKER) {
+                backlog->page[n].time_ms = (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+                                           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+                backlog->page[n].raw = (int16_t)(p[4] | ((uint16_t)p[5] << 8));
+                backlog->page[n].sensor = p[6];
+                n++;
+            } else {
+                backlog->stats.dropped++;           /* torn or never programmed */
+            }
+            p += SAMPLE_BACKLOG_RECORD_SIZE;
+        }
+    }
+    backlog->page_count = n;
+    backlog->flash_rd = a_next_page(backlog, backlog->flash_rd);
+    backlog->flash_pages--;
+}
+
+void sample_backlog_init(sample_backlog_t *backlog, const flash_region_t *region)
+{
+    memset(backlog, 0, sizeof(*backlog));
+    backlog->region = region;
+}
+
+void sample_backlog_push(sample_backlog_t *backlog, const radio_sample_t *sample)
+{
+    if (backlog->ram_count == SAMPLE_BACKLOG_RAM_SAMPLES) {
+        if (backlog->region != NULL) {
+            a_spill(backlog);
+        } else {
+            backlog->ram_head = (uint16_t)((backlog->ram_head + 1) % SAMPLE_BACKLOG_RAM_SAMPLES);
+            backlog->ram_count--;
+            backlog->stats.dropped++;
+        }
+    }
+    backlog->ram[(backlog->ram_head + backlog->ram_count) % SAMPLE_BACKLOG_RAM_SAMPLES] = *sample;
+    backlog->ram_count++;
+    backlog->stats.pushed++;
+}
+
+uint16_t sample_backlog_peek(sample_backlog_t *backlog, radio_sample_t *samples, uint16_t max)
+{
+    uint16_t n = 0;
+    uint16_t k = 0;
+
+    while ((backlog->page_pos == backlog->page_count) && (backlog->flash_pages != 0)) {
+        a_load_page(backlog);
+    }
+    while ((n < max) && (backlog->page_pos + n < backlog->page_count)) {
+        samples[n] = backlog->page[backlog->page_pos + n];
+        n++;
+    }
+    if (backlog->flash_pages != 0) {
+        return n;                                   /* RAM samples are newer than the next flash page */
+    }
+    while ((n < max) && (k < backlog->ram_count)) {
+        samples[n++] = backlog->ram[(backlog->ram_head + k) % SAMPLE_BACKLOG_RAM_SAMPLES];
+        k++;
+    }
+    return n;
+}
+
+void sample_backlog_pop(sample_backlog_t *backlog, uint16_t count)
+{
+    uint16_t k;
+
+    k = (uint16_t)(backlog->page_count - backlog->page_pos);
+    if (k > count) {
+        k = count;
+    }
+    backlog->page_pos = (uint8_t)(backlog->page_pos + k);
+    count = (uint16_t)(count - k);
+    backlog->stats.drained += k;
+
+    if ((count != 0) && (backlog->flash_pages == 0)) {
+        if (count > backlog->ram_count) {
+            count = backlog->ram_count;
+        }
+        backlog->ram_head = (uint16_t)((backlog->ram_head + count) % SAMPLE_BACKLOG_RAM_SAMPLES);
+        backlog->ram_count = (uint16_t)(backlog->ram_count - count);
+        backlog->stats.drained += count;
+    }
+}
+
+uint32_t sample_backlog_depth(const sample_backlog_t *backlog)
+{
+    return (uint32_t)(backlog->page_count - backlog->page_pos) +
+           backlog->flash_pages * SAMPLE_BACKLOG_PAGE_SAMPLES + backlog->ram_count;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file      sample_codec.c
+ * @brief     Delta-of-delta / zigzag varint codec for timestamped raw sample streams
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "sample_codec.h"
+#include <string.h>
+
+/**
+ * @brief per-sensor predictor state inside one block
+ */
+typedef struct sample_codec_state_s
+{
+    uint8_t valid;                                  /**< bit per sensor seen in this block */
+    uint32_t time_ms[SAMPLE_CODEC_MAX_SENSORS];     /**< last timestamp */
+    uint32_t delta_ms[SAMPLE_CODEC_MAX_SENSORS];    /**< last sampling interval */
+    int16_t raw[SAMPLE_CODEC_MAX_SENSORS];          /**< last reading */
+} sample_codec_state_t;
+
+static uint32_t a_zigzag(int32_t v)
+{
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static int32_t a_unzigzag(uint32_t v)
+{
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+static uint8_t a_put_varint(uint8_t *p, uint32_t v)
+{
+    uint8_t n = 0;
+
+    while (v >= 0x80) {
+        p[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+static uint8_t a_get_varint(const uint8_t *p, uint16_t avail, uint32_t *v)
+{
+    uint8_t n = 0;
+    uint32_t r = 0;
+
+    while ((n < avail) && (n < 5)) {
+        r |= (uint32_t)(p[n] & 0x7F) << (7 * n);
+        if ((p[n++] & 0x80) == 0) {
+            *v = r;
+            return n;
+        }
+    }
+    return 0;                                       /* truncated or longer than 32 bits */
+}
+
+uint8_t sample_codec_encode_block(const radio_sample_t *samples, uint8_t count,
+                                  uint8_t *out, uint16_t max, uint16_t *len, uint8_t *encoded)
+{
+    sample_codec_state_t st;
+    uint8_t tmp[SAMPLE_CODEC_MAX_ENCODED];
+    uint8_t n = 0;
+    uint8_t k;
+    uint8_t s;
+    uint8_t same;
+    uint16_t pos;
+    uint32_t base;
+    uint32_t dt;
+    int32_t dod;
+    int32_t draw;
+
+    if ((samples == NULL) || (out == NULL) || (len == NULL) || (encoded == NULL) ||
+        (count == 0) || (max < SAMPLE_CODEC_BLOCK_HEADER)) {
+        return 1;
+    }
+
+    base = samples[0].time_ms;
+    out[0] = (uint8_t)base;
+    out[1] = (uint8_t)(base >> 8);
+    out[2] = (uint8_t)(base >> 16);
+    out[3] = (uint8_t)(base >> 24);
+    pos = SAMPLE_CODEC_BLOCK_HEADER;
+    st.valid = 0;
+
+    while (n < count) {
+        s = samples[n].sensor;
+        if (s >= SAMPLE_CODEC_MAX_SENSORS) {
+            break;
+        }
+        if ((st.valid & (1U << s)) == 0) {
+            dt = samples[n].time_ms - base;         /* keyframe for this sensor */
+            draw = samples[n].raw;
+            same = 0;
+        } else {
+            dt = samples[n].time_ms - st.time_ms[s];
+            draw = (int32_t)samples[n].raw - st.raw[s];
+            same = (draw == 0) ? 1 : 0;
+        }
+        dod = (int32_t)(((st.valid & (1U << s)) == 0) ? dt : dt - st.delta_ms[s]);
+        if ((dod >= (1 << 27)) || (dod < -(1 << 27))) {
+            break;                                  /* does not fit the 28-bit field, start a new block */
+        }
+        k = a_put_varint(tmp, (a_zigzag(dod) << 4) | ((uint32_t)same << 3) | s);
+        if (same == 0) {
+            k += a_put_varint(&tmp[k], a_zigzag(draw));
+        }
+        if ((uint16_t)(pos + k) > max) {
+            break;
+        }
+        memcpy(&out[pos], tmp, k);
+        pos += k;
+
+        st.delta_ms[s] = ((st.valid & (1U << s)) == 0) ? 0 : dt;
+        st.time_ms[s] = samples[n].time_ms;
+        st.raw[s] = samples[n].raw;
+        st.valid |= (uint8_t)(1U << s);
+        n++;
+    }
+    if (n == 0) {
+        return 1;
+    }
+
+    *len = pos;
+    *encoded = n;
+    return 0;
+}
+
+uint8_t sample_codec_decode_block(const uint8_t *in, uint16_t len,
+                                  radio_sample_t *samples, uint8_t max, uint8_t *count)
+{
+    sample_codec_state_t st;
+    uint8_t n = 0;
+    uint8_t k;
+    uint8_t s;
+    uint16_t pos;
+    uint32_t base;
+    uint32_t v;
+    uint32_t dt;
+    int32_t raw;
+
+    if ((in == NULL) || (samples == NULL) || (count == NULL) || (len < SAMPLE_CODEC_BLOCK_HEADER)) {
+        return 1;
+    }
+
+    base = (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+    pos = SAMPLE_CODEC_BLOCK_HEADER;
+    st.valid = 0;
+
+    while (pos < len) {
+        if (n >= max) {
+            return 1;
+        }
+        k = a_get_varint(&in[pos], (uint16_t)(len - pos), &v);
+        if (k == 0) {
+            return 1;
+        }
+        pos += k;
+        s = (uint8_t)(v & 0x07);
+        dt = (uint32_t)a_unzigzag(v >> 4);
+
+        if ((st.valid & (1U << s)) == 0) {
+            if ((v & 0x08) != 0) {
+                return 1;                           /* keyframe must carry an absolute value */
+            }
+            samples[n].time_ms = base + dt;
+            st.delta_ms[s] = 0;
+        } else {
+            dt += st.delta_ms[s];
+            samples[n].time_ms = st.time_ms[s] + dt;
+            st.delta_ms[s] = dt;
+        }
+
+        if ((v & 0x08) != 0) {
+            raw = st.raw[s];
+        } else {
+            k = a_get_varint(&in[pos], (uint16_t)(len - pos), &v);
+            if (k == 0) {
+                return 1;
+            }
+            pos += k;
+            raw = a_unzigzag(v);
+            if ((st.valid & (1U << s)) != 0) {
+                raw += st.raw[s];
+            }
+        }
+
+        samples[n].raw = (int16_t)raw;
+        samples[n].sensor = s;
+        st.time_ms[s] = samples[n].time_ms;
+        st.raw[s] = (int16_t)raw;
+        st.valid |= (uint8_t)(1U << s);
+        n++;
+    }
+
+    *count = n;
+    return 0;
+}
@@ -0,0 +1,801 @@
+/**
+ * @file      sensor_node.c
+ * @brief     Sensor node firmware: DS18B20 sampling with batched nRF24L01+ uplink
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "pico/stdio/driver.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "driver_ds18b20_dual.h"
+#include "radio_protocol.h"
+#include "report_policy.h"
+#include "tdma.h"
+#include "timesync.h"
+#include "sample_backlog.h"
+#include "flash_log.h"
+#include "usb_frame.h"
+#include "power.h"
+#include "clock_gov.h"
+#include "rtos_stats.h"
+#include "ow_trace.h"
+#include "dlog.h"
+
+#define TEMP_TASK_STACK    2048
+#define TEMP_TASK_PRIO     (tskIDLE_PRIORITY + 1)
+#define RADIO_TASK_STACK   1024
+#define RADIO_TASK_PRIO    (tskIDLE_PRIORITY + 2)
+#define LOG_TASK_STACK     1024
+#define LOG_TASK_PRIO      (tskIDLE_PRIORITY + 1)
+
+/* 1-Wire sampling runs on core 0; flash programming is started from core 1 */
+#define SAMPLE_CORE_MASK   (1 << 0)
+#define LOG_CORE_MASK      (1 << 1)
+
+/* Node address on the uplink (override with -DSENSOR_NODE_ID=N) */
+#ifndef SENSOR_NODE_ID
+#define SENSOR_NODE_ID     1
+#endif
+
+
+/* Sampling period; both cores sleep in WFI between cycles */
+#ifndef SENSOR_NODE_SAMPLE_MS
+#define SENSOR_NODE_SAMPLE_MS  5000
+#endif
+/* Longest time a sample waits for its burst to fill up */
+#ifndef SENSOR_NODE_FLUSH_MS
+#define SENSOR_NODE_FLUSH_MS  10000
+#endif
+
+/* Transmit in the slot assigned by the base station beacon (0: transmit at once) */
+#ifndef SENSOR_NODE_TDMA
+#define SENSOR_NODE_TDMA      1
+#endif
+
+/* Beacon queued at the base to RX interrupt here: SPI write, TX settling, air time */
+#ifndef SENSOR_NODE_SYNC_LATENCY_US
+#define SENSOR_NODE_SYNC_LATENCY_US  350
+#endif
+
+/* Bursts between two status lines on stdio */
+#ifndef SENSOR_NODE_REPORT_BURSTS
+#define SENSOR_NODE_REPORT_BURSTS    32
+#endif
+
+/* Beacons listened for per flush while joining before the samples go to the backlog */
+#define SENSOR_NODE_JOIN_TRIES     3
+
+/* Store-and-forward: unacknowledged samples wait in a RAM ring that spills to
+   flash (0 keeps the backlog in RAM only); once ACKs resume the backlog is
+   drained at most once per SENSOR_NODE_BACKLOG_MS, behind live samples */
+#ifndef SENSOR_NODE_BACKLOG_FLASH
+#define SENSOR_NODE_BACKLOG_FLASH  1
+#endif
+#ifndef SENSOR_NODE_BACKLOG_MS
+#define SENSOR_NODE_BACKLOG_MS     1000
+#endif
+
+/* Period of the per-task CPU and stack report on the console */
+#ifndef SENSOR_NODE_TASK_STATS_MS
+#define SENSOR_NODE_TASK_STATS_MS  60000
+#endif
+
+/* Keep every reading in the flash sample log (0 disables the log task) */
+#ifndef SENSOR_NODE_FLASH_LOG
+#define SENSOR_NODE_FLASH_LOG      1
+#endif
+#define LOG_QUEUE_LEN              (16 * DS18B20_DUAL_MAX_SENSORS)   /* 16 sampling cycles */
+
+/* Send-on-delta: report a reading only when it moves more than the deadband
+   (raw LSB, 1/16 degC at 12 bit) or the heartbeat expires; heartbeat 0 reports all */
+#ifndef SENSOR_NODE_DEADBAND_RAW
+#define SENSOR_NODE_DEADBAND_RAW   1
+#endif
+#ifndef SENSOR_NODE_HEARTBEAT_MS
+#define SENSOR_NODE_HEARTBEAT_MS   60000
+#endif
+
+/* Delta-compressed payloads (0 selects the fixed 4-byte sample format) */
+#ifndef SENSOR_NODE_PACKED
+#define SENSOR_NODE_PACKED    1
+#endif
+
+/** Samples carried by one full burst */
+#if SENSOR_NODE_PACKED
+#define SENSOR_NODE_BURST_SAMPLES  (RADIO_TX_BURST_MAX * RADIO_PROTOCOL_MAX_PACKED)
+#define SENSOR_NODE_PACK           radio_protocol_pack_samples_packed
+#else
+#define SENSOR_NODE_BURST_SAMPLES  (RADIO_TX_BURST_MAX * RADIO_PROTOCOL_MAX_SAMPLES)
+#define SENSOR_NODE_PACK           radio_protocol_pack_samples
+#endif
+
+#define SAMPLE_QUEUE_LEN   (2 * SENSOR_NODE_BURST_SAMPLES)
+
+static const radio_ops_t *const gs_radio = &gc_radio_nrf24l01_ops;
+static QueueHandle_t gs_sample_queue;
+static report_policy_t gs_policy;
+static tdma_node_t gs_tdma;
+static timesync_t gs_sync;                  /* written by radio_task, read by temperature_task */
+static sample_backlog_t gs_backlog;         /* radio_task only */
+static SemaphoreHandle_t gs_bus_lock;       /* 1-Wire transaction vs. flash erase/program */
+static uint8_t gs_link_up = 1;              /* last burst fully acknowledged */
+static QueueHandle_t gs_log_queue;
+static flash_log_t gs_log;                  /* log_task only */
+static uint32_t gs_log_overflows;
+
+/* Kernel objects, all static: sizes follow from the sensor count and burst size at compile time */
+static StaticSemaphore_t gs_bus_lock_buf;
+static StaticQueue_t gs_sample_queue_buf;
+static radio_sample_t gs_sample_queue_items[SAMPLE_QUEUE_LEN];
+static StaticTask_t gs_temp_tcb;
+static StackType_t gs_temp_stack[TEMP_TASK_STACK];
+static StaticTask_t gs_radio_tcb;
+static StackType_t gs_radio_stack[RADIO_TASK_STACK];
+#if SENSOR_NODE_FLASH_LOG
+static StaticQueue_t gs_log_queue_buf;
+static radio_sample_t gs_log_queue_items[LOG_QUEUE_LEN];
+static StaticTask_t gs_log_tcb;
+static StackType_t gs_log_stack[LOG_TASK_STACK];
+#endif
+
+/**
+ * @brief Uplink counters
+ */
+static struct {
+    uint32_t bursts;          /**< send_burst calls */
+    uint32_t frames_sent;     /**< acknowledged payloads */
+    uint32_t samples_sent;    /**< samples in acknowledged payloads */
+    uint32_t samples_lost;    /**< samples dropped before reaching a payload or the backlog */
+    uint32_t beacon_misses;   /**< flushes that heard no beacon and sent unscheduled */
+    uint32_t joins;           /**< join requests sent */
+    uint32_t join_holds;      /**< flushes held back in the backlog while joining */
+    uint32_t backlog_frames;  /**< acknowledged payloads carrying backlog samples */
+    uint32_t backlog_samples; /**< backlog samples delivered */
+} gs_stats;
+
+static void bus_lock(void)
+{
+    (void)xSemaphoreTake(gs_bus_lock, portMAX_DELAY);
+}
+
+static void bus_unlock(void)
+{
+    (void)xSemaphoreGive(gs_bus_lock);
+}
+
+/** Backlog spill partition; erase/program wait until no 1-Wire transaction is running */
+static const flash_region_t gc_backlog_region = {
+    .offset = FLASH_REGION_BACKLOG_OFFSET,
+    .size   = FLASH_REGION_BACKLOG_SIZE,
+    .lock   = bus_lock,
+    .unlock = bus_unlock,
+};
+
+/** Sample log partition, same rule */
+static const flash_region_t gc_log_region = {
+    .offset = FLASH_REGION_LOG_OFFSET,
+    .size   = FLASH_REGION_LOG_SIZE,
+    .lock   = bus_lock,
+    .unlock = bus_unlock,
+};
+
+/**
+ * @brief Local milliseconds since boot; samples carry these until they are packed or logged
+ */
+static uint32_t local_ms(void)
+{
+    return (uint32_t)(time_us_64() / 1000);
+}
+
+/**
+ * @brief      Convert a local sample time to network milliseconds with the current sync model
+ * @param[in]  ms    Time from local_ms(), less than 49 days old
+ * @param[out] epoch Timebase the result is on, changes on the first beacon and on every model step; may be NULL
+ * @return     Network time, local time until the first beacon
+ *
+ * Converting late keeps every sample on one timebase: samples taken before the
+ * first beacon or before a model step come out in the same time scale as the
+ * ones after it, so a packed block never steps backwards.
+ */
+static uint32_t to_network_ms(uint32_t ms, uint32_t *epoch)
+{
+    uint64_t now_us = time_us_64();
+    uint64_t us = now_us - (uint64_t)((uint32_t)(now_us / 1000) - ms) * 1000;
+
+    taskENTER_CRITICAL();
+    us = timesync_to_network(&gs_sync, us);
+    if (epoch != NULL) {
+        *epoch = gs_sync.synced ? gs_sync.steps + 1 : 0;
+    }
+    taskEXIT_CRITICAL();
+    return (uint32_t)(us / 1000);
+}
+
+/**
+ * @brief         Print the awake share of both cores since a snapshot
+ * @param[in,out] prev Snapshot at the start of the window, replaced by the current one
+ */
+static void print_power(power_stats_t *prev)
+{
+    power_stats_t now;
+    uint16_t awake[POWER_CORES];
+
+    power_get_stats(&now);
+    for (uint8_t i = 0; i < POWER_CORES; ++i) {
+        awake[i] = power_awake_permille(&now, prev, i);
+    }
+    printf("power: awake core0 %u.%u%% core1 %u.%u%%, wakeups %lu/%lu\r\n",
+           awake[0] / 10, awake[0] % 10, awake[1] / 10, awake[1] % 10,
+           (unsigned long)(now.wakeups[0] - prev->wakeups[0]),
+           (unsigned long)(now.wakeups[1] - prev->wakeups[1]));
+    *prev = now;
+}
+
+/**
+ * @brief Print the governor's time per clock level and, in measurement mode, the frequency checks
+ */
+static void print_clock(void)
+{
+    clock_gov_stats_t st;
+    uint64_t total;
+    uint32_t low;
+
+    clock_gov_get_stats(&st);
+    total = st.level_us[CLOCK_GOV_FULL] + st.level_us[CLOCK_GOV_LOW];
+    low = (total == 0) ? 0 : (uint32_t)((st.level_us[CLOCK_GOV_LOW] * 1000) / total);
+    printf("clock: low %lu.%lu%%, %lu switches (max %lu us), %lu errors, checks %lu failed %lu last %lu kHz\r\n",
+           (unsigned long)(low / 10), (unsigned long)(low % 10), (unsigned long)st.transitions,
+           (unsigned long)st.max_switch_us, (unsigned long)st.errors, (unsigned long)st.checks,
+           (unsigned long)st.check_errors, (unsigned long)st.last_khz);
+}
+
+/**
+ * @brief Reads the sensors and queues the fresh samples stamped in network time
+ */
+static void temperature_task(void *params)
+{
+    int16_t raw[DS18B20_DUAL_MAX_SENSORS];
+    float temps[DS18B20_DUAL_MAX_SENSORS];
+    uint8_t status[DS18B20_DUAL_MAX_SENSORS];
+    radio_sample_t sample;
+    TickType_t wake;
+
+    ds18b20_dual_set_bus_lock(bus_lock, bus_unlock);   /* flash work may run during the conversion sleep */
+    if (ds18b20_dual_init() != 0) {
+        printf("ds18b20_dual: init failed\r\n");
+        vTaskDelete(NULL);
+    }
+    report_policy_init(&gs_policy, SENSOR_NODE_DEADBAND_RAW, SENSOR_NODE_HEARTBEAT_MS);
+    wake = xTaskGetTickCount();
+
+    for (;;) {
+        (void)clock_gov_set(CLOCK_GOV_LOW);
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(SENSOR_NODE_SAMPLE_MS));
+        (void)clock_gov_set(CLOCK_GOV_FULL);
+        (void)ds18b20_dual_read_status(raw, temps, status);   /* failures and quarantines go to dlog */
+        sample.time_ms = local_ms();                    /* converted when packed or logged */
+        for (uint8_t i = 0; i < DS18B20_DUAL_MAX_SENSORS; ++i) {
+            if (status[i] != DS18B20_DUAL_OK) {
+                continue;
+            }
+            sample.sensor = i;
+            sample.raw = raw[i];
+            if ((gs_log_queue != NULL) && (xQueueSend(gs_log_queue, &sample, 0) != pdPASS)) {
+                gs_log_overflows++;                     /* log task fell behind */
+            }
+            if (report_policy_check(&gs_policy, &sample) == 0) {
+                continue;                               /* within deadband, base keeps the held value */
+            }
+            if (xQueueSend(gs_sample_queue, &sample, 0) != pdPASS) {
+                gs_stats.samples_lost++;                /* radio task fell behind, retried next cycle */
+                continue;
+            }
+            report_policy_commit(&gs_policy, &sample);
+        }
+    }
+}
+
+/**
+ * @brief      Listen for the next beacon
+ * @param[out] beacon_tick Tick the beacon arrived
+ * @return     0 on a beacon, 1 if none arrived within two frame periods
+ */
+static uint8_t tdma_wait_beacon(TickType_t *beacon_tick)
+{
+    radio_frame_t frame;
+    uint64_t irq_us = 0;
+    TickType_t start = xTaskGetTickCount();
+    TickType_t limit = pdMS_TO_TICKS(2 * TDMA_FRAME_MS);
+    TickType_t elapsed;
+    uint8_t res = 1;
+
+    if (gs_radio->listen() != 0) {
+        return 1;
+    }
+    while (res != 0) {
+        elapsed = xTaskGetTickCount() - start;
+        if ((elapsed >= limit) || (gs_radio->wait((uint32_t)((limit - elapsed) * portTICK_PERIOD_MS)) != 0)) {
+            break;
+        }
+        *beacon_tick = xTaskGetTickCount();
+        (void)gs_radio->irq_time(&irq_us);
+        while (gs_radio->receive(&frame) == 0) {
+            if (tdma_node_on_beacon(&gs_tdma, &frame) == 0) {
+                taskENTER_CRITICAL();
+                timesync_update(&gs_sync, irq_us, gs_tdma.time_us + SENSOR_NODE_SYNC_LATENCY_US);
+                taskEXIT_CRITICAL();
+                res = 0;
+            }
+        }
+    }
+    (void)gs_radio->sleep();
+    return res;
+}
+
+/**
+ * @brief  Block until the own TDMA slot starts, joining first if needed
+ * @return 0 to send now, 1 to hold the burst: beacons are heard but no slot is assigned yet
+ *
+ * Without a beacon (no TDMA base station in range) the burst goes out at once.
+ * A node still joining does not send unscheduled, which would jam the join
+ * slot for every other node joining.
+ */
+static uint8_t tdma_wait_slot(void)
+{
+#if SENSOR_NODE_TDMA
+    radio_frame_t join;
+    TickType_t beacon_tick;
+    uint8_t sent;
+
+    for (uint8_t i = 0; i < SENSOR_NODE_JOIN_TRIES; ++i) {
+        if (tdma_wait_beacon(&beacon_tick) != 0) {
+            gs_stats.beacon_misses++;
+            return 0;
+        }
+        if (gs_tdma.slot != TDMA_SLOT_NONE) {
+            vTaskDelayUntil(&beacon_tick, pdMS_TO_TICKS(tdma_node_slot_offset_ms(&gs_tdma, gs_tdma.slot)));
+            (void)gs_radio->set_uplink(tdma_slot_pipe(gs_tdma.slot));
+            return 0;
+        }
+        if (tdma_node_join_due(&gs_tdma) == 0) {
+            continue;                                   /* backing off */
+        }
+
+        /* contend in the join slot, spread over it by node id and frame */
+        vTaskDelayUntil(&beacon_tick, pdMS_TO_TICKS(tdma_node_slot_offset_ms(&gs_tdma, 0) +
+                                                    tdma_node_join_offset(&gs_tdma, 4) * gs_tdma.slot_ms / 4));
+        tdma_node_join(&gs_tdma, &join);
+        (void)gs_radio->set_uplink(tdma_slot_pipe(0));
+        (void)gs_radio->send_burst(&join, 1, &sent);
+        gs_stats.joins++;
+    }
+    gs_stats.join_holds++;
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief      Pack pending samples, then backlog samples into free FIFO entries, and send them in one burst
+ * @param[in]  pending Samples in time order
+ * @param[in]  count   Number of pending samples
+ * @param[in]  seq     Payload sequence counter, advanced per payload
+ * @return     Number of pending samples consumed (sent, moved to the backlog or dropped)
+ *
+ * Live samples always take the first payloads, so draining the backlog never
+ * delays them. Live samples of payloads that were not acknowledged go to the
+ * backlog; backlog samples are removed only once acknowledged.
+ */
+static uint8_t radio_flush(const radio_sample_t *pending, uint8_t count, uint16_t *seq)
+{
+    static radio_sample_t live[SENSOR_NODE_BURST_SAMPLES];
+    radio_frame_t frames[RADIO_TX_BURST_MAX];
+    radio_sample_t backlog[SENSOR_NODE_BURST_SAMPLES];
+    uint8_t samples[RADIO_TX_BURST_MAX];
+    uint8_t first[RADIO_TX_BURST_MAX];
+    uint8_t nlive;
+    uint8_t nframes = 0;
+    uint8_t used = 0;
+    uint8_t sent = 0;
+    uint8_t packed;
+    uint16_t navail = 0;
+    uint16_t bused = 0;
+    uint16_t backed = 0;
+
+    if ((count == 0) && !(gs_link_up && (sample_backlog_depth(&gs_backlog) != 0))) {
+        return 0;
+    }
+    /* The slot wait may bring the first beacon; convert to network time only after it */
+    if (tdma_wait_slot() != 0) {
+        for (uint8_t i = 0; i < count; ++i) {
+            sample_backlog_push(&gs_backlog, &pending[i]);     /* local time, sent once admitted */
+        }
+        gs_link_up = 0;
+        return count;
+    }
+    for (uint8_t i = 0; i < count; ++i) {
+        live[i] = pending[i];
+        live[i].time_ms = to_network_ms(pending[i].time_ms, NULL);
+    }
+
+    while ((used < count) && (nframes < RADIO_TX_BURST_MAX)) {
+        if (SENSOR_NODE_PACK(SENSOR_NODE_ID, *seq, &live[used], (uint8_t)(count - used),
+                             &frames[nframes], &packed) != 0) {
+            used++;                                     /* unpackable sample, drop it */
+            gs_stats.samples_lost++;
+            continue;
+        }
+        first[nframes] = used;
+        samples[nframes] = packed;
+        used += packed;
+        (*seq)++;
+        nframes++;
+    }
+    nlive = nframes;
+
+    if (gs_link_up && (nframes < RADIO_TX_BURST_MAX) && (sample_backlog_depth(&gs_backlog) != 0)) {
+        navail = sample_backlog_peek(&gs_backlog, backlog,
+                                     (uint16_t)((RADIO_TX_BURST_MAX - nframes) * (SENSOR_NODE_BURST_SAMPLES / RADIO_TX_BURST_MAX)));
+    }
+    for (uint16_t i = 0; i < navail; ++i) {
+        backlog[i].time_ms = to_network_ms(backlog[i].time_ms, NULL);
+    }
+    while ((bused < navail) && (nframes < RADIO_TX_BURST_MAX)) {
+        if (SENSOR_NODE_PACK(SENSOR_NODE_ID, *seq, &backlog[bused], (uint8_t)(navail - bused),
+                             &frames[nframes], &packed) != 0) {
+            break;
+        }
+        samples[nframes] = packed;
+        bused += packed;
+        (*seq)++;
+        nframes++;
+    }
+    if (nframes == 0) {
+        return used;
+    }
+
+    gs_stats.bursts++;
+    if (gs_radio->send_burst(frames, nframes, &sent) != 0) {
+        printf("radio: burst failed\r\n");
+    }
+    (void)gs_radio->sleep();
+    gs_link_up = (sent == nframes) ? 1 : 0;
+
+    for (uint8_t i = 0; i < nframes; ++i) {
+        if (i < sent) {
+            gs_stats.frames_sent++;
+            gs_stats.samples_sent += samples[i];
+            if (i >= nlive) {
+                gs_stats.backlog_frames++;
+                gs_stats.backlog_samples += samples[i];
+                backed += samples[i];
+            }
+        }
+    }
+    sample_backlog_pop(&gs_backlog, backed);
+    for (uint8_t i = sent; i < nlive; ++i) {
+        for (uint8_t k = 0; k < samples[i]; ++k) {
+            sample_backlog_push(&gs_backlog, &pending[first[i] + k]);   /* local time, retried once the link is back */
+        }
+    }
+    return used;
+}
+
+/**
+ * @brief     Ticks from now until a deadline, 0 once it has passed
+ */
+static TickType_t ticks_until(TickType_t deadline, TickType_t now)
+{
+    return ((int32_t)(deadline - now) > 0) ? (TickType_t)(deadline - now) : 0;
+}
+
+/**
+ * @brief Collects samples until a full burst is ready or the oldest one is SENSOR_NODE_FLUSH_MS old,
+ *        and drains the backlog every SENSOR_NODE_BACKLOG_MS while the link is up
+ */
+static void radio_task(void *params)
+{
+    radio_sample_t pending[SENSOR_NODE_BURST_SAMPLES];
+    uint8_t count = 0;
+    uint8_t used;
+    uint16_t seq = 0;
+    uint32_t reported = 0;                              /* bursts at the last status print */
+    TickType_t deadline = 0;
+    TickType_t last_burst = 0;
+    TickType_t wait;
+    TickType_t now;
+    power_stats_t power_prev;
+
+    if (gs_radio->init(RADIO_ROLE_NODE) != 0) {
+        printf("radio: init failed\r\n");
+        vTaskDelete(NULL);
+    }
+    tdma_node_init(&gs_tdma, SENSOR_NODE_ID);
+    power_get_stats(&power_prev);
+    printf("radio: node %d ready\r\n", SENSOR_NODE_ID);
+
+    for (;;) {
+        now = xTaskGetTickCount();
+        wait = (count == 0) ? portMAX_DELAY : ticks_until(deadline, now);
+        if (gs_link_up && (sample_backlog_depth(&gs_backlog) != 0) &&
+            (ticks_until(last_burst + pdMS_TO_TICKS(SENSOR_NODE_BACKLOG_MS), now) < wait)) {
+            wait = ticks_until(last_burst + pdMS_TO_TICKS(SENSOR_NODE_BACKLOG_MS), now);
+        }
+
+        if ((wait != 0) && (xQueueReceive(gs_sample_queue, &pending[count], wait) == pdPASS)) {
+            if (count == 0) {
+                deadline = xTaskGetTickCount() + pdMS_TO_TICKS(SENSOR_NODE_FLUSH_MS);
+            }
+            count++;
+            if (count < SENSOR_NODE_BURST_SAMPLES) {
+                continue;
+            }
+        }
+
+        used = radio_flush(pending, count, &seq);
+        last_burst = xTaskGetTickCount();
+        /* once per SENSOR_NODE_REPORT_BURSTS: a pass that sent nothing must not print again */
+        if ((gs_stats.bursts / SENSOR_NODE_REPORT_BURSTS) != (reported / SENSOR_NODE_REPORT_BURSTS)) {
+            reported = gs_stats.bursts;
+            printf("radio: sent %lu lost %lu suppressed %lu, sync err %ld us max %lu us drift %ld ppb\r\n",
+                   (unsigned long)gs_stats.samples_sent, (unsigned long)gs_stats.samples_lost,
+                   (unsigned long)gs_policy.suppressed, (long)gs_sync.error_us,
+                   (unsigned long)gs_sync.max_error_us, (long)gs_sync.drift_ppb);
+            printf("backlog: depth %lu drained %lu in %lu frames, spilled %lu pages, dropped %lu\r\n",
+                   (unsigned long)sample_backlog_depth(&gs_backlog), (unsigned long)gs_stats.backlog_samples,
+                   (unsigned long)gs_stats.backlog_frames, (unsigned long)gs_backlog.stats.spilled,
+                   (unsigned long)gs_backlog.stats.dropped);
+            print_power(&power_prev);
+        }
+        for (uint8_t i = used; i < count; ++i) {
+            pending[i - used] = pending[i];             /* keep what did not fit this burst */
+        }
+        count = (uint8_t)(count - used);
+        deadline = xTaskGetTickCount() + pdMS_TO_TICKS(SENSOR_NODE_FLUSH_MS);
+    }
+}
+
+/**
+ * @brief Start a binary stream: take the USB driver out of stdio until usb_binary_end()
+ *
+ * Other tasks keep printing while a dump runs; with the driver out of stdio their
+ * text is dropped instead of landing inside a frame. Frames go to the driver
+ * directly, so no CR/LF translation applies to them either.
+ */
+static void usb_binary_begin(void)
+{
+    fflush(stdout);
+    stdio_set_driver_enabled(&stdio_usb, false);
+}
+
+/**
+ * @brief Write one finished frame of a binary stream
+ */
+static void usb_binary_write(const usb_frame_t *frame, uint16_t n)
+{
+    stdio_usb.out_chars((const char *)frame->buf, n);
+}
+
+/**
+ * @brief End a binary stream and give the USB driver back to stdio
+ */
+static void usb_binary_end(void)
+{
+    if (stdio_usb.out_flush != NULL) {
+        stdio_usb.out_flush();
+    }
+    stdio_set_driver_enabled(&stdio_usb, true);
+}
+
+/**
+ * @brief     Write the whole sample log to USB as USB_FRAME_LOG_PAGE frames, oldest page first
+ */
+static void log_dump(void)
+{
+    static usb_frame_t frame;
+    uint8_t page[FLASH_REGION_PAGE_SIZE];
+    uint8_t seq = 0;
+    uint16_t n;
+
+    (void)flash_log_flush(&gs_log);
+    usb_binary_begin();
+    for (uint32_t i = 0; i < flash_log_pages(&gs_log); ++i) {
+        if (flash_log_read_page(&gs_log, i, page) != 0) {
+            continue;                                   /* torn or failed page */
+        }
+        usb_frame_begin(&frame, USB_FRAME_LOG_PAGE);
+        (void)usb_frame_append(&frame, page, sizeof(page));
+        n = usb_frame_finish(&frame, seq++);
+        usb_binary_write(&frame, n);
+    }
+    usb_frame_begin(&frame, USB_FRAME_LOG_PAGE);
+    n = usb_frame_finish(&frame, seq);
+    usb_binary_write(&frame, n);
+    usb_binary_end();
+}
+
+/**
+ * @brief     Write a USB_FRAME_TASK_STATS frame covering the time since boot
+ */
+static void task_stats_dump(void)
+{
+    static usb_frame_t frame;
+    static rtos_stats_t now;
+    static const rtos_stats_t boot;
+    uint16_t n;
+
+    if (rtos_stats_snapshot(&now) != 0) {
+        return;
+    }
+    usb_frame_begin(&frame, USB_FRAME_TASK_STATS);
+    (void)rtos_stats_append(&frame, &now, &boot);
+    n = usb_frame_finish(&frame, 0);
+    usb_binary_begin();
+    usb_binary_write(&frame, n);
+    usb_binary_end();
+}
+
+#if OW_TRACE_ENABLE
+/**
+ * @brief     Write the 1-Wire events recorded since the last dump as USB_FRAME_OW_TRACE frames
+ */
+static void ow_trace_dump(void)
+{
+    static usb_frame_t frame;
+    static ow_trace_event_t events[(USB_FRAME_MAX_PAYLOAD - 4) / sizeof(ow_trace_event_t)];
+    static uint32_t lost;
+    uint8_t seq = 0;
+    uint16_t count;
+    uint16_t n;
+
+    usb_binary_begin();
+    do {
+        count = ow_trace_read(events, sizeof(events) / sizeof(events[0]), &lost);
+        usb_frame_begin(&frame, USB_FRAME_OW_TRACE);
+        (void)usb_frame_append(&frame, (const uint8_t *)&lost, sizeof(lost));
+        (void)usb_frame_append(&frame, (const uint8_t *)events, (uint16_t)(count * sizeof(ow_trace_event_t)));
+        n = usb_frame_finish(&frame, seq++);
+        usb_binary_write(&frame, n);
+    } while (count != 0);
+    usb_binary_end();
+}
+#endif
+
+/**
+ * @brief Stages readings into the flash log, reports task stats and serves the USB commands
+ *        ('D' dump, 'S' counters, 'T' binary task stats, 'O' 1-Wire trace)
+ *
+ * Runs on the other core than temperature_task; a page is programmed only every
+ * FLASH_LOG_STAGE_SAMPLES readings and never during a 1-Wire transaction.
+ */
+static void log_task(void *params)
+{
+    static rtos_stats_t stats_prev;
+    static rtos_stats_t stats_now;
+    radio_sample_t sample;
+    power_stats_t power_last;
+    TickType_t stats_at = xTaskGetTickCount() + pdMS_TO_TICKS(SENSOR_NODE_TASK_STATS_MS);
+    uint32_t epoch = 0;
+    uint32_t now_epoch;
+    int c;
+
+    if (flash_log_init(&gs_log, &gc_log_region) != 0) {
+        printf("flash_log: init failed\r\n");
+        vTaskDelete(NULL);
+    }
+    printf("flash_log: %lu pages\r\n", (unsigned long)flash_log_pages(&gs_log));
+    memset(&power_last, 0, sizeof(power_last));
+    rtos_stats_print_ram();
+
+    for (;;) {
+        if (xQueueReceive(gs_log_queue, &sample, pdMS_TO_TICKS(100)) == pdPASS) {
+            sample.time_ms = to_network_ms(sample.time_ms, &now_epoch);
+            if (now_epoch != epoch) {
+                (void)flash_log_flush(&gs_log);         /* staged samples are on the old timebase */
+                epoch = now_epoch;
+            }
+            (void)flash_log_append(&gs_log, &sample);
+        }
+        c = getchar_timeout_us(0);
+        if (c == 'D') {
+            log_dump();
+        } else if (c == 'S') {
+            printf("flash_log: %lu pages, %lu samples, %lu erases, %lu overwritten, %lu errors, %lu dropped, "
+                   "%lu overflows\r\n",
+                   (unsigned long)flash_log_pages(&gs_log), (unsigned long)gs_log.stats.samples,
+                   (unsigned long)gs_log.stats.erases, (unsigned long)gs_log.stats.overwritten,
+                   (unsigned long)gs_log.stats.errors, (unsigned long)gs_log.stats.dropped,
+                   (unsigned long)gs_log_overflows);
+            print_power(&power_last);
+            print_clock();
+            ds18b20_dual_print_timing();
+            ds18b20_dual_print_health();
+            rtos_stats_print_ram();
+        } else if (c == 'T') {
+            task_stats_dump();
+#if OW_TRACE_ENABLE
+        } else if (c == 'O') {
+            ow_trace_dump();
+#endif
+        }
+        if ((int32_t)(xTaskGetTickCount() - stats_at) >= 0) {
+            if (rtos_stats_snapshot(&stats_now) == 0) {
+                rtos_stats_print(&stats_now, &stats_prev);
+                stats_prev = stats_now;
+            }
+            stats_at += pdMS_TO_TICKS(SENSOR_NODE_TASK_STATS_MS);
+        }
+    }
+}
+
+int main(void)
+{
+    /* Initialize stdio over USB/UART */
+    stdio_init_all();
+
+    /* Delay to allow console connection */
+    sleep_ms(5000);
+
+    if (clock_gov_init() != 0) {
+        printf("clock_gov: init failed, staying at full clock\r\n");
+    }
+    timesync_init(&gs_sync);
+#if SENSOR_NODE_BACKLOG_FLASH
+    sample_backlog_init(&gs_backlog, &gc_backlog_region);
+#else
+    sample_backlog_init(&gs_backlog, NULL);
+#endif
+    gs_bus_lock = xSemaphoreCreateMutexStatic(&gs_bus_lock_buf);
+#if SENSOR_NODE_FLASH_LOG
+    gs_log_queue = xQueueCreateStatic(LOG_QUEUE_LEN, sizeof(radio_sample_t),
+                                      (uint8_t *)gs_log_queue_items, &gs_log_queue_buf);
+#endif
+    gs_sample_queue = xQueueCreateStatic(SAMPLE_QUEUE_LEN, sizeof(radio_sample_t),
+                                         (uint8_t *)gs_sample_queue_items, &gs_sample_queue_buf);
+
+    (void)xTaskCreateStaticAffinitySet(temperature_task, "temp_task", TEMP_TASK_STACK, NULL, TEMP_TASK_PRIO,
+                                       gs_temp_stack, &gs_temp_tcb, SAMPLE_CORE_MASK);
+    (void)xTaskCreateStatic(radio_task, "radio_task", RADIO_TASK_STACK, NULL, RADIO_TASK_PRIO,
+                            gs_radio_stack, &gs_radio_tcb);
+#if SENSOR_NODE_FLASH_LOG
+    (void)xTaskCreateStaticAffinitySet(log_task, "log_task", LOG_TASK_STACK, NULL, LOG_TASK_PRIO,
+                                       gs_log_stack, &gs_log_tcb, LOG_CORE_MASK);
+#endif
+    if (dlog_task_create(tskIDLE_PRIORITY + 1) != 0) {
+        printf("Failed to create dlog task\r\n");
+    }
+
+    /* Start the FreeRTOS scheduler */
+    vTaskStartScheduler();
+
+    /* Should never reach here */
+    for (;;) { tight_loop_contents(); }
+}
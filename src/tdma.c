@@ -0,0 +1,228 @@
+/**
+ * @file      tdma.c
+ * @brief     Beacon-driven TDMA slot allocation for sensor nodes sharing one channel
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tdma.h"
+#include <string.h>
+
+uint8_t tdma_slot_pipe(uint8_t slot)
+{
+    return (slot == 0) ? 1 : (uint8_t)(1 + (slot - 1) % 5);
+}
+
+void tdma_master_init(tdma_master_t *master)
+{
+    memset(master, 0, sizeof(*master));
+    master->cursor = 1;
+}
+
+/**
+ * @brief Slot owned by a node, TDMA_SLOT_NONE if it has none
+ */
+static uint8_t a_tdma_find(const tdma_master_t *master, uint8_t node_id)
+{
+    for (uint8_t s = 1; s < TDMA_SLOTS; ++s) {
+        if (master->used[s] && (master->owner[s] == node_id)) {
+            return s;
+        }
+    }
+    return TDMA_SLOT_NONE;
+}
+
+uint8_t tdma_master_join(tdma_master_t *master, uint8_t node_id)
+{
+    uint8_t free_slot = a_tdma_find(master, node_id);
+
+    if (free_slot != TDMA_SLOT_NONE) {
+        master->heard[free_slot] = master->frame;   /* rejoin after a reset or a missed beacon */
+        return free_slot;
+    }
+    for (uint8_t s = 1; s < TDMA_SLOTS; ++s) {
+        if (!master->used[s] && (free_slot == TDMA_SLOT_NONE)) {
+            free_slot = s;
+        }
+    }
+    if (free_slot == TDMA_SLOT_NONE) {
+        master->rejected++;
+        return TDMA_SLOT_NONE;
+    }
+    master->used[free_slot] = 1;
+    master->owner[free_slot] = node_id;
+    master->heard[free_slot] = master->frame;
+    master->joins++;
+    return free_slot;
+}
+
+uint8_t tdma_master_heard(tdma_master_t *master, uint8_t node_id)
+{
+    uint8_t s = a_tdma_find(master, node_id);
+
+    if (s == TDMA_SLOT_NONE) {
+        return 1;
+    }
+    master->heard[s] = master->frame;
+    return 0;
+}
+
+void tdma_master_beacon(tdma_master_t *master, uint64_t now_us, radio_frame_t *frame)
+{
+    uint8_t pairs = 0;
+    uint8_t s;
+
+    for (s = 1; s < TDMA_SLOTS; ++s) {
+        if (master->used[s] && ((uint16_t)(master->frame - master->heard[s]) >= TDMA_LEASE_FRAMES)) {
+            master->used[s] = 0;                    /* node gone or rebooted into another id */
+            master->expired++;
+        }
+    }
+    s = master->cursor;
+    frame->data[0] = RADIO_PACKET_BEACON;
+    frame->data[1] = TDMA_SLOTS;
+    frame->data[2] = (uint8_t)master->frame;
+    frame->data[3] = (uint8_t)(master->frame >> 8);
+    frame->data[4] = (uint8_t)TDMA_SLOT_MS;
+    frame->data[5] = (uint8_t)(TDMA_SLOT_MS >> 8);
+    for (uint8_t i = 0; i < 6; ++i) {
+        frame->data[6 + i] = (uint8_t)(now_us >> (8 * i));
+    }
+
+    for (uint8_t n = 1; (n < TDMA_SLOTS) && (pairs < TDMA_BEACON_PAIRS); ++n) {
+        if (master->used[s]) {
+            frame->data[TDMA_BEACON_HEADER + 2 * pairs] = master->owner[s];
+            frame->data[TDMA_BEACON_HEADER + 2 * pairs + 1] = s;
+            pairs++;
+        }
+        s = (uint8_t)((s + 1 < TDMA_SLOTS) ? s + 1 : 1);
+    }
+    master->cursor = s;
+    master->frame++;
+
+    frame->len = (uint8_t)(TDMA_BEACON_HEADER + 2 * pairs);
+    frame->pipe = 0;
+}
+
+uint8_t tdma_parse_join(const radio_frame_t *frame, uint8_t *node_id)
+{
+    if ((frame->len != TDMA_JOIN_SIZE) || (frame->data[0] != RADIO_PACKET_JOIN)) {
+        return 1;
+    }
+    *node_id = frame->data[1];
+    return 0;
+}
+
+void tdma_node_init(tdma_node_t *node, uint8_t node_id)
+{
+    memset(node, 0, sizeof(*node));
+    node->node_id = node_id;
+    node->slot = TDMA_SLOT_NONE;
+}
+
+uint8_t tdma_node_on_beacon(tdma_node_t *node, const radio_frame_t *frame)
+{
+    uint8_t pairs;
+
+    if ((frame->len < TDMA_BEACON_HEADER) || (frame->data[0] != RADIO_PACKET_BEACON) ||
+        (((frame->len - TDMA_BEACON_HEADER) & 1) != 0)) {
+        return 1;
+    }
+    node->slots = frame->data[1];
+    node->frame = (uint16_t)(frame->data[2] | ((uint16_t)frame->data[3] << 8));
+    node->slot_ms = (uint16_t)(frame->data[4] | ((uint16_t)frame->data[5] << 8));
+    node->time_us = 0;
+    for (uint8_t i = 0; i < 6; ++i) {
+        node->time_us |= (uint64_t)frame->data[6 + i] << (8 * i);
+    }
+
+    pairs = (uint8_t)((frame->len - TDMA_BEACON_HEADER) / 2);
+    if (node->missing < UINT8_MAX) {
+        node->missing++;
+    }
+    for (uint8_t i = 0; i < pairs; ++i) {
+        const uint8_t *p = &frame->data[TDMA_BEACON_HEADER + 2 * i];
+        if (p[0] == node->node_id) {
+            node->slot = p[1];
+            node->missing = 0;
+            node->join_wait = 0;
+            node->join_fails = 0;
+        } else if (p[1] == node->slot) {
+            node->slot = TDMA_SLOT_NONE;            /* our slot went to someone else, join again */
+        }
+    }
+    if (node->missing >= TDMA_NODE_MISSING) {
+        node->slot = TDMA_SLOT_NONE;                /* lease expired on the base, join again */
+    }
+    if ((node->slot != TDMA_SLOT_NONE) && (node->slot >= node->slots)) {
+        node->slot = TDMA_SLOT_NONE;                /* base shrank the frame */
+    }
+    return 0;
+}
+
+void tdma_node_join(const tdma_node_t *node, radio_frame_t *frame)
+{
+    frame->data[0] = RADIO_PACKET_JOIN;
+    frame->data[1] = node->node_id;
+    frame->len = TDMA_JOIN_SIZE;
+    frame->pipe = 0;
+}
+
+/**
+ * @brief Pseudo-random number per node and frame, the same on every call
+ */
+static uint32_t a_tdma_node_hash(const tdma_node_t *node, uint32_t salt)
+{
+    uint32_t h = (((uint32_t)node->node_id << 16) | node->frame) ^ salt;
+
+    h *= 0x9E3779B1u;
+    h ^= h >> 15;
+    h *= 0x85EBCA77u;
+    h ^= h >> 13;
+    return h;
+}
+
+uint8_t tdma_node_join_due(tdma_node_t *node)
+{
+    uint8_t order = (node->join_fails < TDMA_JOIN_BACKOFF_MAX) ? node->join_fails : TDMA_JOIN_BACKOFF_MAX;
+
+    if (node->join_wait != 0) {
+        node->join_wait--;
+        return 0;
+    }
+    node->join_wait = (uint8_t)(a_tdma_node_hash(node, 0x4A4F494Eu) & ((1u << order) - 1));
+    if (node->join_fails < UINT8_MAX) {
+        node->join_fails++;
+    }
+    return 1;
+}
+
+uint8_t tdma_node_join_offset(const tdma_node_t *node, uint8_t parts)
+{
+    return (uint8_t)(a_tdma_node_hash(node, 0) % parts);
+}
+
+uint32_t tdma_node_slot_offset_ms(const tdma_node_t *node, uint8_t slot)
+{
+    return TDMA_GUARD_MS + (uint32_t)slot * node->slot_ms;
+}
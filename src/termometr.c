@@ -31,9 +31,14 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "driver_ds18b20_dual.h"
+#include "dlog.h"
 
 #define TEMP_TASK_STACK    2048
 #define TEMP_TASK_PRIO     (tskIDLE_PRIORITY + 1)
+#define TEMP_SAMPLE_MS     1000
+
+static StaticTask_t gs_temp_tcb;
+static StackType_t gs_temp_stack[TEMP_TASK_STACK];
 
 /**
  * @brief Reads two temperatures every second and prints them
@@ -41,6 +46,7 @@
 static void temperature_task(void *params)
 {
     float temps[DS18B20_DUAL_MAX_SENSORS];
+    TickType_t wake;
 
     /* Initialize both sensors */
     if (ds18b20_dual_init() != 0) {
@@ -48,8 +54,10 @@ static void temperature_task(void *params)
         vTaskDelete(NULL);
     }
     printf("ds18b20_dual: sensors initialized\r\n");
+    wake = xTaskGetTickCount();
 
     for (;;) {
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(TEMP_SAMPLE_MS));
         if (ds18b20_dual_read(temps) == 0) {
             printf("Sensor0: %.2f°C | Sensor1: %.2f°C\r\n", temps[0], temps[1]);
         } else {
@@ -58,24 +66,6 @@ static void temperature_task(void *params)
     }
 }
 
-/**
- * @brief Malloc-failed hook
- */
-void vApplicationMallocFailedHook(void)
-{
-    printf("FreeRTOS malloc failed!\r\n");
-    for (;;) { tight_loop_contents(); }
-}
-
-/**
- * @brief Stack-overflow hook
- */
-void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
-{
-    printf("FreeRTOS stack overflow in task %s!\r\n", pcTaskName);
-    for (;;) { tight_loop_contents(); }
-}
-
 int main(void)
 {
     /* Initialize stdio over USB/UART */
@@ -85,18 +75,20 @@ int main(void)
     /* Delay to allow console connection */
     sleep_ms(5000);
 
-    /* Create temperature-reading task */
-    if (xTaskCreate(
+    /* Create temperature-reading task (static, cannot fail) */
+    (void)xTaskCreateStatic(
             temperature_task,
             "temp_task",
             TEMP_TASK_STACK,
             NULL,
             TEMP_TASK_PRIO,
-            NULL
-        ) != pdPASS)
-    {
-        printf("Failed to create temp_task\r\n");
-        while (1) { tight_loop_contents(); }
+            gs_temp_stack,
+            &gs_temp_tcb
+        );
+
+    /* Driver messages are printed by a low-priority task */
+    if (dlog_task_create(tskIDLE_PRIORITY + 1) != 0) {
+        printf("Failed to create dlog task\r\n");
     }
 
     /* Start the FreeRTOS scheduler */
@@ -0,0 +1,79 @@
+/**
+ * @file      timesync.c
+ * @brief     Network time from radio beacons: offset and drift model over the local microsecond clock
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "timesync.h"
+#include <string.h>
+
+void timesync_init(timesync_t *ts)
+{
+    memset(ts, 0, sizeof(*ts));
+}
+
+uint64_t timesync_to_network(const timesync_t *ts, uint64_t local_us)
+{
+    int64_t dt;
+
+    if (!ts->synced) {
+        return local_us;
+    }
+    dt = (int64_t)(local_us - ts->ref_local_us);
+    return ts->ref_net_us + (uint64_t)(dt + dt * ts->drift_ppb / 1000000000LL);
+}
+
+void timesync_update(timesync_t *ts, uint64_t local_us, uint64_t net_us)
+{
+    int64_t err;
+    int64_t span;
+    int64_t drift;
+
+    if (ts->synced) {
+        err = (int64_t)(net_us - timesync_to_network(ts, local_us));
+        span = (int64_t)(local_us - ts->ref_local_us);
+        if ((err > TIMESYNC_STEP_US) || (err < -TIMESYNC_STEP_US) || (span <= 0)) {
+            ts->drift_ppb = 0;                      /* lost track (base reboot, missed wrap), start over */
+            ts->max_error_us = 0;
+            ts->steps++;
+        } else {
+            ts->error_us = (int32_t)err;
+            if ((uint32_t)((err < 0) ? -err : err) > ts->max_error_us) {
+                ts->max_error_us = (uint32_t)((err < 0) ? -err : err);
+            }
+            drift = ts->drift_ppb + err * 1000000000LL / span / TIMESYNC_DRIFT_GAIN;
+            if (drift > TIMESYNC_MAX_DRIFT_PPB) {
+                drift = TIMESYNC_MAX_DRIFT_PPB;
+            } else if (drift < -TIMESYNC_MAX_DRIFT_PPB) {
+                drift = -TIMESYNC_MAX_DRIFT_PPB;
+            }
+            ts->drift_ppb = (int32_t)drift;
+        }
+    }
+
+    ts->ref_local_us = local_us;
+    ts->ref_net_us = net_us;
+    ts->synced = 1;
+    ts->updates++;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file      topology_check.cpp
+ * @brief     Compile-time checks of the ROMs in topology.h
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "topology.h"
+#include "ds18b20.hpp"
+#include "ds2482.h"
+
+/*
+ * Generates no code. A mistyped ROM fails the build here instead of
+ * showing up as a sensor that never answers match rom.
+ */
+
+namespace
+{
+
+constexpr bool a_rom_crc_ok(uint8_t r0, uint8_t r1, uint8_t r2, uint8_t r3,
+                            uint8_t r4, uint8_t r5, uint8_t r6, uint8_t r7)
+{
+    const uint8_t rom[7] = {r0, r1, r2, r3, r4, r5, r6};
+
+    return ds18b20::crc8(rom, 7) == r7;
+}
+
+#define A_CHECK_SENSOR(arg, bus, res, r0, r1, r2, r3, r4, r5, r6, r7)                                   \
+    static_assert((r0) == 0x28, "not a DS18B20 family code: " #r0 " " #r1 " " #r2 " " #r3 " " #r4 " "   \
+                  #r5 " " #r6 " " #r7);                                                                \
+    static_assert(a_rom_crc_ok(r0, r1, r2, r3, r4, r5, r6, r7), "ROM CRC mismatch: " #r0 " " #r1 " "   \
+                  #r2 " " #r3 " " #r4 " " #r5 " " #r6 " " #r7);                                        \
+    static_assert((res) >= DS18B20_RESOLUTION_9BIT && (res) <= DS18B20_RESOLUTION_12BIT,                \
+                  "bad resolution for " #r0 " " #r1 " " #r2 " " #r3 " " #r4 " " #r5 " " #r6 " " #r7);
+
+#define A_CHECK_BUS(name, gpio)                                                                         \
+    static_assert(TOPOLOGY_IS_DS2482(gpio) ? (TOPOLOGY_DS2482_CHANNEL(gpio) < DS2482_CHANNELS)          \
+                                           : ((gpio) < 30), "bus " #name ": no such GPIO or DS2482 channel");
+
+TOPOLOGY_BUSES(A_CHECK_BUS)
+TOPOLOGY_SENSORS(A_CHECK_SENSOR, 0)
+
+}
@@ -0,0 +1,112 @@
+/**
+ * @file      usb_frame.c
+ * @brief     Binary framing for the base station USB stream
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "usb_frame.h"
+#include "sample_codec.h"
+#include <string.h>
+
+void usb_frame_begin(usb_frame_t *frame, uint8_t type)
+{
+    frame->len = 0;
+    frame->buf[0] = USB_FRAME_SYNC0;
+    frame->buf[1] = USB_FRAME_SYNC1;
+    frame->buf[2] = type;
+}
+
+uint8_t usb_frame_append(usb_frame_t *frame, const uint8_t *data, uint16_t len)
+{
+    if ((uint32_t)frame->len + len > USB_FRAME_MAX_PAYLOAD) {
+        return 1;
+    }
+    memcpy(&frame->buf[USB_FRAME_HEADER_SIZE + frame->len], data, len);
+    frame->len = (uint16_t)(frame->len + len);
+    return 0;
+}
+
+uint8_t usb_frame_append_sample(usb_frame_t *frame, uint8_t node_id, uint8_t sensor,
+                                int16_t raw, uint32_t time_ms)
+{
+    uint8_t rec[USB_FRAME_SAMPLE_SIZE];
+
+    rec[0] = node_id;
+    rec[1] = sensor;
+    rec[2] = (uint8_t)raw;
+    rec[3] = (uint8_t)((uint16_t)raw >> 8);
+    rec[4] = (uint8_t)time_ms;
+    rec[5] = (uint8_t)(time_ms >> 8);
+    rec[6] = (uint8_t)(time_ms >> 16);
+    rec[7] = (uint8_t)(time_ms >> 24);
+    return usb_frame_append(frame, rec, sizeof(rec));
+}
+
+uint8_t usb_frame_append_block(usb_frame_t *frame, uint8_t node_id,
+                               const radio_sample_t *samples, uint8_t count, uint8_t *encoded)
+{
+    uint8_t *rec = &frame->buf[USB_FRAME_HEADER_SIZE + frame->len];
+    uint16_t room = (uint16_t)(USB_FRAME_MAX_PAYLOAD - frame->len);
+    uint16_t len;
+
+    if (room < 2 + SAMPLE_CODEC_BLOCK_HEADER + 1) {
+        return 1;
+    }
+    room = (uint16_t)(room - 2);
+    if (room > 0xFF) {
+        room = 0xFF;
+    }
+    if (sample_codec_encode_block(samples, count, &rec[2], room, &len, encoded) != 0) {
+        return 1;
+    }
+    rec[0] = node_id;
+    rec[1] = (uint8_t)len;
+    frame->len = (uint16_t)(frame->len + 2 + len);
+    return 0;
+}
+
+uint16_t usb_frame_finish(usb_frame_t *frame, uint8_t seq)
+{
+    uint16_t crc;
+    uint16_t end = (uint16_t)(USB_FRAME_HEADER_SIZE + frame->len);
+
+    frame->buf[3] = seq;
+    frame->buf[4] = (uint8_t)frame->len;
+    frame->buf[5] = (uint8_t)(frame->len >> 8);
+    crc = usb_frame_crc16(0xFFFF, &frame->buf[2], (uint16_t)(end - 2));
+    frame->buf[end] = (uint8_t)crc;
+    frame->buf[end + 1] = (uint8_t)(crc >> 8);
+    return (uint16_t)(end + USB_FRAME_CRC_SIZE);
+}
+
+uint16_t usb_frame_crc16(uint16_t crc, const uint8_t *data, uint16_t len)
+{
+    while (len--) {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (uint8_t i = 0; i < 8; ++i) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file      fake_dlog.c
+ * @brief     Host test: dlog_write that counts records per message
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "fake_dlog.h"
+#include <string.h>
+
+fake_dlog_t g_fake_dlog;
+
+void fake_dlog_reset(void)
+{
+    memset(&g_fake_dlog, 0, sizeof(g_fake_dlog));
+}
+
+void dlog_write(uint16_t id, uint32_t arg0, uint32_t arg1)
+{
+    if (id < DLOG_COUNT) {
+        g_fake_dlog.count[id]++;
+        g_fake_dlog.last_arg[id][0] = arg0;
+        g_fake_dlog.last_arg[id][1] = arg1;
+    }
+}
@@ -0,0 +1,57 @@
+/**
+ * @file      fake_dlog.h
+ * @brief     Host test: dlog_write that counts records per message
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FAKE_DLOG_H
+#define FAKE_DLOG_H
+
+#include "dlog.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Records written through dlog_write, counted per id
+ */
+typedef struct fake_dlog_s
+{
+    uint32_t count[DLOG_COUNT];       /**< records per dlog_id_t */
+    uint32_t last_arg[DLOG_COUNT][2]; /**< arguments of the last record per id */
+} fake_dlog_t;
+
+extern fake_dlog_t g_fake_dlog;
+
+/**
+ * @brief Clear the counters
+ */
+void fake_dlog_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,239 @@
+/**
+ * @file      fake_ds2482.c
+ * @brief     Host test: I2C model of a DS2482-100/-800 bridge
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "fake_ds2482.h"
+#include "hardware/i2c.h"
+#include <string.h>
+
+/* Register pointer codes, as for set read pointer */
+#define A_PTR_STATUS     0xF0
+#define A_PTR_DATA       0xE1
+#define A_PTR_CHANNEL    0xD2
+#define A_PTR_CONFIG     0xC3
+
+#define A_ST_1WB         0x01
+#define A_ST_PPD         0x02
+#define A_ST_SD          0x04
+#define A_ST_RST         0x10
+#define A_ST_SBR         0x20
+#define A_ST_TSB         0x40
+#define A_ST_DIR         0x80
+
+/* CHSL codes and channel register read-back, from the DS2482-800 data sheet */
+static const uint8_t gc_chsl_code[8] = { 0xF0, 0xE1, 0xD2, 0xC3, 0xB4, 0xA5, 0x96, 0x87 };
+static const uint8_t gc_chsl_read[8] = { 0xB8, 0xB1, 0xAA, 0xA3, 0x9C, 0x95, 0x8E, 0x87 };
+
+fake_ds2482_t g_fake_ds2482;
+i2c_inst_t i2c0_inst = { 0 };
+i2c_inst_t i2c1_inst = { 1 };
+
+void fake_ds2482_reset(uint8_t channels)
+{
+    memset(&g_fake_ds2482, 0, sizeof(g_fake_ds2482));
+    g_fake_ds2482.channels = channels;
+    g_fake_ds2482.address = 0x18;
+    g_fake_ds2482.status = A_ST_RST;
+    g_fake_ds2482.pointer = A_PTR_STATUS;
+}
+
+/* Next bit the chip sends in a read slot, lsb first; an idle bus reads 1 */
+static uint8_t a_read_bit(fake_ds2482_channel_t *c)
+{
+    uint8_t bit;
+
+    if (c->read_pos >= c->read_len) {
+        return 1;
+    }
+    bit = (uint8_t)((c->read[c->read_pos] >> c->read_bit) & 1);
+    if (++c->read_bit == 8) {
+        c->read_bit = 0;
+        c->read_pos++;
+    }
+    return bit;
+}
+
+/* Start a 1-Wire command: the result is in place at once, 1WB shows for busy_reads reads */
+static void a_one_wire(fake_ds2482_t *d, uint8_t status)
+{
+    d->status = (uint8_t)((d->status & A_ST_RST) | status);
+    d->pointer = A_PTR_STATUS;
+    d->busy_left = d->busy_reads;
+    d->commands++;
+}
+
+/* Execute one command; 0 when the bridge ACKs it */
+static int a_command(fake_ds2482_t *d, const uint8_t *buf, size_t len)
+{
+    fake_ds2482_channel_t *c = &d->ch[d->channel];
+    uint8_t p = (len > 1) ? buf[1] : 0;
+
+    /* only a device reset or a read pointer move gets through while 1WB shows */
+    if (d->busy_left != 0 && buf[0] != 0xF0 && buf[0] != 0xE1) {
+        return 1;
+    }
+    switch (buf[0]) {
+        case 0xF0:                                      /* DRST */
+            d->status = A_ST_RST;
+            d->config = 0;
+            d->channel = 0;
+            d->busy_left = 0;
+            d->pointer = A_PTR_STATUS;
+            return (len == 1) ? 0 : 1;
+        case 0xE1:                                      /* SRP */
+            if (len != 2 || (p != A_PTR_STATUS && p != A_PTR_DATA && p != A_PTR_CONFIG &&
+                             !(p == A_PTR_CHANNEL && d->channels > 1))) {
+                return 1;
+            }
+            d->pointer = p;
+            return 0;
+        case 0xD2:                                      /* WCFG: low nibble and its complement */
+            if (len != 2 || ((p >> 4) ^ 0x0F) != (p & 0x0F)) {
+                return 1;
+            }
+            if (!d->ignore_config) {
+                d->config = p & 0x0F;
+                d->status &= (uint8_t)~A_ST_RST;
+            }
+            d->pointer = A_PTR_CONFIG;
+            return 0;
+        case 0xC3:                                      /* CHSL, DS2482-800 only */
+            if (d->channels == 1 || len != 2) {
+                return 1;
+            }
+            for (uint8_t i = 0; i < d->channels; i++) {
+                if (gc_chsl_code[i] == p) {
+                    d->channel = i;
+                    d->chsl++;
+                }
+            }
+            d->pointer = A_PTR_CHANNEL;
+            return 0;
+        case 0xB4:                                      /* 1WRS */
+            a_one_wire(d, c->shorted ? A_ST_SD : (c->presence ? A_ST_PPD : 0));
+            c->read_bit = 0;
+            return (len == 1) ? 0 : 1;
+        case 0x87: {                                    /* 1WSB */
+            uint8_t bit = (p & 0x80) ? a_read_bit(c) : 0;
+
+            c->bits_written++;
+            a_one_wire(d, bit ? A_ST_SBR : 0);
+            return (len == 2) ? 0 : 1;
+        }
+        case 0xA5:                                      /* 1WWB */
+            if (c->written_len < FAKE_DS2482_QUEUE) {
+                c->written[c->written_len++] = p;
+            }
+            a_one_wire(d, 0);
+            return (len == 2) ? 0 : 1;
+        case 0x96:                                      /* 1WRB */
+            d->data = 0;
+            for (uint8_t i = 0; i < 8; i++) {
+                d->data |= (uint8_t)(a_read_bit(c) << i);
+            }
+            a_one_wire(d, 0);
+            return (len == 1) ? 0 : 1;
+        case 0x78: {                                    /* 1WT */
+            uint8_t id = 1, cmp = 1, dir;
+
+            if (c->triplet_pos < c->triplet_len) {
+                id = c->triplet[c->triplet_pos][0];
+                cmp = c->triplet[c->triplet_pos][1];
+            }
+            dir = (id != cmp) ? id : (uint8_t)((p & 0x80) ? 1 : 0);
+            if (c->triplet_pos < 64) {
+                c->directions[c->triplet_pos++] = dir;
+            }
+            a_one_wire(d, (uint8_t)((id ? A_ST_SBR : 0) | (cmp ? A_ST_TSB : 0) | (dir ? A_ST_DIR : 0)));
+            return (len == 2) ? 0 : 1;
+        }
+        default:
+            return 1;
+    }
+}
+
+/* The register under the read pointer */
+static uint8_t a_register(fake_ds2482_t *d)
+{
+    switch (d->pointer) {
+        case A_PTR_DATA:
+            return d->data;
+        case A_PTR_CONFIG:
+            return d->config;
+        case A_PTR_CHANNEL:
+            return d->bad_chsl_ack ? 0x00 : gc_chsl_read[d->channel];
+        default:
+            if (d->stuck_busy) {
+                return (uint8_t)(d->status | A_ST_1WB);
+            }
+            if (d->busy_left != 0) {
+                d->busy_left--;
+                return (uint8_t)(d->status | A_ST_1WB);
+            }
+            return d->status;
+    }
+}
+
+/* 1 when this transfer is NACKed */
+static int a_nack(fake_ds2482_t *d, uint8_t addr)
+{
+    d->transfers++;
+    return (addr != d->address) || (d->nack_after != 0 && d->transfers >= d->nack_after) || !d->i2c_up;
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate)
+{
+    g_fake_ds2482.i2c_up = 1;
+    return baudrate;
+}
+
+void i2c_deinit(i2c_inst_t *i2c)
+{
+    g_fake_ds2482.i2c_up = 0;
+}
+
+int i2c_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop, uint timeout_us)
+{
+    fake_ds2482_t *d = &g_fake_ds2482;
+
+    if (a_nack(d, addr) || len == 0 || len > 2) {
+        return PICO_ERROR_GENERIC;
+    }
+    return (a_command(d, src, len) == 0) ? (int)len : PICO_ERROR_GENERIC;
+}
+
+int i2c_read_timeout_us(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop, uint timeout_us)
+{
+    fake_ds2482_t *d = &g_fake_ds2482;
+
+    if (a_nack(d, addr)) {
+        return PICO_ERROR_GENERIC;
+    }
+    for (size_t i = 0; i < len; i++) {
+        dst[i] = a_register(d);
+    }
+    return (int)len;
+}
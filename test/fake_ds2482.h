@@ -0,0 +1,97 @@
+/**
+ * @file      fake_ds2482.h
+ * @brief     Host test: I2C model of a DS2482-100/-800 bridge
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FAKE_DS2482_H
+#define FAKE_DS2482_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Bytes one channel can queue for read byte commands, and log from write byte commands */
+#define FAKE_DS2482_QUEUE    32
+
+/**
+ * @brief One 1-Wire channel behind the bridge
+ */
+typedef struct fake_ds2482_channel_s
+{
+    uint8_t presence;                     /**< a chip answers resets */
+    uint8_t shorted;                      /**< the bus is shorted to ground */
+    uint8_t read[FAKE_DS2482_QUEUE];      /**< bytes the chip sends, 0xFF once used up */
+    uint8_t read_len;                     /**< queued bytes */
+    uint8_t read_pos;                     /**< next byte */
+    uint8_t read_bit;                     /**< next bit of read[read_pos] for single bit reads */
+    uint8_t written[FAKE_DS2482_QUEUE];   /**< bytes written by write byte commands */
+    uint8_t written_len;                  /**< logged bytes */
+    uint32_t bits_written;                /**< single bit slots run */
+    uint8_t triplet[64][2];               /**< id and complement bits of each triplet */
+    uint8_t triplet_len;                  /**< queued triplets, 1/1 once used up */
+    uint8_t triplet_pos;                  /**< next triplet */
+    uint8_t directions[64];               /**< direction taken by each triplet */
+} fake_ds2482_channel_t;
+
+/**
+ * @brief Bridge state and fault injection
+ */
+typedef struct fake_ds2482_s
+{
+    uint8_t channels;                     /**< 1 for a DS2482-100, 8 for a DS2482-800 */
+    uint8_t address;                      /**< 7-bit I2C address it answers */
+    uint8_t status;                       /**< status register, 1WB excluded */
+    uint8_t config;                       /**< configuration register, low nibble */
+    uint8_t channel;                      /**< selected channel */
+    uint8_t pointer;                      /**< read pointer code */
+    uint8_t data;                         /**< read data register */
+    uint8_t busy_reads;                   /**< status reads showing 1WB after each 1-Wire command */
+    uint8_t busy_left;                    /**< of the current command */
+    uint8_t stuck_busy;                   /**< 1WB never clears */
+    uint8_t bad_chsl_ack;                 /**< the channel register reads back wrong */
+    uint8_t ignore_config;                /**< config writes do not take */
+    uint32_t nack_after;                  /**< I2C transfers until every one is NACKed, 0 never */
+    uint32_t transfers;                   /**< I2C transfers, NACKed ones included */
+    uint32_t chsl;                        /**< channel select commands accepted */
+    uint32_t commands;                    /**< 1-Wire commands run */
+    uint8_t i2c_up;                       /**< i2c_init called without i2c_deinit */
+    fake_ds2482_channel_t ch[8];          /**< channels */
+} fake_ds2482_t;
+
+extern fake_ds2482_t g_fake_ds2482;
+
+/**
+ * @brief     Power up a bridge: no chips, nothing queued, status RST
+ * @param[in] channels 1 or 8
+ */
+void fake_ds2482_reset(uint8_t channels);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
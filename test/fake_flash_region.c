@@ -0,0 +1,84 @@
+/**
+ * @file      fake_flash_region.c
+ * @brief     Host test: RAM-backed flash_region with failure injection
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "fake_flash_region.h"
+#include <string.h>
+
+fake_flash_t g_fake_flash;
+
+void fake_flash_reset(void)
+{
+    memset(&g_fake_flash, 0, sizeof(g_fake_flash));
+    memset(g_fake_flash.mem, 0xFF, sizeof(g_fake_flash.mem));
+}
+
+uint8_t flash_region_erase(const flash_region_t *region, uint32_t offset, uint32_t len)
+{
+    if (((offset | len) % FLASH_REGION_SECTOR_SIZE) != 0 || (offset + len > region->size) ||
+        (region->offset + offset + len > FAKE_FLASH_SIZE)) {
+        return 1;
+    }
+    if (g_fake_flash.fail_erases != 0) {
+        g_fake_flash.fail_erases--;
+        return 4;
+    }
+    memset(&g_fake_flash.mem[region->offset + offset], 0xFF, len);
+    g_fake_flash.erases++;
+    return 0;
+}
+
+uint8_t flash_region_program(const flash_region_t *region, uint32_t offset, const uint8_t *data, uint32_t len)
+{
+    uint8_t *p;
+
+    if (((offset | len) % FLASH_REGION_PAGE_SIZE) != 0 || (offset + len > region->size) || (data == NULL) ||
+        (region->offset + offset + len > FAKE_FLASH_SIZE)) {
+        return 1;
+    }
+    if (g_fake_flash.fail_programs != 0) {
+        g_fake_flash.fail_programs--;
+        return 4;
+    }
+    p = &g_fake_flash.mem[region->offset + offset];
+    for (uint32_t i = 0; i < len; ++i) {
+        if (p[i] != 0xFF) {
+            g_fake_flash.reprograms++;
+        }
+        p[i] &= data[i];                      /* NOR: programming only clears bits */
+    }
+    g_fake_flash.programs++;
+    return 0;
+}
+
+uint8_t flash_region_read(const flash_region_t *region, uint32_t offset, uint8_t *buf, uint32_t len)
+{
+    if ((offset + len > region->size) || (region->offset + offset + len > FAKE_FLASH_SIZE)) {
+        return 1;
+    }
+    memcpy(buf, &g_fake_flash.mem[region->offset + offset], len);
+    return 0;
+}
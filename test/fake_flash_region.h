@@ -0,0 +1,64 @@
+/**
+ * @file      fake_flash_region.h
+ * @brief     Host test: RAM-backed flash_region with failure injection
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FAKE_FLASH_REGION_H
+#define FAKE_FLASH_REGION_H
+
+#include "flash_region.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Size of the RAM behind every region, regions start at offset 0 of it */
+#define FAKE_FLASH_SIZE    (64 * 1024)
+
+/**
+ * @brief Fake flash state
+ */
+typedef struct fake_flash_s
+{
+    uint8_t mem[FAKE_FLASH_SIZE];     /**< contents, 0xFF when erased */
+    uint32_t fail_erases;             /**< erases still to fail, as if flash_safe_execute timed out */
+    uint32_t fail_programs;           /**< programs still to fail */
+    uint32_t erases;                  /**< erases run */
+    uint32_t programs;                /**< programs run */
+    uint32_t reprograms;              /**< programs onto bytes that were not erased */
+} fake_flash_t;
+
+extern fake_flash_t g_fake_flash;
+
+/**
+ * @brief Erase everything and clear the counters
+ */
+void fake_flash_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,265 @@
+/**
+ * @file      fake_ow_bus.c
+ * @brief     Host test: slot-level model of a 1-Wire bus with many ROM devices
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "fake_ow_bus.h"
+#include <string.h>
+
+#define A_IDLE      0           /* waits for a reset */
+#define A_ROM_CMD   1           /* receives the rom command */
+#define A_SEARCH    2           /* runs search rom */
+#define A_MATCH     3           /* receives the rom of match rom */
+#define A_FUNC      4           /* receives the function command */
+#define A_SEND      5           /* sends its scratchpad */
+
+/* Scratchpad of a new device: 25.0625 C, th 75, tl 70, 12 bit */
+static const uint8_t gc_scratchpad[8] = { 0x91, 0x01, 0x4B, 0x46, 0x7F, 0xFF, 0x0C, 0x10 };
+
+fake_ow_bus_t g_fake_ow_bus;
+
+static ds18b20_timing_t gs_timing = DS18B20_TIMING_STANDARD;
+
+void fake_ow_reset(void)
+{
+    memset(&g_fake_ow_bus, 0, sizeof(g_fake_ow_bus));
+}
+
+void fake_ow_add(const uint8_t rom[8], uint8_t alarm)
+{
+    fake_ow_device_t *d;
+
+    if (g_fake_ow_bus.count < FAKE_OW_DEVICES) {
+        d = &g_fake_ow_bus.dev[g_fake_ow_bus.count++];
+        memset(d, 0, sizeof(*d));
+        memcpy(d->rom, rom, 8);
+        d->alarm = alarm;
+        memcpy(d->scratchpad, gc_scratchpad, 8);
+        for (uint8_t i = 0; i < 8; i++) {
+            d->scratchpad[8] ^= d->scratchpad[i];
+            for (uint8_t b = 0; b < 8; b++) {
+                d->scratchpad[8] = (d->scratchpad[8] & 0x01) ? (uint8_t)((d->scratchpad[8] >> 1) ^ 0x8C)
+                                                             : (uint8_t)(d->scratchpad[8] >> 1);
+            }
+        }
+    }
+}
+
+/* Rom bit n of a device */
+static uint8_t a_rom_bit(const fake_ow_device_t *d)
+{
+    return (uint8_t)((d->rom[d->bit >> 3] >> (d->bit & 7)) & 1);
+}
+
+/* Scratchpad bit n of a device */
+static uint8_t a_scratchpad_bit(const fake_ow_device_t *d)
+{
+    return (uint8_t)((d->scratchpad[d->bit >> 3] >> (d->bit & 7)) & 1);
+}
+
+/* A device got the direction of its current search bit; it drops out unless that is its own */
+static void a_direction(fake_ow_device_t *d, uint8_t bit)
+{
+    if (bit != a_rom_bit(d)) {
+        d->state = A_IDLE;
+        return;
+    }
+    d->phase = 0;
+    if (++d->bit == 64) {
+        d->state = A_IDLE;      /* selected; function commands are not modelled */
+    }
+}
+
+/* End of a slot the master held low for held us */
+static void a_slot(uint64_t held)
+{
+    uint8_t bit = (held < 15) ? 1 : 0;
+
+    g_fake_ow_bus.slots++;
+    if (held >= 15 && held < 60) {
+        g_fake_ow_bus.timing_errors++;
+    }
+    for (uint8_t i = 0; i < g_fake_ow_bus.count; i++) {
+        fake_ow_device_t *d = &g_fake_ow_bus.dev[i];
+
+        if (d->state == A_ROM_CMD) {
+            d->cmd = (uint8_t)((d->cmd >> 1) | (bit << 7));
+            if (++d->shift == 8) {
+                d->state = ((d->cmd == 0xF0) || (d->cmd == 0xEC && d->alarm)) ? A_SEARCH :
+                           (d->cmd == 0x55) ? A_MATCH : (d->cmd == 0xCC) ? A_FUNC : A_IDLE;
+                d->phase = 0;
+                d->bit = 0;
+                d->shift = 0;
+            }
+        } else if (d->state == A_MATCH) {
+            if (bit != a_rom_bit(d)) {
+                d->state = A_IDLE;
+            } else if (++d->bit == 64) {
+                d->state = A_FUNC;
+            }
+        } else if (d->state == A_FUNC) {
+            d->cmd = (uint8_t)((d->cmd >> 1) | (bit << 7));
+            if (++d->shift == 8) {
+                g_fake_ow_bus.conversions += (d->cmd == 0x44) ? 1 : 0;
+                d->state = (d->cmd == 0xBE) ? A_SEND : A_IDLE;      /* a conversion is done at once */
+                d->bit = 0;
+            }
+        } else if (d->state == A_SEND) {
+            if (++d->bit == 72) {
+                d->state = A_IDLE;
+            }
+        } else if (d->state == A_SEARCH) {
+            if (d->phase < 2) {
+                d->phase++;
+            } else {
+                a_direction(d, bit);
+            }
+        }
+    }
+}
+
+static uint8_t a_bus_init(void)
+{
+    return 0;
+}
+
+static uint8_t a_bus_deinit(void)
+{
+    return 0;
+}
+
+static uint8_t a_bus_read(uint8_t *value)
+{
+    fake_ow_bus_t *b = &g_fake_ow_bus;
+
+    *value = !(b->master_low || b->now_us < b->drive_until_us ||
+               (b->now_us >= b->presence_from_us && b->now_us < b->presence_to_us));
+    return 0;
+}
+
+static uint8_t a_bus_write(uint8_t value)
+{
+    fake_ow_bus_t *b = &g_fake_ow_bus;
+    uint64_t held;
+
+    if (value == 0) {
+        if (b->master_low) {
+            return 0;
+        }
+        b->master_low = 1;
+        b->fall_us = b->now_us;
+        b->drive_until_us = 0;
+        for (uint8_t i = 0; i < b->count; i++) {
+            fake_ow_device_t *d = &b->dev[i];
+
+            /* a 0, or the complement of a 1, holds the read slot low */
+            if (d->state == A_SEARCH && d->phase < 2 && (a_rom_bit(d) ^ d->phase) == 0) {
+                b->drive_until_us = b->fall_us + 30;
+            }
+            if (d->state == A_SEND && a_scratchpad_bit(d) == 0) {
+                b->drive_until_us = b->fall_us + 30;
+            }
+        }
+        return 0;
+    }
+    if (!b->master_low) {
+        return 0;
+    }
+    b->master_low = 0;
+    held = b->now_us - b->fall_us;
+    if (held < 480) {
+        a_slot(held);
+        return 0;
+    }
+    b->resets++;
+    if (b->count != 0) {
+        b->presence_from_us = b->now_us + 30;
+        b->presence_to_us = b->now_us + 150;
+    }
+    for (uint8_t i = 0; i < b->count; i++) {
+        b->dev[i].state = A_ROM_CMD;
+        b->dev[i].shift = 0;
+    }
+    return 0;
+}
+
+static void a_delay_ms(uint32_t ms)
+{
+    g_fake_ow_bus.now_us += (uint64_t)ms * 1000;
+}
+
+static void a_delay_us(uint32_t us)
+{
+    g_fake_ow_bus.now_us += us;
+}
+
+static void a_enable_irq(void)
+{
+    g_fake_ow_bus.irq_depth--;
+}
+
+static void a_disable_irq(void)
+{
+    g_fake_ow_bus.irq_depth++;
+}
+
+static void a_debug_print(const char *const fmt, ...)
+{
+}
+
+/* One search step in a call: read slot, complement slot, direction slot */
+static uint8_t a_bus_triplet(uint8_t direction, uint8_t *id_bit, uint8_t *cmp_bit, uint8_t *taken)
+{
+    fake_ow_bus_t *b = &g_fake_ow_bus;
+    uint8_t id = 1, cmp = 1;
+
+    b->triplets++;
+    b->now_us += 3 * (uint32_t)(gs_timing.read_low_us + gs_timing.read_sample_us + gs_timing.read_high_us);
+    for (uint8_t i = 0; i < b->count; i++) {
+        if (b->dev[i].state == A_SEARCH) {
+            id &= a_rom_bit(&b->dev[i]);
+            cmp &= (uint8_t)!a_rom_bit(&b->dev[i]);
+        }
+    }
+    *id_bit = id;
+    *cmp_bit = cmp;
+    *taken = (id != cmp) ? id : direction;
+    for (uint8_t i = 0; i < b->count; i++) {
+        if (b->dev[i].state == A_SEARCH) {
+            a_direction(&b->dev[i], *taken);
+        }
+    }
+    return 0;
+}
+
+const ds18b20_bus_t gc_fake_ow_bus = {
+    a_bus_init, a_bus_deinit, a_bus_read, a_bus_write, a_delay_ms, a_delay_us,
+    a_enable_irq, a_disable_irq, a_debug_print, &gs_timing, NULL, NULL, NULL,
+};
+
+const ds18b20_bus_t gc_fake_ow_bus_triplet = {
+    a_bus_init, a_bus_deinit, a_bus_read, a_bus_write, a_delay_ms, a_delay_us,
+    a_enable_irq, a_disable_irq, a_debug_print, &gs_timing, NULL, NULL, a_bus_triplet,
+};
@@ -0,0 +1,102 @@
+/**
+ * @file      fake_ow_bus.h
+ * @brief     Host test: slot-level model of a 1-Wire bus with many ROM devices
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FAKE_OW_BUS_H
+#define FAKE_OW_BUS_H
+
+#include "driver_ds18b20.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Devices the model holds */
+#define FAKE_OW_DEVICES    64
+
+/**
+ * @brief One device on the bus
+ */
+typedef struct fake_ow_device_s
+{
+    uint8_t rom[8];                   /**< rom, lsb of rom[0] is the first search bit */
+    uint8_t alarm;                    /**< takes part in alarm search */
+    uint8_t state;                    /**< idle, rom command or search */
+    uint8_t phase;                    /**< search: 0 send bit, 1 send complement, 2 receive direction */
+    uint8_t bit;                      /**< search: rom bit */
+    uint8_t shift;                    /**< rom command: bits received */
+    uint8_t cmd;                      /**< rom or function command being received */
+    uint8_t scratchpad[9];            /**< sent by read scratchpad, crc in the last byte */
+} fake_ow_device_t;
+
+/**
+ * @brief Bus state and counters
+ */
+typedef struct fake_ow_bus_s
+{
+    fake_ow_device_t dev[FAKE_OW_DEVICES];  /**< devices */
+    uint8_t count;                    /**< devices on the bus */
+    uint64_t now_us;                  /**< virtual time, advanced by the delays */
+    uint8_t master_low;               /**< the master pulls the line */
+    uint64_t fall_us;                 /**< start of the current slot */
+    uint64_t drive_until_us;          /**< a device holds a read slot low until then */
+    uint64_t presence_from_us;        /**< presence pulse of the last reset */
+    uint64_t presence_to_us;
+    uint32_t resets;                  /**< reset pulses */
+    uint32_t slots;                   /**< bit slots */
+    uint32_t triplets;                /**< bus_triplet calls */
+    uint32_t conversions;             /**< convert t commands received, counted per device */
+    uint32_t timing_errors;           /**< slots held low 15 to 60 us, which a device may read either way */
+    int32_t irq_depth;                /**< disable_irq minus enable_irq */
+} fake_ow_bus_t;
+
+extern fake_ow_bus_t g_fake_ow_bus;
+
+/** Bit-banged bus: reset and slots through bus_read, bus_write and delay_us */
+extern const ds18b20_bus_t gc_fake_ow_bus;
+
+/** Same bus with a native bus_triplet, as a bridge provides */
+extern const ds18b20_bus_t gc_fake_ow_bus_triplet;
+
+/**
+ * @brief Remove every device and clear the counters
+ */
+void fake_ow_reset(void);
+
+/**
+ * @brief     Add a device
+ * @param[in] rom   Its rom
+ * @param[in] alarm 1 when its alarm flag is set
+ * @note      it answers match and skip rom, convert t (done at once) and
+ *            read scratchpad with 25.0625 C at 12 bit
+ */
+void fake_ow_add(const uint8_t rom[8], uint8_t alarm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
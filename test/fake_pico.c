@@ -0,0 +1,88 @@
+/**
+ * @file      fake_pico.c
+ * @brief     Host test: fake clock, GPIO and mutexes behind the stubs
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "fake_pico.h"
+
+fake_pico_t g_fake_pico = { 0, 1, NULL };
+
+void fake_pico_reset(void)
+{
+    g_fake_pico.now_us = 0;
+    g_fake_pico.step_us = 1;
+}
+
+uint32_t time_us_32(void)
+{
+    uint32_t now = g_fake_pico.now_us;
+
+    g_fake_pico.now_us += g_fake_pico.step_us;
+    return now;
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn)
+{
+}
+
+void gpio_pull_up(uint gpio)
+{
+}
+
+void gpio_disable_pulls(uint gpio)
+{
+}
+
+void gpio_deinit(uint gpio)
+{
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *buffer)
+{
+    buffer->held = 0;
+    buffer->takes = 0;
+    buffer->misuse = 0;
+    g_fake_pico.last_mutex = buffer;
+    return buffer;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t wait)
+{
+    if (sem->held != 0) {
+        sem->misuse++;                  /* single threaded: it would block forever */
+    }
+    sem->held = 1;
+    sem->takes++;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    if (sem->held == 0) {
+        sem->misuse++;
+    }
+    sem->held = 0;
+    return pdTRUE;
+}
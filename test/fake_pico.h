@@ -0,0 +1,59 @@
+/**
+ * @file      fake_pico.h
+ * @brief     Host test: fake clock, GPIO and mutexes behind the stubs
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FAKE_PICO_H
+#define FAKE_PICO_H
+
+#include "pico/stdlib.h"
+#include "semphr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Fake SDK state
+ */
+typedef struct fake_pico_s
+{
+    uint32_t now_us;                  /**< returned and advanced by time_us_32 */
+    uint32_t step_us;                 /**< advance per time_us_32 call, 1 after a reset */
+    SemaphoreHandle_t last_mutex;     /**< last mutex created */
+} fake_pico_t;
+
+extern fake_pico_t g_fake_pico;
+
+/**
+ * @brief Restart the clock; mutexes keep their state
+ */
+void fake_pico_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
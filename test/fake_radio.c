@@ -0,0 +1,168 @@
+/**
+ * @file      fake_radio.c
+ * @brief     Host test: lossy, reordering radio medium behind radio_ops_t
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "fake_radio.h"
+#include <string.h>
+
+fake_radio_t g_fake_radio;
+
+void fake_radio_reset(uint32_t seed)
+{
+    memset(&g_fake_radio, 0, sizeof(g_fake_radio));
+    g_fake_radio.seed = seed;
+    g_fake_radio.retries = 3;
+}
+
+/* Percent roll from a small LCG */
+static uint8_t a_roll(uint8_t pct)
+{
+    g_fake_radio.seed = g_fake_radio.seed * 1103515245u + 12345u;
+    return (((g_fake_radio.seed >> 16) % 100) < pct) ? 1 : 0;
+}
+
+/* A copy of the frame reaches the base station */
+static void a_arrive(const radio_frame_t *frame)
+{
+    fake_radio_t *r = &g_fake_radio;
+    uint32_t due = r->now_ms;
+
+    if (r->in_air >= FAKE_RADIO_AIR) {
+        r->overflows++;
+        return;
+    }
+    if ((r->hold_max_ms != 0) && a_roll(r->reorder_pct)) {
+        g_fake_radio.seed = g_fake_radio.seed * 1103515245u + 12345u;
+        due += 1 + (g_fake_radio.seed >> 16) % r->hold_max_ms;
+        r->held++;
+    }
+    r->air[r->in_air].frame = *frame;
+    r->air[r->in_air].due_ms = due;
+    r->in_air++;
+}
+
+static uint8_t a_ok(void)
+{
+    return 0;
+}
+
+static uint8_t a_ok_role(radio_role_t role)
+{
+    (void)role;
+    return 0;
+}
+
+static uint8_t a_ok_pipe(uint8_t pipe)
+{
+    (void)pipe;
+    return 0;
+}
+
+static uint8_t a_send_burst(const radio_frame_t *frames, uint8_t count, uint8_t *sent)
+{
+    fake_radio_t *r = &g_fake_radio;
+
+    *sent = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t acked = 0;
+
+        for (uint8_t a = 0; (a <= r->retries) && !acked; a++) {
+            r->attempts++;
+            if (a_roll(r->loss_pct)) {
+                r->lost++;
+                continue;
+            }
+            a_arrive(&frames[i]);
+            if (a_roll(r->ack_loss_pct)) {
+                r->acks_lost++;
+                continue;
+            }
+            acked = 1;
+        }
+        if (!acked) {
+            return 0;                           /* max retransmits: the rest of the burst is flushed */
+        }
+        (*sent)++;
+    }
+    return 0;
+}
+
+static uint8_t a_broadcast(const radio_frame_t *frame)
+{
+    (void)frame;
+    return 0;
+}
+
+/* Index of the first frame due, in send order, or -1 */
+static int a_due(void)
+{
+    for (uint8_t i = 0; i < g_fake_radio.in_air; i++) {
+        if ((int32_t)(g_fake_radio.now_ms - g_fake_radio.air[i].due_ms) >= 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static uint8_t a_wait(uint32_t timeout_ms)
+{
+    (void)timeout_ms;
+    return (a_due() >= 0) ? 0 : 1;
+}
+
+static uint8_t a_receive(radio_frame_t *frame)
+{
+    fake_radio_t *r = &g_fake_radio;
+    int i = a_due();
+
+    if (i < 0) {
+        return 4;
+    }
+    *frame = r->air[i].frame;
+    memmove(&r->air[i], &r->air[i + 1], (size_t)(r->in_air - i - 1) * sizeof(r->air[0]));
+    r->in_air--;
+    return 0;
+}
+
+static uint8_t a_irq_time(uint64_t *us)
+{
+    *us = (uint64_t)g_fake_radio.now_ms * 1000;
+    return 0;
+}
+
+const radio_ops_t gc_fake_radio_ops = {
+    .init = a_ok_role,
+    .deinit = a_ok,
+    .send_burst = a_send_burst,
+    .listen = a_ok,
+    .wait = a_wait,
+    .receive = a_receive,
+    .sleep = a_ok,
+    .broadcast = a_broadcast,
+    .set_uplink = a_ok_pipe,
+    .kick = a_ok,
+    .irq_time = a_irq_time,
+};
@@ -0,0 +1,85 @@
+/**
+ * @file      fake_radio.h
+ * @brief     Host test: lossy, reordering radio medium behind radio_ops_t
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FAKE_RADIO_H
+#define FAKE_RADIO_H
+
+#include "radio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Frames in the air, received but not yet popped by the base station */
+#define FAKE_RADIO_AIR    64
+
+/**
+ * @brief Medium between the node ops and the base ops
+ *
+ * Each attempt of a frame is lost with loss_pct. A frame that gets through
+ * is acknowledged unless the acknowledgement is lost with ack_loss_pct, in
+ * which case the sender retries it and the base station hears it again,
+ * as the nRF24 auto-retransmit does. A frame that gets through is held in
+ * the air for 1 - hold_max_ms with reorder_pct, so later frames overtake it.
+ */
+typedef struct fake_radio_s
+{
+    uint32_t seed;                        /**< random state, set for a repeatable run */
+    uint8_t loss_pct;                     /**< frame lost per attempt */
+    uint8_t ack_loss_pct;                 /**< acknowledgement lost per received attempt */
+    uint8_t reorder_pct;                  /**< received frame held back */
+    uint8_t hold_max_ms;                  /**< longest hold */
+    uint8_t retries;                      /**< auto-retransmits per frame */
+    uint32_t now_ms;                      /**< medium time, advanced by the test */
+    struct {
+        radio_frame_t frame;
+        uint32_t due_ms;
+    } air[FAKE_RADIO_AIR];                /**< frames in flight, in send order */
+    uint8_t in_air;                       /**< used entries of air */
+    uint32_t attempts;                    /**< transmissions, retries included */
+    uint32_t lost;                        /**< attempts that did not arrive */
+    uint32_t acks_lost;                   /**< attempts that arrived unacknowledged */
+    uint32_t held;                        /**< frames held back */
+    uint32_t overflows;                   /**< frames dropped on a full air queue */
+} fake_radio_t;
+
+extern fake_radio_t g_fake_radio;
+
+/** Uplink only: every node sends through it, the base station receives; broadcasts go nowhere */
+extern const radio_ops_t gc_fake_radio_ops;
+
+/**
+ * @brief     Empty the medium and clear the counters and the fault settings
+ * @param[in] seed random seed
+ */
+void fake_radio_reset(uint32_t seed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
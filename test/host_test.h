@@ -0,0 +1,59 @@
+/**
+ * @file      host_test.h
+ * @brief     Minimal check macros shared by the host tests
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+
+static int gs_host_test_failures;
+
+/** Record a failed condition and keep going, so one run reports every broken case */
+#define HOST_CHECK(cond)                                                            \
+    do {                                                                            \
+        if (!(cond)) {                                                              \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            gs_host_test_failures++;                                                \
+        }                                                                           \
+    } while (0)
+
+/** Like HOST_CHECK for two integers, printing both values */
+#define HOST_CHECK_EQ(a, b)                                                         \
+    do {                                                                            \
+        long long a_ = (long long)(a);                                              \
+        long long b_ = (long long)(b);                                              \
+        if (a_ != b_) {                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s == %s (%lld != %lld)\n",       \
+                    __FILE__, __LINE__, #a, #b, a_, b_);                            \
+            gs_host_test_failures++;                                                \
+        }                                                                           \
+    } while (0)
+
+/** Exit status of a test binary */
+#define HOST_TEST_RESULT()    ((gs_host_test_failures == 0) ? 0 : 1)
+
+#endif
@@ -0,0 +1,161 @@
+/**
+ * @file      test_ds18b20_cores.c
+ * @brief     Host test: bus time and cycle time of the dual driver's read cycle on 1 and 2 cores
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * The read cycle of driver_ds18b20_dual.c replayed on the slot model: per bus
+ * a skip rom convert t, then a poll and a match rom scratchpad read of every
+ * sensor, all through the real driver. The bus time of each bus comes from
+ * the model's clock; the cores are then given their buses the way
+ * DS18B20_DUAL_BUS_CORE does and each phase lasts as long as its slowest core.
+ * The owner task handoff, a few us per phase, is not modelled.
+ */
+
+#include <string.h>
+
+#include "host_test.h"
+#include "fake_ow_bus.h"
+#include "driver_ds18b20.h"
+
+/** Buses of the largest installation modelled */
+#define BUSES_MAX        4
+
+/** Slowest 12 bit conversion; the sleep and the polls cover it on every core at once */
+#define CONVERSION_MS    750
+
+/** Bus time of one bus in the two phases of a cycle */
+typedef struct {
+    uint64_t start_us;
+    uint64_t read_us;
+} bus_time_t;
+
+/** Run one cycle on a bus with n sensors and time both phases */
+static bus_time_t run_bus(uint8_t n)
+{
+    ds18b20_handle_t bus;
+    ds18b20_handle_t sensor[8];
+    bus_time_t t;
+    uint8_t rom[8] = { 0x28, 0, 0, 0, 0, 0, 0, 0 };
+    uint64_t t0;
+    int16_t raw;
+    float temp;
+
+    fake_ow_reset();
+    for (uint8_t i = 0; i < n; i++) {
+        rom[1] = (uint8_t)(0x10 + i);
+        fake_ow_add(rom, 0);
+    }
+    DRIVER_DS18B20_LINK_INIT(&bus, ds18b20_handle_t);
+    DRIVER_DS18B20_LINK_BUS(&bus, &gc_fake_ow_bus);
+    HOST_CHECK_EQ(ds18b20_init(&bus), 0);
+    ds18b20_set_mode(&bus, DS18B20_MODE_SKIP_ROM);
+    for (uint8_t i = 0; i < n; i++) {
+        DRIVER_DS18B20_LINK_INIT(&sensor[i], ds18b20_handle_t);
+        DRIVER_DS18B20_LINK_BUS(&sensor[i], &gc_fake_ow_bus);
+        HOST_CHECK_EQ(ds18b20_init(&sensor[i]), 0);
+        ds18b20_set_rom(&sensor[i], g_fake_ow_bus.dev[i].rom);
+        ds18b20_set_mode(&sensor[i], DS18B20_MODE_MATCH_ROM);
+    }
+
+    /* a_group_start */
+    t0 = g_fake_ow_bus.now_us;
+    HOST_CHECK_EQ(ds18b20_start_conversion(&bus), 0);
+    t.start_us = g_fake_ow_bus.now_us - t0;
+    HOST_CHECK_EQ(g_fake_ow_bus.conversions, n);
+
+    /* a_group_read, after the sleep */
+    t0 = g_fake_ow_bus.now_us;
+    HOST_CHECK_EQ(ds18b20_wait_conversion(&bus, 0), 0);
+    for (uint8_t i = 0; i < n; i++) {
+        HOST_CHECK_EQ(ds18b20_read_converted(&sensor[i], &raw, &temp), 0);
+        HOST_CHECK_EQ(raw, 0x191);
+    }
+    t.read_us = g_fake_ow_bus.now_us - t0;
+    HOST_CHECK_EQ(g_fake_ow_bus.timing_errors, 0);
+    HOST_CHECK_EQ(g_fake_ow_bus.irq_depth, 0);
+    return t;
+}
+
+/** Longest time any core spends in a phase when the buses are spread over cores */
+static uint64_t phase_us(const bus_time_t *t, uint8_t buses, uint8_t cores, uint8_t read)
+{
+    uint64_t core_us[2] = { 0, 0 };
+    uint64_t worst = 0;
+
+    for (uint8_t b = 0; b < buses; b++) {
+        core_us[b % cores] += read ? t[b].read_us : t[b].start_us;     /* DS18B20_DUAL_BUS_CORE */
+    }
+    for (uint8_t c = 0; c < cores; c++) {
+        worst = (core_us[c] > worst) ? core_us[c] : worst;
+    }
+    return worst;
+}
+
+/** Bus time and cycle time of one installation on 1 and 2 cores; returns the 2 over 1 bus time ratio */
+static double run_installation(const char *name, const uint8_t *sensors, uint8_t buses)
+{
+    bus_time_t t[BUSES_MAX];
+    uint64_t bus_us[3];
+    uint32_t count = 0;
+
+    for (uint8_t b = 0; b < buses; b++) {
+        t[b] = run_bus(sensors[b]);
+        count += sensors[b];
+    }
+    for (uint8_t cores = 1; cores <= 2; cores++) {
+        bus_us[cores] = phase_us(t, buses, cores, 0) + phase_us(t, buses, cores, 1);
+        printf("%-12s %u core%s: bus time %6.1f ms, %5.1f reads/s of bus time, cycle %5.1f ms\n",
+               name, cores, (cores == 1) ? " " : "s", (double)bus_us[cores] / 1000.0,
+               (double)count * 1e6 / (double)bus_us[cores],
+               (double)(bus_us[cores] + (uint64_t)CONVERSION_MS * 1000) / 1000.0);
+    }
+    return (double)bus_us[2] / (double)bus_us[1];
+}
+
+int main(void)
+{
+    static const uint8_t one[1] = { 4 };
+    static const uint8_t two[2] = { 4, 4 };
+    static const uint8_t four[4] = { 4, 4, 4, 4 };
+    static const uint8_t uneven[2] = { 6, 2 };
+    double ratio;
+
+    /* one bus: the second core has nothing to do */
+    ratio = run_installation("1 x 4", one, 1);
+    HOST_CHECK(ratio > 0.999 && ratio < 1.001);
+
+    /* even buses: bus time halves */
+    ratio = run_installation("2 x 4", two, 2);
+    HOST_CHECK(ratio > 0.499 && ratio < 0.501);
+    ratio = run_installation("4 x 4", four, 4);
+    HOST_CHECK(ratio > 0.499 && ratio < 0.501);
+
+    /* uneven buses: the core with the long bus sets the pace */
+    ratio = run_installation("6 + 2", uneven, 2);
+    HOST_CHECK(ratio > 0.6 && ratio < 0.9);
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,191 @@
+/**
+ * @file      test_ds18b20_handles.c
+ * @brief     Host test: memory per sensor and sweep speed of shared bus tables against per-handle callbacks
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "host_test.h"
+#include "driver_ds18b20.h"
+
+/** Sensors in the large array, spread over BUSES buses */
+#define SENSORS    16384
+#define BUSES      4
+
+/** Sweeps timed per layout */
+#define RUNS       200
+
+/** The handle before the shared tables: nine callbacks copied into every handle */
+typedef struct {
+    uint8_t (*bus_init)(void);
+    uint8_t (*bus_deinit)(void);
+    uint8_t (*bus_read)(uint8_t *value);
+    uint8_t (*bus_write)(uint8_t value);
+    void (*delay_ms)(uint32_t ms);
+    void (*delay_us)(uint32_t us);
+    void (*enable_irq)(void);
+    void (*disable_irq)(void);
+    void (*debug_print)(const char *const fmt, ...);
+    uint8_t inited;
+    uint8_t mode;
+    uint8_t rom[8];
+    uint8_t resolution;
+} legacy_handle_t;
+
+static volatile uint32_t gs_calls;
+
+static uint8_t a_bus_init(void) { return 0; }
+static uint8_t a_bus_deinit(void) { return 0; }
+static uint8_t a_bus_read(uint8_t *value) { *value = 1; return 0; }
+static uint8_t a_bus_write(uint8_t value) { return 0; }
+static void a_delay_ms(uint32_t ms) { }
+static void a_delay_us(uint32_t us) { gs_calls += us; }
+static void a_irq(void) { }
+static void a_debug_print(const char *const fmt, ...) { }
+
+static ds18b20_timing_t gs_timing[BUSES] = {
+    DS18B20_TIMING_STANDARD, DS18B20_TIMING_STANDARD, DS18B20_TIMING_STANDARD, DS18B20_TIMING_STANDARD,
+};
+
+/** One table per bus, as driver_ds18b20_interface.c builds them */
+static ds18b20_bus_t gs_buses[BUSES];
+
+/** Fill both layouts with the same sensors */
+static void fill(legacy_handle_t *old, ds18b20_handle_t *cur)
+{
+    for (uint8_t b = 0; b < BUSES; b++) {
+        gs_buses[b] = (ds18b20_bus_t) {
+            a_bus_init, a_bus_deinit, a_bus_read, a_bus_write, a_delay_ms, a_delay_us,
+            a_irq, a_irq, a_debug_print, &gs_timing[b], NULL, NULL, NULL,
+        };
+    }
+    for (uint32_t i = 0; i < SENSORS; i++) {
+        memset(&old[i], 0, sizeof(old[i]));
+        old[i].bus_init = a_bus_init;
+        old[i].bus_deinit = a_bus_deinit;
+        old[i].bus_read = a_bus_read;
+        old[i].bus_write = a_bus_write;
+        old[i].delay_ms = a_delay_ms;
+        old[i].delay_us = a_delay_us;
+        old[i].enable_irq = a_irq;
+        old[i].disable_irq = a_irq;
+        old[i].debug_print = a_debug_print;
+        old[i].inited = 1;
+        old[i].mode = DS18B20_MODE_MATCH_ROM;
+        old[i].rom[0] = 0x28;
+        memcpy(&old[i].rom[1], &i, sizeof(i));
+        old[i].resolution = DS18B20_RESOLUTION_12BIT;
+
+        DRIVER_DS18B20_LINK_INIT(&cur[i], ds18b20_handle_t);
+        DRIVER_DS18B20_LINK_BUS(&cur[i], &gs_buses[i % BUSES]);
+        cur[i].inited = 1;
+        cur[i].mode = DS18B20_MODE_MATCH_ROM;
+        memcpy(cur[i].rom, old[i].rom, 8);
+        cur[i].resolution = DS18B20_RESOLUTION_12BIT;
+    }
+}
+
+/*
+ * One sweep over the sensor table as the read cycle does it: the state
+ * checks of every handle, its rom, and one call through its callbacks
+ */
+static uint32_t sweep_old(const legacy_handle_t *h)
+{
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < SENSORS; i++) {
+        if ((h[i].inited != 1) || (h[i].mode != DS18B20_MODE_MATCH_ROM)) {
+            continue;
+        }
+        for (uint8_t j = 0; j < 8; j++) {
+            sum += h[i].rom[j];
+        }
+        h[i].delay_us(1);
+    }
+    return sum;
+}
+
+static uint32_t sweep_cur(const ds18b20_handle_t *h)
+{
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < SENSORS; i++) {
+        if ((h[i].inited != 1) || (h[i].mode != DS18B20_MODE_MATCH_ROM)) {
+            continue;
+        }
+        for (uint8_t j = 0; j < 8; j++) {
+            sum += h[i].rom[j];
+        }
+        h[i].bus->delay_us(1);
+    }
+    return sum;
+}
+
+int main(void)
+{
+    legacy_handle_t *old = malloc(sizeof(legacy_handle_t) * SENSORS);
+    ds18b20_handle_t *cur = malloc(sizeof(ds18b20_handle_t) * SENSORS);
+    uint32_t sum_old = 0, sum_cur = 0;
+    double old_ns, cur_ns;
+    clock_t t0;
+
+    HOST_CHECK(old != NULL && cur != NULL);
+    if (old == NULL || cur == NULL) {
+        return HOST_TEST_RESULT();
+    }
+    fill(old, cur);
+
+    /* the shared table costs its size once per bus, not per sensor */
+    HOST_CHECK(sizeof(ds18b20_handle_t) + sizeof(ds18b20_bus_t) * BUSES / SENSORS < sizeof(legacy_handle_t));
+    HOST_CHECK(sizeof(ds18b20_handle_t) <= sizeof(void *) + 16);
+
+    /* whole passes timed together, a single one is below the clock resolution */
+    t0 = clock();
+    for (uint32_t r = 0; r < RUNS; r++) {
+        sum_old += sweep_old(old);
+    }
+    old_ns = (double)(clock() - t0) * 1e9 / CLOCKS_PER_SEC / RUNS / SENSORS;
+    t0 = clock();
+    for (uint32_t r = 0; r < RUNS; r++) {
+        sum_cur += sweep_cur(cur);
+    }
+    cur_ns = (double)(clock() - t0) * 1e9 / CLOCKS_PER_SEC / RUNS / SENSORS;
+    HOST_CHECK_EQ(sum_old, sum_cur);
+    HOST_CHECK_EQ(gs_calls, 2u * RUNS * SENSORS);
+
+    printf("%u sensors on %u buses\n", SENSORS, BUSES);
+    printf("per-handle callbacks: %3zu bytes per sensor, %6.2f MB, sweep %.2f ns per sensor\n",
+           sizeof(legacy_handle_t), (double)sizeof(legacy_handle_t) * SENSORS / 1e6, old_ns);
+    printf("shared bus tables:    %3zu bytes per sensor, %6.2f MB, sweep %.2f ns per sensor"
+           " (+%zu bytes per bus table)\n",
+           sizeof(ds18b20_handle_t), (double)sizeof(ds18b20_handle_t) * SENSORS / 1e6, cur_ns,
+           sizeof(ds18b20_bus_t));
+
+    free(old);
+    free(cur);
+    return HOST_TEST_RESULT();
+}
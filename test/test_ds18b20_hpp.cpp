@@ -0,0 +1,168 @@
+/**
+ * @file      test_ds18b20_hpp.cpp
+ * @brief     Host test of ds18b20.hpp against the simulated bus
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <chrono>
+#include <string.h>
+
+#include "host_test.h"
+#include "ds18b20.hpp"
+#include "ds18b20_sim.hpp"
+
+using bus = ds18b20::sim_bus<0>;
+using absent_bus = ds18b20::sim_bus<1>;
+
+/** A ROM with a valid crc */
+static void make_rom(uint8_t rom[8], uint8_t serial)
+{
+    const uint8_t head[7] = {0x28, serial, 0x10, 0x20, 0x30, 0x40, 0x00};
+
+    memcpy(rom, head, 7);
+    rom[7] = ds18b20::crc8(rom, 7);
+}
+
+/** Skip rom read at each resolution, positive and negative */
+static void test_skip_rom(void)
+{
+    ds18b20::sensor<bus> s;
+    int16_t raw;
+    float temp;
+
+    HOST_CHECK_EQ(s.read(&raw, &temp), 3);
+    HOST_CHECK_EQ(s.init(), 0);
+
+    bus::device().temp = 0x0191;                 /* +25.0625 */
+    HOST_CHECK_EQ(s.read(&raw, &temp), 0);
+    HOST_CHECK_EQ(raw, 0x0191);
+    HOST_CHECK(temp == 25.0625f);
+
+    bus::device().temp = (int16_t)0xFE6F;        /* -25.0625 */
+    HOST_CHECK_EQ(s.read(&raw, &temp), 0);
+    HOST_CHECK(temp == -25.0625f);
+
+    /* 9 bit: the first read learns the resolution, the second decodes with it */
+    bus::device().resolution = 0x00;
+    bus::device().temp = 0x0190;                 /* +25.0 */
+    bus::device().conversion_us = 80000;
+    HOST_CHECK_EQ(s.read(&raw, &temp), 0);
+    HOST_CHECK_EQ(s.read(&raw, &temp), 0);
+    HOST_CHECK_EQ(raw, 50);
+    HOST_CHECK(temp == 25.0f);
+    bus::device().resolution = 0x03;
+    bus::device().conversion_us = 400000;
+
+    HOST_CHECK_EQ(bus::device().timing_errors, 0);
+    s.deinit();
+}
+
+/** Match rom answers only to the device's own rom */
+static void test_match_rom(void)
+{
+    ds18b20::sensor<bus> s;
+    uint8_t rom[8];
+    int16_t raw;
+    float temp;
+
+    make_rom(bus::device().rom, 0x11);
+    HOST_CHECK_EQ(s.init(), 0);
+
+    s.set_rom(bus::device().rom);
+    bus::device().temp = 0x00A2;                 /* +10.125 */
+    HOST_CHECK_EQ(s.read(&raw, &temp), 0);
+    HOST_CHECK(temp == 10.125f);
+
+    /* Nobody drives the scratchpad, so it reads as all ones and fails the crc */
+    make_rom(rom, 0x12);
+    s.set_rom(rom);
+    HOST_CHECK_EQ(s.read(&raw, &temp), 1);
+
+    HOST_CHECK_EQ(bus::device().timing_errors, 0);
+    s.deinit();
+}
+
+/** No presence pulse: init fails and leaves the sensor unusable */
+static void test_absent(void)
+{
+    ds18b20::sensor<absent_bus> s;
+    int16_t raw;
+    float temp;
+
+    absent_bus::device().present = false;
+    HOST_CHECK_EQ(s.init(), 4);
+    HOST_CHECK_EQ(s.read(&raw, &temp), 3);
+}
+
+/** A conversion that never finishes times out after about 1 s */
+static void test_conversion_timeout(void)
+{
+    ds18b20::sensor<bus> s;
+    int16_t raw;
+    float temp;
+    uint64_t start;
+
+    HOST_CHECK_EQ(s.init(), 0);
+    bus::device().conversion_us = 5000000;
+    start = bus::device().now_us;
+    HOST_CHECK_EQ(s.read(&raw, &temp), 1);
+    HOST_CHECK(bus::device().now_us - start < 1100000);
+    bus::device().conversion_us = 400000;
+    s.deinit();
+}
+
+/** Host time and policy calls per byte written and read back */
+static void bench_bytes(void)
+{
+    ds18b20::sensor<bus> s;
+    const uint32_t bytes = 200000;
+    uint32_t calls;
+    uint8_t sink = 0;
+
+    HOST_CHECK_EQ(s.init(), 0);
+    calls = bus::device().calls;
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < bytes; i++)
+    {
+        (void)s.write_byte((uint8_t)i);
+        sink = (uint8_t)(sink ^ s.read_byte());
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    calls = bus::device().calls - calls;
+    printf("ds18b20.hpp sim bus: %.1f ns and %.1f policy calls per byte (sink %u)\n",
+           std::chrono::duration<double, std::nano>(t1 - t0).count() / (2.0 * bytes),
+           (double)calls / (2.0 * bytes), sink);
+    s.deinit();
+}
+
+int main(void)
+{
+    test_skip_rom();
+    test_match_rom();
+    test_absent();
+    test_conversion_timeout();
+    bench_bytes();
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,298 @@
+/**
+ * @file      test_ds18b20_search.c
+ * @brief     Host test: ROM search and verify against a simulated multi-device bus
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <time.h>
+
+#include "host_test.h"
+#include "fake_ow_bus.h"
+#include "driver_ds18b20.h"
+
+/** Deterministic rom generator */
+static uint32_t gs_seed = 12345;
+
+static uint8_t a_rand8(void)
+{
+    gs_seed = gs_seed * 1103515245u + 12345u;
+    return (uint8_t)(gs_seed >> 16);
+}
+
+/** A DS18B20 rom with a valid crc */
+static void make_rom(uint8_t rom[8], const uint8_t serial[6])
+{
+    uint8_t crc = 0;
+
+    rom[0] = 0x28;
+    memcpy(&rom[1], serial, 6);
+    for (uint8_t i = 0; i < 7; i++) {
+        crc ^= rom[i];
+        for (uint8_t b = 0; b < 8; b++) {
+            crc = (crc & 0x01) ? (uint8_t)((crc >> 1) ^ 0x8C) : (uint8_t)(crc >> 1);
+        }
+    }
+    rom[7] = crc;
+}
+
+/** Put n random devices on the bus */
+static void add_random(uint8_t n)
+{
+    uint8_t serial[6];
+    uint8_t rom[8];
+
+    for (uint8_t i = 0; i < n; i++) {
+        for (uint8_t j = 0; j < 6; j++) {
+            serial[j] = a_rand8();
+        }
+        make_rom(rom, serial);
+        fake_ow_add(rom, 0);
+    }
+}
+
+/** Index of a rom on the bus, -1 when none has it */
+static int find_device(const uint8_t rom[8])
+{
+    for (uint8_t i = 0; i < g_fake_ow_bus.count; i++) {
+        if (memcmp(g_fake_ow_bus.dev[i].rom, rom, 8) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/** Every rom found is on the bus and found once */
+static void check_found(uint8_t (*rom)[8], uint8_t num)
+{
+    uint8_t seen[FAKE_OW_DEVICES] = {0};
+
+    for (uint8_t i = 0; i < num; i++) {
+        int d = find_device(rom[i]);
+
+        HOST_CHECK(d >= 0);
+        if (d >= 0) {
+            HOST_CHECK_EQ(seen[d], 0);
+            seen[d] = 1;
+        }
+    }
+}
+
+/** Init a handle on the bus; the bus needs a device for the presence pulse */
+static void open_handle(ds18b20_handle_t *h, const ds18b20_bus_t *bus)
+{
+    DRIVER_DS18B20_LINK_INIT(h, ds18b20_handle_t);
+    DRIVER_DS18B20_LINK_BUS(h, bus);
+    HOST_CHECK_EQ(ds18b20_init(h), 0);
+}
+
+/** 64 random devices are all found, bit-banged and with the native triplet */
+static void test_full(const ds18b20_bus_t *bus)
+{
+    ds18b20_handle_t h;
+    uint8_t rom[DS18B20_MAX_SEARCH_SIZE][8];
+    uint8_t num = DS18B20_MAX_SEARCH_SIZE;
+
+    fake_ow_reset();
+    add_random(64);
+    open_handle(&h, bus);
+    g_fake_ow_bus.resets = 0;
+    HOST_CHECK_EQ(ds18b20_search_rom(&h, rom, &num), 0);
+    HOST_CHECK_EQ(num, 64);
+    check_found(rom, num);
+    HOST_CHECK_EQ(g_fake_ow_bus.resets, 64);
+    HOST_CHECK_EQ(g_fake_ow_bus.timing_errors, 0);
+    HOST_CHECK_EQ(g_fake_ow_bus.irq_depth, 0);
+    if (bus->bus_triplet != NULL) {
+        HOST_CHECK_EQ(g_fake_ow_bus.triplets, 64 * 64);
+    }
+}
+
+/** Roms that split at the first bit, the last bit and share long prefixes */
+static void test_discrepancies(const ds18b20_bus_t *bus)
+{
+    static const uint8_t base[8] = {0x28, 0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70};
+    static const uint8_t flips[][2] = { {0, 0x00}, {0, 0x01}, {7, 0x80}, {0, 0x01}, {3, 0x01}, {7, 0x40} };
+    ds18b20_handle_t h;
+    uint8_t rom[8][8];
+    uint8_t r[8];
+    uint8_t num = 8;
+
+    fake_ow_reset();
+    memcpy(r, base, 8);
+    /* cumulative flips give devices that differ from their predecessor in one bit */
+    for (uint8_t i = 0; i < sizeof(flips) / sizeof(flips[0]); i++) {
+        r[flips[i][0]] ^= flips[i][1];
+        fake_ow_add(r, 0);
+    }
+    open_handle(&h, bus);
+    HOST_CHECK_EQ(ds18b20_search_rom(&h, rom, &num), 0);
+    HOST_CHECK_EQ(num, g_fake_ow_bus.count);
+    check_found(rom, num);
+
+    /* The search goes in rom order, read lsb first: the 0 branch before the 1 branch */
+    for (uint8_t i = 1; i < num; i++) {
+        uint8_t b = 0;
+
+        while (b < 64 && ((rom[i][b >> 3] ^ rom[i - 1][b >> 3]) >> (b & 7) & 1) == 0) {
+            b++;
+        }
+        HOST_CHECK(b < 64);
+        if (b < 64) {
+            HOST_CHECK_EQ((rom[i][b >> 3] >> (b & 7)) & 1, 1);
+        }
+    }
+    HOST_CHECK_EQ(g_fake_ow_bus.timing_errors, 0);
+}
+
+/** A lone device ends the search after one pass; a short array stops it early */
+static void test_last_device(const ds18b20_bus_t *bus)
+{
+    ds18b20_handle_t h;
+    uint8_t rom[6][8];
+    uint8_t num;
+
+    fake_ow_reset();
+    add_random(1);
+    open_handle(&h, bus);
+    g_fake_ow_bus.resets = 0;
+    num = 4;
+    HOST_CHECK_EQ(ds18b20_search_rom(&h, rom, &num), 0);
+    HOST_CHECK_EQ(num, 1);
+    HOST_CHECK(memcmp(rom[0], g_fake_ow_bus.dev[0].rom, 8) == 0);
+    HOST_CHECK_EQ(g_fake_ow_bus.resets, 1);
+
+    /* 5 devices, room for 3: three passes and nothing written past rom[2] */
+    add_random(4);
+    memset(rom, 0xA5, sizeof(rom));
+    g_fake_ow_bus.resets = 0;
+    num = 3;
+    HOST_CHECK_EQ(ds18b20_search_rom(&h, rom, &num), 0);
+    HOST_CHECK_EQ(num, 3);
+    check_found(rom, num);
+    HOST_CHECK_EQ(g_fake_ow_bus.resets, 3);
+    for (uint8_t i = 0; i < 8; i++) {
+        HOST_CHECK_EQ(rom[3][i], 0xA5);
+    }
+
+    /* More than the driver allows */
+    num = DS18B20_MAX_SEARCH_SIZE + 1;
+    HOST_CHECK_EQ(ds18b20_search_rom(&h, rom, &num), 1);
+
+    /* Everybody left: no presence */
+    g_fake_ow_bus.count = 0;
+    num = 3;
+    HOST_CHECK_EQ(ds18b20_search_rom(&h, rom, &num), 1);
+}
+
+/** Alarm search finds only the devices with their alarm flag set */
+static void test_alarm(const ds18b20_bus_t *bus)
+{
+    ds18b20_handle_t h;
+    uint8_t rom[16][8];
+    uint8_t num = 16;
+
+    fake_ow_reset();
+    add_random(16);
+    for (uint8_t i = 0; i < 16; i += 3) {
+        g_fake_ow_bus.dev[i].alarm = 1;
+    }
+    open_handle(&h, bus);
+    HOST_CHECK_EQ(ds18b20_search_alarm(&h, rom, &num), 0);
+    HOST_CHECK_EQ(num, 6);
+    for (uint8_t i = 0; i < num; i++) {
+        int d = find_device(rom[i]);
+
+        HOST_CHECK(d >= 0 && g_fake_ow_bus.dev[d].alarm == 1);
+    }
+}
+
+/** Verify rom follows the handle's rom and fails on the first bit nobody has */
+static void test_verify(const ds18b20_bus_t *bus)
+{
+    ds18b20_handle_t h;
+    uint8_t rom[8];
+
+    fake_ow_reset();
+    add_random(8);
+    open_handle(&h, bus);
+    for (uint8_t i = 0; i < g_fake_ow_bus.count; i++) {
+        HOST_CHECK_EQ(ds18b20_set_rom(&h, g_fake_ow_bus.dev[i].rom), 0);
+        HOST_CHECK_EQ(ds18b20_verify_rom(&h), 0);
+    }
+    memcpy(rom, g_fake_ow_bus.dev[3].rom, 8);
+    rom[7] ^= 0x80;                             /* differs only in the last bit */
+    HOST_CHECK_EQ(ds18b20_set_rom(&h, rom), 0);
+    HOST_CHECK_EQ(ds18b20_verify_rom(&h), 1);
+    HOST_CHECK_EQ(g_fake_ow_bus.timing_errors, 0);
+}
+
+/** Full enumeration of 64 devices: simulated bus time and host time */
+static void bench(const char *name, const ds18b20_bus_t *bus)
+{
+    const uint32_t runs = 20;
+    ds18b20_handle_t h;
+    uint8_t rom[DS18B20_MAX_SEARCH_SIZE][8];
+    uint8_t num;
+    uint64_t bus_us;
+    clock_t t0;
+    double host_us;
+
+    fake_ow_reset();
+    add_random(64);
+    open_handle(&h, bus);
+    bus_us = g_fake_ow_bus.now_us;
+    t0 = clock();
+    for (uint32_t i = 0; i < runs; i++) {
+        num = DS18B20_MAX_SEARCH_SIZE;
+        HOST_CHECK_EQ(ds18b20_search_rom(&h, rom, &num), 0);
+        HOST_CHECK_EQ(num, 64);
+    }
+    host_us = (double)(clock() - t0) * 1e6 / CLOCKS_PER_SEC / runs;
+    bus_us = (g_fake_ow_bus.now_us - bus_us) / runs;
+    printf("search of 64 devices, %s: %.1f ms of bus time, %.0f us on the host with the model\n",
+           name, (double)bus_us / 1000.0, host_us);
+}
+
+int main(void)
+{
+    static const struct {
+        const char *name;
+        const ds18b20_bus_t *bus;
+    } buses[] = {
+        { "bit-banged", &gc_fake_ow_bus },
+        { "native triplet", &gc_fake_ow_bus_triplet },
+    };
+
+    for (uint8_t i = 0; i < 2; i++) {
+        test_full(buses[i].bus);
+        test_discrepancies(buses[i].bus);
+        test_last_device(buses[i].bus);
+        test_alarm(buses[i].bus);
+        test_verify(buses[i].bus);
+        bench(buses[i].name, buses[i].bus);
+    }
+
+    return HOST_TEST_RESULT();
+}
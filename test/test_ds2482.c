@@ -0,0 +1,251 @@
+/**
+ * @file      test_ds2482.c
+ * @brief     Host test: ds2482.c against the bridge model, 1 or 8 channels
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "host_test.h"
+#include "fake_pico.h"
+#include "fake_ds2482.h"
+#include "ds2482.h"
+
+#define ST_RST    0x10
+
+/** The bridge mutex is free again and was never taken twice */
+static void check_unlocked(void)
+{
+    HOST_CHECK(g_fake_pico.last_mutex != NULL);
+    if (g_fake_pico.last_mutex != NULL) {
+        HOST_CHECK_EQ(g_fake_pico.last_mutex->held, 0);
+        HOST_CHECK_EQ(g_fake_pico.last_mutex->misuse, 0);
+    }
+}
+
+/** Power up the model and bring the driver up on it */
+static void bring_up(void)
+{
+    fake_pico_reset();
+    fake_ds2482_reset(DS2482_CHANNELS);
+    HOST_CHECK_EQ(ds2482_init(), 0);
+}
+
+/** Close the driver whatever its user count */
+static void bring_down(void)
+{
+    while (ds2482_deinit() == 0) {
+    }
+}
+
+/** Init resets the bridge, writes the config with its complement and is counted */
+static void test_init(void)
+{
+    uint32_t transfers;
+
+    bring_up();
+    HOST_CHECK_EQ(g_fake_ds2482.config, DS2482_ACTIVE_PULLUP ? 0x01 : 0x00);
+    HOST_CHECK_EQ(g_fake_ds2482.status & ST_RST, 0);
+    check_unlocked();
+
+    /* A second bus on the bridge only counts */
+    transfers = g_fake_ds2482.transfers;
+    HOST_CHECK_EQ(ds2482_init(), 0);
+    HOST_CHECK_EQ(g_fake_ds2482.transfers, transfers);
+    HOST_CHECK_EQ(ds2482_deinit(), 0);
+    HOST_CHECK_EQ(g_fake_ds2482.i2c_up, 1);
+    HOST_CHECK_EQ(ds2482_deinit(), 0);
+    HOST_CHECK_EQ(g_fake_ds2482.i2c_up, 0);
+    HOST_CHECK_EQ(ds2482_deinit(), 1);
+
+    /* Nobody at the address */
+    fake_ds2482_reset(DS2482_CHANNELS);
+    g_fake_ds2482.address = 0x19;
+    HOST_CHECK_EQ(ds2482_init(), 1);
+    HOST_CHECK_EQ(g_fake_ds2482.i2c_up, 0);
+
+    /* The config read back must match what was written */
+    fake_ds2482_reset(DS2482_CHANNELS);
+    g_fake_ds2482.ignore_config = 1;
+    HOST_CHECK_EQ(ds2482_init(), 1);
+    HOST_CHECK_EQ(g_fake_ds2482.i2c_up, 0);
+
+    /* The status read after the device reset is NACKed */
+    fake_ds2482_reset(DS2482_CHANNELS);
+    g_fake_ds2482.nack_after = 2;
+    HOST_CHECK_EQ(ds2482_init(), 1);
+    HOST_CHECK_EQ(ds2482_deinit(), 1);
+}
+
+/** Reset maps PPD and SD, waits out 1WB and gives up on a stuck bridge */
+static void test_reset(void)
+{
+    bring_up();
+    HOST_CHECK_EQ(ds2482_reset(0), 1);
+    g_fake_ds2482.ch[0].presence = 1;
+    HOST_CHECK_EQ(ds2482_reset(0), 0);
+    g_fake_ds2482.ch[0].shorted = 1;
+    HOST_CHECK_EQ(ds2482_reset(0), 2);
+    g_fake_ds2482.ch[0].shorted = 0;
+
+    g_fake_ds2482.busy_reads = 20;
+    HOST_CHECK_EQ(ds2482_reset(0), 0);
+    HOST_CHECK_EQ(g_fake_ds2482.busy_left, 0);
+
+    g_fake_ds2482.busy_reads = 0;
+    g_fake_ds2482.stuck_busy = 1;
+    fake_pico_reset();
+    g_fake_pico.step_us = 10;
+    HOST_CHECK_EQ(ds2482_reset(0), 2);
+    HOST_CHECK(g_fake_pico.now_us >= DS2482_BUSY_TIMEOUT_US);
+    g_fake_ds2482.stuck_busy = 0;
+    g_fake_pico.step_us = 1;
+    HOST_CHECK_EQ(ds2482_reset(0), 0);
+
+    g_fake_ds2482.nack_after = g_fake_ds2482.transfers + 1;
+    HOST_CHECK_EQ(ds2482_reset(0), 2);
+    check_unlocked();
+    bring_down();
+}
+
+/** Whole 0xFF bytes are read byte commands, other bytes write byte, the rest single bits */
+static void test_touch(void)
+{
+    const uint8_t tx[3] = { 0xCC, 0xFF, 0x0D };   /* skip rom, a read byte, 5 mixed slots */
+    uint8_t rx[3];
+    fake_ds2482_channel_t *c;
+
+    bring_up();
+    c = &g_fake_ds2482.ch[0];
+    c->read[0] = 0x5A;
+    c->read[1] = 0x02;                          /* single bit reads: 0, 1, ... */
+    c->read_len = 2;
+    g_fake_ds2482.busy_reads = 3;
+
+    memset(rx, 0xEE, sizeof(rx));
+    HOST_CHECK_EQ(ds2482_touch(0, tx, rx, 21), 0);
+    HOST_CHECK_EQ(c->written_len, 1);
+    HOST_CHECK_EQ(c->written[0], 0xCC);
+    HOST_CHECK_EQ(rx[0], 0xCC);
+    HOST_CHECK_EQ(rx[1], 0x5A);
+    HOST_CHECK_EQ(c->bits_written, 5);
+    /* slots 1 0 1 1 0: the write-0 slots read 0, the read slots get 0, 1, 0 from the chip */
+    HOST_CHECK_EQ(rx[2], 0x04);
+
+    /* rx may be NULL */
+    HOST_CHECK_EQ(ds2482_touch(0, tx, NULL, 8), 0);
+    HOST_CHECK_EQ(c->written_len, 2);
+
+    /* A NACK in the middle of a block fails it and frees the bridge */
+    g_fake_ds2482.nack_after = g_fake_ds2482.transfers + 3;
+    HOST_CHECK_EQ(ds2482_touch(0, tx, rx, 24), 1);
+    g_fake_ds2482.nack_after = 0;
+    check_unlocked();
+    bring_down();
+}
+
+/** Triplet status bits: SBR, TSB and DIR */
+static void test_triplet(void)
+{
+    static const uint8_t bits[4][2] = { {0, 1}, {1, 0}, {0, 0}, {0, 0} };
+    fake_ds2482_channel_t *c;
+    uint8_t id, cmp, taken;
+
+    bring_up();
+    c = &g_fake_ds2482.ch[0];
+    memcpy(c->triplet, bits, sizeof(bits));
+    c->triplet_len = 4;
+
+    HOST_CHECK_EQ(ds2482_triplet(0, 1, &id, &cmp, &taken), 0);
+    HOST_CHECK(id == 0 && cmp == 1 && taken == 0);      /* only 0 answered */
+    HOST_CHECK_EQ(ds2482_triplet(0, 0, &id, &cmp, &taken), 0);
+    HOST_CHECK(id == 1 && cmp == 0 && taken == 1);      /* only 1 answered */
+    HOST_CHECK_EQ(ds2482_triplet(0, 1, &id, &cmp, &taken), 0);
+    HOST_CHECK(id == 0 && cmp == 0 && taken == 1);      /* both: the direction given */
+    HOST_CHECK_EQ(ds2482_triplet(0, 0, &id, &cmp, &taken), 0);
+    HOST_CHECK(id == 0 && cmp == 0 && taken == 0);
+    HOST_CHECK_EQ(ds2482_triplet(0, 0, &id, &cmp, &taken), 0);
+    HOST_CHECK(id == 1 && cmp == 1);                    /* nobody */
+    check_unlocked();
+    bring_down();
+}
+
+/** Channel select: codes, read-back check, only on a change, and invalid channels */
+static void test_channels(void)
+{
+    uint8_t id, cmp, taken;
+    uint32_t takes;
+
+    bring_up();
+    takes = g_fake_pico.last_mutex->takes;
+    HOST_CHECK_EQ(ds2482_reset(DS2482_CHANNELS), 2);
+    HOST_CHECK_EQ(g_fake_pico.last_mutex->takes, takes);
+    if (DS2482_CHANNELS == 1) {
+        g_fake_ds2482.ch[0].presence = 1;
+        HOST_CHECK_EQ(ds2482_reset(0), 0);
+        HOST_CHECK_EQ(g_fake_ds2482.chsl, 0);           /* a DS2482-100 NACKs CHSL */
+        bring_down();
+        return;
+    }
+
+    /* Every channel answers on its own bus; the first command selects, repeats do not */
+    for (uint8_t ch = 0; ch < DS2482_CHANNELS; ch++) {
+        g_fake_ds2482.ch[ch].presence = (ch & 1);
+    }
+    for (uint8_t ch = 0; ch < DS2482_CHANNELS; ch++) {
+        HOST_CHECK_EQ(ds2482_reset(ch), (ch & 1) ? 0 : 1);
+        HOST_CHECK_EQ(g_fake_ds2482.channel, ch);
+        HOST_CHECK_EQ(g_fake_ds2482.chsl, ch + 1u);
+        HOST_CHECK_EQ(ds2482_reset(ch), (ch & 1) ? 0 : 1);
+        HOST_CHECK_EQ(g_fake_ds2482.chsl, ch + 1u);
+    }
+
+    /* A wrong read-back fails the command and forces a select next time */
+    g_fake_ds2482.bad_chsl_ack = 1;
+    HOST_CHECK_EQ(ds2482_triplet(2, 0, &id, &cmp, &taken), 1);
+    g_fake_ds2482.bad_chsl_ack = 0;
+    HOST_CHECK_EQ(ds2482_reset(2), 1);
+    HOST_CHECK_EQ(g_fake_ds2482.channel, 2);
+    g_fake_ds2482.chsl = 0;
+    HOST_CHECK_EQ(ds2482_reset(2), 1);
+    HOST_CHECK_EQ(g_fake_ds2482.chsl, 0);
+
+    /* A bridge reset behind the driver's back shows up as the wrong channel */
+    g_fake_ds2482.channel = 0;
+    HOST_CHECK_EQ(ds2482_reset(5), 0);
+    HOST_CHECK_EQ(g_fake_ds2482.channel, 5);
+    check_unlocked();
+    bring_down();
+}
+
+int main(void)
+{
+    test_init();
+    test_reset();
+    test_touch();
+    test_triplet();
+    test_channels();
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,139 @@
+/**
+ * @file      test_flash_log.c
+ * @brief     Host test: flash sample log paging and failed erase/program handling
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "host_test.h"
+#include "fake_flash_region.h"
+#include "flash_log.h"
+#include "sample_codec.h"
+
+static const flash_region_t gc_region = { .offset = 0, .size = 4 * FLASH_REGION_SECTOR_SIZE };
+
+static flash_log_t gs_log;
+static uint32_t gs_next;                 /* samples generated so far */
+
+static uint8_t append(uint32_t n)
+{
+    radio_sample_t s;
+    uint8_t res = 0;
+
+    for (uint32_t i = 0; i < n; ++i, ++gs_next) {
+        s.time_ms = gs_next * 1000u;
+        s.raw = (int16_t)(400 + (gs_next % 3));
+        s.sensor = (uint8_t)(gs_next % 2);
+        res |= flash_log_append(&gs_log, &s);
+        HOST_CHECK(gs_log.staged <= FLASH_LOG_STAGE_SAMPLES);
+    }
+    return res;
+}
+
+/** Every stored page passes its CRC and decodes; returns the samples in them */
+static uint32_t check_pages(void)
+{
+    uint8_t page[FLASH_REGION_PAGE_SIZE];
+    radio_sample_t out[FLASH_LOG_STAGE_SAMPLES];
+    uint32_t total = 0;
+    uint16_t len;
+    uint8_t count;
+
+    for (uint32_t i = 0; i < flash_log_pages(&gs_log); ++i) {
+        HOST_CHECK_EQ(flash_log_read_page(&gs_log, i, page), 0);
+        len = (uint16_t)(page[6] | (page[7] << 8));
+        HOST_CHECK_EQ(sample_codec_decode_block(&page[FLASH_LOG_HEADER_SIZE], len, out,
+                                                FLASH_LOG_STAGE_SAMPLES, &count), 0);
+        total += count;
+    }
+    return total;
+}
+
+static void setup(void)
+{
+    fake_flash_reset();
+    gs_next = 0;
+    HOST_CHECK_EQ(flash_log_init(&gs_log, &gc_region), 0);
+}
+
+static void test_pages(void)
+{
+    setup();
+    HOST_CHECK_EQ(append(1000), 0);
+    HOST_CHECK_EQ(flash_log_flush(&gs_log), 0);
+    HOST_CHECK_EQ(gs_log.staged, 0);
+    HOST_CHECK_EQ(check_pages(), 1000);
+    HOST_CHECK_EQ(gs_log.stats.samples, 1000);
+
+    /* the head is found again after a reset */
+    HOST_CHECK_EQ(flash_log_init(&gs_log, &gc_region), 0);
+    HOST_CHECK_EQ(check_pages(), 1000);
+}
+
+/** A failed erase keeps the full stage; further samples are refused, never written past it */
+static void test_failed_erase(void)
+{
+    setup();
+    g_fake_flash.fail_erases = 1000;
+    HOST_CHECK_EQ(append(FLASH_LOG_STAGE_SAMPLES), 1);
+    HOST_CHECK_EQ(gs_log.staged, FLASH_LOG_STAGE_SAMPLES);
+    HOST_CHECK_EQ(append(10), 1);
+    HOST_CHECK_EQ(gs_log.staged, FLASH_LOG_STAGE_SAMPLES);
+    HOST_CHECK_EQ(gs_log.stats.dropped, 10);
+    HOST_CHECK_EQ(flash_log_pages(&gs_log), 0);
+    HOST_CHECK_EQ(flash_log_flush(&gs_log), 1);                /* gives up instead of spinning */
+
+    /* flash recovers: the staged page goes out on the next sample */
+    g_fake_flash.fail_erases = 0;
+    HOST_CHECK_EQ(append(1), 0);
+    HOST_CHECK(gs_log.staged < FLASH_LOG_STAGE_SAMPLES);
+    HOST_CHECK_EQ(flash_log_flush(&gs_log), 0);
+    HOST_CHECK_EQ(check_pages(), FLASH_LOG_STAGE_SAMPLES + 1);
+}
+
+/** A failed program leaves the head on the still erased page and retries it */
+static void test_failed_program(void)
+{
+    uint32_t head;
+
+    setup();
+    HOST_CHECK_EQ(append(FLASH_LOG_STAGE_SAMPLES), 0);
+    g_fake_flash.fail_programs = 1;
+    do {
+        head = gs_log.head;
+    } while (append(1) == 0);
+    HOST_CHECK_EQ(gs_log.head, head);
+    HOST_CHECK_EQ(gs_log.staged, FLASH_LOG_STAGE_SAMPLES);
+    HOST_CHECK_EQ(append(3 * FLASH_LOG_STAGE_SAMPLES - gs_next), 0);
+    HOST_CHECK_EQ(flash_log_flush(&gs_log), 0);
+    HOST_CHECK_EQ(g_fake_flash.reprograms, 0);
+    HOST_CHECK_EQ(check_pages(), 3 * FLASH_LOG_STAGE_SAMPLES);
+}
+
+int main(void)
+{
+    test_pages();
+    test_failed_erase();
+    test_failed_program();
+    return HOST_TEST_RESULT();
+}
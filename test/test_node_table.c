@@ -0,0 +1,150 @@
+/**
+ * @file      test_node_table.c
+ * @brief     Host test: node_table de-duplication, reordering and node restarts
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "host_test.h"
+#include "node_table.h"
+#include <string.h>
+
+static uint32_t gs_delivered;
+static uint16_t gs_last_seq;
+
+static void deliver(void *ctx, const radio_frame_t *frame)
+{
+    (void)ctx;
+    gs_delivered++;
+    memcpy(&gs_last_seq, frame->data, sizeof(gs_last_seq));
+}
+
+static uint8_t push(node_table_t *t, uint8_t node, uint16_t seq, uint32_t now_ms)
+{
+    radio_frame_t frame;
+
+    memset(&frame, 0, sizeof(frame));
+    memcpy(frame.data, &seq, sizeof(seq));
+    return node_table_push(t, node, seq, &frame, now_ms);
+}
+
+static void reset(node_table_t *t)
+{
+    node_table_init(t, deliver, NULL);
+    gs_delivered = 0;
+}
+
+/** In order, retransmissions and a short reorder */
+static void test_in_order(void)
+{
+    node_table_t t;
+    const node_entry_t *e;
+
+    reset(&t);
+    for (uint16_t s = 0; s < 100; ++s) {
+        HOST_CHECK_EQ(push(&t, 1, s, s), 0);
+        if ((s % 10) == 0) {
+            HOST_CHECK_EQ(push(&t, 1, s, s), 1);              /* lost ack, same payload again */
+        }
+    }
+    HOST_CHECK_EQ(push(&t, 1, 101, 100), 0);                  /* held for 100 */
+    HOST_CHECK_EQ(push(&t, 1, 100, 100), 0);
+    e = node_table_find(&t, 1);
+    HOST_CHECK(e != NULL);
+    HOST_CHECK_EQ(gs_delivered, 102);
+    HOST_CHECK_EQ(gs_last_seq, 101);
+    HOST_CHECK_EQ(e->stats.duplicates, 10);
+    HOST_CHECK_EQ(e->stats.reordered, 1);
+    HOST_CHECK_EQ(e->stats.restarts, 0);
+}
+
+/** A rebooted node starts again at seq 0 and must not be taken for duplicates */
+static void test_restart(void)
+{
+    node_table_t t;
+    const node_entry_t *e;
+
+    reset(&t);
+    for (uint16_t s = 0; s < 200; ++s) {
+        (void)push(&t, 2, s, s);
+    }
+    for (uint16_t s = 0; s < 100; ++s) {
+        HOST_CHECK_EQ(push(&t, 2, s, 1000 + s), 0);
+    }
+    e = node_table_find(&t, 2);
+    HOST_CHECK_EQ(gs_delivered, 300);
+    HOST_CHECK_EQ(e->stats.duplicates, 0);
+    HOST_CHECK_EQ(e->stats.restarts, 1);
+
+    /* Reboot again, this time seq 0 and 1 are lost on the air */
+    for (uint16_t s = 2; s < 50; ++s) {
+        HOST_CHECK_EQ(push(&t, 2, s, 2000 + s), 0);
+    }
+    HOST_CHECK_EQ(gs_delivered, 348);
+    HOST_CHECK_EQ(e->stats.restarts, 2);
+}
+
+/** A node rebooting right after its first few payloads still restarts on seq 0 */
+static void test_early_restart(void)
+{
+    node_table_t t;
+    const node_entry_t *e;
+
+    reset(&t);
+    for (uint16_t s = 0; s < 3; ++s) {
+        (void)push(&t, 3, s, s);
+    }
+    for (uint16_t s = 0; s < 10; ++s) {
+        HOST_CHECK_EQ(push(&t, 3, s, 100 + s), 0);
+    }
+    e = node_table_find(&t, 3);
+    HOST_CHECK_EQ(gs_delivered, 13);
+    HOST_CHECK_EQ(e->stats.restarts, 1);
+    HOST_CHECK_EQ(e->stats.duplicates, 0);
+}
+
+/** The counter wrapping from 65535 to 0 is not a restart */
+static void test_wrap(void)
+{
+    node_table_t t;
+    const node_entry_t *e;
+
+    reset(&t);
+    for (uint32_t s = 65530; s < 65546; ++s) {
+        HOST_CHECK_EQ(push(&t, 4, (uint16_t)s, s), 0);
+    }
+    HOST_CHECK_EQ(push(&t, 4, 9, 70000), 1);                  /* retransmission after the wrap */
+    e = node_table_find(&t, 4);
+    HOST_CHECK_EQ(gs_delivered, 16);
+    HOST_CHECK_EQ(e->stats.restarts, 0);
+    HOST_CHECK_EQ(e->stats.duplicates, 1);
+}
+
+int main(void)
+{
+    test_in_order();
+    test_restart();
+    test_early_restart();
+    test_wrap();
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,120 @@
+/**
+ * @file      test_ow_edge.c
+ * @brief     Host test: presence pulse edge capture of the interrupt-timed reset
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "host_test.h"
+#include "ow_edge.h"
+
+/** One run of the GPIO interrupt: the edges latched since the last one */
+typedef struct {
+    uint32_t at_us;            /**< service time after the release */
+    uint8_t fall;
+    uint8_t rise;
+} edge_irq_t;
+
+/** A reset as the driver sees it: interrupts after the release, then the level at the window end */
+typedef struct {
+    const char *name;
+    uint32_t t0;
+    edge_irq_t irq[4];
+    uint8_t irqs;
+    uint8_t line_high;
+    uint8_t res;
+    uint8_t presence_us;
+    uint8_t width_us;
+} edge_case_t;
+
+static const edge_case_t gc_cases[] = {
+    /* release edge, then a 120 us presence pulse 30 us later */
+    {"presence", 1000, {{0, 0, 1}, {30, 1, 0}, {150, 0, 1}}, 3, 1, 0, 30, 120},
+    /* only the release edge: nobody on the bus */
+    {"no presence", 1000, {{0, 0, 1}}, 1, 1, 1, 0, 0},
+    /* no edge at all and the line still low at the window end */
+    {"stuck low", 1000, {{0}}, 0, 0, 2, 0, 0},
+    /* the section ends late: release rise and presence fall served together */
+    {"late release", 1000, {{40, 1, 1}, {160, 0, 1}}, 2, 1, 0, 40, 120},
+    /* the whole pulse latched in one late interrupt */
+    {"pulse in one irq", 1000, {{0, 0, 1}, {200, 1, 1}}, 2, 1, 0, 200, 0},
+    /* a glitch inside the pulse does not move its start */
+    {"glitch", 1000, {{0, 0, 1}, {30, 1, 0}, {60, 1, 1}, {150, 0, 1}}, 4, 1, 0, 30, 120},
+    /* out of spec delays clamp to the 8 bit fields */
+    {"clamp", 1000, {{0, 0, 1}, {300, 1, 0}, {700, 0, 1}}, 3, 1, 0, 255, 255},
+    /* the release timestamp just before time_us_32() wraps */
+    {"wrap", 0xFFFFFFF0u, {{0, 0, 1}, {30, 1, 0}, {150, 0, 1}}, 3, 1, 0, 30, 120},
+};
+
+/** Arm, feed the interrupts and decode, like a_ds18b20_gpio_reset() */
+static uint8_t run_reset(ow_edge_capture_t *c, const edge_case_t *r, uint8_t *presence_us, uint8_t *width_us)
+{
+    ow_edge_arm(c);
+    for (uint8_t i = 0; i < r->irqs; i++) {
+        ow_edge_event(c, r->irq[i].fall, r->irq[i].rise, r->t0 + r->irq[i].at_us);
+    }
+    return ow_edge_decode(c, r->t0, r->line_high, presence_us, width_us);
+}
+
+/** Every case on a fresh capture */
+static void test_cases(void)
+{
+    for (size_t i = 0; i < sizeof(gc_cases) / sizeof(gc_cases[0]); i++) {
+        const edge_case_t *r = &gc_cases[i];
+        ow_edge_capture_t c = {0};
+        uint8_t presence = 0xAA;
+        uint8_t width = 0xAA;
+        uint8_t res = run_reset(&c, r, &presence, &width);
+
+        if (res != r->res || presence != r->presence_us || width != r->width_us) {
+            fprintf(stderr, "case %s: res %u presence %u width %u\n", r->name, res, presence, width);
+        }
+        HOST_CHECK_EQ(res, r->res);
+        HOST_CHECK_EQ(presence, r->presence_us);
+        HOST_CHECK_EQ(width, r->width_us);
+    }
+}
+
+/** Arming forgets the edges of the previous reset on the same bus */
+static void test_rearm(void)
+{
+    ow_edge_capture_t c = {0};
+    uint8_t presence;
+    uint8_t width;
+
+    HOST_CHECK_EQ(run_reset(&c, &gc_cases[0], &presence, &width), 0);
+    HOST_CHECK_EQ(run_reset(&c, &gc_cases[1], &presence, &width), 1);
+    HOST_CHECK_EQ(presence, 0);
+    HOST_CHECK_EQ(width, 0);
+    HOST_CHECK_EQ(run_reset(&c, &gc_cases[0], &presence, &width), 0);
+    HOST_CHECK_EQ(presence, 30);
+    HOST_CHECK_EQ(width, 120);
+}
+
+int main(void)
+{
+    test_cases();
+    test_rearm();
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,174 @@
+/**
+ * @file      test_ow_tune.c
+ * @brief     Host test: ow_tune profiles stay in the 1-Wire slot spec
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "host_test.h"
+#include "fake_dlog.h"
+#include "ow_tune.h"
+
+static const ds18b20_timing_t gc_standard = DS18B20_TIMING_STANDARD;
+
+/** Check a timing table against the DS18B20 slot spec for a bus rising in rise_us */
+static void check_spec(const ds18b20_timing_t *t, uint32_t rise_us)
+{
+    HOST_CHECK(t->reset_low_us >= 480);
+    HOST_CHECK(t->presence_wait_us >= 15 && t->presence_wait_us <= 60);
+    HOST_CHECK(t->write1_low_us >= 1 && t->write1_low_us + rise_us < 15);
+    HOST_CHECK(t->write1_low_us + t->write1_high_us >= 60);
+    HOST_CHECK(t->write0_low_us >= 60 && t->write0_low_us <= 120);
+    HOST_CHECK(t->write0_high_us >= 1);
+    HOST_CHECK(t->read_low_us >= 1);
+    HOST_CHECK(t->read_low_us + t->read_sample_us < 15);
+    HOST_CHECK(t->read_sample_us >= rise_us);
+    HOST_CHECK(t->read_low_us + t->read_sample_us + t->read_high_us >= 60);
+}
+
+/** Apply a measurement with the given rise and typical presence */
+static uint8_t apply_rise(ow_tune_t *tune, ds18b20_timing_t *t, uint32_t rise_ns)
+{
+    ow_tune_measure_t m = { rise_ns, 30, 120 };
+
+    return ow_tune_apply(tune, t, &m);
+}
+
+/** Unmeasured buses get the standard table; the frame counters survive */
+static void test_standard(void)
+{
+    ow_tune_t tune;
+    ds18b20_timing_t t = gc_standard;
+
+    memset(&tune, 0, sizeof(tune));
+    t.frames = 100;
+    t.crc_errors = 3;
+    t.write0_low_us = 1;
+    HOST_CHECK_EQ(ow_tune_apply(&tune, &t, NULL), OW_TUNE_STANDARD);
+    HOST_CHECK_EQ(t.frames, 100);
+    HOST_CHECK_EQ(t.crc_errors, 3);
+    HOST_CHECK_EQ(t.write0_low_us, gc_standard.write0_low_us);
+    HOST_CHECK_EQ(t.read_sample_us, gc_standard.read_sample_us);
+    check_spec(&gc_standard, 0);
+}
+
+/** Every rise up to the limit picks an in-spec table; slower ones stay standard */
+static void test_sweep(void)
+{
+    ow_tune_t tune;
+    ds18b20_timing_t t = gc_standard;
+    uint8_t profile;
+
+    memset(&tune, 0, sizeof(tune));
+    for (uint32_t rise_ns = 0; rise_ns <= 20000; rise_ns += 250) {
+        profile = apply_rise(&tune, &t, rise_ns);
+        if (rise_ns < 1000) {
+            HOST_CHECK_EQ(profile, OW_TUNE_SHORT);
+        } else if (rise_ns <= 11000) {
+            HOST_CHECK_EQ(profile, OW_TUNE_LONG);
+        } else {
+            HOST_CHECK_EQ(profile, OW_TUNE_STANDARD);
+            continue;
+        }
+        check_spec(&t, (rise_ns + 999) / 1000);
+    }
+}
+
+/** Presence loops are bounded by the measurement but never beyond the standard */
+static void test_presence_bounds(void)
+{
+    ow_tune_t tune;
+    ds18b20_timing_t t = gc_standard;
+    ow_tune_measure_t m = { 500, 20, 100 };
+
+    memset(&tune, 0, sizeof(tune));
+    (void)ow_tune_apply(&tune, &t, &m);
+    HOST_CHECK_EQ(t.presence_max_us, 60);
+    HOST_CHECK_EQ(t.presence_end_us, 220);
+
+    m.presence_delay_us = 200;
+    m.presence_width_us = 240;
+    (void)ow_tune_apply(&tune, &t, &m);
+    HOST_CHECK_EQ(t.presence_max_us, gc_standard.presence_max_us);
+    HOST_CHECK_EQ(t.presence_end_us, gc_standard.presence_end_us);
+}
+
+/** Run one revalidation window with the given number of CRC errors */
+static uint8_t window(ow_tune_t *tune, ds18b20_timing_t *t, uint32_t errors)
+{
+    t->frames += OW_TUNE_WINDOW;
+    t->crc_errors += errors;
+
+    return ow_tune_check(tune, t);
+}
+
+/** CRC errors on a tuned bus fall back to standard, clean windows ask for a new measurement */
+static void test_fallback(void)
+{
+    ow_tune_t tune;
+    ds18b20_timing_t t = gc_standard;
+
+    memset(&tune, 0, sizeof(tune));
+    fake_dlog_reset();
+    HOST_CHECK_EQ(apply_rise(&tune, &t, 500), OW_TUNE_SHORT);
+
+    /* Not a full window yet */
+    t.frames += OW_TUNE_WINDOW - 1;
+    t.crc_errors += 5;
+    HOST_CHECK_EQ(ow_tune_check(&tune, &t), 0);
+    HOST_CHECK_EQ(tune.profile, OW_TUNE_SHORT);
+
+    t.frames += 1;
+    HOST_CHECK_EQ(ow_tune_check(&tune, &t), 0);
+    HOST_CHECK_EQ(tune.profile, OW_TUNE_STANDARD);
+    HOST_CHECK_EQ(tune.fallbacks, 1);
+    HOST_CHECK_EQ(t.reset_low_us, gc_standard.reset_low_us);
+    HOST_CHECK_EQ(g_fake_dlog.count[DLOG_OW_TUNE_FALLBACK], ((int)DLOG_LEVEL_OF_OW_TUNE_FALLBACK <= (int)DLOG_LEVEL) ? 1 : 0);
+
+    /* An error window restarts the clean count */
+    for (uint32_t i = 0; i < OW_TUNE_RETRY_WINDOWS - 1; ++i) {
+        HOST_CHECK_EQ(window(&tune, &t, 0), 0);
+    }
+    HOST_CHECK_EQ(window(&tune, &t, 1), 0);
+    for (uint32_t i = 0; i < OW_TUNE_RETRY_WINDOWS - 1; ++i) {
+        HOST_CHECK_EQ(window(&tune, &t, 0), 0);
+    }
+    HOST_CHECK_EQ(window(&tune, &t, 0), 1);
+
+    /* The standard table itself never falls back */
+    HOST_CHECK_EQ(ow_tune_apply(&tune, &t, NULL), OW_TUNE_STANDARD);
+    HOST_CHECK_EQ(window(&tune, &t, 10), 0);
+    HOST_CHECK_EQ(tune.fallbacks, 1);
+}
+
+int main(void)
+{
+    test_standard();
+    test_sweep();
+    test_presence_bounds();
+    test_fallback();
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,149 @@
+/**
+ * @file      test_ow_uart.c
+ * @brief     Host test: UART 1-Wire slot and reset codec against a line model
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "host_test.h"
+#include "ow_uart.h"
+
+#define SLOT_BIT_NS    (1000000000u / OW_UART_SLOT_BAUD)
+#define RESET_BIT_NS   (1000000000u / OW_UART_RESET_BAUD)
+
+/**
+ * Echo of one UART byte on an open-drain bus: TX sends the start bit and
+ * data bits lsb first, a chip holds the line low from low_from_ns to
+ * low_to_ns after the start edge, and RX samples each data bit mid-bit.
+ */
+static uint8_t line_echo(uint8_t tx, uint32_t bit_ns, uint32_t low_from_ns, uint32_t low_to_ns)
+{
+    uint8_t echo = 0;
+
+    for (uint8_t n = 0; n < 8; n++) {
+        uint32_t t = bit_ns + n * bit_ns + bit_ns / 2;
+        uint8_t level = (tx >> n) & 1;
+
+        if (t >= low_from_ns && t < low_to_ns) {
+            level = 0;
+        }
+        echo |= (uint8_t)(level << n);
+    }
+    return echo;
+}
+
+/** Encode and decode invert each other, for block lengths that are not whole bytes too */
+static void test_round_trip(void)
+{
+    uint8_t bits[4] = {0xA5, 0x3C, 0x81, 0x7E};
+    uint8_t slots[32];
+    uint8_t out[4];
+
+    ow_uart_encode(bits, 32, slots);
+    HOST_CHECK_EQ(slots[0], OW_UART_SLOT_1);
+    HOST_CHECK_EQ(slots[1], OW_UART_SLOT_0);
+    ow_uart_decode(slots, 32, out);
+    HOST_CHECK(memcmp(out, bits, 4) == 0);
+
+    /* 13 slots: the unused bits of the last byte read 0 */
+    memset(out, 0xFF, sizeof(out));
+    ow_uart_decode(slots, 13, out);
+    HOST_CHECK_EQ(out[0], 0xA5);
+    HOST_CHECK_EQ(out[1], 0x3C & 0x1F);
+    HOST_CHECK_EQ(out[2], 0xFF);                 /* past the block, untouched */
+}
+
+/** Without a chip answering, every slot echoes what was sent */
+static void test_write_echo(void)
+{
+    uint8_t bits[2] = {0x5A, 0xC3};
+    uint8_t slots[16];
+    uint8_t echo[16];
+    uint8_t out[2];
+
+    ow_uart_encode(bits, 16, slots);
+    for (uint8_t i = 0; i < 16; i++) {
+        echo[i] = line_echo(slots[i], SLOT_BIT_NS, 0, 0);
+        HOST_CHECK_EQ(echo[i], slots[i]);
+    }
+    ow_uart_decode(echo, 16, out);
+    HOST_CHECK(memcmp(out, bits, 2) == 0);
+}
+
+/** Read slots: a chip sending 0 holds the line 15 to 60 us, which always clears bit 0 of the echo */
+static void test_read_slots(void)
+{
+    const uint8_t byte = 0xA5;
+    const uint8_t ones = 0xFF;
+    uint8_t slots[8];
+    uint8_t echo[8];
+    uint8_t out;
+
+    for (uint32_t hold_us = 15; hold_us <= 60; hold_us += 5) {
+        ow_uart_encode(&ones, 8, slots);
+        for (uint8_t i = 0; i < 8; i++) {
+            uint32_t low_to = ((byte >> i) & 1) ? 0 : hold_us * 1000;
+
+            echo[i] = line_echo(slots[i], SLOT_BIT_NS, 0, low_to);
+        }
+        ow_uart_decode(echo, 8, &out);
+        HOST_CHECK_EQ(out, byte);
+    }
+}
+
+/** Reset: no chip, a stuck bus, and presence pulses across the spec */
+static void test_reset(void)
+{
+    const uint32_t release_ns = 5 * RESET_BIT_NS;    /* start bit plus four 0 bits */
+    uint8_t width;
+
+    HOST_CHECK_EQ(ow_uart_reset_decode(line_echo(OW_UART_RESET_BYTE, RESET_BIT_NS, 0, 0), &width), 1);
+    HOST_CHECK_EQ(width, 0);
+    HOST_CHECK_EQ(ow_uart_reset_decode(line_echo(OW_UART_RESET_BYTE, RESET_BIT_NS, 0, UINT32_MAX), &width), 2);
+    HOST_CHECK_EQ(width, 0);
+
+    /* A presence this wide always covers a sample point. A 60 us pulse that starts late
+       can fall between two of them; at 9600 baud the reset cannot see it */
+    for (uint32_t wait_us = 15; wait_us <= 60; wait_us += 5) {
+        for (uint32_t width_us = 120; width_us <= 240; width_us += 20) {
+            uint32_t from = release_ns + wait_us * 1000;
+            uint8_t echo = line_echo(OW_UART_RESET_BYTE, RESET_BIT_NS, from, from + width_us * 1000);
+
+            HOST_CHECK_EQ(ow_uart_reset_decode(echo, &width), 0);
+            HOST_CHECK(width >= OW_UART_RESET_BIT_US);
+            HOST_CHECK(width <= width_us + OW_UART_RESET_BIT_US);
+        }
+    }
+}
+
+int main(void)
+{
+    test_round_trip();
+    test_write_echo();
+    test_read_slots();
+    test_reset();
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,261 @@
+/**
+ * @file      test_radio_link.c
+ * @brief     Host test: node to base station delivery over a lossy, reordering medium
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "host_test.h"
+#include "fake_radio.h"
+#include "node_table.h"
+#include "radio_protocol.h"
+
+#define NODES           3
+#define SENSORS         4
+#define STEP_MS         20
+#define SAMPLE_STEPS    50          /* a reading of every sensor each second */
+#define FLUSH_STEPS     250         /* a burst every 5 s, retried each step until acknowledged */
+#define RUN_STEPS       3000        /* a minute of samples */
+#define SAMPLES_MAX     (RUN_STEPS / SAMPLE_STEPS * SENSORS)
+
+/** Sender side of one node, a reduced radio_flush(): unacknowledged samples stay pending */
+typedef struct {
+    uint8_t id;
+    uint16_t seq;
+    radio_sample_t pending[SAMPLES_MAX];
+    uint16_t head;
+    uint16_t tail;
+    uint8_t retry;                 /* the last burst was not acknowledged in full */
+} node_t;
+
+/** What the base station delivered, per node */
+typedef struct {
+    uint8_t got[SAMPLES_MAX];      /* deliveries of each sample */
+    uint32_t frames;
+    uint32_t seq_errors;           /* frames delivered out of order or twice */
+    uint16_t last_seq;
+    uint8_t any;
+} sink_t;
+
+static node_t gs_node[NODES];
+static sink_t gs_sink[NODES];
+static node_table_t gs_table;
+static const radio_ops_t *gs_radio = &gc_fake_radio_ops;
+
+/** Sample index n of a node: sensor n % SENSORS at second n / SENSORS */
+static uint16_t a_index(const radio_sample_t *s)
+{
+    return (uint16_t)((s->time_ms / 1000) * SENSORS + s->sensor);
+}
+
+/** node_table delivery callback: frames arrive here at most once, in sequence order */
+static void a_deliver(void *ctx, const radio_frame_t *frame)
+{
+    radio_header_t header;
+    radio_sample_t samples[RADIO_PROTOCOL_MAX_PACKED];
+    uint8_t count;
+    sink_t *k;
+
+    (void)ctx;
+    if (radio_protocol_unpack_samples(frame, &header, samples, &count) != 0 || header.node_id >= NODES) {
+        HOST_CHECK(0);
+        return;
+    }
+    k = &gs_sink[header.node_id];
+    if (k->any && (uint16_t)(header.seq - k->last_seq - 1) >= 0x8000u) {
+        k->seq_errors++;
+    }
+    k->any = 1;
+    k->last_seq = header.seq;
+    k->frames++;
+    for (uint8_t i = 0; i < count; i++) {
+        uint16_t n = a_index(&samples[i]);
+
+        if (n < SAMPLES_MAX && samples[i].raw == (int16_t)(n * 3 - 500)) {
+            k->got[n]++;
+        } else {
+            HOST_CHECK(0);
+        }
+    }
+}
+
+/** Pack up to a burst of pending samples, send it, drop what was acknowledged */
+static void a_node_flush(node_t *n)
+{
+    radio_frame_t frames[RADIO_TX_BURST_MAX];
+    uint8_t samples[RADIO_TX_BURST_MAX];
+    uint8_t nframes = 0;
+    uint16_t used = n->head;
+    uint8_t sent = 0;
+    uint8_t packed;
+
+    while ((used < n->tail) && (nframes < RADIO_TX_BURST_MAX)) {
+        uint16_t avail = (uint16_t)(n->tail - used);
+
+        if (radio_protocol_pack_samples_packed(n->id, n->seq, &n->pending[used],
+                                               (uint8_t)((avail > 255) ? 255 : avail),
+                                               &frames[nframes], &packed) != 0) {
+            HOST_CHECK(0);
+            return;
+        }
+        samples[nframes++] = packed;
+        used += packed;
+        n->seq++;
+    }
+    if (nframes == 0) {
+        return;
+    }
+    HOST_CHECK_EQ(gs_radio->send_burst(frames, nframes, &sent), 0);
+    for (uint8_t i = 0; i < sent; i++) {
+        n->head += samples[i];
+    }
+    n->retry = (n->head != n->tail) ? 1 : 0;
+}
+
+/** Base station receive loop, as in radio_rx_task */
+static void a_base_poll(void)
+{
+    radio_frame_t frame;
+    radio_header_t header;
+
+    while (gs_radio->wait(0) == 0) {
+        HOST_CHECK_EQ(gs_radio->receive(&frame), 0);
+        if (radio_protocol_unpack_header(&frame, &header) == 0) {
+            (void)node_table_push(&gs_table, header.node_id, header.seq, &frame, g_fake_radio.now_ms);
+        }
+    }
+    node_table_expire(&gs_table, g_fake_radio.now_ms);
+}
+
+/**
+ * Run all nodes until every sample is acknowledged and the medium is
+ * empty, then check that each sample arrived and no frame was delivered twice.
+ */
+static void a_run(const char *name, uint8_t loss, uint8_t ack_loss, uint8_t reorder)
+{
+    uint32_t dup_samples = 0;
+    uint32_t missing = 0;
+    uint32_t seq_errors = 0;
+    node_stats_t total = {0};
+    uint32_t step;
+    uint8_t busy = 1;
+
+    fake_radio_reset(0x5EED + loss + ack_loss + reorder);
+    g_fake_radio.loss_pct = loss;
+    g_fake_radio.ack_loss_pct = ack_loss;
+    g_fake_radio.reorder_pct = reorder;
+    /* held past the next burst, a frame could fall behind more than NODE_TABLE_REORDER_DEPTH
+       later ones and be given up on although acknowledged: reorder within one burst only */
+    g_fake_radio.hold_max_ms = (uint8_t)(STEP_MS - 1);
+    node_table_init(&gs_table, a_deliver, NULL);
+    memset(gs_sink, 0, sizeof(gs_sink));
+    for (uint8_t i = 0; i < NODES; i++) {
+        memset(&gs_node[i], 0, sizeof(gs_node[i]));
+        gs_node[i].id = i;
+        gs_node[i].seq = (uint16_t)(0xFFF0 + i);         /* wraps during the run */
+    }
+    HOST_CHECK_EQ(gs_radio->init(RADIO_ROLE_BASE), 0);
+    HOST_CHECK_EQ(gs_radio->listen(), 0);
+
+    for (step = 0; busy && (step < 4 * RUN_STEPS); step++) {
+        g_fake_radio.now_ms = step * STEP_MS;
+        busy = (step < RUN_STEPS) || (g_fake_radio.in_air != 0);
+        for (uint8_t i = 0; i < NODES; i++) {
+            node_t *n = &gs_node[i];
+
+            if ((step < RUN_STEPS) && (step % SAMPLE_STEPS) == i) {
+                for (uint8_t s = 0; s < SENSORS; s++) {
+                    radio_sample_t *p = &n->pending[n->tail];
+
+                    p->time_ms = (step / SAMPLE_STEPS) * 1000 + i * STEP_MS;
+                    p->sensor = s;
+                    p->raw = (int16_t)(a_index(p) * 3 - 500);
+                    n->tail++;
+                }
+            }
+            if (n->retry || (step % FLUSH_STEPS) == i || step >= RUN_STEPS) {
+                a_node_flush(n);
+            }
+            busy |= (n->head != n->tail);
+        }
+        a_base_poll();
+    }
+    /* past the reorder hold, so nothing is left in the table */
+    g_fake_radio.now_ms += NODE_TABLE_REORDER_MS + 1;
+    a_base_poll();
+
+    for (uint8_t i = 0; i < NODES; i++) {
+        const node_entry_t *e = node_table_find(&gs_table, i);
+
+        HOST_CHECK(e != NULL);
+        if (e == NULL) {
+            continue;
+        }
+        for (uint16_t n = 0; n < gs_node[i].tail; n++) {
+            missing += (gs_sink[i].got[n] == 0);
+            dup_samples += (gs_sink[i].got[n] > 1) ? gs_sink[i].got[n] - 1 : 0;
+        }
+        seq_errors += gs_sink[i].seq_errors;
+        HOST_CHECK_EQ(e->held, 0);
+        HOST_CHECK_EQ(e->stats.received, gs_sink[i].frames);
+        total.received += e->stats.received;
+        total.duplicates += e->stats.duplicates;
+        total.reordered += e->stats.reordered;
+        total.lost += e->stats.lost;
+        total.restarts += e->stats.restarts;
+    }
+    printf("%-22s attempts %5u delivered %5u dup frames dropped %4u reordered %4u seq lost %3u "
+           "resent samples %3u\n",
+           name, g_fake_radio.attempts, total.received, total.duplicates, total.reordered, total.lost,
+           dup_samples);
+
+    HOST_CHECK(step < 4 * RUN_STEPS);               /* everything got through in the end */
+    HOST_CHECK_EQ(missing, 0);
+    HOST_CHECK_EQ(seq_errors, 0);
+    HOST_CHECK_EQ(total.restarts, 0);
+    HOST_CHECK_EQ(g_fake_radio.overflows, 0);
+    if (ack_loss == 0 && loss == 0) {
+        HOST_CHECK_EQ(dup_samples, 0);
+        HOST_CHECK_EQ(total.duplicates, 0);
+        HOST_CHECK_EQ(total.lost, 0);
+    }
+    if (ack_loss != 0) {
+        HOST_CHECK(total.duplicates > 0);           /* retransmitted copies, suppressed by the table */
+    }
+    if (reorder != 0) {
+        HOST_CHECK(total.reordered > 0);
+    }
+}
+
+int main(void)
+{
+    a_run("clean", 0, 0, 0);
+    a_run("reorder 30%", 0, 0, 30);
+    a_run("ack loss 20%", 0, 20, 0);
+    a_run("loss 30%", 30, 0, 0);
+    a_run("loss+ack+reorder 20%", 20, 20, 20);
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,202 @@
+/**
+ * @file      test_report_policy.c
+ * @brief     Host test: send-on-delta decisions and their commit
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "host_test.h"
+#include "report_policy.h"
+
+/* sensor_node.c defaults */
+#define NODE_SAMPLE_MS      5000
+#define NODE_FLUSH_MS       10000
+#define NODE_DEADBAND_RAW   1
+#define NODE_HEARTBEAT_MS   60000
+
+#define TRACE_MS            (24u * 3600u * 1000u)
+#define PI                  3.14159265358979
+
+static radio_sample_t sample(uint8_t sensor, int16_t raw, uint32_t time_ms)
+{
+    radio_sample_t s = { .time_ms = time_ms, .raw = raw, .sensor = sensor };
+
+    return s;
+}
+
+/** Deadband and heartbeat, every report handed on */
+static void test_deadband(void)
+{
+    report_policy_t p;
+    radio_sample_t s;
+
+    report_policy_init(&p, 2, 60000);
+    s = sample(0, 400, 0);
+    HOST_CHECK_EQ(report_policy_check(&p, &s), 1);           /* first reading */
+    report_policy_commit(&p, &s);
+    s = sample(0, 402, 5000);
+    HOST_CHECK_EQ(report_policy_check(&p, &s), 0);           /* inside the deadband */
+    s = sample(0, 403, 10000);
+    HOST_CHECK_EQ(report_policy_check(&p, &s), 1);           /* outside */
+    report_policy_commit(&p, &s);
+    s = sample(0, 403, 70000);
+    HOST_CHECK_EQ(report_policy_check(&p, &s), 1);           /* heartbeat */
+    report_policy_commit(&p, &s);
+    HOST_CHECK_EQ(p.reported, 3);
+    HOST_CHECK_EQ(p.suppressed, 1);
+}
+
+/** A report that could not be handed on is retried on the next reading */
+static void test_failed_send(void)
+{
+    report_policy_t p;
+    radio_sample_t s;
+
+    report_policy_init(&p, 2, 60000);
+    s = sample(1, 400, 0);
+    report_policy_commit(&p, &s);
+    s = sample(1, 450, 5000);
+    HOST_CHECK_EQ(report_policy_check(&p, &s), 1);           /* queue full: not committed */
+    s = sample(1, 451, 10000);
+    HOST_CHECK_EQ(report_policy_check(&p, &s), 1);           /* still differs from 400 */
+    report_policy_commit(&p, &s);
+    s = sample(1, 452, 15000);
+    HOST_CHECK_EQ(report_policy_check(&p, &s), 0);
+    HOST_CHECK_EQ(p.reported, 2);
+}
+
+static uint32_t gs_rand = 1;
+
+/** Roughly normal noise with unit deviation, the same every run */
+static double a_noise(void)
+{
+    double sum = 0;
+
+    for (int i = 0; i < 12; i++) {
+        gs_rand = gs_rand * 1103515245u + 12345u;
+        sum += ((gs_rand >> 16) & 0x7FFF) / 32768.0;
+    }
+    return sum - 6.0;
+}
+
+/** Temperature in degC of a day-long trace at time t */
+typedef double (*trace_fn_t)(uint32_t t_ms);
+
+static double a_room(uint32_t t)
+{
+    return 21.0 + 1.5 * sin(2 * PI * t / TRACE_MS);
+}
+
+static double a_fridge(uint32_t t)
+{
+    double phase = fmod(t / (45.0 * 60000.0), 1.0);    /* 45 min compressor cycle */
+
+    return 4.0 + 1.5 * ((phase < 0.3) ? 1.0 - phase / 0.15 : -1.0 + (phase - 0.3) / 0.35);
+}
+
+static double a_outdoor(uint32_t t)
+{
+    return 12.0 + 8.0 * sin(2 * PI * t / TRACE_MS) + 1.0 * sin(2 * PI * t / 600000.0);
+}
+
+static double a_steady(uint32_t t)
+{
+    (void)t;
+    return 20.53;                                       /* between two LSB, the reading flickers */
+}
+
+/**
+ * Replay one sensor's day through the policy as temperature_task does, and
+ * the reports through report_hold as the base station does. Payloads are
+ * counted per NODE_FLUSH_MS window with at least one report, against one
+ * per window when every reading is sent.
+ */
+static void a_replay(const char *name, trace_fn_t fn, double noise_lsb, double min_saving)
+{
+    report_policy_t p;
+    report_hold_t hold = {0};
+    uint32_t windows = 0;
+    uint32_t payloads = 0;
+    uint32_t max_error = 0;
+    uint32_t max_age = 0;
+    uint8_t window_used = 0;
+    double saving;
+
+    report_policy_init(&p, NODE_DEADBAND_RAW, NODE_HEARTBEAT_MS);
+    gs_rand = 1;
+    for (uint32_t t = 0; t < TRACE_MS; t += NODE_SAMPLE_MS) {
+        radio_sample_t s = sample(0, (int16_t)lround(fn(t) * 16.0 + noise_lsb * a_noise()), t);
+        uint32_t err;
+
+        if (report_policy_check(&p, &s)) {
+            report_policy_commit(&p, &s);
+            report_hold_update(&hold, &s, t);
+            window_used = 1;
+        }
+        err = (uint32_t)abs(hold.raw - s.raw);
+        if (err > max_error) {
+            max_error = err;
+        }
+        if (report_hold_age(&hold, t) > max_age) {
+            max_age = report_hold_age(&hold, t);
+        }
+        if (((t + NODE_SAMPLE_MS) % NODE_FLUSH_MS) == 0) {
+            windows++;
+            payloads += window_used;
+            window_used = 0;
+        }
+    }
+    saving = 1.0 - (double)payloads / windows;
+    printf("%-10s %8u %8u %8u %8u %7.1f%% %5u %7u\n", name, p.reported + p.suppressed, p.reported,
+           windows, payloads, 100.0 * saving, max_error, max_age / 1000);
+
+    /* the base station never shows a value off by more than the deadband, or older than a heartbeat */
+    HOST_CHECK(max_error <= NODE_DEADBAND_RAW);
+    HOST_CHECK(max_age < NODE_HEARTBEAT_MS);
+    HOST_CHECK(saving >= min_saving);
+}
+
+/** A day of readings per trace, packet reduction against sending every reading */
+static void test_traces(void)
+{
+    printf("%u ms samples, deadband %u LSB, heartbeat %u ms, a payload per %u ms window\n",
+           NODE_SAMPLE_MS, NODE_DEADBAND_RAW, NODE_HEARTBEAT_MS, NODE_FLUSH_MS);
+    printf("%-10s %8s %8s %8s %8s %8s %5s %7s\n",
+           "trace", "readings", "reports", "every", "policy", "saved", "err", "age s");
+    a_replay("room", a_room, 0.3, 0.80);
+    a_replay("fridge", a_fridge, 0.3, 0.75);
+    a_replay("outdoor", a_outdoor, 0.3, 0.45);
+    a_replay("steady", a_steady, 0.5, 0.75);
+    a_replay("noisy", a_steady, 1.5, 0.25);
+}
+
+int main(void)
+{
+    test_deadband();
+    test_failed_send();
+    test_traces();
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,233 @@
+/**
+ * @file      test_sample_codec.c
+ * @brief     Host test: sample_codec round trip, size and speed on sensor traces
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "host_test.h"
+#include "sample_codec.h"
+#include "radio.h"
+
+#define TRACE_LEN       2048
+#define RADIO_BLOCK     (RADIO_PAYLOAD_MAX - RADIO_PROTOCOL_PACKED_OFFSET)
+#define USB_BLOCK       240
+
+static radio_sample_t gs_trace[TRACE_LEN];
+static uint32_t gs_rand = 1;
+
+/** Small LCG, so every run sees the same trace */
+static uint32_t a_rand(void)
+{
+    gs_rand = gs_rand * 1103515245u + 12345u;
+    return (gs_rand >> 16) & 0x7FFF;
+}
+
+/**
+ * Interleaved readings of `sensors` DS18B20s sampled every period_ms with a
+ * few ms of scheduling jitter. Each reading drifts by up to `drift` LSB from
+ * the last one; drift 0 gives flat readings.
+ */
+static uint16_t a_make_trace(uint8_t sensors, uint32_t period_ms, uint32_t jitter_ms, int16_t drift)
+{
+    int16_t raw[SAMPLE_CODEC_MAX_SENSORS];
+    uint32_t t = 100000;
+    uint16_t n = 0;
+
+    for (uint8_t s = 0; s < sensors; s++) {
+        raw[s] = (int16_t)(21 * 16 + s * 8);    /* about 21 degC, 1/16 degC per LSB */
+    }
+    while (n + sensors <= TRACE_LEN) {
+        for (uint8_t s = 0; s < sensors; s++) {
+            if (drift != 0) {
+                raw[s] = (int16_t)(raw[s] + (int16_t)(a_rand() % (2 * drift + 1)) - drift);
+            }
+            gs_trace[n].time_ms = t + ((jitter_ms != 0) ? a_rand() % jitter_ms : 0) + s;
+            gs_trace[n].raw = raw[s];
+            gs_trace[n].sensor = s;
+            n++;
+        }
+        t += period_ms;
+    }
+    return n;
+}
+
+/**
+ * Encode a trace into blocks of at most `block` bytes, decode every block
+ * and compare. Returns the encoded bytes, headers included, and the block count.
+ */
+static uint32_t a_round_trip(const radio_sample_t *in, uint16_t count, uint16_t block, uint32_t *blocks)
+{
+    uint8_t buf[USB_BLOCK];
+    radio_sample_t out[USB_BLOCK];
+    uint32_t bytes = 0;
+    uint16_t done = 0;
+
+    *blocks = 0;
+    while (done < count) {
+        uint16_t len = 0;
+        uint8_t encoded = 0;
+        uint8_t decoded = 0;
+        uint8_t avail = (uint8_t)(((count - done) > 255) ? 255 : (count - done));
+
+        if (sample_codec_encode_block(&in[done], avail, buf, block, &len, &encoded) != 0) {
+            HOST_CHECK(0);
+            return bytes;
+        }
+        HOST_CHECK(len <= block);
+        HOST_CHECK_EQ(sample_codec_decode_block(buf, len, out, USB_BLOCK, &decoded), 0);
+        HOST_CHECK_EQ(decoded, encoded);
+        for (uint8_t i = 0; i < encoded && i < decoded; i++) {
+            if (memcmp(&out[i].time_ms, &in[done + i].time_ms, sizeof(uint32_t)) != 0 ||
+                out[i].raw != in[done + i].raw || out[i].sensor != in[done + i].sensor) {
+                fprintf(stderr, "sample %u: %u/%d/%u decoded as %u/%d/%u\n", done + i,
+                        in[done + i].time_ms, in[done + i].raw, in[done + i].sensor,
+                        out[i].time_ms, out[i].raw, out[i].sensor);
+                HOST_CHECK(0);
+                break;
+            }
+        }
+        bytes += len;
+        done += encoded;
+        (*blocks)++;
+    }
+    return bytes;
+}
+
+/**
+ * Round trip on sensor traces. Size is counted as sample bytes, the block
+ * minus its 4 byte time header, against the 4 bytes of a fixed sample, and
+ * as radio payloads against fixed payloads of RADIO_PROTOCOL_MAX_SAMPLES.
+ */
+static void test_traces(void)
+{
+    static const struct {
+        const char *name;
+        uint8_t sensors;
+        uint32_t period_ms;
+        uint32_t jitter_ms;
+        int16_t drift;
+        double max_bytes;      /* sample bytes per sample; each radio block re-keys every sensor */
+        double max_payloads;   /* radio payloads per fixed payload */
+    } cases[] = {
+        {"1 sensor, steady",        1, 1000,  0,  0, 1.25, 0.35},
+        {"2 sensors, steady",       2, 1000,  0,  0, 1.6, 0.40},
+        {"2 sensors, jitter+drift", 2, 1000,  4,  1, 2.7, 0.70},
+        {"8 sensors, jitter+drift", 8,  750,  4,  2, 3.9, 1.00},
+        {"8 sensors, noisy",        8,  750, 40, 40, 4.2, 1.10},
+    };
+
+    printf("%-24s %8s %8s %9s %9s\n", "trace", "radio B", "usb B", "payloads", "fixed");
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        uint16_t n = a_make_trace(cases[c].sensors, cases[c].period_ms, cases[c].jitter_ms, cases[c].drift);
+        uint32_t radio_blocks;
+        uint32_t usb_blocks;
+        uint32_t radio = a_round_trip(gs_trace, n, RADIO_BLOCK, &radio_blocks);
+        uint32_t usb = a_round_trip(gs_trace, n, USB_BLOCK, &usb_blocks);
+        uint32_t fixed = (n + RADIO_PROTOCOL_MAX_SAMPLES - 1) / RADIO_PROTOCOL_MAX_SAMPLES;
+        double radio_bytes = (double)(radio - radio_blocks * SAMPLE_CODEC_BLOCK_HEADER) / n;
+        double usb_bytes = (double)(usb - usb_blocks * SAMPLE_CODEC_BLOCK_HEADER) / n;
+
+        printf("%-24s %8.2f %8.2f %9u %9u\n", cases[c].name, radio_bytes, usb_bytes, radio_blocks, fixed);
+        HOST_CHECK(radio_bytes <= cases[c].max_bytes);
+        HOST_CHECK(usb_bytes <= cases[c].max_bytes);
+        HOST_CHECK(radio_blocks <= cases[c].max_payloads * fixed);
+    }
+    printf("fixed format: %u sample bytes per sample, %u samples per payload\n",
+           RADIO_PROTOCOL_SAMPLE_SIZE, (unsigned)RADIO_PROTOCOL_MAX_SAMPLES);
+}
+
+/** Values and gaps at the limits of the fields still round trip */
+static void test_extremes(void)
+{
+    static const radio_sample_t trace[] = {
+        {0xFFFFFF00u, -32768, 0},
+        {0xFFFFFF10u, 32767, 0},               /* largest raw delta */
+        {0x00000010u, -32768, 0},               /* time wraps */
+        {0x00000011u, 0, RADIO_PROTOCOL_MAX_SENSOR},
+        {0x08000020u, 0, RADIO_PROTOCOL_MAX_SENSOR},    /* delta of delta over 28 bits: new block */
+        {0x08000021u, 1, 3},
+    };
+    uint32_t blocks;
+
+    (void)a_round_trip(trace, sizeof(trace) / sizeof(trace[0]), RADIO_BLOCK, &blocks);
+    HOST_CHECK(blocks >= 2);
+}
+
+/** Encode and decode time per sample on the host, for relative comparisons only */
+static void test_speed(void)
+{
+    uint16_t n = a_make_trace(2, 1000, 4, 1);
+    uint8_t buf[USB_BLOCK];
+    radio_sample_t out[USB_BLOCK];
+    uint32_t samples = 0;
+    uint32_t sink = 0;
+    clock_t t0;
+    double enc_ns;
+    double dec_ns;
+
+    t0 = clock();
+    for (int run = 0; run < 200; run++) {
+        for (uint16_t done = 0; done < n;) {
+            uint16_t len;
+            uint8_t encoded;
+
+            (void)sample_codec_encode_block(&gs_trace[done], (uint8_t)(((n - done) > 255) ? 255 : (n - done)),
+                                            buf, RADIO_BLOCK, &len, &encoded);
+            sink += len;
+            done += encoded;
+            samples += encoded;
+        }
+    }
+    enc_ns = (double)(clock() - t0) * 1e9 / CLOCKS_PER_SEC / samples;
+
+    {
+        uint16_t len;
+        uint8_t encoded;
+        uint8_t decoded;
+
+        (void)sample_codec_encode_block(gs_trace, 255, buf, USB_BLOCK, &len, &encoded);
+        samples = 0;
+        t0 = clock();
+        for (int run = 0; run < 20000; run++) {
+            (void)sample_codec_decode_block(buf, len, out, USB_BLOCK, &decoded);
+            sink += out[decoded - 1].raw;
+            samples += decoded;
+        }
+        dec_ns = (double)(clock() - t0) * 1e9 / CLOCKS_PER_SEC / samples;
+    }
+    printf("encode %.1f ns/sample, decode %.1f ns/sample on the host (%u)\n", enc_ns, dec_ns, sink & 1);
+}
+
+int main(void)
+{
+    test_traces();
+    test_extremes();
+    test_speed();
+
+    return HOST_TEST_RESULT();
+}
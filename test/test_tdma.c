@@ -0,0 +1,118 @@
+/**
+ * @file      test_tdma.c
+ * @brief     Host test: TDMA slot leases, expiry and rejoins
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "host_test.h"
+#include "tdma.h"
+
+/** Run the master for a number of frames */
+static void frames(tdma_master_t *m, uint32_t n, radio_frame_t *beacon)
+{
+    for (uint32_t i = 0; i < n; ++i) {
+        tdma_master_beacon(m, (uint64_t)m->frame * TDMA_FRAME_MS * 1000u, beacon);
+    }
+}
+
+/** A full table frees up once the lease of silent nodes runs out */
+static void test_expiry(void)
+{
+    tdma_master_t m;
+    radio_frame_t beacon;
+
+    tdma_master_init(&m);
+    for (uint8_t id = 1; id < TDMA_SLOTS; ++id) {
+        HOST_CHECK(tdma_master_join(&m, id) != TDMA_SLOT_NONE);
+    }
+    HOST_CHECK_EQ(tdma_master_join(&m, 100), TDMA_SLOT_NONE);
+    HOST_CHECK_EQ(m.rejected, 1);
+
+    /* Node 1 keeps reporting, the others fall silent */
+    for (uint32_t i = 0; i < TDMA_LEASE_FRAMES + 1; ++i) {
+        frames(&m, 1, &beacon);
+        if ((i % 40) == 0) {
+            HOST_CHECK_EQ(tdma_master_heard(&m, 1), 0);
+        }
+    }
+    HOST_CHECK_EQ(m.expired, TDMA_SLOTS - 2);
+    HOST_CHECK_EQ(tdma_master_heard(&m, 2), 1);
+    HOST_CHECK(tdma_master_join(&m, 100) != TDMA_SLOT_NONE);
+    HOST_CHECK_EQ(tdma_master_heard(&m, 1), 0);
+}
+
+/** A rebooted node joining again keeps its slot, and the join renews the lease */
+static void test_rejoin(void)
+{
+    tdma_master_t m;
+    radio_frame_t beacon;
+    uint8_t slot;
+
+    tdma_master_init(&m);
+    slot = tdma_master_join(&m, 7);
+    for (uint32_t i = 0; i < 20; ++i) {
+        frames(&m, TDMA_LEASE_FRAMES - 1, &beacon);
+        HOST_CHECK_EQ(tdma_master_join(&m, 7), slot);
+    }
+    HOST_CHECK_EQ(m.joins, 1);
+    HOST_CHECK_EQ(m.expired, 0);
+
+    /* The frame counter wraps without touching the lease */
+    frames(&m, 70000, &beacon);
+    HOST_CHECK_EQ(m.expired, 1);
+    HOST_CHECK_EQ(tdma_master_join(&m, 7), slot);
+}
+
+/** A node whose slot expired on the base notices and joins again */
+static void test_node_drops_expired_slot(void)
+{
+    tdma_master_t m;
+    tdma_node_t n;
+    radio_frame_t beacon;
+
+    tdma_master_init(&m);
+    tdma_node_init(&n, 9);
+    (void)tdma_master_join(&m, 9);
+    (void)tdma_master_join(&m, 10);
+    frames(&m, 1, &beacon);
+    HOST_CHECK_EQ(tdma_node_on_beacon(&n, &beacon), 0);
+    HOST_CHECK(n.slot != TDMA_SLOT_NONE);
+
+    frames(&m, TDMA_LEASE_FRAMES, &beacon);                  /* node 9 went quiet */
+    for (uint8_t i = 0; i < TDMA_NODE_MISSING; ++i) {
+        HOST_CHECK(n.slot != TDMA_SLOT_NONE);
+        (void)tdma_master_heard(&m, 10);
+        frames(&m, 1, &beacon);
+        HOST_CHECK_EQ(tdma_node_on_beacon(&n, &beacon), 0);
+    }
+    HOST_CHECK_EQ(n.slot, TDMA_SLOT_NONE);
+}
+
+int main(void)
+{
+    test_expiry();
+    test_rejoin();
+    test_node_drops_expired_slot();
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,201 @@
+/**
+ * @file      test_tdma_sweep.c
+ * @brief     Host test: TDMA frame throughput and collisions over the node count
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "host_test.h"
+#include "tdma.h"
+
+#define NODES_MAX       40
+#define FRAMES          2000
+#define WARMUP_FRAMES   100         /* joins settle before the counters start */
+#define JOIN_SUBSLOTS   4           /* the join slot is split by tdma_node_join_offset() */
+/* a full three payload burst of a steady trace, about 12 packed samples per payload */
+#define BURST_SAMPLES   (RADIO_TX_BURST_MAX * 12)
+
+static uint32_t gs_rand = 1;
+
+static uint32_t a_rand(uint32_t n)
+{
+    gs_rand = gs_rand * 1103515245u + 12345u;
+    return ((gs_rand >> 16) & 0x7FFF) % n;
+}
+
+/**
+ * One saturated sensor node: always a full burst to send, the flow of
+ * tdma_wait_slot(). It sends in its slot, joins while it has none, and sends
+ * at a random time when it missed the beacon.
+ */
+typedef struct {
+    tdma_node_t tdma;
+    uint32_t delivered;            /* samples */
+} sim_node_t;
+
+/** Transmissions of one frame, per slot */
+typedef struct {
+    uint8_t data[TDMA_SLOTS];      /* bursts started in the slot */
+    uint8_t join[JOIN_SUBSLOTS];   /* join requests per part of the join slot */
+    uint8_t joiner[JOIN_SUBSLOTS]; /* node id of the last join in that part */
+    uint8_t sender[TDMA_SLOTS];    /* node index of the last burst in the slot */
+} air_t;
+
+typedef struct {
+    double samples_per_s;
+    double collisions_per_frame;
+    uint32_t admitted;
+    uint32_t join_frames;          /* frames until every node that can have a slot has one */
+    uint32_t unscheduled;
+} sweep_t;
+
+static void a_sweep(uint8_t nodes, uint8_t beacon_loss_pct, sweep_t *r)
+{
+    static sim_node_t node[NODES_MAX];
+    tdma_master_t master;
+    radio_frame_t beacon;
+    uint32_t collisions = 0;
+    uint32_t delivered = 0;
+    uint8_t can_admit = (nodes < TDMA_SLOTS - 1) ? nodes : TDMA_SLOTS - 1;
+
+    memset(r, 0, sizeof(*r));
+    r->join_frames = FRAMES;
+    tdma_master_init(&master);
+    for (uint8_t i = 0; i < nodes; i++) {
+        tdma_node_init(&node[i].tdma, (uint8_t)(i + 1));
+        node[i].delivered = 0;
+    }
+
+    for (uint32_t f = 0; f < FRAMES; f++) {
+        air_t air;
+        uint8_t admitted = 0;
+        uint8_t joins = 0;
+
+        memset(&air, 0, sizeof(air));
+        tdma_master_beacon(&master, (uint64_t)f * TDMA_FRAME_MS * 1000u, &beacon);
+        for (uint8_t i = 0; i < nodes; i++) {
+            sim_node_t *n = &node[i];
+
+            if (a_rand(100) < beacon_loss_pct) {
+                /* no beacon: tdma_wait_slot() gives up and the burst goes out at once */
+                uint8_t s = (uint8_t)a_rand(TDMA_SLOTS);
+
+                air.data[s]++;
+                air.sender[s] = i;
+                r->unscheduled += (f >= WARMUP_FRAMES);
+                continue;
+            }
+            (void)tdma_node_on_beacon(&n->tdma, &beacon);
+            if (n->tdma.slot != TDMA_SLOT_NONE) {
+                air.data[n->tdma.slot]++;
+                air.sender[n->tdma.slot] = i;
+                admitted++;
+                continue;
+            }
+            if (tdma_node_join_due(&n->tdma)) {
+                uint8_t sub = tdma_node_join_offset(&n->tdma, JOIN_SUBSLOTS);
+
+                air.join[sub]++;
+                air.joiner[sub] = n->tdma.node_id;
+            }
+        }
+        if ((admitted >= can_admit) && (r->join_frames == FRAMES)) {
+            r->join_frames = f;
+        }
+
+        /* one transmission in a slot gets through, two or more destroy each other */
+        for (uint8_t sub = 0; sub < JOIN_SUBSLOTS; sub++) {
+            joins += air.join[sub];
+        }
+        for (uint8_t sub = 0; sub < JOIN_SUBSLOTS; sub++) {
+            if ((air.join[sub] == 1) && (air.data[0] == 0)) {
+                (void)tdma_master_join(&master, air.joiner[sub]);
+            } else if ((air.join[sub] + (air.data[0] != 0) > 1) && (f >= WARMUP_FRAMES)) {
+                collisions++;
+            }
+        }
+        for (uint8_t s = 0; s < TDMA_SLOTS; s++) {
+            if ((air.data[s] == 1) && ((s != 0) || (joins == 0))) {
+                sim_node_t *n = &node[air.sender[s]];
+
+                (void)tdma_master_heard(&master, n->tdma.node_id);
+                if (f >= WARMUP_FRAMES) {
+                    n->delivered += BURST_SAMPLES;
+                    delivered += BURST_SAMPLES;
+                }
+            } else if ((air.data[s] > 1) && (f >= WARMUP_FRAMES)) {
+                collisions++;
+            }
+        }
+        if (f == FRAMES - 1) {
+            r->admitted = admitted;
+        }
+    }
+    r->samples_per_s = delivered * 1000.0 / ((double)(FRAMES - WARMUP_FRAMES) * TDMA_FRAME_MS);
+    r->collisions_per_frame = (double)collisions / (FRAMES - WARMUP_FRAMES);
+}
+
+/** Sweep the node count over a TDMA_SLOTS x TDMA_SLOT_MS frame */
+static void test_sweep(void)
+{
+    static const uint8_t counts[] = {1, 2, 4, 8, 12, 15, 16, 20, 30, 40};
+    static const uint8_t losses[] = {0, 2};
+    const double per_node = BURST_SAMPLES * 1000.0 / TDMA_FRAME_MS;
+
+    printf("%u slots x %u ms, frame %u ms, %u samples per burst\n",
+           TDMA_SLOTS, TDMA_SLOT_MS, TDMA_FRAME_MS, BURST_SAMPLES);
+    printf("%6s %6s %10s %12s %9s %11s %12s\n",
+           "nodes", "loss%", "samples/s", "coll/frame", "admitted", "join frames", "unscheduled");
+    for (size_t l = 0; l < sizeof(losses) / sizeof(losses[0]); l++) {
+        for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+            uint8_t n = counts[c];
+            uint8_t can_admit = (n < TDMA_SLOTS - 1) ? n : TDMA_SLOTS - 1;
+            sweep_t r;
+
+            gs_rand = 1;
+            a_sweep(n, losses[l], &r);
+            printf("%6u %6u %10.0f %12.3f %9u %11u %12u\n", n, losses[l], r.samples_per_s,
+                   r.collisions_per_frame, r.admitted, r.join_frames, r.unscheduled);
+            HOST_CHECK(r.join_frames < WARMUP_FRAMES);
+            if (losses[l] == 0) {
+                HOST_CHECK_EQ(r.admitted, can_admit);
+            }
+            if (n <= can_admit && losses[l] == 0) {
+                /* every admitted node gets its slot in every frame, nothing collides */
+                HOST_CHECK_EQ(r.collisions_per_frame * 1000, 0);
+                HOST_CHECK(r.samples_per_s > 0.999 * n * per_node);
+            }
+            /* admitted nodes keep most of their capacity */
+            HOST_CHECK(r.samples_per_s > 0.5 * can_admit * per_node);
+        }
+    }
+}
+
+int main(void)
+{
+    test_sweep();
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,202 @@
+/**
+ * @file      test_timesync.c
+ * @brief     Host test: timesync error bound over drift and beacon jitter
+ * @version   1.0.0
+ * @date      2026-10-19
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+
+#include "host_test.h"
+#include "timesync.h"
+#include "tdma.h"
+
+#define BEACON_US       ((uint64_t)TDMA_FRAME_MS * 1000)
+#define SETTLE_BEACONS  16          /* beacons before the error bound applies */
+#define RUN_BEACONS     400
+#define ERROR_BOUND_US  20
+
+static uint32_t gs_rand = 1;
+
+/** Uniform jitter in [-j, j] us from a small LCG, the same every run */
+static int32_t a_jitter(int32_t j)
+{
+    gs_rand = gs_rand * 1103515245u + 12345u;
+    return (j == 0) ? 0 : (int32_t)((gs_rand >> 16) % (uint32_t)(2 * j + 1)) - j;
+}
+
+/**
+ * A node clock running drift_ppm fast against the base station, started
+ * at an arbitrary local offset; the beacon timestamp taken by the radio
+ * interrupt is off by up to jitter_us.
+ */
+typedef struct {
+    int32_t drift_ppm;
+    int32_t jitter_us;
+    uint64_t local0;
+} clock_model_t;
+
+static uint64_t a_local(const clock_model_t *m, uint64_t net_us)
+{
+    return m->local0 + net_us + (uint64_t)((int64_t)net_us * m->drift_ppm / 1000000);
+}
+
+/** Result of one run: largest beacon error and largest error between beacons after the settle time */
+typedef struct {
+    uint32_t beacon_us;
+    uint32_t between_us;
+    int32_t drift_ppb;
+    uint32_t steps;
+} sync_result_t;
+
+static void a_run(const clock_model_t *m, timesync_t *ts, sync_result_t *r)
+{
+    r->beacon_us = 0;
+    r->between_us = 0;
+    timesync_init(ts);
+    for (uint32_t i = 0; i < RUN_BEACONS; i++) {
+        uint64_t net = (uint64_t)i * BEACON_US;
+        uint64_t local = a_local(m, net) + (uint64_t)(int64_t)a_jitter(m->jitter_us);
+
+        timesync_update(ts, local, net);
+        if (i >= SETTLE_BEACONS) {
+            uint32_t e = (uint32_t)abs(ts->error_us);
+            /* a sample stamped half way to the next beacon, against the true network time */
+            uint64_t mid = net + BEACON_US / 2;
+            int64_t d = (int64_t)(timesync_to_network(ts, a_local(m, mid)) - mid);
+
+            if (e > r->beacon_us) {
+                r->beacon_us = e;
+            }
+            if ((uint32_t)llabs(d) > r->between_us) {
+                r->between_us = (uint32_t)llabs(d);
+            }
+        }
+    }
+    r->drift_ppb = ts->drift_ppb;
+    r->steps = ts->steps;
+}
+
+/** Drift and jitter sweep: the error stays within the bound once settled, and the drift is learned */
+static void test_sweep(void)
+{
+    static const int32_t drifts[] = {-200, -100, -40, -10, 0, 10, 40, 100, 200};
+    static const int32_t jitters[] = {0, 2, 5};
+    timesync_t ts;
+
+    printf("%8s %8s %10s %10s %12s\n", "ppm", "jitter", "beacon us", "mid us", "drift ppb");
+    for (size_t j = 0; j < sizeof(jitters) / sizeof(jitters[0]); j++) {
+        for (size_t d = 0; d < sizeof(drifts) / sizeof(drifts[0]); d++) {
+            clock_model_t m = {drifts[d], jitters[j], 123456789u};
+            sync_result_t r;
+            int32_t want = -drifts[d] * 1000;
+
+            a_run(&m, &ts, &r);
+            printf("%8d %8d %10u %10u %12d\n", drifts[d], jitters[j], r.beacon_us, r.between_us, r.drift_ppb);
+            HOST_CHECK(r.beacon_us <= ERROR_BOUND_US);
+            HOST_CHECK(r.between_us <= ERROR_BOUND_US);
+            HOST_CHECK_EQ(r.steps, 0);
+            /* the learned rate is good to twice the timestamp resolution over one beacon interval */
+            HOST_CHECK(llabs((long long)r.drift_ppb - want) <=
+                       (2LL * jitters[j] + 1) * 2 * 1000000000LL / (long long)BEACON_US);
+        }
+    }
+}
+
+/** Jitter beyond the bound: reported, and still no step */
+static void test_large_jitter(void)
+{
+    clock_model_t m = {40, 50, 1000};
+    timesync_t ts;
+    sync_result_t r;
+
+    a_run(&m, &ts, &r);
+    printf("jitter 50 us: beacon %u us, mid %u us\n", r.beacon_us, r.between_us);
+    HOST_CHECK(r.beacon_us > ERROR_BOUND_US);
+    HOST_CHECK(r.beacon_us < TIMESYNC_STEP_US);
+    HOST_CHECK_EQ(r.steps, 0);
+}
+
+/** Errors up to TIMESYNC_STEP_US are corrected, beyond it the model starts over */
+static void test_step(void)
+{
+    timesync_t ts;
+
+    timesync_init(&ts);
+    timesync_update(&ts, 1000000, 5000000);
+    timesync_update(&ts, 1000000 + BEACON_US, 5000000 + BEACON_US + TIMESYNC_STEP_US);
+    HOST_CHECK_EQ(ts.steps, 0);
+    HOST_CHECK_EQ(ts.error_us, TIMESYNC_STEP_US);
+    HOST_CHECK_EQ(ts.max_error_us, TIMESYNC_STEP_US);
+
+    timesync_init(&ts);
+    timesync_update(&ts, 1000000, 5000000);
+    timesync_update(&ts, 1000000 + BEACON_US, 5000000 + BEACON_US - TIMESYNC_STEP_US - 1);
+    HOST_CHECK_EQ(ts.steps, 1);
+    HOST_CHECK_EQ(ts.drift_ppb, 0);
+    HOST_CHECK_EQ(ts.max_error_us, 0);
+    /* the step takes the new beacon as reference: the next one lines up again */
+    timesync_update(&ts, 1000000 + 2 * BEACON_US, 5000000 + 2 * BEACON_US - TIMESYNC_STEP_US - 1);
+    HOST_CHECK_EQ(ts.steps, 1);
+    HOST_CHECK_EQ(ts.error_us, 0);
+
+    /* base station reboot: network time goes back to zero */
+    timesync_update(&ts, 1000000 + 3 * BEACON_US, 0);
+    HOST_CHECK_EQ(ts.steps, 2);
+    HOST_CHECK_EQ(timesync_to_network(&ts, 1000000 + 3 * BEACON_US), 0);
+
+    /* a beacon with no local time elapsed cannot correct a rate */
+    timesync_update(&ts, 1000000 + 3 * BEACON_US, 10);
+    HOST_CHECK_EQ(ts.steps, 3);
+}
+
+/** A clock off by more than TIMESYNC_MAX_DRIFT_PPB pins the estimate at the clamp */
+static void test_clamp(void)
+{
+    static const int32_t drifts[] = {700, -700};
+    timesync_t ts;
+
+    for (size_t d = 0; d < sizeof(drifts) / sizeof(drifts[0]); d++) {
+        clock_model_t m = {drifts[d], 0, 0};
+        sync_result_t r;
+        /* the unmodelled 200 ppm shows up as error at every beacon */
+        uint32_t residual = (uint32_t)((abs(drifts[d]) * 1000 - TIMESYNC_MAX_DRIFT_PPB) * BEACON_US / 1000000000u);
+
+        a_run(&m, &ts, &r);
+        printf("%d ppm: drift %d ppb, beacon error %u us\n", drifts[d], r.drift_ppb, r.beacon_us);
+        HOST_CHECK_EQ(llabs(r.drift_ppb), TIMESYNC_MAX_DRIFT_PPB);
+        HOST_CHECK((r.drift_ppb < 0) == (drifts[d] > 0));
+        HOST_CHECK(r.beacon_us + 2 >= residual && r.beacon_us <= residual + 2);
+        HOST_CHECK_EQ(r.steps, 0);
+    }
+}
+
+int main(void)
+{
+    test_sweep();
+    test_large_jitter();
+    test_step();
+    test_clamp();
+
+    return HOST_TEST_RESULT();
+}
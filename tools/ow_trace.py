@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+"""Decode 1-Wire bus traces from the sensor node (USB_FRAME_OW_TRACE frames).
+
+Reads a capture file, or with --port sends 'O' to a node and reads the dump
+until the terminating empty frame. Prints one annotated line per transaction
+(reset, ROM command, function command, data) and latency statistics per
+function command.
+
+    tools/ow_trace.py --port /dev/ttyACM0
+    tools/ow_trace.py capture.bin --quiet
+"""
+
+import argparse
+import struct
+import sys
+
+FRAME_OW_TRACE = 0x08
+
+EV_RESET, EV_WRITE, EV_READ, EV_CONVERT, EV_CRC = 1, 2, 3, 4, 5
+
+ROM_COMMANDS = {
+    0x33: "READ ROM",
+    0x55: "MATCH ROM",
+    0xCC: "SKIP ROM",
+    0xF0: "SEARCH ROM",
+    0xEC: "ALARM SEARCH",
+}
+
+FUNCTION_COMMANDS = {
+    0x44: "CONVERT T",
+    0x4E: "WRITE SCRATCHPAD",
+    0xBE: "READ SCRATCHPAD",
+    0x48: "COPY SCRATCHPAD",
+    0xB8: "RECALL EE",
+    0xB4: "READ POWER SUPPLY",
+}
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, as usb_frame_crc16()."""
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def frames(data):
+    """Yield (type, seq, payload) of every frame with a valid crc."""
+    i = 0
+    while True:
+        i = data.find(b"\xA5\x5A", i)
+        if i < 0 or i + 6 > len(data):
+            return
+        ftype, seq, length = data[i + 2], data[i + 3], struct.unpack_from("<H", data, i + 4)[0]
+        end = i + 6 + length
+        if end + 2 > len(data):
+            return
+        if struct.unpack_from("<H", data, end)[0] == crc16(data[i + 2:end]):
+            yield ftype, seq, data[i + 6:end]
+            i = end + 2
+        else:
+            i += 1
+
+
+def events(data):
+    """Return (events, lost) from all trace frames; events are (time_us, type, data, status)."""
+    out, lost = [], 0
+    for ftype, _, payload in frames(data):
+        if ftype != FRAME_OW_TRACE or len(payload) < 4:
+            continue
+        lost = struct.unpack_from("<I", payload)[0]
+        for off in range(4, len(payload) - 7, 8):
+            out.append(struct.unpack_from("<IBBBx", payload, off))
+    return out, lost
+
+
+def transactions(evs):
+    """Group events into transactions, each starting at a reset."""
+    cur = None
+    for ev in evs:
+        if ev[1] == EV_RESET:
+            if cur:
+                yield cur
+            cur = [ev]
+        elif cur is not None:
+            cur.append(ev)
+    if cur:
+        yield cur
+
+
+def describe(tr):
+    """Return (function name, annotated text, error flag) of one transaction."""
+    t0 = tr[0][0]
+    parts, state, rom, func, error = [], "rom", [], "-", False
+    for t, kind, value, status in tr:
+        dt = (t - t0) & 0xFFFFFFFF
+        if kind == EV_RESET:
+            text = ["RESET presence %d us" % value, "RESET no presence", "RESET bus stuck low"][min(status, 2)]
+            error |= status != 0
+        elif kind == EV_WRITE and state == "rom":
+            text = ROM_COMMANDS.get(value, "ROM 0x%02X" % value)
+            state = "id" if value == 0x55 else "func"
+        elif kind == EV_WRITE and state == "id":
+            rom.append(value)
+            if len(rom) < 8:
+                continue
+            text, state = "id " + "".join("%02X" % b for b in rom), "func"
+        elif kind == EV_WRITE and state == "func":
+            func = FUNCTION_COMMANDS.get(value, "CMD 0x%02X" % value)
+            text, state = func, "data"
+        elif kind == EV_WRITE:
+            text = "w %02X" % value
+        elif kind == EV_READ:
+            text = "r %02X" % value
+        elif kind == EV_CONVERT:
+            text = "done after %d polls" % value if status == 0 else "conversion timeout"
+            error |= status != 0
+        elif kind == EV_CRC:
+            text, error = "CRC mismatch (got %02X)" % value, True
+        else:
+            text = "? %d/%02X/%d" % (kind, value, status)
+        parts.append("+%d %s" % (dt, text))
+    return func, " | ".join(parts), error
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("capture", nargs="?", help="binary capture of the node's USB stream")
+    ap.add_argument("--port", help="serial port of a node; sends 'O' and reads the dump")
+    ap.add_argument("--quiet", action="store_true", help="statistics only")
+    args = ap.parse_args()
+
+    if args.port:
+        import serial  # pyserial, only needed for live capture
+
+        with serial.Serial(args.port, timeout=2) as port:
+            port.reset_input_buffer()
+            port.write(b"O")
+            data = b""
+            while True:
+                chunk = port.read(4096)
+                data += chunk
+                if not chunk or any(t == FRAME_OW_TRACE and len(p) == 4 for t, _, p in frames(data)):
+                    break
+    elif args.capture:
+        with open(args.capture, "rb") as f:
+            data = f.read()
+    else:
+        ap.error("give a capture file or --port")
+
+    evs, lost = events(data)
+    stats = {}
+    errors = 0
+    for tr in transactions(evs):
+        func, text, error = describe(tr)
+        errors += error
+        us = (tr[-1][0] - tr[0][0]) & 0xFFFFFFFF
+        stats.setdefault(func, []).append(us)
+        if not args.quiet:
+            print("%10d %s%s" % (tr[0][0], "! " if error else "", text))
+
+    print("%d events, %d lost, %d transactions with errors" % (len(evs), lost, errors))
+    print("%-20s %6s %8s %8s %8s" % ("command", "count", "min us", "mean us", "max us"))
+    for func, v in sorted(stats.items()):
+        print("%-20s %6d %8d %8d %8d" % (func, len(v), min(v), sum(v) // len(v), max(v)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())